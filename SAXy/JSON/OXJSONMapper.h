@@ -28,6 +28,7 @@
 #pragma mark - lookup
 - (OXJSONObjectMapper *)objectMapperForPath:(NSString *)path;       //lookup object mapper from JSON path
 - (OXJSONObjectMapper *)objectMapperForClass:(Class)type;           //lookup object mapper from it's type
+- (NSArray *)mappedClasses;                                         //snapshot of the classes with object mappers, does not configure
 //- (OXJSONObjectMapper *)matchObject:(OXContext *)context;
 
 #pragma mark - configure
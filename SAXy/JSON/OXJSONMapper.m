@@ -75,19 +75,33 @@
 
 - (OXJSONObjectMapper *)objectMapperForClass:(Class)type
 {
-    NSString *className = NSStringFromClass(type);
-    OXJSONObjectMapper *mapper = [_mappersIndexedByClass objectForKey:className];
-    if (mapper == nil) {
-        //build a mapper on-the-fly
-        mapper = [OXJSONObjectMapper objectClass:type];
-        if (mapper != nil) {
-            [self addObjectMapper:mapper];
+    @synchronized(self) {   //on-the-fly mappers may be added by readers sharing this mapper
+        NSString *className = NSStringFromClass(type);
+        OXJSONObjectMapper *mapper = [_mappersIndexedByClass objectForKey:className];
+        if (mapper == nil) {
+            //build a mapper on-the-fly
+            mapper = [OXJSONObjectMapper objectClass:type];
+            if (mapper != nil) {
+                [self addObjectMapper:mapper];
+            }
         }
+        if ( ! mapper.isConfigured && _context) {
+            [mapper configure:_context];
+        }
+        return mapper;
     }
-    if ( ! mapper.isConfigured && _context) {
-        [mapper configure:_context];
+}
+
+- (NSArray *)mappedClasses
+{
+    @synchronized(self) {
+        NSMutableArray *classes = [NSMutableArray arrayWithCapacity:[_mappersIndexedByClass count]];
+        for(OXJSONObjectMapper *mapper in [_mappersIndexedByClass objectEnumerator]) {
+            if (mapper.toType.type)
+                [classes addObject:mapper.toType.type];
+        }
+        return classes;
     }
-    return mapper;
 }
 
 
@@ -95,16 +109,18 @@
 
 - (NSArray *)configure:(OXContext *)context
 {
-    NSArray *errors = nil;
-    if ( ! _isConfigured) {
-        _context = context;
-        for(OXPathMapper *mapper in [_mappersIndexedByClass allValues]) {
-            NSArray *subErrors = [mapper configure:context];
-            errors = subErrors == nil ? errors : (errors ? [subErrors arrayByAddingObjectsFromArray:errors] : subErrors);
+    @synchronized(self) {   //readers on other threads (or OXMetadataRegistry warmUp:) may configure concurrently
+        NSArray *errors = nil;
+        if ( ! _isConfigured) {
+            _context = context;
+            for(OXPathMapper *mapper in [_mappersIndexedByClass allValues]) {
+                NSArray *subErrors = [mapper configure:context];
+                errors = subErrors == nil ? errors : (errors ? [subErrors arrayByAddingObjectsFromArray:errors] : subErrors);
+            }
+            _isConfigured = YES;
         }
-        _isConfigured = YES;
+        return errors;
     }
-    return errors;
 }
 
 
@@ -11,6 +11,7 @@
 #import "OXProperty.h"
 #import "OXContext.h"
 #import "OXUtil.h"
+#import "OXGeneratedMapping.h"
 
 @interface OXJSONObjectMapper ()
 - (void)resetIndexedMappers;
@@ -98,7 +99,7 @@
 
 - (void)configureRootMapper:(OXContext *)context    //TODO move to OXComplexMapper?
 {
-    self.factory = ^(NSString *path, OXContext *ctx){ return context; }; //just return existing context instance
+    self.factory = ^(NSString *path, OXContext *ctx){ return ctx; };     //the reading context, readers on other threads pass their own
     self.lock = YES;                                                        //don't map other context properties
     NSArray *propertyKeys = self.orderedPropertyKeys;
     NSUInteger keyCount = propertyKeys ? [propertyKeys count] : 0;
@@ -150,7 +151,9 @@
                 switch (property.type.typeEnum) {
                     case OX_CONTAINER: {
                         //unknown source type, polymprphic child type (aka NSObject) and guess that path is singular form of property name:
-                        NSString *singularTag = [OXUtil guessSingularNoun:name];
+                        NSString *singularTag = [OXGeneratedMapping tagForClass:self.toType.type property:name];   //generated ahead-of-time?
+                        if (singularTag == nil)
+                            singularTag = [OXUtil guessSingularNoun:name];
                         simpleMapper = [[OXJSONPathMapper alloc] initMapperToType:property.type toPath:name fromType:nil fromPath:singularTag];
                         break;
                     }
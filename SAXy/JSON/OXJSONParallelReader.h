@@ -0,0 +1,67 @@
+/**
+
+  OXJSONParallelReader.h
+  SAXy OX - Object-to-XML mapping library
+
+  Multi-core reader for large JSON exports whose bulk is one array of homogeneous objects, either the top-level array
+  or an array at a key path of the top-level object (i.e. @"data.items").  Reading takes two phases:
+
+    1) a structural pass classifies the input 64 bytes at a time with SSE2/AVX2 (x86-64) or NEON (arm64) compares,
+       masks out string contents (escaped quotes included) and walks the remaining brackets, commas and colons to
+       locate the array and the boundaries of its elements - no objects are created
+    2) the elements are split into slices of about sliceSize bytes, each slice is parsed by NSJSONSerialization and
+       decoded into domain objects by its own OXJSONReader on a concurrent dispatch queue, sharing the mapper
+
+  The first slice is read in place (with the rest of the document) and its result graph is returned, objects of the
+  other slices are appended to the mapped container property in document order.  The result equals an OXJSONReader
+  read.
+
+    OXJSONParallelReader *reader = [OXJSONParallelReader readerWithMapper:mapper arrayPath:@"statuses"];
+    TweetList *list = [reader readData:data];
+
+  Keys are matched as raw bytes, without escape sequences.  Compressed input, small arrays, lazy container properties,
+  a template context with an identityMap or an array path the mapper doesn't map to a container property are read
+  sequentially with a single OXJSONReader.
+
+  Created by agent on 10/19/26.
+
+ */
+#import <Foundation/Foundation.h>
+#import "OXJSONMapper.h"
+#import "OXContext.h"
+
+
+@interface OXJSONParallelReader : NSObject
+
+#pragma mark - properties
+@property(strong,nonatomic,readonly)OXJSONMapper *mapper;
+@property(strong,nonatomic,readonly)NSArray *arrayPath;            //keys from the top-level object, empty for a top-level array
+@property(strong,nonatomic,readonly)NSArray *errors;               //errors of all slices, nil on success
+@property(strong,nonatomic,readonly)OXContext *context;            //template: transform, limits and logging flags are copied to worker contexts
+@property(assign,nonatomic,readwrite)NSUInteger sliceSize;          //element bytes per worker slice, default: 256KB
+@property(assign,nonatomic,readonly)NSUInteger sliceCount;         //slices of the last read, 1 if read sequentially
+
+#pragma mark - constructor
++ (id)readerWithMapper:(OXJSONMapper *)mapper arrayPath:(NSString *)arrayPath;     //nil or @"" for a top-level array
+
+#pragma mark - reader
+- (id)readData:(NSData *)jsonData;                                  //returns result graph, nil on error
+- (id)readText:(NSString *)jsonText;
+
+@end
+
+//
+//  Copyright (c) 2013 Outsource Cafe, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
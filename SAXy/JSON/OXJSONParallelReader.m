@@ -0,0 +1,512 @@
+//
+//  OXJSONParallelReader.m
+//  SAXy OX - Object-to-XML mapping library
+//
+//  Created by agent on 10/19/26.
+//
+
+#import "OXJSONParallelReader.h"
+#import "OXJSONReader.h"
+#import "OXJSONObjectMapper.h"
+#import "OXJSONPathMapper.h"
+#import "OXGzipStream.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+#define OX_PARALLEL_SLICE_SIZE (256 * 1024)
+#define OX_PARALLEL_MAX_KEYS 32
+
+
+#pragma mark - structural index
+
+
+//one bit per byte of a 64 byte block
+typedef struct {
+    uint64_t quote;
+    uint64_t backslash;
+    uint64_t op;            //[ ] { } , :
+} OXJSONBlockMasks;
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+//NEON has no movemask, weight the compare lanes by bit position and add pairwise
+static inline uint64_t OXNeonMask(uint8x16_t m0, uint8x16_t m1, uint8x16_t m2, uint8x16_t m3)
+{
+    const uint8x16_t weights = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80};
+    uint8x16_t sum0 = vpaddq_u8(vandq_u8(m0, weights), vandq_u8(m1, weights));
+    uint8x16_t sum1 = vpaddq_u8(vandq_u8(m2, weights), vandq_u8(m3, weights));
+    sum0 = vpaddq_u8(sum0, sum1);
+    sum0 = vpaddq_u8(sum0, sum0);
+    return vgetq_lane_u64(vreinterpretq_u64_u8(sum0), 0);
+}
+#endif
+
+//'[' and '{' (or ']' and '}') differ in bit 0x20 only, so 4 compares find all six structural characters
+static inline void OXClassifyBlock(const uint8_t *p, OXJSONBlockMasks *masks)
+{
+#if defined(__AVX2__)
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i lowerBit = _mm256_set1_epi8(0x20);
+    const __m256i open = _mm256_set1_epi8('{');
+    const __m256i close = _mm256_set1_epi8('}');
+    const __m256i comma = _mm256_set1_epi8(',');
+    const __m256i colon = _mm256_set1_epi8(':');
+    masks->quote = masks->backslash = masks->op = 0;
+    for(int i = 0; i < 2; i++) {
+        const __m256i c = _mm256_loadu_si256((const __m256i *)(p + 32 * i));
+        const __m256i lower = _mm256_or_si256(c, lowerBit);
+        const __m256i op = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(lower, open), _mm256_cmpeq_epi8(lower, close)),
+                                           _mm256_or_si256(_mm256_cmpeq_epi8(c, comma), _mm256_cmpeq_epi8(c, colon)));
+        masks->quote |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(c, quote)) << (32 * i);
+        masks->backslash |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(c, backslash)) << (32 * i);
+        masks->op |= (uint64_t)(uint32_t)_mm256_movemask_epi8(op) << (32 * i);
+    }
+#elif defined(__SSE2__)
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i lowerBit = _mm_set1_epi8(0x20);
+    const __m128i open = _mm_set1_epi8('{');
+    const __m128i close = _mm_set1_epi8('}');
+    const __m128i comma = _mm_set1_epi8(',');
+    const __m128i colon = _mm_set1_epi8(':');
+    masks->quote = masks->backslash = masks->op = 0;
+    for(int i = 0; i < 4; i++) {
+        const __m128i c = _mm_loadu_si128((const __m128i *)(p + 16 * i));
+        const __m128i lower = _mm_or_si128(c, lowerBit);
+        const __m128i op = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(lower, open), _mm_cmpeq_epi8(lower, close)),
+                                        _mm_or_si128(_mm_cmpeq_epi8(c, comma), _mm_cmpeq_epi8(c, colon)));
+        masks->quote |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(c, quote)) << (16 * i);
+        masks->backslash |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(c, backslash)) << (16 * i);
+        masks->op |= (uint64_t)(uint16_t)_mm_movemask_epi8(op) << (16 * i);
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    uint8x16_t quote[4], backslash[4], op[4];
+    for(int i = 0; i < 4; i++) {
+        const uint8x16_t c = vld1q_u8(p + 16 * i);
+        const uint8x16_t lower = vorrq_u8(c, vdupq_n_u8(0x20));
+        quote[i] = vceqq_u8(c, vdupq_n_u8('"'));
+        backslash[i] = vceqq_u8(c, vdupq_n_u8('\\'));
+        op[i] = vorrq_u8(vorrq_u8(vceqq_u8(lower, vdupq_n_u8('{')), vceqq_u8(lower, vdupq_n_u8('}'))),
+                         vorrq_u8(vceqq_u8(c, vdupq_n_u8(',')), vceqq_u8(c, vdupq_n_u8(':'))));
+    }
+    masks->quote = OXNeonMask(quote[0], quote[1], quote[2], quote[3]);
+    masks->backslash = OXNeonMask(backslash[0], backslash[1], backslash[2], backslash[3]);
+    masks->op = OXNeonMask(op[0], op[1], op[2], op[3]);
+#else
+    masks->quote = masks->backslash = masks->op = 0;
+    for(int i = 0; i < 64; i++) {
+        const uint8_t c = p[i];
+        const uint8_t lower = c | 0x20;
+        if (c == '"')
+            masks->quote |= 1ULL << i;
+        else if (c == '\\')
+            masks->backslash |= 1ULL << i;
+        else if (lower == '{' || lower == '}' || c == ',' || c == ':')
+            masks->op |= 1ULL << i;
+    }
+#endif
+}
+
+//characters escaped by an odd run of backslashes, carrying runs across blocks
+static inline uint64_t OXEscapedMask(uint64_t backslash, uint64_t *prevEscaped)
+{
+    const uint64_t evenBits = 0x5555555555555555ULL;
+    backslash &= ~*prevEscaped;
+    const uint64_t followsEscape = backslash << 1 | *prevEscaped;
+    const uint64_t oddStarts = backslash & ~evenBits & ~followsEscape;
+    const uint64_t evenStarts = oddStarts + backslash;
+    *prevEscaped = evenStarts < oddStarts;      //carry out of the addition, the run continues in the next block
+    return (evenBits ^ (evenStarts << 1)) & followsEscape;
+}
+
+//bit i is the xor of bits 0..i: set from an opening quote up to (not including) the closing quote
+static inline uint64_t OXPrefixXor(uint64_t x)
+{
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+}
+
+static BOOL OXBlank(const uint8_t *p, const uint8_t *end)
+{
+    for(; p < end; p++) {
+        if (*p != ' ' && *p != '\n' && *p != '\r' && *p != '\t')
+            return NO;
+    }
+    return YES;
+}
+
+//Locates the array at the key path and appends the NSRange of each of its elements to elements.  Returns the offset of
+//the array's closing ']', NSNotFound if there is no such array or brackets are unbalanced.
+static NSUInteger OXIndexArray(const uint8_t *bytes, NSUInteger length, const char **keys, const size_t *keyLengths, NSUInteger keyCount, NSMutableData *elements)
+{
+    uint64_t prevEscaped = 0;
+    uint64_t prevInString = 0;              //all ones if the previous block ended inside a string
+    NSUInteger depth = 0;                   //open objects and arrays
+    NSUInteger matched = 0;                 //keys matched, the object holding the next key is at depth matched + 1
+    NSUInteger candidate = 0;               //keys matched if the pending value opens
+    BOOL pending = (keyCount == 0);         //YES until the next structural character, which starts the value of a matched key
+    NSUInteger arrayDepth = 0;              //depth inside the located array, 0 until found
+    NSUInteger elementStart = 0;
+    NSUInteger quoteStart = 0;
+    NSUInteger quoteEnd = 0;
+    uint8_t tail[64];
+    for(NSUInteger block = 0; block < length; block += 64) {
+        const uint8_t *p = bytes + block;
+        if (length - block < 64) {
+            memset(tail, ' ', sizeof(tail));
+            memcpy(tail, p, length - block);
+            p = tail;
+        }
+        OXJSONBlockMasks masks;
+        OXClassifyBlock(p, &masks);
+        const uint64_t quotes = masks.quote & ~OXEscapedMask(masks.backslash, &prevEscaped);
+        const uint64_t inString = OXPrefixXor(quotes) ^ prevInString;
+        prevInString = (uint64_t)((int64_t)inString >> 63);
+        uint64_t structurals = (masks.op & ~inString) | quotes;
+        while (structurals) {
+            const unsigned bit = __builtin_ctzll(structurals);
+            const NSUInteger pos = block + bit;
+            structurals &= structurals - 1;
+            const uint8_t c = bytes[pos];
+            if (c == '"') {
+                if (inString & (1ULL << bit)) {
+                    quoteStart = pos;
+                    pending = NO;           //string value
+                } else {
+                    quoteEnd = pos;
+                }
+                continue;
+            }
+            if (pending) {
+                pending = NO;
+                if (c == '{' && candidate < keyCount) {
+                    matched = candidate;
+                } else if (c == '[' && candidate == keyCount) {
+                    arrayDepth = depth + 1;
+                    elementStart = pos + 1;
+                }
+            }
+            switch (c) {
+                case '{':
+                case '[':
+                    depth++;
+                    break;
+                case '}':
+                case ']':
+                    if (depth == 0)
+                        return NSNotFound;
+                    if (arrayDepth && depth == arrayDepth) {
+                        if ( ! OXBlank(bytes + elementStart, bytes + pos)) {
+                            NSRange element = NSMakeRange(elementStart, pos - elementStart);
+                            [elements appendBytes:&element length:sizeof(NSRange)];
+                        }
+                        return pos;
+                    }
+                    if (matched > 0 && depth == matched + 1)
+                        matched--;
+                    depth--;
+                    break;
+                case ',':
+                    if (arrayDepth && depth == arrayDepth) {
+                        NSRange element = NSMakeRange(elementStart, pos - elementStart);
+                        [elements appendBytes:&element length:sizeof(NSRange)];
+                        elementStart = pos + 1;
+                    }
+                    break;
+                case ':':
+                    if (arrayDepth == 0 && matched < keyCount && depth == matched + 1 && quoteEnd > quoteStart
+                            && quoteEnd - quoteStart - 1 == keyLengths[matched] && memcmp(bytes + quoteStart + 1, keys[matched], keyLengths[matched]) == 0) {
+                        pending = YES;
+                        candidate = matched + 1;
+                    }
+                    break;
+            }
+        }
+    }
+    return NSNotFound;
+}
+
+
+#pragma mark - OXJSONParallelReader
+
+
+@implementation OXJSONParallelReader
+{
+    NSMutableArray *_errorList;
+}
+
+#pragma mark - constructor
+
+- (id)initWithMapper:(OXJSONMapper *)mapper arrayPath:(NSString *)arrayPath
+{
+    if (self = [super init]) {
+        NSMutableArray *keys = [NSMutableArray array];
+        for(NSString *key in [arrayPath componentsSeparatedByString:@"."]) {
+            if ([key length] > 0)
+                [keys addObject:key];
+        }
+        NSAssert2(mapper != nil && [keys count] <= OX_PARALLEL_MAX_KEYS, @"ERROR: OXJSONParallelReader requires a mapper and an array path with at most %d keys, not '%@'", OX_PARALLEL_MAX_KEYS, arrayPath);
+        _mapper = mapper;
+        _arrayPath = keys;
+        _context = [[OXContext alloc] init];
+        _sliceSize = OX_PARALLEL_SLICE_SIZE;
+    }
+    return self;
+}
+
++ (id)readerWithMapper:(OXJSONMapper *)mapper arrayPath:(NSString *)arrayPath
+{
+    return [[OXJSONParallelReader alloc] initWithMapper:mapper arrayPath:arrayPath];
+}
+
+
+#pragma mark - error handling
+
+- (void)addErrors:(NSArray *)errors
+{
+    if (_errorList == nil)
+        _errorList = [NSMutableArray array];
+    [_errorList addObjectsFromArray:errors];
+    _errors = _errorList;
+}
+
+- (NSError *)errorWithMessage:(NSString *)errorMessage
+{
+    return [NSError errorWithDomain:@"com.outsourcecafe.ox" code:99 userInfo:@{NSLocalizedDescriptionKey:errorMessage}];
+}
+
+
+#pragma mark - private
+
+//worker context: transform and logging flags of the template, its own stacks, no pool or intern table (not thread safe)
+- (OXContext *)workerContext
+{
+    OXContext *ctx = [[OXContext alloc] initWithTransform:_context.transform];
+    ctx.logReaderStack = _context.logReaderStack;
+    [ctx copyLimitsFrom:_context];
+    return ctx;
+}
+
+- (id)readSequentially:(NSData *)jsonData
+{
+    _sliceCount = 1;
+    OXJSONReader *reader = [OXJSONReader readerWithMapper:_mapper context:_context];
+    id result = [reader readData:jsonData];
+    if (reader.errors)
+        [self addErrors:reader.errors];
+    return result;
+}
+
+//path mappers from the root mapper down to the container property holding the array, nil if the array isn't mapped
+- (NSArray *)pathMappersToArray
+{
+    NSMutableArray *remaining = [NSMutableArray arrayWithObject:OX_ROOT_PATH];     //the reader wraps JSON in a root object
+    [remaining addObjectsFromArray:_arrayPath];
+    NSMutableArray *chain = [NSMutableArray array];
+    OXJSONObjectMapper *objMapper = _mapper.rootMapper;
+    while (objMapper) {
+        OXJSONPathMapper *next = nil;
+        NSArray *nextKeys = nil;
+        for(NSString *propertyKey in objMapper.orderedPropertyKeys) {
+            OXJSONPathMapper *pathMapper = [objMapper objectMapperByProperty:propertyKey];
+            NSArray *keys = [pathMapper.fromPath componentsSeparatedByString:@"."];
+            if ([keys count] <= [remaining count] && [keys isEqualToArray:[remaining subarrayWithRange:NSMakeRange(0, [keys count])]]) {
+                next = pathMapper;
+                nextKeys = keys;
+                break;
+            }
+        }
+        if (next == nil || next.lazy)
+            return nil;
+        [chain addObject:next];
+        [remaining removeObjectsInRange:NSMakeRange(0, [nextKeys count])];
+        if ([remaining count] == 0)
+            return next.toType.typeEnum == OX_CONTAINER ? chain : nil;
+        if (next.toType.typeEnum != OX_COMPLEX)
+            return nil;
+        objMapper = [_mapper objectMapperForClass:next.toType.type];
+    }
+    return nil;
+}
+
+//element ranges grouped into slices of about sliceSize bytes, as NSRange of element indexes
+- (NSArray *)slicesOfElements:(const NSRange *)elements count:(NSUInteger)count
+{
+    NSMutableArray *slices = [NSMutableArray array];
+    const NSUInteger sliceSize = MAX(_sliceSize, 1);
+    NSUInteger first = 0;
+    for(NSUInteger i = 0; i < count; i++) {
+        if (NSMaxRange(elements[i]) - elements[first].location >= sliceSize || i == count - 1) {
+            [slices addObject:[NSValue valueWithRange:NSMakeRange(first, i + 1 - first)]];
+            first = i + 1;
+        }
+    }
+    return slices;
+}
+
+#pragma mark - reader
+
+- (id)readData:(NSData *)jsonData
+{
+    _errorList = nil;
+    _errors = nil;
+    _sliceCount = 0;
+    if (jsonData == nil || [jsonData length] == 0)
+        return nil;
+    if ([OXGzipInputStream compressionOfData:jsonData] != OX_COMPRESSION_NONE || _context.identityMap
+            || (_context.maxBytes && [jsonData length] > _context.maxBytes))
+        return [self readSequentially:jsonData];    //the sequential reader reports an exceeded limit
+
+    //configure the shared mapper once, before the workers use it
+    NSArray *configErrors = [_mapper configure:_context];
+    if (configErrors) {
+        [self addErrors:configErrors];
+        return nil;
+    }
+    NSArray *chain = [self pathMappersToArray];
+    if (chain == nil)
+        return [self readSequentially:jsonData];
+    OXJSONPathMapper *containerMapper = [chain lastObject];
+    const NSUInteger chainDepth = [chain count];  //instances enclosing an element: the root wrapper and the objects on the path
+    if (_context.maxDepth && _context.maxDepth <= chainDepth)
+        return [self readSequentially:jsonData];
+
+    //structural pass: element boundaries of the array
+    const NSUInteger keyCount = [_arrayPath count];
+    const char *keys[OX_PARALLEL_MAX_KEYS];
+    size_t keyLengths[OX_PARALLEL_MAX_KEYS];
+    for(NSUInteger i = 0; i < keyCount; i++) {
+        keys[i] = [[_arrayPath objectAtIndex:i] UTF8String];
+        keyLengths[i] = strlen(keys[i]);
+    }
+    const uint8_t *bytes = [jsonData bytes];
+    const NSUInteger length = [jsonData length];
+    NSMutableData *elementData = [NSMutableData data];
+    const NSUInteger close = OXIndexArray(bytes, length, keys, keyLengths, keyCount, elementData);
+    if (close == NSNotFound)
+        return [self readSequentially:jsonData];
+    const NSRange *elements = [elementData bytes];
+    if (_context.maxContainerCount && [elementData length] / sizeof(NSRange) > _context.maxContainerCount)
+        return [self readSequentially:jsonData];    //workers only see their own slice
+    NSArray *slices = [self slicesOfElements:elements count:[elementData length] / sizeof(NSRange)];
+    if ([slices count] < 2)
+        return [self readSequentially:jsonData];
+    _sliceCount = [slices count];
+
+    //slice documents: the first keeps everything but the elements of later slices, others are bare arrays
+    NSMutableArray *documents = [NSMutableArray arrayWithCapacity:_sliceCount];
+    for(NSValue *slice in slices) {
+        const NSRange range = [slice rangeValue];
+        const NSUInteger start = elements[range.location].location;
+        const NSUInteger stop = NSMaxRange(elements[NSMaxRange(range) - 1]);
+        NSMutableData *document = [NSMutableData dataWithCapacity:stop - start + 2];
+        if (range.location == 0) {
+            [document appendBytes:bytes length:stop];
+            [document appendBytes:bytes + close length:length - close];
+        } else {
+            [document appendBytes:"[" length:1];
+            [document appendBytes:bytes + start length:stop - start];
+            [document appendBytes:"]" length:1];
+        }
+        [documents addObject:document];
+    }
+
+    //decode slices concurrently
+    NSMutableArray *sliceItems = [NSMutableArray arrayWithCapacity:_sliceCount];
+    NSMutableArray *sliceErrors = [NSMutableArray arrayWithCapacity:_sliceCount];
+    for(NSUInteger i = 0; i < _sliceCount; i++) {
+        [sliceItems addObject:[NSMutableArray array]];
+        [sliceErrors addObject:[NSMutableArray array]];
+    }
+    OXContext *headContext = [self workerContext];
+    OXJSONMapper *mapper = _mapper;
+    dispatch_apply(_sliceCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t i) {
+        NSData *document = [documents objectAtIndex:i];
+        NSMutableArray *errors = [sliceErrors objectAtIndex:i];
+        OXContext *ctx = i == 0 ? headContext : [self workerContext];
+        if (i > 0 && ctx.maxDepth)
+            ctx.maxDepth -= chainDepth;     //slice elements are read without their enclosing objects
+        OXJSONReader *reader = [OXJSONReader readerWithMapper:mapper context:ctx];
+        if (i == 0) {
+            if ([reader readData:document] == nil && reader.errors == nil)
+                [errors addObject:[self errorWithMessage:@"slice 1 is not valid JSON"]];
+        } else {
+            NSError *error = nil;
+            id json = [NSJSONSerialization JSONObjectWithData:document options:0 error:&error];
+            if ( ! [json isKindOfClass:[NSArray class]]) {
+                [errors addObject:[self errorWithMessage:[NSString stringWithFormat:@"slice %lu is not valid JSON: %@", (unsigned long)i + 1, [error localizedDescription]]]];
+                return;
+            }
+            NSArray *items = [reader readItems:json pathMapper:containerMapper];
+            if (items)
+                [[sliceItems objectAtIndex:i] addObjectsFromArray:items];
+        }
+        if (reader.errors)
+            [errors addObjectsFromArray:reader.errors];
+    });
+    for(NSArray *errors in sliceErrors) {
+        if ([errors count] > 0)
+            [self addErrors:errors];
+    }
+    if (_errors)
+        return nil;
+
+    //merge: append the items of the other slices to the container read with the first slice, in document order
+    NSObject *parent = headContext;
+    for(NSUInteger i = 0; i + 1 < [chain count] && parent; i++) {
+        OXJSONPathMapper *pathMapper = [chain objectAtIndex:i];
+        parent = pathMapper.getter(pathMapper.toPath, parent, headContext);
+    }
+    if (parent == nil) {
+        [self addErrors:@[[self errorWithMessage:[NSString stringWithFormat:@"no object holds the '%@' array", [_arrayPath componentsJoinedByString:@"."]]]]];
+        return nil;
+    }
+    NSMutableArray *rest = [NSMutableArray array];
+    for(NSUInteger i = 1; i < _sliceCount; i++) {
+        [rest addObjectsFromArray:[sliceItems objectAtIndex:i]];
+    }
+    headContext.currentMapper = containerMapper;
+    if (containerMapper.containerBuilder) {
+        id container = containerMapper.containerBuilder(containerMapper.getter(containerMapper.toPath, parent, headContext), rest, headContext);
+        containerMapper.setter(containerMapper.toPath, container, parent, headContext);
+    } else {
+        for(id item in rest) {
+            containerMapper.appender(containerMapper.toPath, item, parent, headContext);
+        }
+    }
+    return headContext.result;     //re-read, the builder may have replaced a top-level container
+}
+
+- (id)readText:(NSString *)jsonText
+{
+    return [self readData:[jsonText dataUsingEncoding:NSUTF8StringEncoding]];
+}
+
+@end
+
+//
+//  Copyright (c) 2013 Outsource Cafe, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
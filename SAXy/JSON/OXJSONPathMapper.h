@@ -33,7 +33,10 @@
 - (OXJSONPathMapper *)fromTransform:(OXTransformBlock)fromTransform;
 - (OXJSONPathMapper *)enumerator:(OXEnumerationBlock)enumerator;
 - (OXJSONPathMapper *)appender:(OXSetterBlock)appender;
+- (OXJSONPathMapper *)containerBuilder:(OXContainerBuilderBlock)containerBuilder;
 - (OXJSONPathMapper *)isVirtualProperty;
+- (OXJSONPathMapper *)isLazy;
+- (OXJSONPathMapper *)isInterned;
 - (OXJSONPathMapper *)formatter:(NSString *)formatterName;
 
 @end
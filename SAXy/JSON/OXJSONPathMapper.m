@@ -106,12 +106,30 @@
     return self;
 }
 
+- (OXJSONPathMapper *)containerBuilder:(OXContainerBuilderBlock)containerBuilder
+{
+    self.containerBuilder = containerBuilder;
+    return self;
+}
+
 - (OXJSONPathMapper *)isVirtualProperty
 {
     self.virtualProperty = YES;
     return self;
 }
 
+- (OXJSONPathMapper *)isLazy
+{
+    self.lazy = YES;
+    return self;
+}
+
+- (OXJSONPathMapper *)isInterned
+{
+    self.intern = YES;
+    return self;
+}
+
 - (OXJSONPathMapper *)formatter:(NSString *)formatterName
 {
     [self setValue:formatterName forKey:@"formatterName"];  //readonly end-run
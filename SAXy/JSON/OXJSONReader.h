@@ -14,6 +14,11 @@
  */
 #import <Foundation/Foundation.h>
 #import "OXJSONMapper.h"
+#import "OXResultCache.h"
+@class OXJSONPathMapper;
+
+//called on the completion queue with the result graph, or nil and the read errors
+typedef void (^OXJSONReadCompletionBlock)(id result, NSArray *errors);
 
 
 @interface OXJSONReader : NSObject
@@ -21,6 +26,11 @@
 @property(strong,nonatomic,readonly)OXJSONMapper *mapper;
 @property(strong,nonatomic,readonly) OXContext *context;
 @property(strong,nonatomic,readonly) NSArray *errors;
+@property(assign,nonatomic,readwrite)BOOL lenient;                  //drop a container item that fails to map and continue, default: NO
+@property(assign,nonatomic,readwrite)NSUInteger maxErrorCount;      //dropped items logged in errors, later ones are only counted, default: 100
+@property(assign,nonatomic,readonly)NSUInteger droppedRecordCount;  //items dropped by the last lenient read, errors are returned along with the result
+//lenient reads catch exceptions: build files defining factory, setter or transform blocks with -fobjc-arc-exceptions (as the library does) or ARC leaks their unwound frames
+@property(strong,nonatomic,readwrite)OXResultCache *resultCache;    //optional, readData: and readText: return the cached graph of repeated input
 
 #pragma mark - constructor
 + (id)readerWithMapper:(OXJSONMapper *)mapper;
@@ -31,9 +41,21 @@
 
 #pragma mark - reader
 - (id)read:(id)jsonObject;                      //expects an NSArray or NSDictionary
-- (id)readData:(NSData *)jsonData;
+- (id)readData:(NSData *)jsonData;              //gzip or zlib compressed data is inflated while parsing
+- (id)readStream:(NSInputStream *)jsonStream;   //compressed or plain
 - (id)readText:(NSString *)jsonText;
 - (id)readResourceFile:(NSString *)fileName;
+- (NSArray *)readItems:(NSArray *)sources pathMapper:(OXJSONPathMapper *)pathMapper;  //decodes elements of a mapped container property, drops nulls
+
+#pragma mark - asynchronous reader
+//input is loaded in chunks on a background queue while it's parsed on another, completion is called on queue (main queue if nil),
+//don't start other reads until then.  NSJSONSerialization parses once the stream ends, decoding still runs off the caller's thread.
+- (void)readURL:(NSURL *)url queue:(dispatch_queue_t)queue completion:(OXJSONReadCompletionBlock)completion;    //file, http or https
+- (void)readResourceFile:(NSString *)fileName queue:(dispatch_queue_t)queue completion:(OXJSONReadCompletionBlock)completion;
+- (void)readStream:(NSInputStream *)jsonStream queue:(dispatch_queue_t)queue completion:(OXJSONReadCompletionBlock)completion;
+
+#pragma mark - recycling
+- (NSUInteger)recycle:(id)result;               //return result graph to context.objectPool, returns number of recycled instances
 
 
 @end
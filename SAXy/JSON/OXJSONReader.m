@@ -10,12 +10,19 @@
 #import "OXJSONObjectMapper.h"
 #import "OXJSONPathMapper.h"
 #import "OXUtil.h"
+#import "OXLazyArray.h"
+#import "OXGzipStream.h"
+#import "OXPipeStream.h"
+#import "OXResultCache.h"
 
 
 @implementation OXJSONReader
 {
     BOOL _logMapping;
     NSJSONReadingOptions _readingOptions;
+    BOOL _limitExceeded;                        //a context limit was exceeded or the read was cancelled, result is discarded
+    NSUInteger _objectCount;                    //objects created, the deadline and cancellation token are checked every 64
+    NSMutableArray *_errorLog;                  //errors, appended in place
 }
 
 #pragma mark - constructor
@@ -26,6 +33,7 @@
         _mapper = mapper;
         _context = context ? context : [[OXContext alloc] init];
         _readingOptions = 0;
+        _maxErrorCount = 100;
     }
     return self;
 }
@@ -52,7 +60,11 @@
 
 - (NSArray *)addError:(NSError *)error
 {
-    _errors = (_errors == nil) ? [NSArray arrayWithObject:error] : [_errors arrayByAddingObject:error];
+    if (_errorLog == nil || _errors != _errorLog) {     //first error of a read, or after the mapper's configuration errors
+        _errorLog = _errors ? [_errors mutableCopy] : [NSMutableArray arrayWithCapacity:7];
+        _errors = _errorLog;
+    }
+    [_errorLog addObject:error];
     return _errors;
 }
 
@@ -62,9 +74,101 @@
     return [self addError:error];
 }
 
+//stops mapping, the read returns nil with errorMessage
+- (void)failWithLimit:(NSString *)errorMessage
+{
+    if (_logMapping) NSLog(@"ERROR: %@ - aborting read", errorMessage);
+    _limitExceeded = YES;
+    [self addErrorMessage:errorMessage];
+}
+
+- (BOOL)exceedsTextLimit:(id)value pathMapper:(OXJSONPathMapper *)pathMapper
+{
+    if (_context.maxTextLength && [value isKindOfClass:[NSString class]] && [(NSString *)value length] > _context.maxTextLength) {
+        [self failWithLimit:[NSString stringWithFormat:@"%@ value exceeds the maximum length of %lu", pathMapper.fromPath, (unsigned long)_context.maxTextLength]];
+        return YES;
+    }
+    return NO;
+}
+
 #pragma mark - reader
 
 
+//decodes one container element with the child mapping of pathMapper
+- (id)readItem:(id)source pathMapper:(OXJSONPathMapper *)pathMapper intern:(BOOL)intern
+{
+    id target = nil;
+    switch (pathMapper.toType.containerChildType.typeEnum) {
+        case OX_COMPLEX: {
+            OXJSONObjectMapper *childMapper = [_mapper objectMapperForClass:pathMapper.toType.containerChildType.type];
+            if (childMapper == nil)
+                NSAssert2(childMapper, @"ERROR, no objectMapper for %@ class in %@", NSStringFromClass(pathMapper.toType.containerChildType.type), pathMapper);
+            target = [self read:source objectMapper:childMapper];
+            break;
+        }
+        case OX_SCALAR:
+        case OX_ATOMIC: {
+            id value = source;
+            if ([self exceedsTextLimit:value pathMapper:pathMapper])
+                break;
+            if (intern && pathMapper.intern && [value isKindOfClass:[NSString class]])
+                value = [_context.internTable intern:value];
+            if (pathMapper.toTransform) {
+                target = pathMapper.toTransform(value, _context);
+            } else {
+                target = value;
+            }
+            break;
+        }
+        case OX_POLYMORPHIC:
+        default: {
+            NSAssert2(NO, @"OXmlWriter does not yet support child typeEnum:%d in container mapper: %@", pathMapper.toType.containerChildType.typeEnum, pathMapper);
+            break;
+        }
+    }
+    return target;
+}
+
+//strict reads keep the unconvertible value nil and report it here, lenient reads raised and dropped the record instead
+- (void)collectTransformErrors
+{
+    for(NSError *error in _context.transformErrors)
+        [self addError:error];
+}
+
+//errors other than the items dropped by a lenient read
+- (BOOL)failed
+{
+    return _limitExceeded || [_errors count] > MIN(_droppedRecordCount, _maxErrorCount);
+}
+
+//lenient read: an item that fails to map is dropped and logged, the reader state of the container's owner is restored
+- (id)readItemLeniently:(id)source pathMapper:(OXJSONPathMapper *)pathMapper index:(NSUInteger)index intern:(BOOL)intern
+{
+    const NSUInteger instanceCount = [_context.instanceStack count];
+    const NSUInteger mapperCount = [_context.mapperStack count];
+    @try {
+        return [self readItem:source pathMapper:pathMapper intern:intern];
+    } @catch (NSException *e) {
+        while ([_context.instanceStack count] > instanceCount)
+            [_context.instanceStack pop];
+        while ([_context.mapperStack count] > mapperCount)
+            [_context.mapperStack pop];
+        _droppedRecordCount++;
+        NSString *path = [NSString stringWithFormat:@"%@[%lu]", pathMapper.fromPath, (unsigned long)index];
+        if (_logMapping) NSLog(@"ERROR %@ - dropping item: %@", path, [e reason]);
+        if (_droppedRecordCount <= _maxErrorCount) {
+            NSMutableDictionary *userInfo = [NSMutableDictionary dictionaryWithCapacity:3];
+            [userInfo setObject:[NSString stringWithFormat:@"item dropped at %@: %@", path, [e reason]] forKey:NSLocalizedDescriptionKey];
+            [userInfo setObject:path forKey:OXErrorPathKey];
+            if (_context.currentMapper)
+                [userInfo setObject:_context.currentMapper forKey:OXErrorMapperKey];
+            [self addError:[NSError errorWithDomain:@"com.outsourcecafe.ox" code:99 userInfo:userInfo]];
+        }
+        return nil;
+    }
+}
+
 - (id)read:(NSDictionary *)json objectMapper:(OXJSONObjectMapper *)objMapper
 {
     if (json == nil)
@@ -73,6 +177,19 @@
         [self addErrorMessage:[NSString stringWithFormat:@"Expecting NSDictionary parameter type, not %@ for %@ read mapping", NSStringFromClass([json class]), objMapper]];
         return nil;
     }
+    if (_limitExceeded)
+        return nil;
+    if (_context.maxDepth && [_context.instanceStack count] > _context.maxDepth) {  //the root wrapper is not counted
+        [self failWithLimit:[NSString stringWithFormat:@"%@ object exceeds the maximum depth of %lu", objMapper.fromPath, (unsigned long)_context.maxDepth]];
+        return nil;
+    }
+    if ((++_objectCount & 63) == 0) {
+        NSString *violation = [_context budgetViolation];
+        if (violation) {
+            [self failWithLimit:violation];
+            return nil;
+        }
+    }
     id parent = nil;
     if (objMapper) {
         [_context.mapperStack push:objMapper];
@@ -83,8 +200,8 @@
         if (_logMapping) NSLog(@"create %@ - %@", objMapper.fromPath, NSStringFromClass([parent class]));
         [_context.instanceStack push:parent];
         for(NSString *propertyKey in objMapper.orderedPropertyKeys) {
-            if ([propertyKey hasSuffix:@"website"])
-                NSLog(@"website");
+            if (_limitExceeded)
+                break;
             OXJSONPathMapper *pathMapper = [objMapper objectMapperByProperty:propertyKey];
             _context.currentMapper = pathMapper;
             switch (pathMapper.toType.typeEnum) {
@@ -94,42 +211,39 @@
                         if (_logMapping) NSLog(@"no source data %@ - %@.%@ = nil", pathMapper.fromPath, NSStringFromClass([parent class]), pathMapper.toPath);
                     } else if ( ! [sourceContainer isKindOfClass:[NSArray class]] ) {
                         if (_logMapping) NSLog(@"ERROR %@ - expected NSArray, not %@", pathMapper.fromPath, NSStringFromClass([sourceContainer class]));
+                    } else if (_context.maxContainerCount && [sourceContainer count] > _context.maxContainerCount) {
+                        [self failWithLimit:[NSString stringWithFormat:@"%@.%@ exceeds the maximum of %lu container items", NSStringFromClass([parent class]), pathMapper.toPath, (unsigned long)_context.maxContainerCount]];
+                    } else if (pathMapper.lazy) {
+                        if (_logMapping) NSLog(@"lazy %@ - %@.%@ = %lu items", pathMapper.fromPath, NSStringFromClass([parent class]), pathMapper.toPath, (unsigned long)[sourceContainer count]);
+                        pathMapper.setter(pathMapper.toPath, [self lazyArray:sourceContainer pathMapper:pathMapper], parent, _context);
                     } else {
+                        NSMutableArray *items = pathMapper.containerBuilder ? [NSMutableArray arrayWithCapacity:[sourceContainer count]] : nil;
+                        NSUInteger index = 0;
                         for (id source in (NSArray *)sourceContainer) {
-                            if ([source isMemberOfClass:[NSNull class]])
+                            if (_limitExceeded)
+                                break;
+                            if ([source isMemberOfClass:[NSNull class]]) {
+                                index++;
                                 continue;
-                            id target = nil;
-                            switch (pathMapper.toType.containerChildType.typeEnum) {
-                                case OX_COMPLEX: {
-                                    OXJSONObjectMapper *childMapper = [_mapper objectMapperForClass:pathMapper.toType.containerChildType.type];
-                                    if (childMapper == nil)
-                                        NSAssert2(childMapper, @"ERROR, no objectMapper for %@ class in %@", NSStringFromClass(pathMapper.toType.containerChildType.type), pathMapper);
-                                    target = [self read:source objectMapper:childMapper];
-                                    _context.currentMapper = pathMapper;    //restore after recursive call
-                                    break;
-                                }
-                                case OX_SCALAR:
-                                case OX_ATOMIC: {
-                                    if (pathMapper.toTransform) {
-                                        target = pathMapper.toTransform(source, _context);
-                                    } else {
-                                        target = source;
-                                    }
-                                    break;
-                                }
-                                case OX_POLYMORPHIC:
-                                default: {
-                                    NSAssert2(NO, @"OXmlWriter does not yet support child typeEnum:%d in container mapper: %@", pathMapper.toType.containerChildType.typeEnum, pathMapper);
-                                    break;
-                                }
                             }
+                            id target = _lenient ? [self readItemLeniently:source pathMapper:pathMapper index:index++ intern:items != nil]
+                                                 : [self readItem:source pathMapper:pathMapper intern:items != nil];   //appender interns otherwise
+                            _context.currentMapper = pathMapper;    //restore after recursive call
                             if (target && ![target isMemberOfClass:[NSNull class]]) {   //TODO add switch to control NSNull behavior?
                                 if (_logMapping) NSLog(@"append %@ - %@.%@ += %@", pathMapper.fromPath, NSStringFromClass([parent class]), pathMapper.toPath, target);
-                                pathMapper.appender(pathMapper.toPath, target, parent, _context);
+                                if (items)
+                                    [items addObject:target];
+                                else
+                                    pathMapper.appender(pathMapper.toPath, target, parent, _context);
                             } else {
                                 if (_logMapping) NSLog(@"ignore %@ - %@.%@ += nil", pathMapper.fromPath, NSStringFromClass([parent class]), pathMapper.toPath);
                             }
                         }
+                        if ([items count] > 0) {    //assign whole container at once
+                            _context.currentMapper = pathMapper;
+                            id container = pathMapper.containerBuilder(pathMapper.getter(pathMapper.toPath, parent, _context), items, _context);
+                            pathMapper.setter(pathMapper.toPath, container, parent, _context);
+                        }
                     }
                     break;
                 }
@@ -139,7 +253,7 @@
                         NSAssert2(childMapper, @"ERROR, no objectMapper for %@ class in %@", NSStringFromClass(pathMapper.toType.type), pathMapper);
                     id source = [json valueForKeyPath:pathMapper.fromPath];
                     if (source && ![source isMemberOfClass:[NSNull class]]) {
-                        id target = [self read:source objectMapper:childMapper];
+                        id target = pathMapper.lazy ? [self lazyProxy:source pathMapper:pathMapper childMapper:childMapper] : [self read:source objectMapper:childMapper];
                         if (target) {
                             _context.currentMapper = pathMapper;    //restore after recursive call
                             pathMapper.setter(pathMapper.toPath, target, parent, _context);
@@ -155,7 +269,9 @@
                 case OX_SCALAR:     // handle single-value (automic) element:
                 case OX_ATOMIC: {
                     id source = [json valueForKeyPath:pathMapper.fromPath];
-                    if (source && ![source isMemberOfClass:[NSNull class]]) {
+                    if ([self exceedsTextLimit:source pathMapper:pathMapper]) {
+                        break;
+                    } else if (source && ![source isMemberOfClass:[NSNull class]]) {
                         if (_logMapping) NSLog(@"%@ - %@.%@=%@", pathMapper.fromPath, NSStringFromClass([parent class]), pathMapper.toPath, source);
                         pathMapper.setter(pathMapper.toPath, source, parent, _context);
                     } else {
@@ -175,10 +291,51 @@
     if (objMapper) {
         [_context.instanceStack pop];
         [_context.mapperStack pop];
+        if (_context.identityMap && parent)
+            parent = [_context.identityMap merge:parent mapper:objMapper context:_context];  //existing instance when merge-reading
     }
     return parent;
 }
 
+#pragma mark - lazy
+
+- (id)decode:(id)source pathMapper:(OXJSONPathMapper *)pathMapper childMapper:(OXJSONObjectMapper *)childMapper
+{
+    OXPathMapper *currentMapper = _context.currentMapper;  //decoding can happen in the middle of another read
+    id target = nil;
+    if (childMapper) {
+        target = [self read:source objectMapper:childMapper];
+    } else {
+        _context.currentMapper = pathMapper;
+        target = pathMapper.toTransform ? pathMapper.toTransform(source, _context) : source;
+    }
+    _context.currentMapper = currentMapper;
+    return target;
+}
+
+- (OXLazyArray *)lazyArray:(NSArray *)sourceContainer pathMapper:(OXJSONPathMapper *)pathMapper
+{
+    OXType *childType = pathMapper.toType.containerChildType;
+    OXJSONObjectMapper *childMapper = (childType.typeEnum == OX_COMPLEX) ? [_mapper objectMapperForClass:childType.type] : nil;
+    if (childType.typeEnum == OX_COMPLEX && childMapper == nil)
+        NSAssert2(childMapper, @"ERROR, no objectMapper for %@ class in %@", NSStringFromClass(childType.type), pathMapper);
+    NSMutableArray *sources = [NSMutableArray arrayWithCapacity:[sourceContainer count]];
+    for (id source in sourceContainer) {
+        if ( ! [source isMemberOfClass:[NSNull class]] )
+            [sources addObject:source];
+    }
+    return [OXLazyArray lazyArrayWithSources:sources decoder:^(id source) {
+        return [self decode:source pathMapper:pathMapper childMapper:childMapper];
+    }];
+}
+
+- (OXLazyProxy *)lazyProxy:(id)source pathMapper:(OXJSONPathMapper *)pathMapper childMapper:(OXJSONObjectMapper *)childMapper
+{
+    return [OXLazyProxy proxyWithSource:source decoder:^(id source) {
+        return [self decode:source pathMapper:pathMapper childMapper:childMapper];
+    }];
+}
+
 - (id)read:(id)jsonObject
 {
     _logMapping = _context.logReaderStack;
@@ -193,14 +350,81 @@
         return nil;
     } else {
         NSAssert(_mapper.rootMapper != nil, @"_mapper.rootMapper can't be nil in OXJSONReader");
+        _limitExceeded = NO;
+        _objectCount = 0;
+        _droppedRecordCount = 0;
+        _context.raiseTransformErrors = _lenient;
+        NSString *violation = [_context budgetViolation];
+        if (violation) {
+            [self failWithLimit:violation];
+            return nil;
+        }
         //SAXy rootMapper maps the result of the JSON read to the 'OXContext.result' property using the OX_ROOT_PATH key:
+        [_context.identityMap beginMerge];
         [self read: @{ OX_ROOT_PATH : jsonObject } objectMapper:_mapper.rootMapper];  //wrap json in 'root' object and read
-        return _errors ? nil : _context.result;
+        id result = [self failed] ? nil : _context.result;
+        [_context.identityMap endMerge:result];
+        [self collectTransformErrors];
+        return result;
     }
 }
 
+- (NSArray *)readItems:(NSArray *)sources pathMapper:(OXJSONPathMapper *)pathMapper
+{
+    _logMapping = _context.logReaderStack;
+    [_context reset];
+    _errors = [self.mapper configure:_context];
+    if (_errors)
+        return nil;
+    _limitExceeded = NO;
+    _objectCount = 0;
+    _droppedRecordCount = 0;
+    _context.raiseTransformErrors = _lenient;
+    NSMutableArray *items = [NSMutableArray arrayWithCapacity:[sources count]];
+    NSUInteger index = 0;
+    for (id source in sources) {
+        if (_limitExceeded)
+            break;
+        if ([source isMemberOfClass:[NSNull class]]) {
+            index++;
+            continue;
+        }
+        _context.currentMapper = pathMapper;
+        id target = _lenient ? [self readItemLeniently:source pathMapper:pathMapper index:index++ intern:pathMapper.containerBuilder != nil]
+                             : [self readItem:source pathMapper:pathMapper intern:pathMapper.containerBuilder != nil];   //appender interns otherwise
+        if (target && ![target isMemberOfClass:[NSNull class]])
+            [items addObject:target];
+    }
+    items = [self failed] ? nil : items;
+    [self collectTransformErrors];
+    return items;
+}
+
 - (id)readData:(NSData *)jsonData
 {
+    //merged results depend on more than the input, pooled results are recycled by the caller:
+    if (_resultCache == nil || _context.identityMap || _context.objectPool || [jsonData length] == 0)
+        return [self parseData:jsonData];
+    id result = [_resultCache resultForData:jsonData];
+    if (result) {
+        _errors = nil;
+        return result;
+    }
+    result = [self parseData:jsonData];
+    if (result && _errors == nil)
+        [_resultCache setResult:result forData:jsonData];
+    return result;
+}
+
+- (id)parseData:(NSData *)jsonData
+{
+    if ([OXGzipInputStream compressionOfData:jsonData] != OX_COMPRESSION_NONE)
+        return [self readStream:[OXGzipInputStream inputStreamWithData:jsonData]];
+    if (_context.maxBytes && [jsonData length] > _context.maxBytes) {
+        _errors = nil;
+        [self addErrorMessage:[NSString stringWithFormat:@"input of %lu bytes exceeds the maximum of %llu bytes", (unsigned long)[jsonData length], _context.maxBytes]];
+        return nil;
+    }
     NSError *error = nil;
     id json = [NSJSONSerialization JSONObjectWithData:jsonData options:_readingOptions error:&error];
     if (error) {
@@ -211,6 +435,23 @@
     }
 }
 
+- (id)readStream:(NSInputStream *)jsonStream
+{
+    NSError *error = nil;
+    OXGzipInputStream *stream = [jsonStream isKindOfClass:[OXGzipInputStream class]] ? (OXGzipInputStream *)jsonStream : [OXGzipInputStream inputStreamWithStream:jsonStream];
+    stream.maxLength = _context.maxBytes;     //counts inflated bytes
+    [stream open];
+    id json = [NSJSONSerialization JSONObjectWithStream:stream options:_readingOptions error:&error];
+    if ([stream streamError])       //failed source, invalid compressed input or maxBytes exceeded
+        error = [stream streamError];
+    [stream close];
+    if (error) {
+        _errors = nil;
+        [self addError:error];
+    }
+    return error ? nil : [self read:json];
+}
+
 - (id)readText:(NSString *)jsonText
 {
     NSData *data = [jsonText dataUsingEncoding:NSUTF8StringEncoding];
@@ -223,6 +464,37 @@
     return [self readData:data];
 }
 
+#pragma mark - asynchronous reader
+
+- (void)readStream:(NSInputStream *)jsonStream queue:(dispatch_queue_t)queue completion:(OXJSONReadCompletionBlock)completion
+{
+    dispatch_queue_t completionQueue = queue ? queue : dispatch_get_main_queue();
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        id result = [self readStream:jsonStream];
+        NSArray *errors = _errors;
+        dispatch_async(completionQueue, ^{
+            completion(result, errors);
+        });
+    });
+}
+
+- (void)readURL:(NSURL *)url queue:(dispatch_queue_t)queue completion:(OXJSONReadCompletionBlock)completion
+{
+    [self readStream:[OXPipeInputStream inputStreamWithURL:url] queue:queue completion:completion];     //loading starts now
+}
+
+- (void)readResourceFile:(NSString *)fileName queue:(dispatch_queue_t)queue completion:(OXJSONReadCompletionBlock)completion
+{
+    [self readURL:[OXUtil resourceURL:fileName] queue:queue completion:completion];
+}
+
+#pragma mark - recycling
+
+- (NSUInteger)recycle:(id)result
+{
+    return _context.objectPool ? [_context.objectPool recycleGraph:result] : 0;
+}
+
 @end
 
 
@@ -8,6 +8,11 @@
   Known limitations:
   1) can't write arrays of raw JSON numbers or booleans (works fine if values have quotes)
   2) can't write arrays directly nested in arrays (i.e. [[],[]])
+
+  Set parallelThreshold to map large containers of complex objects on all cores:  the items are split into chunks,
+  each mapped by its own writer and context on a concurrent queue, and the results are joined in order, so the output
+  is identical to a serial write.  Getters and transformers of the child mappings must be safe to call from several
+  threads.
  
   Created by Richard Easterling on 3/8/13.
 
@@ -23,6 +28,7 @@
 @property(strong,nonatomic,readonly)OXContext *context;
 @property(strong,nonatomic,readonly)OXJSONMapper *mapper;
 @property(strong,nonatomic,readonly) NSArray *errors;
+@property(assign,nonatomic,readwrite)NSUInteger parallelThreshold;  //containers with at least this many complex items are mapped concurrently, 0 (default) disables
 
 #pragma mark - constructors
 + (id)writerWithMapper:(OXJSONMapper *)mapper;
@@ -33,6 +39,7 @@
 
 #pragma mark - writer
 - (NSString *)writeAsText:(id)object;
+- (BOOL)write:(id)object toStream:(NSOutputStream *)stream;   //open stream, i.e. OXGzipOutputStream; NO on error
 - (id)write:(id)object objectMapper:(OXJSONObjectMapper *)objMapper;
 
 @end
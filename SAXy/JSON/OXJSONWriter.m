@@ -112,8 +112,23 @@
                 id sourceContainer = pathMapper.getter(pathMapper.toPath, object, _context);
                 if (sourceContainer) {
                     NSMutableArray *targetArray = [NSMutableArray arrayWithCapacity:[sourceContainer count]];
+                    id<NSFastEnumeration> enumeration = pathMapper.enumerator(sourceContainer, _context);
+                    if (_parallelThreshold > 0 && pathMapper.toType.containerChildType.typeEnum == OX_COMPLEX && [sourceContainer count] >= _parallelThreshold) {
+                        OXJSONObjectMapper *childMapper = [_mapper objectMapperForClass:pathMapper.toType.containerChildType.type];
+                        if (childMapper == nil) {
+                            [self addErrorMessage:[NSString stringWithFormat:@"no objectMapper for %@ class in %@", NSStringFromClass(pathMapper.toType.containerChildType.type), pathMapper]];
+                            return nil;
+                        }
+                        NSMutableArray *items = [NSMutableArray arrayWithCapacity:[sourceContainer count]];
+                        for (id source in enumeration) {
+                            [items addObject:source];
+                        }
+                        [targetArray addObjectsFromArray:[self writeConcurrently:items objectMapper:childMapper]];
+                        _context.currentMapper = pathMapper;
+                        enumeration = @[];
+                    }
                     id target = nil;
-                    for (id source in pathMapper.enumerator(sourceContainer, _context)) {
+                    for (id source in enumeration) {
                         switch (pathMapper.toType.containerChildType.typeEnum) {
                             case OX_COMPLEX: {
                                 OXJSONObjectMapper *childMapper = [_mapper objectMapperForClass:pathMapper.toType.containerChildType.type];
@@ -162,33 +177,97 @@
     return dict;
 }
 
-- (NSData *)writeAsData:(id)object
+//maps chunks of items with separate writers and contexts on a concurrent queue, results are joined in order
+- (NSArray *)writeConcurrently:(NSArray *)items objectMapper:(OXJSONObjectMapper *)objMapper
+{
+    const NSUInteger count = [items count];
+    const NSUInteger chunkCount = MIN(count, [[NSProcessInfo processInfo] activeProcessorCount] * 4);
+    NSMutableArray *writers = [NSMutableArray arrayWithCapacity:chunkCount];
+    NSMutableArray *results = [NSMutableArray arrayWithCapacity:chunkCount];
+    for(NSUInteger i = 0; i < chunkCount; i++) {
+        OXContext *ctx = [[OXContext alloc] initWithTransform:_context.transform];
+        ctx.logReaderStack = _context.logReaderStack;
+        [writers addObject:[OXJSONWriter writerWithMapper:_mapper context:ctx]];
+        [results addObject:[NSMutableArray arrayWithCapacity:count / chunkCount + 1]];
+    }
+    dispatch_apply(chunkCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t i) {
+        OXJSONWriter *writer = [writers objectAtIndex:i];
+        NSMutableArray *result = [results objectAtIndex:i];
+        for(NSUInteger j = count * i / chunkCount; j < count * (i + 1) / chunkCount; j++) {
+            NSDictionary *target = [writer write:[items objectAtIndex:j] objectMapper:objMapper];
+            if (target)
+                [result addObject:target];
+        }
+    });
+    NSMutableArray *targets = [NSMutableArray arrayWithCapacity:count];
+    for(NSUInteger i = 0; i < chunkCount; i++) {
+        OXJSONWriter *writer = [writers objectAtIndex:i];
+        for(NSError *error in writer.errors) {
+            [self addError:error];
+        }
+        [targets addObjectsFromArray:[results objectAtIndex:i]];
+    }
+    return targets;
+}
+
+//maps object to its NSJSONSerialization tree, nil on error
+- (id)jsonFromObject:(id)object
 {
     _logMapping = _context.logReaderStack;
     [_context reset];
     _errors = [ _mapper configure:_context];
+    id json = nil;
     if (_errors == nil) {
         [_context setValue:object forKey:@"result"];
         NSDictionary *jsonResultWrapper = [self write:_context objectMapper:_mapper.rootMapper];
-        id json = jsonResultWrapper ? [jsonResultWrapper objectForKey:OX_ROOT_PATH] : nil;
-        if (json) {
-            NSError *error = nil;
-            NSData *jsonData = [NSJSONSerialization dataWithJSONObject:json options:_writingOptions error:&error];
-            if (error) {
-                [self addError:error];
-            } else {
-                return jsonData;
-            }
-        }
+        json = jsonResultWrapper ? [jsonResultWrapper objectForKey:OX_ROOT_PATH] : nil;
     }
+    return json;
+}
+
+- (void)logErrors
+{
     if (_logMapping) {
         for(NSError *error in _errors) {
             NSLog(@"ERROR: %@", [error.userInfo objectForKey:NSLocalizedDescriptionKey]);
         }
     }
+}
+
+- (NSData *)writeAsData:(id)object
+{
+    id json = [self jsonFromObject:object];
+    if (json) {
+        NSError *error = nil;
+        NSData *jsonData = [NSJSONSerialization dataWithJSONObject:json options:_writingOptions error:&error];
+        if (error) {
+            [self addError:error];
+        } else {
+            return jsonData;
+        }
+    }
+    [self logErrors];
     return nil;
 }
 
+- (BOOL)write:(id)object toStream:(NSOutputStream *)stream
+{
+    id json = [self jsonFromObject:object];
+    if (json) {
+        NSError *error = nil;
+        [NSJSONSerialization writeJSONObject:json toStream:stream options:_writingOptions error:&error];
+        if (error == nil && [stream streamError])
+            error = [stream streamError];
+        if (error) {
+            [self addError:error];
+        } else {
+            return YES;
+        }
+    }
+    [self logErrors];
+    return NO;
+}
+
 - (NSString *)writeAsText:(id)object
 {
     NSData *jsonData = [self writeAsData:object];
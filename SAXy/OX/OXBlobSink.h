@@ -0,0 +1,63 @@
+/**
+
+  OXBlobSink.h
+  SAXy OX - Object-to-XML mapping library
+
+  Incremental destination for large element bodies, i.e. base64 encoded attachments.  Without a sink, body text is
+  accumulated whole in the context, then decoded into NSData, holding the content several times over.  Mappers with a
+  blobSink block get a new sink per element instead:  each text chunk delivered by the parser is decoded and written
+  out immediately, and the property receives the sink's result handle when the element ends:
+
+    * dataSink   - NSData, decoded bytes kept in memory, no text copy
+    * fileSink   - NSURL of a temporary file, nothing kept in memory
+    * streamSink - the NSOutputStream passed in, for custom destinations
+
+    [[OXmlElementMapper elementClass:[Attachment class]]
+        body:@"content" blobSink:^(NSString *path, OXContext *ctx) { return [OXBlobSink fileSink]; }]
+
+  The handle is assigned with the mapper's setter, so custom setters and generated accessors apply, but the string
+  toTransform doesn't:  blob mappers are configured with a pass-through one.  Set base64 to NO to store the text itself
+  as UTF-8 bytes.  Base64 text may contain whitespace, any other character outside the standard alphabet is an error.
+  A file written by a sink that fails or is aborted is removed.
+
+  Created by agent on 10/19/26.
+
+ */
+#import <Foundation/Foundation.h>
+
+
+@interface OXBlobSink : NSObject
+
+@property(assign,nonatomic,readwrite)BOOL base64;                   //decode base64 text, default: YES
+@property(assign,nonatomic,readonly)unsigned long long length;      //bytes written
+@property(strong,nonatomic,readonly)id result;                      //NSData, NSURL or NSOutputStream handle, set by finish
+@property(strong,nonatomic,readonly)NSError *error;                 //write or decoding error, nil on success
+
+#pragma mark - constructors
++ (id)dataSink;
++ (id)fileSink;                                                     //unique file in NSTemporaryDirectory(), removal after a successful read is up to the caller
++ (id)fileSinkWithPath:(NSString *)path;
++ (id)streamSink:(NSOutputStream *)stream;                          //opened if needed, closed by finish
+
+#pragma mark - public
+- (BOOL)appendText:(NSString *)text;                                //NO once an error occurred
+- (id)finish;                                                       //flushes and returns the result handle, nil on error
+- (void)abort;                                                      //discards the partial result, readers call it for dropped or stopped reads
+
+@end
+
+//
+//  Copyright (c) 2013 Outsource Cafe, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
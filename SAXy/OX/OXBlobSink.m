@@ -0,0 +1,185 @@
+//
+//  OXBlobSink.m
+//  SAXy OX - Object-to-XML mapping library
+//
+//  Created by agent on 10/19/26.
+//
+
+#import "OXBlobSink.h"
+#import "OXUtil.h"
+
+
+@implementation OXBlobSink
+{
+    NSMutableData *_data;           //dataSink destination
+    NSOutputStream *_stream;        //fileSink and streamSink destination
+    NSURL *_fileURL;
+    NSMutableData *_quantum;        //base64 characters carried over to the next chunk, less than 4
+    BOOL _finished;
+}
+
+#pragma mark - constructors
+
+- (id)initWithData:(NSMutableData *)data stream:(NSOutputStream *)stream fileURL:(NSURL *)fileURL
+{
+    if (self = [super init]) {
+        _base64 = YES;
+        _data = data;
+        _stream = stream;
+        _fileURL = fileURL;
+        _quantum = [NSMutableData dataWithCapacity:8];
+        if (_stream && [_stream streamStatus] == NSStreamStatusNotOpen)
+            [_stream open];
+    }
+    return self;
+}
+
++ (id)dataSink
+{
+    return [[OXBlobSink alloc] initWithData:[NSMutableData data] stream:nil fileURL:nil];
+}
+
++ (id)fileSink
+{
+    NSString *name = [NSString stringWithFormat:@"ox-blob-%@", [[NSProcessInfo processInfo] globallyUniqueString]];
+    return [OXBlobSink fileSinkWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:name]];
+}
+
++ (id)fileSinkWithPath:(NSString *)path
+{
+    return [[OXBlobSink alloc] initWithData:nil stream:[NSOutputStream outputStreamToFileAtPath:path append:NO] fileURL:[NSURL fileURLWithPath:path]];
+}
+
++ (id)streamSink:(NSOutputStream *)stream
+{
+    NSAssert(stream != nil, @"ERROR: streamSink requires an output stream");
+    return [[OXBlobSink alloc] initWithData:nil stream:stream fileURL:nil];
+}
+
+- (void)dealloc
+{
+    if ( ! _finished)
+        [self abort];       //abandoned mid-element
+}
+
+#pragma mark - private
+
+//closes the stream and removes the file this sink wrote, a partial or invalid blob is never left behind
+- (void)discard
+{
+    [_stream close];
+    if (_fileURL)
+        [[NSFileManager defaultManager] removeItemAtURL:_fileURL error:NULL];
+    _data = nil;
+}
+
+- (void)failWithMessage:(NSString *)errorMessage
+{
+    if (_error == nil)
+        _error = [NSError errorWithDomain:@"com.outsourcecafe.ox" code:99 userInfo:@{NSLocalizedDescriptionKey:errorMessage}];
+}
+
+- (BOOL)writeBytes:(const uint8_t *)bytes length:(NSUInteger)length
+{
+    if (_data) {
+        [_data appendBytes:bytes length:length];
+    } else {
+        NSUInteger offset = 0;
+        while (offset < length) {
+            NSInteger written = [_stream write:bytes + offset maxLength:length - offset];
+            if (written <= 0) {
+                [self failWithMessage:[NSString stringWithFormat:@"blob write failed after %llu bytes: %@", _length + offset, [[_stream streamError] localizedDescription]]];
+                return NO;
+            }
+            offset += written;
+        }
+    }
+    _length += length;
+    return YES;
+}
+
+//decodes complete 4 character quanta, keeping the remainder for the next chunk
+- (BOOL)decodeQuanta
+{
+    NSUInteger complete = ([_quantum length] / 4) * 4;
+    if (complete == 0)
+        return YES;
+    NSData *decoded = [OXUtil decodeBase64Bytes:[_quantum bytes] length:complete options:OX_BASE64_STANDARD];
+    if (decoded == nil) {
+        [self failWithMessage:[NSString stringWithFormat:@"invalid base64 text after %llu bytes", _length]];
+        return NO;
+    }
+    [_quantum replaceBytesInRange:NSMakeRange(0, complete) withBytes:NULL length:0];
+    return [self writeBytes:[decoded bytes] length:[decoded length]];
+}
+
+#pragma mark - public
+
+- (BOOL)appendText:(NSString *)text
+{
+    if (_error || _finished)
+        return NO;
+    const char *bytes = [text UTF8String];
+    const size_t length = bytes ? strlen(bytes) : 0;
+    if ( ! _base64)
+        return [self writeBytes:(const uint8_t *)bytes length:length];
+    const NSUInteger start = [_quantum length];
+    [_quantum setLength:start + length];
+    char *quantum = (char *)[_quantum mutableBytes] + start;
+    size_t count = 0;
+    for(size_t i = 0; i < length; i++) {
+        const char c = bytes[i];
+        if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '+' || c == '/' || c == '=') {
+            quantum[count++] = c;
+        } else if (c != ' ' && c != '\n' && c != '\r' && c != '\t') {     //skip line breaks and other whitespace
+            [_quantum setLength:start + count];
+            [self failWithMessage:[NSString stringWithFormat:@"invalid base64 character 0x%02x after %llu bytes", (unsigned char)c, _length]];
+            return NO;
+        }
+    }
+    [_quantum setLength:start + count];
+    return [self decodeQuanta];
+}
+
+- (id)finish
+{
+    if ( ! _finished) {
+        _finished = YES;
+        if (_error == nil && [_quantum length] > 0) {
+            [self failWithMessage:[NSString stringWithFormat:@"truncated base64 text, %lu characters left over", (unsigned long)[_quantum length]]];
+        }
+        if (_error) {
+            [self discard];
+        } else {
+            [_stream close];
+            _result = _data ? _data : (_fileURL ? _fileURL : _stream);
+        }
+    }
+    return _result;
+}
+
+- (void)abort
+{
+    if ( ! _finished) {
+        _finished = YES;
+        [self discard];
+    }
+}
+
+@end
+
+//
+//  Copyright (c) 2013 Outsource Cafe, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
@@ -11,6 +11,7 @@
 #import <Foundation/Foundation.h>
 @class OXContext;
 @class OXPathMapper;
+@class OXBlobSink;
 
 
 typedef id (^OXFactoryBlock)(NSString *path, OXContext *ctx);
@@ -20,6 +21,8 @@ typedef id (^OXGetterBlock)(NSString *path, id source, OXContext *ctx);
 
 typedef id<NSFastEnumeration> (^OXEnumerationBlock)(id container, OXContext *ctx);
 
+typedef id (^OXContainerBuilderBlock)(id container, NSArray *items, OXContext *ctx);   //container may be nil, returns container to assign
+
 typedef NSString *(^OXPathFactoryBlock)(id object, OXContext *ctx);
 
 typedef id (^OXTransformBlock)(id source, OXContext *ctx);
@@ -28,6 +31,10 @@ typedef id (^OXForEachPathMapperBlock)(OXPathMapper *mapper);
 
 typedef void (^OCPropertyMetadataBlock)(NSString *propertyName, Class propertyClass, const char *attributes);
 
+typedef id (^OXLazyDecoderBlock)(id source);
+
+typedef OXBlobSink *(^OXBlobSinkBlock)(NSString *path, OXContext *ctx);    //returns a new sink for each element body
+
 //
 //  Copyright (c) 2013 Outsource Cafe, Inc. All rights reserved.
 //
@@ -0,0 +1,46 @@
+/**
+
+  OXCancellationToken.h
+  SAXy OX - Object-to-XML mapping library
+
+  Thread-safe flag for stopping a read from another thread, i.e. when the requesting client goes away.  Assign it to
+  the context's cancellationToken, then call cancel from any thread:  the reader checks the token as it goes, aborts
+  parsing and returns nil with a cancellation error.  One token can be shared by several readers, i.e. the workers of
+  a parallel read.
+
+    OXCancellationToken *token = [OXCancellationToken token];
+    reader.context.cancellationToken = token;
+    dispatch_async(queue, ^{ result = [reader readXmlData:data fromURL:nil]; });
+    ...
+    [token cancel];
+
+  Created by agent on 10/19/26.
+
+ */
+#import <Foundation/Foundation.h>
+
+
+@interface OXCancellationToken : NSObject
+
+@property(assign,atomic,readonly)BOOL cancelled;
+
++ (id)token;
+- (void)cancel;                                                     //can't be undone, use a new token for the next read
+
+@end
+
+//
+//  Copyright (c) 2013 Outsource Cafe, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
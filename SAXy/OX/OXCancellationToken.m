@@ -0,0 +1,43 @@
+//
+//  OXCancellationToken.m
+//  SAXy OX - Object-to-XML mapping library
+//
+//  Created by agent on 10/19/26.
+//
+
+#import "OXCancellationToken.h"
+
+
+@interface OXCancellationToken ()
+@property(assign,atomic,readwrite)BOOL cancelled;
+@end
+
+@implementation OXCancellationToken
+
++ (id)token
+{
+    return [[OXCancellationToken alloc] init];
+}
+
+- (void)cancel
+{
+    self.cancelled = YES;
+}
+
+@end
+
+//
+//  Copyright (c) 2013 Outsource Cafe, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
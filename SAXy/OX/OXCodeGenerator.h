@@ -0,0 +1,65 @@
+/**
+
+  OXCodeGenerator.h
+  SAXy OX - Object-to-XML mapping library
+
+  Generates Objective-C source for OXGeneratedMapping, moving the self reflection done by mappers at configure time
+  to build time.  The generated file is a category with a +load method registering, for each mapped class:
+
+    * the OXProperty table normally obtained with OXUtil propertyInspectionForClass:
+    * direct property access setter and getter blocks, replacing KVC in the default mapper blocks
+    * container property tags, normally guessed with OXUtil guessSingularNoun:
+
+  Usage (i.e. from a unit test or a small command line tool):
+    OXCodeGenerator *generator = [OXCodeGenerator generatorWithName:@"Contacts"];
+    generator.imports = @[@"Contact.h", @"Address.h"];
+    NSString *source = [generator sourceForXmlMapper:mapper];
+    [source writeToFile:[dir stringByAppendingPathComponent:generator.fileName] atomically:YES encoding:NSUTF8StringEncoding error:&error];
+
+  Add the file to the target and regenerate it whenever the mapped classes change.  Custom blocks, formatters and
+  xpaths remain in the mapper declarations - only the reflective defaults are generated.
+
+  Scope: this removes configure-time reflection and KVC dispatch, not the generic read and write paths.  The generated
+  accessors are OXSetterBlock/OXGetterBlock values with the usual boxed signature:  scalars still go through NSNumber
+  (string -> toTransform -> NSNumber -> unboxed setter), and readers and writers still walk the mapper tables.  No
+  per-class read handlers or write functions are generated.
+
+  Created by agent on 10/19/26.
+
+ */
+#import <Foundation/Foundation.h>
+@class OXmlMapper;
+@class OXJSONMapper;
+
+
+@interface OXCodeGenerator : NSObject
+
+@property(strong,nonatomic,readonly)NSString *name;                 //category name, must be a valid identifier
+@property(strong,nonatomic,readonly)NSString *fileName;             //OXGeneratedMapping+<name>.m
+@property(strong,nonatomic,readwrite)NSArray *imports;              //headers declaring the mapped classes
+
+#pragma mark - constructor
++ (id)generatorWithName:(NSString *)name;
+
+#pragma mark - generate
+- (NSString *)sourceForXmlMapper:(OXmlMapper *)mapper;              //classes reachable from the root mapper
+- (NSString *)sourceForJSONMapper:(OXJSONMapper *)mapper;           //classes reachable from the root mapper
+- (NSString *)sourceForClasses:(NSArray *)classes;                  //listed classes and the complex classes they reference
+
+@end
+
+//
+//  Copyright (c) 2013 Outsource Cafe, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
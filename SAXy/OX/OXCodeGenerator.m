@@ -0,0 +1,245 @@
+//
+//  OXCodeGenerator.m
+//  SAXy OX - Object-to-XML mapping library
+//
+//  Created by agent on 10/19/26.
+//
+
+#import "OXCodeGenerator.h"
+#import "OXType.h"
+#import "OXProperty.h"
+#import "OXUtil.h"
+#import "OXContext.h"
+#import "OXComplexMapper.h"
+#import "OXmlMapper.h"
+#import "OXJSONMapper.h"
+#import "OXJSONObjectMapper.h"
+#import <objc/runtime.h>
+
+typedef OXComplexMapper *(^OXMapperLookupBlock)(Class type);
+
+
+@implementation OXCodeGenerator
+
+#pragma mark - constructor
+
+- (id)initWithName:(NSString *)name
+{
+    if (self = [super init]) {
+        NSCharacterSet *invalid = [[NSCharacterSet characterSetWithCharactersInString:@"abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_"] invertedSet];
+        NSAssert1([name length] > 0 && [name rangeOfCharacterFromSet:invalid].location == NSNotFound, @"ERROR: generator name must be a valid identifier, not '%@'", name);
+        _name = name;
+        _fileName = [NSString stringWithFormat:@"OXGeneratedMapping+%@.m", name];
+    }
+    return self;
+}
+
++ (id)generatorWithName:(NSString *)name
+{
+    return [[OXCodeGenerator alloc] initWithName:name];
+}
+
+
+#pragma mark - class discovery
+
+- (BOOL)isMappedClass:(Class)type
+{
+    return type != nil
+        && type != [NSObject class]
+        && ! [type isSubclassOfClass:[OXContext class]]
+        && ! [OXUtil knownSimpleType:type]
+        && ! [OXUtil knownCollectionType:type];
+}
+
+- (void)addType:(OXType *)type to:(NSMutableOrderedSet *)classes lookup:(OXMapperLookupBlock)lookup
+{
+    if (type.typeEnum == OX_COMPLEX) {
+        [self addClass:type.type to:classes lookup:lookup];
+    } else if (type.typeEnum == OX_CONTAINER) {
+        [self addClass:type.containerChildType.type to:classes lookup:lookup];
+    }
+}
+
+- (void)addClass:(Class)type to:(NSMutableOrderedSet *)classes lookup:(OXMapperLookupBlock)lookup
+{
+    if ( ! [self isMappedClass:type] || [classes containsObject:type])
+        return;
+    [classes addObject:type];
+    OXComplexMapper *mapper = lookup ? lookup(type) : nil;
+    for(OXPathMapper *pathMapper in mapper.pathMappers) {     //explicit mappings may declare container child types
+        [self addType:pathMapper.toType to:classes lookup:lookup];
+    }
+    for(OXProperty *property in [[OXType cachedType:type].properties allValues]) {
+        [self addType:property.type to:classes lookup:lookup];
+    }
+}
+
+
+#pragma mark - code fragments
+
+- (NSString *)cString:(const char *)value
+{
+    NSString *string = [NSString stringWithUTF8String:value];
+    string = [string stringByReplacingOccurrencesOfString:@"\\" withString:@"\\\\"];
+    return [NSString stringWithFormat:@"\"%@\"", [string stringByReplacingOccurrencesOfString:@"\"" withString:@"\\\""]];
+}
+
+- (NSString *)typeExpression:(OXType *)type
+{
+    switch (type.typeEnum) {
+        case OX_SCALAR:
+            return [NSString stringWithFormat:@"[OXType scalarType:nil scalarEncoding:%@]", [self cString:type.scalarEncoding]];
+        case OX_CONTAINER:
+            return [NSString stringWithFormat:@"[OXType typeContainer:[%@ class] containing:nil]", NSStringFromClass(type.type)];
+        case OX_COMPLEX:
+            return [NSString stringWithFormat:@"[OXType type:[%@ class] typeEnum:OX_COMPLEX]", NSStringFromClass(type.type)];
+        case OX_ATOMIC:
+            return [NSString stringWithFormat:@"[OXType type:[%@ class] typeEnum:OX_ATOMIC]", NSStringFromClass(type.type)];
+        case OX_POLYMORPHIC:
+        default:
+            return [NSString stringWithFormat:@"[OXType type:[%@ class] typeEnum:OX_POLYMORPHIC]", NSStringFromClass(type.type)];
+    }
+}
+
+//NSNumber unboxing and boxing selectors, indexed by OXScalarEnum
+static NSString *const unboxSelectors[OX_SCALAR_ENUM_COUNT] = {
+    nil, @"boolValue", @"charValue", @"unsignedCharValue", @"shortValue", @"unsignedShortValue", @"intValue", @"unsignedIntValue",
+    @"longValue", @"unsignedLongValue", @"longLongValue", @"unsignedLongLongValue", @"floatValue", @"doubleValue"
+};
+static NSString *const boxSelectors[OX_SCALAR_ENUM_COUNT] = {
+    nil, @"numberWithBool", @"numberWithChar", @"numberWithUnsignedChar", @"numberWithShort", @"numberWithUnsignedShort", @"numberWithInt", @"numberWithUnsignedInt",
+    @"numberWithLong", @"numberWithUnsignedLong", @"numberWithLongLong", @"numberWithUnsignedLongLong", @"numberWithFloat", @"numberWithDouble"
+};
+
+- (BOOL)isReadonly:(NSString *)name inClass:(Class)type
+{
+    objc_property_t property = class_getProperty(type, [name UTF8String]);
+    const char *attributes = property ? property_getAttributes(property) : NULL;
+    if (attributes == NULL)
+        return YES;
+    for(NSString *attribute in [[NSString stringWithUTF8String:attributes] componentsSeparatedByString:@","]) {
+        if ([attribute isEqualToString:@"R"])
+            return YES;
+    }
+    return NO;
+}
+
+- (void)appendAccessors:(OXProperty *)property ofClass:(Class)type to:(NSMutableString *)source
+{
+    NSString *className = NSStringFromClass(type);
+    NSString *name = property.name;
+    NSString *setter = nil;
+    NSString *getter = nil;
+    if (property.type.typeEnum == OX_SCALAR) {
+        OXScalarEnum scalarEnum = property.type.scalarEnum;
+        if (scalarEnum == OX_SCALAR_UNKNOWN || scalarEnum >= OX_SCALAR_ENUM_COUNT)
+            return;     //structs, pointers, etc. - KVC only
+        //nil goes to setNilValueForKey:, as with KVC, instead of being unboxed to 0
+        setter = [NSString stringWithFormat:@"if (value) ((%@ *)target).%@ = [value %@]; else [target setNilValueForKey:path];", className, name, unboxSelectors[scalarEnum]];
+        getter = [NSString stringWithFormat:@"return [NSNumber %@:((%@ *)source).%@];", boxSelectors[scalarEnum], className, name];
+    } else {
+        setter = [NSString stringWithFormat:@"((%@ *)target).%@ = value;", className, name];
+        getter = [NSString stringWithFormat:@"return ((%@ *)source).%@;", className, name];
+    }
+    if ([self isReadonly:name inClass:type])
+        setter = nil;   //readonly properties are set through their ivar by KVC
+    [source appendFormat:@"        [OXGeneratedMapping registerClass:[%@ class] property:@\"%@\"\n", className, name];
+    if (setter)
+        [source appendFormat:@"            setter:^(NSString *path, id value, id target, OXContext *ctx) { %@ }\n", setter];
+    else
+        [source appendString:@"            setter:nil\n"];
+    [source appendFormat:@"            getter:^id(NSString *path, id source, OXContext *ctx) { %@ }];\n", getter];
+}
+
+- (void)appendClass:(Class)type to:(NSMutableString *)source
+{
+    NSString *className = NSStringFromClass(type);
+    NSDictionary *properties = [OXType cachedType:type].properties;
+    NSArray *names = [[properties allKeys] sortedArrayUsingSelector:@selector(compare:)];
+    [source appendFormat:@"        //%@\n", className];
+    [source appendFormat:@"        [OXGeneratedMapping registerClass:[%@ class] properties:@[\n", className];
+    for(NSString *name in names) {
+        OXProperty *property = [properties objectForKey:name];
+        [source appendFormat:@"            [OXProperty property:@\"%@\" type:%@],\n", name, [self typeExpression:property.type]];
+    }
+    [source appendString:@"        ]];\n"];
+    NSMutableArray *tags = [NSMutableArray array];
+    for(NSString *name in names) {
+        OXProperty *property = [properties objectForKey:name];
+        if (property.type.typeEnum == OX_CONTAINER)
+            [tags addObject:[NSString stringWithFormat:@"@\"%@\":@\"%@\"", name, [OXUtil guessSingularNoun:name]]];
+    }
+    if ([tags count] > 0)
+        [source appendFormat:@"        [OXGeneratedMapping registerClass:[%@ class] tags:@{%@}];\n", className, [tags componentsJoinedByString:@", "]];
+    for(NSString *name in names) {
+        [self appendAccessors:[properties objectForKey:name] ofClass:type to:source];
+    }
+    [source appendString:@"\n"];
+}
+
+
+#pragma mark - generate
+
+- (NSString *)sourceForOrderedClasses:(NSOrderedSet *)classes
+{
+    NSMutableString *source = [NSMutableString stringWithCapacity:4096];
+    [source appendFormat:@"//\n//  %@\n//\n//  Generated by OXCodeGenerator - do not edit, regenerate when the mapped classes change.\n//\n\n", _fileName];
+    [source appendString:@"#import \"OXGeneratedMapping.h\"\n#import \"OXType.h\"\n#import \"OXProperty.h\"\n#import \"OXContext.h\"\n"];
+    for(NSString *import in _imports) {
+        [source appendFormat:@"#import \"%@\"\n", import];
+    }
+    [source appendFormat:@"\n\n@interface OXGeneratedMapping (%@)\n@end\n\n@implementation OXGeneratedMapping (%@)\n\n", _name, _name];
+    [source appendString:@"+ (void)load\n{\n    @autoreleasepool {\n"];
+    for(Class type in classes) {
+        [self appendClass:type to:source];
+    }
+    [source appendString:@"    }\n}\n\n@end\n"];
+    return source;
+}
+
+- (NSString *)sourceForClasses:(NSArray *)classes
+{
+    NSMutableOrderedSet *orderedClasses = [NSMutableOrderedSet orderedSet];
+    for(Class type in classes) {
+        [self addClass:type to:orderedClasses lookup:nil];
+    }
+    return [self sourceForOrderedClasses:orderedClasses];
+}
+
+- (NSString *)sourceForXmlMapper:(OXmlMapper *)mapper
+{
+    NSMutableOrderedSet *classes = [NSMutableOrderedSet orderedSet];
+    OXMapperLookupBlock lookup = ^(Class type) { return (OXComplexMapper *)[mapper elementMapperForClass:type]; };
+    for(OXPathMapper *pathMapper in mapper.rootMapper.pathMappers) {
+        [self addType:pathMapper.toType to:classes lookup:lookup];
+    }
+    return [self sourceForOrderedClasses:classes];
+}
+
+- (NSString *)sourceForJSONMapper:(OXJSONMapper *)mapper
+{
+    NSMutableOrderedSet *classes = [NSMutableOrderedSet orderedSet];
+    OXMapperLookupBlock lookup = ^(Class type) { return (OXComplexMapper *)[mapper objectMapperForClass:type]; };
+    for(OXPathMapper *pathMapper in mapper.rootMapper.pathMappers) {
+        [self addType:pathMapper.toType to:classes lookup:lookup];
+    }
+    return [self sourceForOrderedClasses:classes];
+}
+
+@end
+
+//
+//  Copyright (c) 2013 Outsource Cafe, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
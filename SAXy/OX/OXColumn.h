@@ -0,0 +1,87 @@
+/**
+
+  OXColumn.h
+  SAXy OX - Object-to-XML mapping library
+
+  Contiguous, typed storage of one property across many records (struct-of-arrays), filled by OXmlColumnReader in
+  place of one object per record.  The storage type is derived from the mapped property type:
+
+    * OX_COLUMN_INT64  - integer and BOOL scalars, int64_t values, missing values are 0.  Unsigned long and unsigned
+                         long long columns (isUnsigned) hold uint64_t values, read them with uint64Values
+    * OX_COLUMN_DOUBLE - float and double scalars, NSNumber properties, missing values are NAN
+    * OX_COLUMN_DATE   - NSDate properties, seconds since 1970 as double values, missing values are NAN
+    * OX_COLUMN_STRING - everything else, UTF-8 bytes of all values in one arena, record i spans
+                         [stringOffsets[i], stringOffsets[i+1]), missing values are empty
+
+  Each column also keeps a presence bit per record, so a missing value can be told apart from a stored 0, NAN or
+  empty string.  The value pointers remain valid until the next append, copy what you need before reading again.
+
+  Created by agent on 10/19/26.
+
+ */
+#import <Foundation/Foundation.h>
+@class OXType;
+
+typedef enum {
+    OX_COLUMN_INT64,
+    OX_COLUMN_DOUBLE,
+    OX_COLUMN_DATE,
+    OX_COLUMN_STRING
+} OXColumnEnum;
+
+
+@interface OXColumn : NSObject
+
+@property(strong,nonatomic,readonly)NSString *name;                 //property name
+@property(assign,nonatomic,readonly)OXColumnEnum columnEnum;        //storage type
+@property(assign,nonatomic,readonly)NSUInteger count;               //number of records
+@property(assign,nonatomic,readonly)NSUInteger missingCount;        //records without a value
+@property(assign,nonatomic,readonly)BOOL isUnsigned;                //OX_COLUMN_INT64 of unsigned 64-bit values
+
+#pragma mark - constructors
++ (id)column:(NSString *)name columnEnum:(OXColumnEnum)columnEnum;
++ (id)column:(NSString *)name type:(OXType *)type;                  //storage type derived from property type, nil for complex and container types
+
+#pragma mark - append
+- (void)appendValue:(id)value;                                      //property value (NSNumber, NSDate or NSString), nil appends a missing value
+- (void)removeAll;
+
+#pragma mark - record buffer
+- (void)clearPending;                                               //start of a record, the pending value is missing
+- (void)setPendingValue:(id)value;                                  //property value, appended by appendPending
+- (BOOL)setPendingText:(NSString *)text;                            //parses integer, BOOL and real text in place, NO if the property type needs a transform
+- (void)appendPending;                                              //end of a record, appends the pending value
+
+#pragma mark - raw access
+- (const int64_t *)int64Values;                                     //OX_COLUMN_INT64 only
+- (const double *)doubleValues;                                     //OX_COLUMN_DOUBLE and OX_COLUMN_DATE only
+- (const NSUInteger *)stringOffsets;                                //OX_COLUMN_STRING only, count + 1 entries
+- (const char *)stringArena;                                        //OX_COLUMN_STRING only, not NUL terminated
+- (const uint64_t *)uint64Values;                                   //OX_COLUMN_INT64 only, same storage as int64Values
+- (const uint8_t *)presenceMask;                                    //bit (i % 8) of byte (i / 8) is set if record i has a value
+
+#pragma mark - boxed access
+- (BOOL)hasValueAtIndex:(NSUInteger)index;
+- (int64_t)int64AtIndex:(NSUInteger)index;
+- (uint64_t)uint64AtIndex:(NSUInteger)index;
+- (double)doubleAtIndex:(NSUInteger)index;
+- (NSString *)stringAtIndex:(NSUInteger)index;
+- (id)objectAtIndex:(NSUInteger)index;                              //NSNumber, NSDate or NSString, nil for missing values
+
+@end
+
+//
+//  Copyright (c) 2013 Outsource Cafe, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
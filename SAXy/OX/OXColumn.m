@@ -0,0 +1,312 @@
+//
+//  OXColumn.m
+//  SAXy OX - Object-to-XML mapping library
+//
+//  Created by agent on 10/19/26.
+//
+
+#import "OXColumn.h"
+#import "OXType.h"
+
+#define OX_COLUMN_INITIAL_CAPACITY 1024     //records
+
+
+@implementation OXColumn
+{
+    NSMutableData *_values;         //int64_t, double or NSUInteger string offsets
+    NSMutableData *_arena;          //OX_COLUMN_STRING bytes
+    NSMutableData *_presence;       //one bit per record, set when the record has a value
+    OXScalarEnum _scalarEnum;       //scalar property type, OX_SCALAR_UNKNOWN for atomic properties
+    BOOL _hasPending;               //record buffer: set once the open record has a value
+    int64_t _pendingInt64;
+    double _pendingDouble;
+    id _pendingValue;               //OX_COLUMN_DATE and OX_COLUMN_STRING values
+}
+
+#pragma mark - constructors
+
+- (id)initWithName:(NSString *)name columnEnum:(OXColumnEnum)columnEnum
+{
+    if (self = [super init]) {
+        _name = name;
+        _columnEnum = columnEnum;
+        [self removeAll];
+    }
+    return self;
+}
+
++ (id)column:(NSString *)name columnEnum:(OXColumnEnum)columnEnum
+{
+    return [[OXColumn alloc] initWithName:name columnEnum:columnEnum];
+}
+
++ (id)column:(NSString *)name type:(OXType *)type
+{
+    switch (type.typeEnum) {
+        case OX_SCALAR: {
+            if (type.scalarEnum == OX_SCALAR_UNKNOWN || type.scalarEnum >= OX_SCALAR_ENUM_COUNT)
+                return nil;
+            BOOL isReal = type.scalarEnum == OX_SCALAR_FLOAT || type.scalarEnum == OX_SCALAR_DOUBLE;
+            OXColumn *column = [OXColumn column:name columnEnum:isReal ? OX_COLUMN_DOUBLE : OX_COLUMN_INT64];
+            column->_isUnsigned = type.scalarEnum == OX_SCALAR_ULONG || type.scalarEnum == OX_SCALAR_ULONGLONG;
+            column->_scalarEnum = type.scalarEnum;
+            return column;
+        }
+        case OX_ATOMIC: {
+            if ([type.type isSubclassOfClass:[NSDate class]])
+                return [OXColumn column:name columnEnum:OX_COLUMN_DATE];
+            if ([type.type isSubclassOfClass:[NSNumber class]])
+                return [OXColumn column:name columnEnum:OX_COLUMN_DOUBLE];
+            return [OXColumn column:name columnEnum:OX_COLUMN_STRING];
+        }
+        default:
+            return nil;
+    }
+}
+
+#pragma mark - append
+
+- (void)appendPresence:(BOOL)present
+{
+    if ((_count & 7) == 0)
+        [_presence increaseLengthBy:1];     //zero filled
+    if (present)
+        ((uint8_t *)[_presence mutableBytes])[_count >> 3] |= (uint8_t)(1 << (_count & 7));
+    else
+        _missingCount++;
+    _count++;
+}
+
+- (void)appendValue:(id)value
+{
+    BOOL present = NO;
+    switch (_columnEnum) {
+        case OX_COLUMN_INT64: {
+            present = _isUnsigned ? [value respondsToSelector:@selector(unsignedLongLongValue)] : [value respondsToSelector:@selector(longLongValue)];
+            int64_t v = ! present ? 0 : (_isUnsigned ? (int64_t)[value unsignedLongLongValue] : [value longLongValue]);   //longLongValue overflows above INT64_MAX
+            [_values appendBytes:&v length:sizeof(v)];
+            break;
+        }
+        case OX_COLUMN_DOUBLE: {
+            present = [value respondsToSelector:@selector(doubleValue)];
+            double v = present ? [value doubleValue] : NAN;
+            [_values appendBytes:&v length:sizeof(v)];
+            break;
+        }
+        case OX_COLUMN_DATE: {
+            present = [value isKindOfClass:[NSDate class]];
+            double v = present ? [value timeIntervalSince1970] : NAN;
+            [_values appendBytes:&v length:sizeof(v)];
+            break;
+        }
+        case OX_COLUMN_STRING: {
+            NSString *string = value == nil || [value isKindOfClass:[NSString class]] ? value : [value description];
+            const char *bytes = [string UTF8String];
+            present = bytes != NULL;
+            if (bytes)
+                [_arena appendBytes:bytes length:strlen(bytes)];
+            NSUInteger end = [_arena length];
+            [_values appendBytes:&end length:sizeof(end)];
+            break;
+        }
+    }
+    [self appendPresence:present];
+}
+
+- (void)removeAll
+{
+    size_t width = _columnEnum == OX_COLUMN_INT64 ? sizeof(int64_t) : (_columnEnum == OX_COLUMN_STRING ? sizeof(NSUInteger) : sizeof(double));
+    _values = [NSMutableData dataWithCapacity:OX_COLUMN_INITIAL_CAPACITY * width];
+    if (_columnEnum == OX_COLUMN_STRING) {
+        NSUInteger start = 0;
+        [_values appendBytes:&start length:sizeof(start)];
+        _arena = [NSMutableData dataWithCapacity:OX_COLUMN_INITIAL_CAPACITY * 16];
+    }
+    _presence = [NSMutableData dataWithCapacity:OX_COLUMN_INITIAL_CAPACITY / 8];
+    _count = 0;
+    _missingCount = 0;
+}
+
+#pragma mark - record buffer
+
+- (void)clearPending
+{
+    _hasPending = NO;
+    _pendingValue = nil;
+}
+
+- (void)setPendingValue:(id)value
+{
+    if (value == nil)
+        return;
+    switch (_columnEnum) {
+        case OX_COLUMN_INT64:
+            if ( ! [value respondsToSelector:@selector(longLongValue)])
+                return;
+            _pendingInt64 = _isUnsigned ? (int64_t)[value unsignedLongLongValue] : [value longLongValue];
+            break;
+        case OX_COLUMN_DOUBLE:
+            if ( ! [value respondsToSelector:@selector(doubleValue)])
+                return;
+            _pendingDouble = [value doubleValue];
+            break;
+        default:
+            _pendingValue = value;
+            break;
+    }
+    _hasPending = YES;
+}
+
+//same conversions as the default NSString to scalar transformers, without boxing the result
+- (BOOL)setPendingText:(NSString *)text
+{
+    switch (_scalarEnum) {
+        case OX_SCALAR_BOOL:        _pendingInt64 = [text boolValue]; break;
+        case OX_SCALAR_SHORT:       _pendingInt64 = (short)[text intValue]; break;
+        case OX_SCALAR_USHORT:      _pendingInt64 = (unsigned short)(short)[text intValue]; break;
+        case OX_SCALAR_INT:         _pendingInt64 = [text intValue]; break;
+        case OX_SCALAR_UINT:        _pendingInt64 = (unsigned int)[text intValue]; break;
+        case OX_SCALAR_LONG:        _pendingInt64 = (long)[text longLongValue]; break;
+        case OX_SCALAR_ULONG:       _pendingInt64 = (int64_t)(unsigned long)strtoull([text UTF8String], NULL, 10); break;
+        case OX_SCALAR_LONGLONG:    _pendingInt64 = [text longLongValue]; break;
+        case OX_SCALAR_ULONGLONG:   _pendingInt64 = (int64_t)strtoull([text UTF8String], NULL, 10); break;
+        case OX_SCALAR_FLOAT:       _pendingDouble = [text floatValue]; break;
+        case OX_SCALAR_DOUBLE:      _pendingDouble = [text doubleValue]; break;
+        default:
+            return NO;  //char types and atomic properties
+    }
+    _hasPending = YES;
+    return YES;
+}
+
+- (void)appendPending
+{
+    switch (_columnEnum) {
+        case OX_COLUMN_INT64: {
+            int64_t v = _hasPending ? _pendingInt64 : 0;
+            [_values appendBytes:&v length:sizeof(v)];
+            [self appendPresence:_hasPending];
+            break;
+        }
+        case OX_COLUMN_DOUBLE: {
+            double v = _hasPending ? _pendingDouble : NAN;
+            [_values appendBytes:&v length:sizeof(v)];
+            [self appendPresence:_hasPending];
+            break;
+        }
+        default:
+            [self appendValue:_pendingValue];
+            break;
+    }
+    [self clearPending];
+}
+
+#pragma mark - raw access
+
+- (const int64_t *)int64Values
+{
+    NSAssert1(_columnEnum == OX_COLUMN_INT64, @"ERROR: %@ is not an int64 column", _name);
+    return [_values bytes];
+}
+
+- (const uint64_t *)uint64Values
+{
+    NSAssert1(_columnEnum == OX_COLUMN_INT64, @"ERROR: %@ is not an int64 column", _name);
+    return [_values bytes];
+}
+
+- (const double *)doubleValues
+{
+    NSAssert1(_columnEnum == OX_COLUMN_DOUBLE || _columnEnum == OX_COLUMN_DATE, @"ERROR: %@ is not a double or date column", _name);
+    return [_values bytes];
+}
+
+- (const NSUInteger *)stringOffsets
+{
+    NSAssert1(_columnEnum == OX_COLUMN_STRING, @"ERROR: %@ is not a string column", _name);
+    return [_values bytes];
+}
+
+- (const char *)stringArena
+{
+    NSAssert1(_columnEnum == OX_COLUMN_STRING, @"ERROR: %@ is not a string column", _name);
+    return [_arena bytes];
+}
+
+- (const uint8_t *)presenceMask
+{
+    return [_presence bytes];
+}
+
+#pragma mark - boxed access
+
+- (BOOL)hasValueAtIndex:(NSUInteger)index
+{
+    NSAssert2(index < _count, @"ERROR: index %lu beyond %@ column bounds", (unsigned long)index, _name);
+    return ([self presenceMask][index >> 3] >> (index & 7)) & 1;
+}
+
+- (uint64_t)uint64AtIndex:(NSUInteger)index
+{
+    NSAssert2(index < _count, @"ERROR: index %lu beyond %@ column bounds", (unsigned long)index, _name);
+    return [self uint64Values][index];
+}
+
+- (int64_t)int64AtIndex:(NSUInteger)index
+{
+    NSAssert2(index < _count, @"ERROR: index %lu beyond %@ column bounds", (unsigned long)index, _name);
+    return [self int64Values][index];
+}
+
+- (double)doubleAtIndex:(NSUInteger)index
+{
+    NSAssert2(index < _count, @"ERROR: index %lu beyond %@ column bounds", (unsigned long)index, _name);
+    return [self doubleValues][index];
+}
+
+- (NSString *)stringAtIndex:(NSUInteger)index
+{
+    NSAssert2(index < _count, @"ERROR: index %lu beyond %@ column bounds", (unsigned long)index, _name);
+    const NSUInteger *offsets = [self stringOffsets];
+    return [[NSString alloc] initWithBytes:[self stringArena] + offsets[index] length:offsets[index+1] - offsets[index] encoding:NSUTF8StringEncoding];
+}
+
+- (id)objectAtIndex:(NSUInteger)index
+{
+    if ( ! [self hasValueAtIndex:index])
+        return nil;
+    switch (_columnEnum) {
+        case OX_COLUMN_INT64:
+            return _isUnsigned ? [NSNumber numberWithUnsignedLongLong:[self uint64AtIndex:index]] : [NSNumber numberWithLongLong:[self int64AtIndex:index]];
+        case OX_COLUMN_DOUBLE:
+            return [NSNumber numberWithDouble:[self doubleAtIndex:index]];
+        case OX_COLUMN_DATE:
+            return [NSDate dateWithTimeIntervalSince1970:[self doubleAtIndex:index]];
+        case OX_COLUMN_STRING:
+        default:
+            return [self stringAtIndex:index];
+    }
+}
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"%@ %@[%lu]", NSStringFromClass([self class]), _name, (unsigned long)_count];
+}
+
+@end
+
+//
+//  Copyright (c) 2013 Outsource Cafe, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
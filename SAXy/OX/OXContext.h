@@ -12,6 +12,12 @@
   4) transform        - OXTransform with registered formatters and default block functions
   5) result           - holds the result ('root' object) of the mapping operation
   6) userData         - for custom mappers that need to pass data between operations at run time
+  7) objectPool       - optional, when set the default factories reuse recycled instances (see OXObjectPool)
+  8) identityMap      - optional, when set readers merge into the previous result graph (see OXIdentityMap)
+  9) internTable      - bounded table sharing repeated string values of interned mappers (see OXInternTable)
+  10) limits          - optional bounds on untrusted input: nesting depth, input size, container items, text length,
+                        a deadline and a cancellation token (see OXCancellationToken).  Readers stop with an error as
+                        soon as one is exceeded, the partial result is discarded.
 
   Paths are abstract at this level and take specific meaning in concreate mapper frameworks (KVC path,
   xpath, etc.). Paths refer to the current position in the object tree your mapping and always have a
@@ -27,6 +33,16 @@
 #import "NSMutableArray+OXStack.h"
 #import "OXTransform.h"
 #import "OXPathMapper.h"
+#import "OXObjectPool.h"
+#import "OXIdentityMap.h"
+#import "OXInternTable.h"
+#import "OXCancellationToken.h"
+
+//userInfo keys of the errors logged for records dropped by a lenient read
+extern NSString *const OXErrorPathKey;          //where the failure occurred, i.e. /rss/channel/item/pubDate or items[12]
+extern NSString *const OXErrorLineKey;          //NSNumber, XML only
+extern NSString *const OXErrorColumnKey;        //NSNumber, XML only
+extern NSString *const OXErrorMapperKey;        //OXPathMapper in use when the failure occurred
 
 
 @interface OXContext : NSObject
@@ -38,12 +54,30 @@
 @property(strong,nonatomic,readonly)NSMutableDictionary *userData;
 @property(strong,nonatomic,readonly)OXTransform *transform;
 @property(strong,nonatomic,readonly)NSObject *result;
+@property(strong,nonatomic,readwrite)OXObjectPool *objectPool;         //opt-in recycling, nil by default. Survives reset.
+@property(strong,nonatomic,readwrite)OXIdentityMap *identityMap;       //opt-in merge-reading, nil by default. Survives reset.
+@property(strong,nonatomic,readwrite)OXInternTable *internTable;       //created on first use by interned mappers. Survives reset.
+
+@property(assign,nonatomic,readwrite)BOOL raiseTransformErrors;        //set by lenient readers: transformFailed: raises, so the record is dropped
+@property(strong,nonatomic,readonly)NSArray *transformErrors;           //values the transform couldn't convert, collected by the reader. Cleared by reset.
 
 @property(assign,readwrite,nonatomic) BOOL logReaderStack;              //log tag mapping - helpful debugging tool
 @property(assign,readwrite,nonatomic) BOOL logReaderInput;              //log input data - usefull for remote data debugging
 
+#pragma mark - limits, all survive reset
+@property(assign,nonatomic,readwrite)NSUInteger maxDepth;                  //element or object nesting, 0 (default) is unlimited
+@property(assign,nonatomic,readwrite)unsigned long long maxBytes;          //input size after inflating, 0 (default) is unlimited
+@property(assign,nonatomic,readwrite)NSUInteger maxContainerCount;         //items per container property, 0 (default) is unlimited
+@property(assign,nonatomic,readwrite)NSUInteger maxTextLength;             //characters per text node or string value, 0 (default) is unlimited
+@property(strong,nonatomic,readwrite)NSDate *deadline;                     //reads fail once it has passed, nil (default) for no time limit
+@property(strong,nonatomic,readwrite)OXCancellationToken *cancellationToken;   //cancel from any thread to stop a read
+
+- (id)initWithTransform:(OXTransform *)transform;                        //share registered transformers and formatters with another context
 - (void)reset;
 - (void)resetUserData;
+- (void)copyLimitsFrom:(OXContext *)context;                             //limits, deadline and cancellation token, for nested and worker contexts
+- (NSString *)budgetViolation;                                           //error message if the read was cancelled or the deadline passed, nil otherwise
+- (id)transformFailed:(NSString *)message;                               //for transformer blocks: logs (or raises) the failure, returns nil
 
 @end
 
@@ -7,12 +7,17 @@
 
 #import "OXContext.h"
 
+NSString *const OXErrorPathKey = @"OXErrorPath";
+NSString *const OXErrorLineKey = @"OXErrorLine";
+NSString *const OXErrorColumnKey = @"OXErrorColumn";
+NSString *const OXErrorMapperKey = @"OXErrorMapper";
+
 @implementation OXContext
 
-- (id)init
+- (id)initWithTransform:(OXTransform *)transform
 {
     if ((self = [super init])) {
-        _transform = [[OXTransform alloc] init];
+        _transform = transform;
         _userData = [NSMutableDictionary dictionary];
         _pathStack = [[NSMutableArray alloc] init];
         _instanceStack = [[NSMutableArray alloc] init];
@@ -21,12 +26,60 @@
     return self;
 }
 
+- (id)init
+{
+    return [self initWithTransform:[[OXTransform alloc] init]];
+}
+
+- (OXInternTable *)internTable
+{
+    if (_internTable == nil)
+        _internTable = [OXInternTable internTable];
+    return _internTable;
+}
+
 - (void)resetUserData
 {
     
     [_userData removeAllObjects];
 }
 
+- (void)copyLimitsFrom:(OXContext *)context
+{
+    _maxDepth = context.maxDepth;
+    _maxBytes = context.maxBytes;
+    _maxContainerCount = context.maxContainerCount;
+    _maxTextLength = context.maxTextLength;
+    _deadline = context.deadline;
+    _cancellationToken = context.cancellationToken;
+}
+
+- (NSString *)budgetViolation
+{
+    if (_cancellationToken.cancelled)
+        return @"read cancelled";
+    if (_deadline && [_deadline timeIntervalSinceNow] < 0)
+        return [NSString stringWithFormat:@"read deadline of %@ passed", _deadline];
+    return nil;
+}
+
+- (id)transformFailed:(NSString *)message
+{
+    NSString *path = [_currentMapper toPath];
+    NSString *reason = path ? [NSString stringWithFormat:@"%@: %@", path, message] : message;
+    if (_raiseTransformErrors)
+        [NSException raise:NSInvalidArgumentException format:@"%@", reason];
+    NSMutableDictionary *userInfo = [NSMutableDictionary dictionaryWithCapacity:2];
+    [userInfo setObject:reason forKey:NSLocalizedDescriptionKey];
+    if (_currentMapper)
+        [userInfo setObject:_currentMapper forKey:OXErrorMapperKey];
+    NSError *error = [NSError errorWithDomain:@"com.outsourcecafe.ox" code:99 userInfo:userInfo];
+    if (_transformErrors == nil)
+        _transformErrors = [NSMutableArray arrayWithCapacity:7];
+    [(NSMutableArray *)_transformErrors addObject:error];
+    return nil;
+}
+
 - (void)reset
 {
     [_pathStack clear];
@@ -34,6 +87,7 @@
     [_mapperStack clear];
     _currentMapper = nil;
     _result = nil;
+    _transformErrors = nil;
 }
 
 
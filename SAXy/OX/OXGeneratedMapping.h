@@ -0,0 +1,52 @@
+/**
+
+  OXGeneratedMapping.h
+  SAXy OX - Object-to-XML mapping library
+
+  Registry for mapping metadata generated ahead-of-time by OXCodeGenerator.  Generated source files register their
+  tables from a +load method in a category of this class, so linking them in is all that's required:
+
+    * properties - replaces OXType self reflection of the mapped classes
+    * accessors  - direct property access blocks, used by OXPathMapper in place of KVC setters and getters (values
+                   are boxed as with KVC, scalars arrive as NSNumber)
+    * tags       - element/path names of container properties, replaces guessSingularNoun: at configure time
+
+  Classes without generated metadata are mapped by self reflection, as before.
+
+  Created by agent on 10/19/26.
+
+ */
+#import <Foundation/Foundation.h>
+#import "OXBlockDef.h"
+
+
+@interface OXGeneratedMapping : NSObject
+
+#pragma mark - registration
++ (void)registerClass:(Class)type properties:(NSArray *)properties;                                          //OXProperty list
++ (void)registerClass:(Class)type property:(NSString *)name setter:(OXSetterBlock)setter getter:(OXGetterBlock)getter;  //nil setter for readonly properties
++ (void)registerClass:(Class)type tags:(NSDictionary *)tags;                                                //tags keyed by property name
+
+#pragma mark - lookup
++ (OXSetterBlock)setterForClass:(Class)type property:(NSString *)name;
++ (OXGetterBlock)getterForClass:(Class)type property:(NSString *)name;
++ (NSString *)tagForClass:(Class)type property:(NSString *)name;
++ (BOOL)isGeneratedClass:(Class)type;
+
+@end
+
+//
+//  Copyright (c) 2013 Outsource Cafe, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
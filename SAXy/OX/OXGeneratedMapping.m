@@ -0,0 +1,139 @@
+//
+//  OXGeneratedMapping.m
+//  SAXy OX - Object-to-XML mapping library
+//
+//  Created by agent on 10/19/26.
+//
+
+#import "OXGeneratedMapping.h"
+#import "OXType.h"
+#import "OXProperty.h"
+
+
+#pragma mark - OXGeneratedClass
+
+
+//generated metadata of a single class
+@interface OXGeneratedClass : NSObject
+@property(strong,nonatomic,readonly)NSMutableDictionary *setters;
+@property(strong,nonatomic,readonly)NSMutableDictionary *getters;
+@property(strong,nonatomic,readonly)NSMutableDictionary *tags;
+@end
+
+@implementation OXGeneratedClass
+- (id)init
+{
+    if (self = [super init]) {
+        _setters = [NSMutableDictionary dictionary];
+        _getters = [NSMutableDictionary dictionary];
+        _tags = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+@end
+
+
+#pragma mark - OXGeneratedMapping
+
+
+@implementation OXGeneratedMapping
+
+static NSMutableDictionary *generatedClasses = nil;    //OXGeneratedClass keyed by Class
+
+//registration happens in +load, lookups during configure, so a lock is cheap enough
++ (OXGeneratedClass *)generatedClass:(Class)type create:(BOOL)create
+{
+    @synchronized(self) {
+        if (generatedClasses == nil) {
+            if (!create)
+                return nil;
+            generatedClasses = [NSMutableDictionary dictionary];
+        }
+        OXGeneratedClass *generated = type ? [generatedClasses objectForKey:type] : nil;
+        if (generated == nil && create && type) {
+            generated = [[OXGeneratedClass alloc] init];
+            [generatedClasses setObject:generated forKey:(id<NSCopying>)type];
+        }
+        return generated;
+    }
+}
+
+#pragma mark - registration
+
++ (void)registerClass:(Class)type properties:(NSArray *)properties
+{
+    NSMutableDictionary *propertyMap = [NSMutableDictionary dictionaryWithCapacity:[properties count]];
+    for(OXProperty *property in properties) {
+        [propertyMap setObject:property forKey:property.name];
+    }
+    [[OXType cachedType:type] setValue:propertyMap forKey:@"properties"];   //bypass readonly, skips self reflection
+    [self generatedClass:type create:YES];
+}
+
++ (void)registerClass:(Class)type property:(NSString *)name setter:(OXSetterBlock)setter getter:(OXGetterBlock)getter
+{
+    OXGeneratedClass *generated = [self generatedClass:type create:YES];
+    @synchronized(self) {
+        if (setter)
+            [generated.setters setObject:[setter copy] forKey:name];
+        if (getter)
+            [generated.getters setObject:[getter copy] forKey:name];
+    }
+}
+
++ (void)registerClass:(Class)type tags:(NSDictionary *)tags
+{
+    OXGeneratedClass *generated = [self generatedClass:type create:YES];
+    @synchronized(self) {
+        [generated.tags addEntriesFromDictionary:tags];
+    }
+}
+
+#pragma mark - lookup
+
++ (OXSetterBlock)setterForClass:(Class)type property:(NSString *)name
+{
+    OXGeneratedClass *generated = [self generatedClass:type create:NO];
+    @synchronized(self) {
+        return generated ? [generated.setters objectForKey:name] : nil;
+    }
+}
+
++ (OXGetterBlock)getterForClass:(Class)type property:(NSString *)name
+{
+    OXGeneratedClass *generated = [self generatedClass:type create:NO];
+    @synchronized(self) {
+        return generated ? [generated.getters objectForKey:name] : nil;
+    }
+}
+
++ (NSString *)tagForClass:(Class)type property:(NSString *)name
+{
+    OXGeneratedClass *generated = [self generatedClass:type create:NO];
+    @synchronized(self) {
+        return generated ? [generated.tags objectForKey:name] : nil;
+    }
+}
+
++ (BOOL)isGeneratedClass:(Class)type
+{
+    return [self generatedClass:type create:NO] != nil;
+}
+
+@end
+
+//
+//  Copyright (c) 2013 Outsource Cafe, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
@@ -0,0 +1,77 @@
+/**
+
+  OXGzipStream.h
+  SAXy OX - Object-to-XML mapping library
+
+  Streaming zlib compression for reader input and writer output, so inflating, parsing and deflating overlap instead of
+  passing full-size buffers between separate passes:
+
+    * OXGzipInputStream  - inflates gzip or zlib (RFC 1950) input read from another stream, sniffing the format from the
+                           first bytes.  Uncompressed input passes through unchanged, so any source can be wrapped.
+    * OXGzipOutputStream - deflates everything written to it into another stream, the gzip trailer is written by close.
+
+  Readers detect compressed NSData on their own, wrap streams explicitly:
+
+    NSInputStream *feed = [OXGzipInputStream inputStreamWithStream:[NSInputStream inputStreamWithFileAtPath:path]];
+    id result = [reader readXmlStream:feed];
+
+    OXGzipOutputStream *sink = [OXGzipOutputStream outputStreamWithStream:[NSOutputStream outputStreamToFileAtPath:path append:NO]];
+    [sink open];
+    [writer writeXml:result toStream:sink prettyPrint:NO];
+    [sink close];
+
+  Both streams are synchronous, run loop scheduling is ignored.  Requires libz.
+
+  Created by agent on 10/19/26.
+
+ */
+#import <Foundation/Foundation.h>
+
+typedef enum {
+    OX_COMPRESSION_NONE,
+    OX_COMPRESSION_GZIP,
+    OX_COMPRESSION_ZLIB
+} OXCompressionEnum;
+
+
+@interface OXGzipInputStream : NSInputStream
+
+@property(assign,nonatomic,readonly)OXCompressionEnum compression;  //format of the source, known after the first read
+@property(assign,nonatomic,readonly)unsigned long long totalOut;    //bytes returned by read:maxLength:
+@property(assign,nonatomic,readwrite)unsigned long long maxLength;  //the read fails once more bytes would be returned, 0 (default) is unlimited
+
++ (OXCompressionEnum)compressionOfData:(NSData *)data;              //sniffs the gzip magic number or a zlib header
++ (id)inputStreamWithStream:(NSInputStream *)source;                //source is opened and closed with this stream
++ (id)inputStreamWithData:(NSData *)data;
++ (NSData *)inflateData:(NSData *)data;                             //whole-buffer convenience, nil on error
++ (NSData *)inflateData:(NSData *)data maxLength:(unsigned long long)maxLength;    //nil on error or if the result would exceed maxLength
+
+@end
+
+
+@interface OXGzipOutputStream : NSOutputStream
+
+@property(assign,nonatomic,readonly)unsigned long long totalIn;     //uncompressed bytes written
+@property(assign,nonatomic,readonly)unsigned long long totalOut;    //compressed bytes passed on
+
++ (id)outputStreamWithStream:(NSOutputStream *)destination;         //gzip format, default compression level
++ (id)outputStreamWithStream:(NSOutputStream *)destination compression:(OXCompressionEnum)compression level:(int)level;    //level: 0-9, -1 for default
++ (NSData *)gzipData:(NSData *)data;                                //whole-buffer convenience
+
+@end
+
+//
+//  Copyright (c) 2013 Outsource Cafe, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
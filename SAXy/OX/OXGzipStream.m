@@ -0,0 +1,439 @@
+//
+//  OXGzipStream.m
+//  SAXy OX - Object-to-XML mapping library
+//
+//  Created by agent on 10/19/26.
+//
+
+#import "OXGzipStream.h"
+#include <zlib.h>
+
+#define OX_GZIP_CHUNK 16384                 //compressed bytes per source read or destination write
+
+
+static NSError *OXGzipError(NSString *message)
+{
+    return [NSError errorWithDomain:@"com.outsourcecafe.ox" code:99 userInfo:@{NSLocalizedDescriptionKey:message}];
+}
+
+static OXCompressionEnum OXSniffCompression(const uint8_t *bytes, NSUInteger length)
+{
+    if (length < 2)
+        return OX_COMPRESSION_NONE;
+    if (bytes[0] == 0x1f && bytes[1] == 0x8b)
+        return OX_COMPRESSION_GZIP;
+    //zlib header: deflate method, window <= 32K and a check value making the first two bytes a multiple of 31
+    if ((bytes[0] & 0x0f) == Z_DEFLATED && (bytes[0] >> 4) <= 7 && ((bytes[0] << 8) | bytes[1]) % 31 == 0)
+        return OX_COMPRESSION_ZLIB;
+    return OX_COMPRESSION_NONE;
+}
+
+
+@implementation OXGzipInputStream
+{
+    NSInputStream *_source;
+    NSMutableData *_chunk;
+    z_stream _zstream;
+    BOOL _sniffed;
+    BOOL _inflating;                        //inflateInit2 succeeded, inflateEnd pending
+    BOOL _sourceEnded;
+    NSStreamStatus _status;
+    NSError *_error;
+    __weak id<NSStreamDelegate> _delegate;
+}
+
+#pragma mark - constructors
+
+- (id)initWithSource:(NSInputStream *)source
+{
+    if (self = [super init]) {
+        _source = source;
+        _chunk = [NSMutableData dataWithLength:OX_GZIP_CHUNK];
+        _status = NSStreamStatusNotOpen;
+    }
+    return self;
+}
+
++ (id)inputStreamWithStream:(NSInputStream *)source
+{
+    NSAssert(source != nil, @"ERROR: OXGzipInputStream requires a source stream");
+    return [[OXGzipInputStream alloc] initWithSource:source];
+}
+
++ (id)inputStreamWithData:(NSData *)data
+{
+    return [[OXGzipInputStream alloc] initWithSource:[NSInputStream inputStreamWithData:data]];
+}
+
++ (OXCompressionEnum)compressionOfData:(NSData *)data
+{
+    return OXSniffCompression([data bytes], [data length]);
+}
+
++ (NSData *)inflateData:(NSData *)data
+{
+    return [OXGzipInputStream inflateData:data maxLength:0];
+}
+
++ (NSData *)inflateData:(NSData *)data maxLength:(unsigned long long)maxLength
+{
+    OXGzipInputStream *stream = [OXGzipInputStream inputStreamWithData:data];
+    stream.maxLength = maxLength;
+    NSMutableData *result = [NSMutableData dataWithCapacity:[data length] * 4];
+    uint8_t buffer[OX_GZIP_CHUNK];
+    NSInteger length;
+    [stream open];
+    while ((length = [stream read:buffer maxLength:sizeof(buffer)]) > 0)
+        [result appendBytes:buffer length:length];
+    [stream close];
+    return length < 0 ? nil : result;
+}
+
+- (void)dealloc
+{
+    if (_inflating)
+        inflateEnd(&_zstream);
+}
+
+#pragma mark - private
+
+- (void)failWithError:(NSError *)error
+{
+    _error = error;
+    _status = NSStreamStatusError;
+}
+
+//reads until the format is known, the sniffed bytes stay in the input buffer
+- (BOOL)sniff
+{
+    uint8_t *bytes = [_chunk mutableBytes];
+    NSUInteger length = 0;
+    while (length < 2 && ! _sourceEnded) {
+        NSInteger count = [_source read:bytes + length maxLength:OX_GZIP_CHUNK - length];
+        if (count < 0) {
+            [self failWithError:[_source streamError] ? [_source streamError] : OXGzipError(@"compressed source read failed")];
+            return NO;
+        }
+        _sourceEnded = count == 0;
+        length += count;
+    }
+    _zstream.next_in = bytes;
+    _zstream.avail_in = (uInt)length;
+    _compression = OXSniffCompression(bytes, length);
+    _sniffed = YES;
+    if (_compression != OX_COMPRESSION_NONE) {
+        if (inflateInit2(&_zstream, 15 + 32) != Z_OK) {     //+32: gzip or zlib header, detected by zlib
+            [self failWithError:OXGzipError(@"inflateInit2 failed")];
+            return NO;
+        }
+        _inflating = YES;
+    }
+    return YES;
+}
+
+//refills the input buffer once zlib drained it
+- (BOOL)fillSource
+{
+    if (_zstream.avail_in > 0 || _sourceEnded)
+        return YES;
+    NSInteger count = [_source read:[_chunk mutableBytes] maxLength:OX_GZIP_CHUNK];
+    if (count < 0) {
+        [self failWithError:[_source streamError] ? [_source streamError] : OXGzipError(@"compressed source read failed")];
+        return NO;
+    }
+    _zstream.next_in = [_chunk mutableBytes];
+    _zstream.avail_in = (uInt)count;
+    _sourceEnded = count == 0;
+    return YES;
+}
+
+- (NSInteger)passThrough:(uint8_t *)buffer maxLength:(NSUInteger)len
+{
+    if (_zstream.avail_in > 0) {            //sniffed bytes first
+        NSUInteger count = MIN(len, _zstream.avail_in);
+        memcpy(buffer, _zstream.next_in, count);
+        _zstream.next_in += count;
+        _zstream.avail_in -= (uInt)count;
+        return count;
+    }
+    NSInteger count = _sourceEnded ? 0 : [_source read:buffer maxLength:len];
+    if (count < 0) {
+        [self failWithError:[_source streamError] ? [_source streamError] : OXGzipError(@"source read failed")];
+    } else if (count == 0) {
+        _sourceEnded = YES;
+        _status = NSStreamStatusAtEnd;
+    }
+    return count;
+}
+
+- (NSInteger)inflate:(uint8_t *)buffer maxLength:(NSUInteger)len
+{
+    const uInt capacity = (uInt)MIN(len, (NSUInteger)UINT_MAX);
+    _zstream.next_out = buffer;
+    _zstream.avail_out = capacity;
+    while (_zstream.avail_out > 0 && _status != NSStreamStatusAtEnd) {
+        if ( ! [self fillSource])
+            return -1;
+        if (_zstream.avail_in == 0) {
+            [self failWithError:OXGzipError(@"truncated compressed input")];
+            return -1;
+        }
+        int status = inflate(&_zstream, Z_NO_FLUSH);
+        if (status == Z_STREAM_END) {
+            if ( ! [self fillSource])
+                return -1;
+            if (_zstream.avail_in == 0)
+                _status = NSStreamStatusAtEnd;
+            else
+                inflateReset(&_zstream);    //concatenated gzip members
+        } else if (status != Z_OK && status != Z_BUF_ERROR) {
+            [self failWithError:OXGzipError([NSString stringWithFormat:@"inflate failed: %s", _zstream.msg ? _zstream.msg : "corrupt data"])];
+            return -1;
+        }
+    }
+    return capacity - _zstream.avail_out;
+}
+
+#pragma mark - NSStream
+
+- (void)open
+{
+    if (_status == NSStreamStatusNotOpen) {
+        if ([_source streamStatus] == NSStreamStatusNotOpen)
+            [_source open];
+        _status = NSStreamStatusOpen;
+    }
+}
+
+- (void)close
+{
+    if (_inflating) {
+        inflateEnd(&_zstream);
+        _inflating = NO;
+    }
+    [_source close];
+    _status = NSStreamStatusClosed;
+}
+
+- (id<NSStreamDelegate>)delegate                            { return _delegate; }
+- (void)setDelegate:(id<NSStreamDelegate>)delegate          { _delegate = delegate; }
+- (id)propertyForKey:(NSString *)key                        { return nil; }
+- (BOOL)setProperty:(id)property forKey:(NSString *)key     { return NO; }
+- (void)scheduleInRunLoop:(NSRunLoop *)aRunLoop forMode:(NSString *)mode   { }
+- (void)removeFromRunLoop:(NSRunLoop *)aRunLoop forMode:(NSString *)mode   { }
+- (NSStreamStatus)streamStatus                              { return _status; }
+- (NSError *)streamError                                    { return _error; }
+
+#pragma mark - NSInputStream
+
+- (NSInteger)read:(uint8_t *)buffer maxLength:(NSUInteger)len
+{
+    if (_status == NSStreamStatusAtEnd || len == 0)
+        return 0;
+    if (_status != NSStreamStatusOpen)
+        return -1;
+    if ( ! _sniffed && ! [self sniff])
+        return -1;
+    NSInteger length = _compression == OX_COMPRESSION_NONE ? [self passThrough:buffer maxLength:len] : [self inflate:buffer maxLength:len];
+    if (length > 0) {
+        _totalOut += length;
+        if (_maxLength > 0 && _totalOut > _maxLength) {     //i.e. a small compressed bomb
+            [self failWithError:OXGzipError([NSString stringWithFormat:@"input exceeds the limit of %llu bytes", _maxLength])];
+            return -1;
+        }
+    }
+    return length;
+}
+
+- (BOOL)getBuffer:(uint8_t **)buffer length:(NSUInteger *)len
+{
+    return NO;
+}
+
+- (BOOL)hasBytesAvailable
+{
+    return _status == NSStreamStatusOpen;
+}
+
+@end
+
+
+@implementation OXGzipOutputStream
+{
+    NSOutputStream *_destination;
+    NSMutableData *_chunk;
+    z_stream _zstream;
+    int _windowBits;
+    int _level;
+    BOOL _deflating;                        //deflateInit2 succeeded, deflateEnd pending
+    NSStreamStatus _status;
+    NSError *_error;
+    __weak id<NSStreamDelegate> _delegate;
+}
+
+#pragma mark - constructors
+
+- (id)initWithDestination:(NSOutputStream *)destination compression:(OXCompressionEnum)compression level:(int)level
+{
+    if (self = [super init]) {
+        _destination = destination;
+        _windowBits = compression == OX_COMPRESSION_ZLIB ? 15 : 15 + 16;   //+16: gzip header and trailer
+        _level = level;
+        _chunk = [NSMutableData dataWithLength:OX_GZIP_CHUNK];
+        _status = NSStreamStatusNotOpen;
+    }
+    return self;
+}
+
++ (id)outputStreamWithStream:(NSOutputStream *)destination
+{
+    return [OXGzipOutputStream outputStreamWithStream:destination compression:OX_COMPRESSION_GZIP level:Z_DEFAULT_COMPRESSION];
+}
+
++ (id)outputStreamWithStream:(NSOutputStream *)destination compression:(OXCompressionEnum)compression level:(int)level
+{
+    NSAssert(destination != nil, @"ERROR: OXGzipOutputStream requires a destination stream");
+    NSAssert(compression != OX_COMPRESSION_NONE, @"ERROR: OXGzipOutputStream requires OX_COMPRESSION_GZIP or OX_COMPRESSION_ZLIB");
+    return [[OXGzipOutputStream alloc] initWithDestination:destination compression:compression level:level];
+}
+
++ (NSData *)gzipData:(NSData *)data
+{
+    NSOutputStream *memory = [NSOutputStream outputStreamToMemory];
+    OXGzipOutputStream *stream = [OXGzipOutputStream outputStreamWithStream:memory];
+    [stream open];
+    NSInteger written = [stream write:[data bytes] maxLength:[data length]];
+    [stream close];
+    return written < 0 || [stream streamError] ? nil : [memory propertyForKey:NSStreamDataWrittenToMemoryStreamKey];
+}
+
+- (void)dealloc
+{
+    if (_deflating)
+        deflateEnd(&_zstream);
+}
+
+#pragma mark - private
+
+- (void)failWithError:(NSError *)error
+{
+    _error = error;
+    _status = NSStreamStatusError;
+}
+
+- (BOOL)writeOut:(NSUInteger)length
+{
+    const uint8_t *bytes = [_chunk bytes];
+    NSUInteger offset = 0;
+    while (offset < length) {
+        NSInteger written = [_destination write:bytes + offset maxLength:length - offset];
+        if (written <= 0) {
+            [self failWithError:[_destination streamError] ? [_destination streamError] : OXGzipError(@"compressed destination write failed")];
+            return NO;
+        }
+        offset += written;
+    }
+    _totalOut += length;
+    return YES;
+}
+
+//runs deflate until the input is consumed, or for Z_FINISH until the trailer is out
+- (BOOL)deflate:(int)flush
+{
+    int status;
+    do {
+        _zstream.next_out = [_chunk mutableBytes];
+        _zstream.avail_out = OX_GZIP_CHUNK;
+        status = deflate(&_zstream, flush);
+        if (status == Z_STREAM_ERROR) {
+            [self failWithError:OXGzipError(@"deflate failed")];
+            return NO;
+        }
+        if ( ! [self writeOut:OX_GZIP_CHUNK - _zstream.avail_out])
+            return NO;
+    } while (flush == Z_FINISH ? status != Z_STREAM_END : _zstream.avail_out == 0);
+    return YES;
+}
+
+#pragma mark - NSStream
+
+- (void)open
+{
+    if (_status == NSStreamStatusNotOpen) {
+        if ([_destination streamStatus] == NSStreamStatusNotOpen)
+            [_destination open];
+        if (deflateInit2(&_zstream, _level, Z_DEFLATED, _windowBits, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+            [self failWithError:OXGzipError(@"deflateInit2 failed")];
+            return;
+        }
+        _deflating = YES;
+        _status = NSStreamStatusOpen;
+    }
+}
+
+- (void)close
+{
+    if (_deflating) {
+        if (_status == NSStreamStatusOpen) {
+            _zstream.next_in = Z_NULL;
+            _zstream.avail_in = 0;
+            [self deflate:Z_FINISH];
+        }
+        deflateEnd(&_zstream);
+        _deflating = NO;
+    }
+    [_destination close];
+    if (_status != NSStreamStatusError)
+        _status = NSStreamStatusClosed;
+}
+
+- (id<NSStreamDelegate>)delegate                            { return _delegate; }
+- (void)setDelegate:(id<NSStreamDelegate>)delegate          { _delegate = delegate; }
+- (id)propertyForKey:(NSString *)key                        { return nil; }
+- (BOOL)setProperty:(id)property forKey:(NSString *)key     { return NO; }
+- (void)scheduleInRunLoop:(NSRunLoop *)aRunLoop forMode:(NSString *)mode   { }
+- (void)removeFromRunLoop:(NSRunLoop *)aRunLoop forMode:(NSString *)mode   { }
+- (NSStreamStatus)streamStatus                              { return _status; }
+- (NSError *)streamError                                    { return _error; }
+
+#pragma mark - NSOutputStream
+
+- (NSInteger)write:(const uint8_t *)buffer maxLength:(NSUInteger)len
+{
+    if (_status != NSStreamStatusOpen)
+        return -1;
+    NSUInteger offset = 0;
+    while (offset < len) {                  //avail_in is 32 bits
+        const uInt count = (uInt)MIN(len - offset, (NSUInteger)UINT_MAX);
+        _zstream.next_in = (Bytef *)buffer + offset;
+        _zstream.avail_in = count;
+        if ( ! [self deflate:Z_NO_FLUSH])
+            return -1;
+        offset += count;
+    }
+    _totalIn += len;
+    return len;
+}
+
+- (BOOL)hasSpaceAvailable
+{
+    return _status == NSStreamStatusOpen;
+}
+
+@end
+
+//
+//  Copyright (c) 2013 Outsource Cafe, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
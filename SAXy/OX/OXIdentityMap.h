@@ -0,0 +1,77 @@
+/**
+
+  OXIdentityMap.h
+  SAXy OX - Object-to-XML mapping library
+
+  Opt-in merge-reading into an existing object graph.  Clients polling the same feed usually receive mostly unchanged
+  items, so instead of replacing the previous graph, assign an identity map to OXContext.identityMap and the readers
+  will resolve each completed object against the previous result:
+
+    * known identity   - changed mapped properties are copied onto the existing instance, which replaces the new one
+    * unknown identity - the new instance is kept and registered
+    * not read again   - the existing instance is reported as removed and unregistered
+
+  Identities are declared per class with a key property, just like dictionaryKeyName, and apply to subclasses too.
+  Nested objects without an identity key are merged property-by-property (mapped properties only) into the existing
+  child instance, so untouched sub-graphs are left alone.  Identity keys usually arrive in child elements, so objects
+  are resolved when they are complete rather than in their factories; when an objectPool is assigned the discarded
+  duplicates are recycled, after the values moved onto the existing instance are detached from them.
+
+  Usage:
+    OXIdentityMap *identityMap = [[OXIdentityMap identityMap] key:@"itemId" forClass:[Item class]];
+    identityMap.root = previousResult;              //optional, index an existing graph
+    reader.context.identityMap = identityMap;
+    NSArray *items = [reader readXmlText:xml];      //same Item instances as previousResult where itemId matches
+    for(Item *item in identityMap.changed) ...      //skip downstream work for unchanged items
+
+  Changes are applied in place during the read, so a read that fails part way leaves the changed instances updated.
+  Lazily decoded properties are not merged.  Not thread safe, use one identity map per context (i.e. per reader).
+
+  Created by agent on 10/19/26.
+
+ */
+#import <Foundation/Foundation.h>
+@class OXContext;
+@class OXComplexMapper;
+
+
+@interface OXIdentityMap : NSObject
+
+@property(strong,nonatomic,readwrite)id root;                       //current graph, indexed when assigned, replaced by the result of each merge-read
+@property(strong,nonatomic,readonly)NSArray *created;               //last read: instances with a new identity
+@property(strong,nonatomic,readonly)NSArray *changed;               //last read: existing instances with at least one changed property
+@property(strong,nonatomic,readonly)NSArray *removed;               //last read: previously indexed instances that were not read again
+@property(assign,nonatomic,readonly)NSUInteger unchangedCount;      //last read: existing instances left untouched
+
+#pragma mark - constructors
++ (id)identityMap;
+
+#pragma mark - builder
+- (OXIdentityMap *)key:(NSString *)keyName forClass:(Class)type;   //identity property (or key path) of type and its subclasses
+
+#pragma mark - lookup
+- (id)objectOfClass:(Class)type withKey:(id)keyValue;
+- (NSUInteger)count;                                                //number of indexed instances
+
+#pragma mark - merging (called by readers)
+- (void)beginMerge;                                                 //clears last read statistics
+- (id)merge:(id)object mapper:(OXComplexMapper *)mapper context:(OXContext *)ctx;    //returns existing instance or object
+- (void)endMerge:(id)result;                                        //nil result for a failed read, unregisters the objects it created
+
+@end
+
+//
+//  Copyright (c) 2013 Outsource Cafe, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
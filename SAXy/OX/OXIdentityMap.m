@@ -0,0 +1,296 @@
+//
+//  OXIdentityMap.m
+//  SAXy OX - Object-to-XML mapping library
+//
+//  Created by agent on 10/19/26.
+//
+
+#import "OXIdentityMap.h"
+#import "OXType.h"
+#import "OXProperty.h"
+#import "OXUtil.h"
+#import "OXContext.h"
+#import "OXComplexMapper.h"
+#import <objc/runtime.h>
+
+#define OX_MAX_MERGE_DEPTH 8    //nested value objects merged in place, deeper ones are simply replaced
+
+
+@implementation OXIdentityMap
+{
+    NSMutableDictionary *_keyNameByClass;       //identity property names keyed by declaring Class
+    NSMutableDictionary *_keyClassByClass;      //declaring Class (or NSNull) keyed by instance Class
+    NSMutableDictionary *_instancesByClass;     //NSMutableDictionary of instances by key value, keyed by declaring Class
+    NSMapTable *_namesByMapper;                 //mapped property names keyed by (weak) mapper
+    NSMapTable *_mapperByClass;                 //(weak) mapper that last read each class, used for nested value merges
+    NSHashTable *_seen;                         //instances created or matched by the current read
+    NSMutableArray *_createdObjects;
+    NSMutableArray *_changedObjects;
+    NSMutableArray *_replacedObjects;           //existing instances replaced by an instance of another class
+    NSArray *_removedObjects;
+    BOOL _merging;
+}
+
+#pragma mark - constructors
+
+- (id)init
+{
+    if (self = [super init]) {
+        _keyNameByClass = [NSMutableDictionary dictionary];
+        _keyClassByClass = [NSMutableDictionary dictionary];
+        _instancesByClass = [NSMutableDictionary dictionary];
+        _namesByMapper = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsWeakMemory|NSPointerFunctionsObjectPointerPersonality
+                                               valueOptions:NSPointerFunctionsStrongMemory];
+        _mapperByClass = [NSMapTable strongToWeakObjectsMapTable];
+        _seen = [NSHashTable hashTableWithOptions:NSPointerFunctionsObjectPointerPersonality];
+    }
+    return self;
+}
+
++ (id)identityMap
+{
+    return [[OXIdentityMap alloc] init];
+}
+
+#pragma mark - builder
+
+- (OXIdentityMap *)key:(NSString *)keyName forClass:(Class)type
+{
+    NSAssert2(keyName && type, @"ERROR: identity key (%@) and class (%@) are required", keyName, NSStringFromClass(type));
+    [_keyNameByClass setObject:keyName forKey:(id<NSCopying>)type];
+    [_keyClassByClass removeAllObjects];
+    return self;
+}
+
+#pragma mark - utility
+
+- (Class)keyClassForClass:(Class)type
+{
+    id keyClass = [_keyClassByClass objectForKey:type];
+    if (keyClass == nil) {
+        keyClass = [NSNull null];
+        for(Class c = type; c != nil; c = class_getSuperclass(c)) {
+            if ([_keyNameByClass objectForKey:c]) {
+                keyClass = c;
+                break;
+            }
+        }
+        [_keyClassByClass setObject:keyClass forKey:(id<NSCopying>)type];
+    }
+    return keyClass == [NSNull null] ? nil : keyClass;
+}
+
+- (id)keyValueOf:(id)object keyClass:(Class)keyClass
+{
+    return [object valueForKeyPath:[_keyNameByClass objectForKey:keyClass]];
+}
+
+- (NSMutableDictionary *)instancesForKeyClass:(Class)keyClass
+{
+    NSMutableDictionary *instances = [_instancesByClass objectForKey:keyClass];
+    if (instances == nil) {
+        instances = [NSMutableDictionary dictionary];
+        [_instancesByClass setObject:instances forKey:(id<NSCopying>)keyClass];
+    }
+    return instances;
+}
+
+- (BOOL)isValueObject:(id)object
+{
+    Class type = [object class];
+    return ! [OXUtil knownSimpleType:type] && ! [OXUtil knownCollectionType:type] && [self keyClassForClass:type] == nil;
+}
+
+//properties owned by the mapper, other properties of the existing instance are left alone
+- (NSArray *)propertyNamesForMapper:(OXComplexMapper *)mapper ofClass:(Class)type
+{
+    if (mapper == nil)
+        return [[OXType cachedType:type].properties allKeys];
+    NSArray *names = [_namesByMapper objectForKey:mapper];
+    if (names == nil) {
+        NSMutableOrderedSet *roots = [NSMutableOrderedSet orderedSetWithCapacity:[mapper.pathMappers count]];
+        for(OXPathMapper *pathMapper in mapper.pathMappers) {
+            if (pathMapper.toPathRoot)
+                [roots addObject:pathMapper.toPathRoot];
+        }
+        names = [roots array];
+        [_namesByMapper setObject:names forKey:mapper];
+    }
+    return names;
+}
+
+//detach: values moved into target by reference are cleared on source, so recycling source can't reset them
+- (BOOL)mergeProperties:(NSArray *)names from:(id)source into:(id)target depth:(NSUInteger)depth detach:(BOOL)detach
+{
+    BOOL changed = NO;
+    for(NSString *name in names) {
+        id value = [source valueForKey:name];
+        id current = [target valueForKey:name];
+        if (value == current || [value isEqual:current])
+            continue;
+        if (value && current && [value class] == [current class] && depth < OX_MAX_MERGE_DEPTH && [self isValueObject:value]) {
+            NSArray *childNames = [self propertyNamesForMapper:[_mapperByClass objectForKey:[value class]] ofClass:[value class]];
+            changed = [self mergeProperties:childNames from:value into:current depth:depth+1 detach:detach] || changed;
+        } else {
+            [target setValue:value forKey:name];
+            if (detach && value && ! [OXUtil knownSimpleType:[value class]])
+                [source setValue:nil forKey:name];
+            changed = YES;
+        }
+    }
+    return changed;
+}
+
+- (void)indexGraph:(id)object visited:(NSHashTable *)visited
+{
+    if (object == nil || object == [NSNull null] || [visited containsObject:object])
+        return;
+    [visited addObject:object];
+    Class type = [object class];
+    if ([OXUtil knownCollectionType:type]) {
+        id<NSFastEnumeration> items = [object isKindOfClass:[NSDictionary class]] ? [object objectEnumerator] : object;
+        for(id item in items)
+            [self indexGraph:item visited:visited];
+    } else if ( ! [OXUtil knownSimpleType:type] ) {
+        Class keyClass = [self keyClassForClass:type];
+        id keyValue = keyClass ? [self keyValueOf:object keyClass:keyClass] : nil;
+        if (keyValue)
+            [[self instancesForKeyClass:keyClass] setObject:object forKey:keyValue];
+        for(OXProperty *property in [[OXType cachedType:type].properties objectEnumerator]) {
+            OXTypeEnum typeEnum = property.type.typeEnum;
+            if (typeEnum == OX_COMPLEX || typeEnum == OX_CONTAINER || typeEnum == OX_POLYMORPHIC)
+                [self indexGraph:[object valueForKey:property.name] visited:visited];
+        }
+    }
+}
+
+#pragma mark - properties
+
+@dynamic created;
+- (NSArray *)created
+{
+    return _createdObjects;
+}
+
+@dynamic changed;
+- (NSArray *)changed
+{
+    return _changedObjects;
+}
+
+@dynamic removed;
+- (NSArray *)removed
+{
+    return _removedObjects;
+}
+
+- (void)setRoot:(id)root
+{
+    _root = root;
+    [_instancesByClass removeAllObjects];
+    [self indexGraph:root visited:[NSHashTable hashTableWithOptions:NSPointerFunctionsObjectPointerPersonality]];
+}
+
+#pragma mark - lookup
+
+- (id)objectOfClass:(Class)type withKey:(id)keyValue
+{
+    Class keyClass = [self keyClassForClass:type];
+    return keyClass && keyValue ? [[_instancesByClass objectForKey:keyClass] objectForKey:keyValue] : nil;
+}
+
+- (NSUInteger)count
+{
+    NSUInteger count = 0;
+    for(NSDictionary *instances in [_instancesByClass objectEnumerator])
+        count += [instances count];
+    return count;
+}
+
+#pragma mark - merging
+
+- (void)beginMerge
+{
+    _createdObjects = [NSMutableArray array];
+    _changedObjects = [NSMutableArray array];
+    _replacedObjects = [NSMutableArray array];
+    _removedObjects = nil;
+    _unchangedCount = 0;
+    [_seen removeAllObjects];
+    _merging = YES;
+}
+
+- (id)merge:(id)object mapper:(OXComplexMapper *)mapper context:(OXContext *)ctx
+{
+    if (_merging && object && mapper)
+        [_mapperByClass setObject:mapper forKey:[object class]];    //nested values are merged before their parent
+    Class keyClass = (_merging && object) ? [self keyClassForClass:[object class]] : nil;
+    id keyValue = keyClass ? [self keyValueOf:object keyClass:keyClass] : nil;
+    if (keyValue == nil)
+        return object;      //no identity, merged as a value by its parent (if any)
+    NSMutableDictionary *instances = [self instancesForKeyClass:keyClass];
+    id existing = [instances objectForKey:keyValue];
+    if (existing == object) {
+        return object;
+    } else if (existing == nil || [existing class] != [object class]) {
+        if (existing)
+            [_replacedObjects addObject:existing];
+        [instances setObject:object forKey:keyValue];
+        [_seen addObject:object];
+        [_createdObjects addObject:object];
+        return object;
+    }
+    [_seen addObject:existing];
+    BOOL recycle = ctx.objectPool != nil;
+    if ([self mergeProperties:[self propertyNamesForMapper:mapper ofClass:[object class]] from:object into:existing depth:0 detach:recycle]) {
+        [_changedObjects addObject:existing];
+    } else {
+        _unchangedCount++;
+    }
+    if (recycle)
+        [ctx.objectPool recycle:object];    //duplicate no longer needed, detached from the values moved into existing
+    return existing;
+}
+
+- (void)endMerge:(id)result
+{
+    _merging = NO;
+    NSHashTable *created = [NSHashTable hashTableWithOptions:NSPointerFunctionsObjectPointerPersonality];
+    for(id object in _createdObjects)
+        [created addObject:object];
+    NSMutableArray *removed = [NSMutableArray arrayWithArray:_replacedObjects];
+    for(NSMutableDictionary *instances in [_instancesByClass objectEnumerator]) {
+        for(id keyValue in [instances allKeys]) {
+            id object = [instances objectForKey:keyValue];
+            if (result == nil ? [created containsObject:object] : ! [_seen containsObject:object]) {
+                [instances removeObjectForKey:keyValue];
+                [removed addObject:object];
+            }
+        }
+    }
+    if (result) {
+        _root = result;
+        _removedObjects = removed;
+    } else {
+        _removedObjects = nil;  //failed read, nothing was removed
+    }
+    [_seen removeAllObjects];
+}
+
+@end
+
+//
+//  Copyright (c) 2013 Outsource Cafe, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
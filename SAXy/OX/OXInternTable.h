@@ -0,0 +1,58 @@
+/**
+
+  OXInternTable.h
+  SAXy OX - Object-to-XML mapping library
+
+  Bounded string intern table.  Feeds repeat a small set of values for fields like category, language, currency or
+  media type, yet each occurrence is decoded into a new NSString.  Mark those path mappers with the isInterned builder
+  and readers will pass their string values through context.internTable, so repeated values share one instance:
+
+    [[OXmlElementMapper elementClass:[Item class]]
+        xpathMapper:[[OXmlXPathMapper xpath:@"category"] isInterned]]
+
+  Only short strings are interned and the table stops growing once maxCount values are held, so a high-cardinality
+  field marked by mistake can't turn into a leak - values are then simply passed through.  Not thread safe, use one
+  table per context (i.e. per reader).
+
+  Created by agent on 10/19/26.
+
+ */
+#import <Foundation/Foundation.h>
+
+#define OX_DEFAULT_INTERN_MAX_COUNT 1024
+#define OX_DEFAULT_INTERN_MAX_LENGTH 64
+
+
+@interface OXInternTable : NSObject
+
+@property(assign,nonatomic,readwrite)NSUInteger maxCount;           //table size limit, defaults to OX_DEFAULT_INTERN_MAX_COUNT
+@property(assign,nonatomic,readwrite)NSUInteger maxLength;          //longer strings are not interned, defaults to OX_DEFAULT_INTERN_MAX_LENGTH
+@property(assign,nonatomic,readonly)NSUInteger hits;                //values replaced by an interned instance
+@property(assign,nonatomic,readonly)NSUInteger misses;              //values not found in the table
+
+#pragma mark - constructors
++ (id)internTable;
++ (id)internTableWithMaxCount:(NSUInteger)maxCount;
+
+#pragma mark - public
+- (NSString *)intern:(NSString *)value;                             //returns the shared instance equal to value, or value itself
+- (NSUInteger)count;                                                //number of interned values
+- (void)drain;                                                      //release all interned values
+
+@end
+
+//
+//  Copyright (c) 2013 Outsource Cafe, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
@@ -0,0 +1,88 @@
+//
+//  OXInternTable.m
+//  SAXy OX - Object-to-XML mapping library
+//
+//  Created by agent on 10/19/26.
+//
+
+#import "OXInternTable.h"
+
+
+@implementation OXInternTable
+{
+    NSMutableSet *_values;
+}
+
+#pragma mark - constructors
+
+- (id)initWithMaxCount:(NSUInteger)maxCount
+{
+    if (self = [super init]) {
+        _maxCount = maxCount;
+        _maxLength = OX_DEFAULT_INTERN_MAX_LENGTH;
+        _values = [NSMutableSet setWithCapacity:MIN(maxCount, 64)];
+    }
+    return self;
+}
+
+- (id)init
+{
+    return [self initWithMaxCount:OX_DEFAULT_INTERN_MAX_COUNT];
+}
+
++ (id)internTable
+{
+    return [[OXInternTable alloc] init];
+}
+
++ (id)internTableWithMaxCount:(NSUInteger)maxCount
+{
+    return [[OXInternTable alloc] initWithMaxCount:maxCount];
+}
+
+#pragma mark - public
+
+- (NSString *)intern:(NSString *)value
+{
+    if (value == nil || [value length] > _maxLength)
+        return value;
+    NSString *interned = [_values member:value];
+    if (interned) {
+        _hits++;
+        return interned;
+    }
+    _misses++;
+    if ([_values count] >= _maxCount)
+        return value;           //full, pass through
+    interned = [value copy];    //parser text may be mutable
+    [_values addObject:interned];
+    return interned;
+}
+
+- (NSUInteger)count
+{
+    return [_values count];
+}
+
+- (void)drain
+{
+    [_values removeAllObjects];
+}
+
+@end
+
+//
+//  Copyright (c) 2013 Outsource Cafe, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
@@ -0,0 +1,64 @@
+/**
+
+  OXLazyArray.h
+  SAXy OX - Object-to-XML mapping library
+
+  Deferred materialization of mapped sub-trees.  When a container or complex property mapping is marked 'lazy', readers
+  don't build the child objects.  They capture the raw source of each sub-tree instead: an NSJSONSerialization value for
+  JSON, or a recorded list of SAX events for XML.  A stand-in is then assigned to the property:
+
+    OXLazyArray   - immutable NSArray, decodes items individually on first access via objectAtIndex:
+    OXLazyProxy   - NSProxy for a single complex value, decodes its target on the first message it receives
+
+  Decoded values are cached, so each sub-tree is decoded at most once, and decoding is locked so stand-ins can be read
+  from several threads.  Copying an OXLazyArray returns the same instance, so copy properties keep it lazy.  The decoder
+  block retains the mapper and a snapshot of the reader's context settings, not the reader itself.
+
+  Created by agent on 10/19/26.
+
+ */
+#import <Foundation/Foundation.h>
+#import "OXBlockDef.h"
+
+
+@interface OXLazyArray : NSArray
+
+@property(assign,nonatomic,readonly)NSUInteger decodedCount;               //number of items decoded so far
+
+#pragma mark - constructors
++ (id)lazyArrayWithSources:(NSArray *)sources decoder:(OXLazyDecoderBlock)decoder;
+
+#pragma mark - public
+- (void)addSource:(id)source;                                               //used by readers while building the array
+- (BOOL)isDecodedAtIndex:(NSUInteger)index;
+
+@end
+
+
+@interface OXLazyProxy : NSProxy
+
+@property(assign,nonatomic,readonly)BOOL isDecoded;
+
+#pragma mark - constructors
++ (id)proxyWithSource:(id)source decoder:(OXLazyDecoderBlock)decoder;
+
+#pragma mark - public
+- (id)lazyTarget;                                                           //decoded target, decodes on first call
+
+@end
+
+//
+//  Copyright (c) 2013 Outsource Cafe, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
@@ -0,0 +1,247 @@
+//
+//  OXLazyArray.m
+//  SAXy OX - Object-to-XML mapping library
+//
+//  Created by agent on 10/19/26.
+//
+
+#import "OXLazyArray.h"
+#include <pthread.h>
+
+
+#pragma mark - OXLazyArray
+
+
+static id _pendingItem;     //placeholder for items not yet decoded
+
+
+@implementation OXLazyArray
+{
+    NSMutableArray *_sources;
+    NSMutableArray *_items;
+    OXLazyDecoderBlock _decoder;
+    pthread_mutex_t _lock;                      //recursive, items may be decoded from several threads
+}
+
+static void OXInitRecursiveLock(pthread_mutex_t *lock)
+{
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(lock, &attr);
+    pthread_mutexattr_destroy(&attr);
+}
+
++ (void)initialize
+{
+    if (_pendingItem == nil)
+        _pendingItem = [[NSObject alloc] init];
+}
+
+#pragma mark - constructors
+
+- (id)initWithSources:(NSArray *)sources decoder:(OXLazyDecoderBlock)decoder
+{
+    if (self = [super init]) {
+        _decoder = [decoder copy];
+        _sources = sources ? [sources mutableCopy] : [NSMutableArray array];
+        _items = [NSMutableArray arrayWithCapacity:[_sources count]];
+        for(NSUInteger i=0;i<[_sources count];i++)
+            [_items addObject:_pendingItem];
+        OXInitRecursiveLock(&_lock);
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    pthread_mutex_destroy(&_lock);
+}
+
++ (id)lazyArrayWithSources:(NSArray *)sources decoder:(OXLazyDecoderBlock)decoder
+{
+    return [[OXLazyArray alloc] initWithSources:sources decoder:decoder];
+}
+
+#pragma mark - NSArray primitives
+
+- (NSUInteger)count
+{
+    pthread_mutex_lock(&_lock);
+    NSUInteger count = [_items count];
+    pthread_mutex_unlock(&_lock);
+    return count;
+}
+
+- (id)objectAtIndex:(NSUInteger)index
+{
+    pthread_mutex_lock(&_lock);
+    id item = nil;
+    @try {
+        item = [_items objectAtIndex:index];
+        if (item == _pendingItem) {
+            item = _decoder([_sources objectAtIndex:index]);
+            if (item == nil)
+                item = [NSNull null];   //NSArray can't hold nil
+            [_items replaceObjectAtIndex:index withObject:item];
+            [_sources replaceObjectAtIndex:index withObject:[NSNull null]];    //release source data once decoded
+            _decodedCount++;
+        }
+    } @finally {
+        pthread_mutex_unlock(&_lock);
+    }
+    return item;
+}
+
+#pragma mark - NSCopying
+
+//immutable as far as clients are concerned, so copy (property) setters keep the lazy array rather than decoding it
+- (id)copyWithZone:(NSZone *)zone
+{
+    return self;
+}
+
+#pragma mark - public
+
+- (void)addSource:(id)source
+{
+    pthread_mutex_lock(&_lock);
+    [_sources addObject:source];
+    [_items addObject:_pendingItem];
+    pthread_mutex_unlock(&_lock);
+}
+
+- (BOOL)isDecodedAtIndex:(NSUInteger)index
+{
+    pthread_mutex_lock(&_lock);
+    BOOL decoded = [_items objectAtIndex:index] != _pendingItem;
+    pthread_mutex_unlock(&_lock);
+    return decoded;
+}
+
+@end
+
+
+#pragma mark - OXLazyProxy
+
+
+@implementation OXLazyProxy
+{
+    id _source;
+    id _target;
+    OXLazyDecoderBlock _decoder;
+    pthread_mutex_t _lock;
+}
+
+#pragma mark - constructors
+
+- (id)initWithSource:(id)source decoder:(OXLazyDecoderBlock)decoder
+{
+    _source = source;
+    _decoder = [decoder copy];
+    _isDecoded = NO;
+    OXInitRecursiveLock(&_lock);
+    return self;
+}
+
+- (void)dealloc
+{
+    pthread_mutex_destroy(&_lock);
+}
+
++ (id)proxyWithSource:(id)source decoder:(OXLazyDecoderBlock)decoder
+{
+    return [[OXLazyProxy alloc] initWithSource:source decoder:decoder];
+}
+
+#pragma mark - public
+
+- (id)lazyTarget
+{
+    pthread_mutex_lock(&_lock);
+    @try {
+        if (!_isDecoded) {
+            _target = _decoder(_source);
+            _isDecoded = YES;
+            _source = nil;
+            _decoder = nil;
+        }
+    } @finally {
+        pthread_mutex_unlock(&_lock);
+    }
+    return _target;
+}
+
+#pragma mark - forwarding
+
+- (id)forwardingTargetForSelector:(SEL)selector
+{
+    return [self lazyTarget];
+}
+
+- (NSMethodSignature *)methodSignatureForSelector:(SEL)selector
+{
+    id target = [self lazyTarget];
+    return target ? [target methodSignatureForSelector:selector] : [NSObject instanceMethodSignatureForSelector:@selector(init)];
+}
+
+- (void)forwardInvocation:(NSInvocation *)invocation
+{
+    [invocation setTarget:[self lazyTarget]];   //a nil target behaves like messaging nil
+    [invocation invoke];
+}
+
+#pragma mark - NSObject protocol
+
+- (BOOL)isKindOfClass:(Class)aClass
+{
+    return [[self lazyTarget] isKindOfClass:aClass];
+}
+
+- (BOOL)isMemberOfClass:(Class)aClass
+{
+    return [[self lazyTarget] isMemberOfClass:aClass];
+}
+
+- (BOOL)conformsToProtocol:(Protocol *)aProtocol
+{
+    return [[self lazyTarget] conformsToProtocol:aProtocol];
+}
+
+- (BOOL)respondsToSelector:(SEL)selector
+{
+    return [[self lazyTarget] respondsToSelector:selector];
+}
+
+- (BOOL)isEqual:(id)object
+{
+    return [[self lazyTarget] isEqual:object];
+}
+
+- (NSUInteger)hash
+{
+    return [[self lazyTarget] hash];
+}
+
+- (NSString *)description
+{
+    return [[self lazyTarget] description];
+}
+
+@end
+
+//
+//  Copyright (c) 2013 Outsource Cafe, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
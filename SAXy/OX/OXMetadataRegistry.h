@@ -0,0 +1,56 @@
+/**
+
+  OXMetadataRegistry.h
+  SAXy OX - Object-to-XML mapping library
+
+  Process-wide, thread-safe access to the mapping metadata shared by all mappers:
+
+    * OXType       - one cached instance per Class (see OXType cachedType:), holding the reflected OXProperty table
+    * accessors    - generated direct access blocks keyed by Class (see OXGeneratedMapping)
+    * mappers      - OXmlMapper and OXJSONMapper instances configure themselves once, under a lock, on first use
+
+  By default all of this is resolved lazily, so the first read or write after launch pays for self reflection and
+  mapper configuration inline.  Call warmUp: at process start to move that work to a background queue:
+
+    [OXMetadataRegistry warmUp:@[ xmlMapper, jsonMapper, [Invoice class] ]];
+
+  Mapper items contribute their mapped classes only: warm-up reflects the type metadata, but never configures a
+  shared mapper, since configuration binds the mapper to a context and a throwaway one would race the readers'
+  own.  Readers that start before warm-up finishes are safe, OXType reflects each class once under its own lock.
+
+  Created by agent on 10/19/26.
+
+ */
+#import <Foundation/Foundation.h>
+@class OXType;
+@class OXProperty;
+
+
+@interface OXMetadataRegistry : NSObject
+
+#pragma mark - lookup
++ (OXType *)typeForClass:(Class)type;                                           //same as OXType cachedType:
++ (OXProperty *)property:(NSString *)name ofClass:(Class)type;
+
+#pragma mark - warm-up
++ (void)warmUp:(NSArray *)items;                                                //Class, OXmlMapper or OXJSONMapper instances, resolved in the background
++ (void)warmUp:(NSArray *)items completion:(void (^)(NSArray *errors))completion;  //completion called on the background queue, errors is nil on success
++ (NSArray *)warmUpNow:(NSArray *)items;                                        //synchronous, returns nil - mapper configuration errors surface on first read
+
+@end
+
+//
+//  Copyright (c) 2013 Outsource Cafe, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
@@ -0,0 +1,102 @@
+//
+//  OXMetadataRegistry.m
+//  SAXy OX - Object-to-XML mapping library
+//
+//  Created by agent on 10/19/26.
+//
+
+#import "OXMetadataRegistry.h"
+#import "OXType.h"
+#import "OXProperty.h"
+#import "OXUtil.h"
+#import "OXmlMapper.h"
+#import "OXJSONMapper.h"
+#import <objc/runtime.h>
+
+
+@implementation OXMetadataRegistry
+
+#pragma mark - lookup
+
++ (OXType *)typeForClass:(Class)type
+{
+    return [OXType cachedType:type];
+}
+
++ (OXProperty *)property:(NSString *)name ofClass:(Class)type
+{
+    return name ? [[OXType cachedType:type].properties objectForKey:name] : nil;
+}
+
+#pragma mark - warm-up
+
+//reflect the class and every complex class reachable through its properties
++ (void)resolveClass:(Class)type visited:(NSMutableSet *)visited
+{
+    if (type == nil || [visited containsObject:type] || [OXUtil knownSimpleType:type] || [OXUtil knownCollectionType:type])
+        return;
+    [visited addObject:type];
+    OXType *oxType = [OXType cachedType:type];
+    if (oxType.typeEnum != OX_COMPLEX)
+        return;
+    for(OXProperty *property in [oxType.properties objectEnumerator]) {
+        if (property.type.typeEnum == OX_COMPLEX) {
+            [self resolveClass:property.type.type visited:visited];
+        } else if (property.type.typeEnum == OX_CONTAINER) {
+            [self resolveClass:property.type.containerChildType.type visited:visited];
+        }
+    }
+}
+
++ (NSArray *)warmUpNow:(NSArray *)items
+{
+    NSMutableSet *visited = [NSMutableSet set];
+    for(id item in items) {
+        if (class_isMetaClass(object_getClass(item))) {
+            [self resolveClass:item visited:visited];
+        } else if ([item isKindOfClass:[OXmlMapper class]] || [item isKindOfClass:[OXJSONMapper class]]) {
+            //only the shared type metadata is warmed, mappers are left for the first reader to configure with its own context
+            for(Class type in [item mappedClasses]) {
+                [self resolveClass:type visited:visited];
+            }
+        } else {
+            NSAssert1(NO, @"ERROR: warmUp: expects Class, OXmlMapper or OXJSONMapper items, not %@", item);
+        }
+    }
+    return nil;     //reflection reports no errors, configuration errors surface from the reader's own configure:
+}
+
++ (void)warmUp:(NSArray *)items completion:(void (^)(NSArray *errors))completion
+{
+    NSArray *snapshot = [items copy];
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_LOW, 0), ^{
+        @autoreleasepool {
+            NSArray *errors = [self warmUpNow:snapshot];
+            if (completion)
+                completion(errors);
+        }
+    });
+}
+
++ (void)warmUp:(NSArray *)items
+{
+    [self warmUp:items completion:nil];
+}
+
+@end
+
+//
+//  Copyright (c) 2013 Outsource Cafe, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
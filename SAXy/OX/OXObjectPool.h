@@ -0,0 +1,68 @@
+/**
+
+  OXObjectPool.h
+  SAXy OX - Object-to-XML mapping library
+
+  Opt-in recycling of factory-created domain objects.  High-frequency readers of small messages spend a noticeable
+  share of their time in alloc/dealloc, so a pool can be assigned to OXContext.objectPool, in which case the default
+  mapper factories will reuse idle instances rather than allocating new ones.
+
+  Only classes adopting the OXReusable protocol are pooled, because SAXy can't know what state a domain object holds
+  beyond its mapped properties.  The prepareForReuse hook is called when an instance is returned to the pool, so idle
+  instances don't retain stale sub-graphs.
+
+  Usage:
+    context.objectPool = [OXObjectPool pool];
+    id result = [reader readXmlText:xml];
+    ...
+    [reader recycle:result];    //hand the graph back when you're done with it
+
+  Not thread safe, use one pool per context (i.e. per reader).
+
+  Created by agent on 10/19/26.
+
+ */
+#import <Foundation/Foundation.h>
+
+
+@protocol OXReusable
+
+- (void)prepareForReuse;                                            //clear all state, called before an instance enters the pool
+
+@end
+
+
+@interface OXObjectPool : NSObject
+
+@property(assign,nonatomic,readwrite)NSUInteger maxPerClass;        //idle instances retained per class, defaults to 64
+@property(assign,nonatomic,readonly)NSUInteger hits;                //factory requests satisfied from the pool
+@property(assign,nonatomic,readonly)NSUInteger misses;              //factory requests that required a new instance
+
+#pragma mark - constructors
++ (id)pool;
++ (id)poolWithMaxPerClass:(NSUInteger)maxPerClass;
+
+#pragma mark - public
+- (id)instanceOfClass:(Class)type;                                  //returns a pooled instance or a new [[type alloc] init]
+- (BOOL)recycle:(id)object;                                         //return single instance to pool, YES if accepted (must be OXReusable)
+- (NSUInteger)recycleGraph:(id)root;                                //walk graph via self-reflection, recycle OXReusable instances, returns count
+- (NSUInteger)countForClass:(Class)type;                            //number of idle instances of type
+- (void)drain;                                                      //release all idle instances
+
+@end
+
+//
+//  Copyright (c) 2013 Outsource Cafe, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
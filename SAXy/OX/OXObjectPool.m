@@ -0,0 +1,142 @@
+//
+//  OXObjectPool.m
+//  SAXy OX - Object-to-XML mapping library
+//
+//  Created by agent on 10/19/26.
+//
+
+#import "OXObjectPool.h"
+#import "OXType.h"
+#import "OXProperty.h"
+#import "OXUtil.h"
+
+#define OX_DEFAULT_POOL_SIZE 64
+
+
+@implementation OXObjectPool
+{
+    NSMutableDictionary *_idleByClass;      //NSMutableArray of idle instances keyed by Class
+}
+
+#pragma mark - constructors
+
+- (id)initWithMaxPerClass:(NSUInteger)maxPerClass
+{
+    if (self = [super init]) {
+        _maxPerClass = maxPerClass;
+        _idleByClass = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+- (id)init
+{
+    return [self initWithMaxPerClass:OX_DEFAULT_POOL_SIZE];
+}
+
++ (id)pool
+{
+    return [[OXObjectPool alloc] init];
+}
+
++ (id)poolWithMaxPerClass:(NSUInteger)maxPerClass
+{
+    return [[OXObjectPool alloc] initWithMaxPerClass:maxPerClass];
+}
+
+#pragma mark - public
+
+- (id)instanceOfClass:(Class)type
+{
+    NSMutableArray *idle = [_idleByClass objectForKey:type];
+    id instance = [idle lastObject];
+    if (instance) {
+        [idle removeLastObject];
+        _hits++;
+        return instance;
+    } else {
+        _misses++;
+        return [[type alloc] init];
+    }
+}
+
+- (BOOL)recycle:(id)object
+{
+    if ( ! [object conformsToProtocol:@protocol(OXReusable)] )
+        return NO;
+    Class type = [object class];
+    NSMutableArray *idle = [_idleByClass objectForKey:type];
+    if (idle == nil) {
+        idle = [NSMutableArray arrayWithCapacity:_maxPerClass];
+        [_idleByClass setObject:idle forKey:(id<NSCopying>)type];
+    }
+    if ([idle count] >= _maxPerClass)
+        return NO;
+    [object prepareForReuse];
+    [idle addObject:object];
+    return YES;
+}
+
+//collects reachable OXReusable instances, only descending through containers and other OXReusable instances
+- (void)collectReusables:(id)object into:(NSMutableArray *)reusables visited:(NSMutableSet *)visited
+{
+    if (object == nil || object == [NSNull null])
+        return;
+    NSValue *identity = [NSValue valueWithNonretainedObject:object];
+    if ([visited containsObject:identity])
+        return;
+    [visited addObject:identity];
+    Class type = [object class];
+    if ([OXUtil knownCollectionType:type]) {
+        id<NSFastEnumeration> items = [object isKindOfClass:[NSDictionary class]] ? [object objectEnumerator] : object;
+        for(id item in items)
+            [self collectReusables:item into:reusables visited:visited];
+    } else if ([object conformsToProtocol:@protocol(OXReusable)]) {
+        for(OXProperty *property in [[OXType cachedType:type].properties objectEnumerator]) {
+            OXTypeEnum typeEnum = property.type.typeEnum;
+            if (typeEnum == OX_COMPLEX || typeEnum == OX_CONTAINER || typeEnum == OX_POLYMORPHIC)
+                [self collectReusables:[object valueForKey:property.name] into:reusables visited:visited];
+        }
+        [reusables addObject:object];
+    }
+}
+
+- (NSUInteger)recycleGraph:(id)root
+{
+    NSMutableArray *reusables = [NSMutableArray array];
+    [self collectReusables:root into:reusables visited:[NSMutableSet set]];
+    NSUInteger count = 0;
+    for(id object in reusables) {   //reset only after the whole graph is walked, prepareForReuse may release sub-graphs
+        if ([self recycle:object])
+            count++;
+    }
+    return count;
+}
+
+- (NSUInteger)countForClass:(Class)type
+{
+    return [[_idleByClass objectForKey:type] count];
+}
+
+- (void)drain
+{
+    [_idleByClass removeAllObjects];
+}
+
+@end
+
+//
+//  Copyright (c) 2013 Outsource Cafe, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
@@ -65,6 +65,7 @@ typedef enum {
 @property(copy,nonatomic,readwrite)OXTransformBlock toTransform;        //optional: convert 'from' instance to 'to' instance
 @property(copy,nonatomic,readwrite)OXTransformBlock fromTransform;      //optional: convert 'to' instance to 'from' instance
 @property(strong,nonatomic,readonly)NSString *formatterName;            //applies formatter to number or date. See OXTransform registerFormatter:withName: method
+@property(strong,nonatomic,readonly)NSFormatter *formatter;             //formatterName resolved at configure time, use via OXTransform localFormatter:
 
 #pragma mark - KVC property blocks
 @property(copy,nonatomic,readwrite)OXGetterBlock getter;                //retunrs property value (usualy from parent), optionaly transformed to fromType
@@ -73,12 +74,15 @@ typedef enum {
 #pragma mark - collection blocks
 @property(copy,nonatomic,readwrite)OXEnumerationBlock enumerator;       //for collection properties, enumerates over contained instances
 @property(copy,nonatomic,readwrite)OXSetterBlock appender;              //for collection properties, appends/adds child instance to container
+@property(copy,nonatomic,readwrite)OXContainerBuilderBlock containerBuilder;  //for collection properties, builds container from all children, preferred over appender
 @property(strong,nonatomic,readwrite)NSString *dictionaryKeyName;       //for dictionary properties, identifies property to use as key
 
 #pragma mark - house keeping
 @property(assign,nonatomic,readonly)OXMapperEnum mapperEnum;            //indicates specific mapping type
 @property(assign,nonatomic,readwrite)BOOL isConfigured;                 //set to YES after configure method is called
 @property(assign,nonatomic,readwrite)BOOL virtualProperty;              //no actual property under this name
+@property(assign,nonatomic,readwrite)BOOL lazy;                         //container/complex only: readers defer decoding until first access
+@property(assign,nonatomic,readwrite)BOOL intern;                       //atomic/scalar (or their containers) only: share repeated string values via context.internTable
 @property(weak,nonatomic,readwrite)OXComplexMapper *parent;             //OXComplexMapper parent/owning instance of this path mapper
 
 #pragma mark - constructors
@@ -10,6 +10,8 @@
 #import "OXContext.h"
 #import "OXUtil.h"
 #import "OXProperty.h"
+#import "OXLazyArray.h"
+#import "OXGeneratedMapping.h"
 
 #pragma mark - OXPathMapper
 
@@ -112,10 +114,14 @@
 - (void)assignDefaultBlocks:(OXContext *)context
 {
     BOOL isComplexKVC = [_toPath rangeOfString:@"."].location != NSNotFound;
+    //ahead-of-time generated direct property access, if linked in:
+    OXSetterBlock directSetter = isComplexKVC || _virtualProperty ? nil : [OXGeneratedMapping setterForClass:_parent.toType.type property:_toPath];
+    OXGetterBlock directGetter = isComplexKVC || _virtualProperty ? nil : [OXGeneratedMapping getterForClass:_parent.toType.type property:_toPath];
     if (!_factory) {
         _factory = ^(NSString *path, OXContext *ctx) {
             OXPathMapper *mapper = ctx.currentMapper;
-            return [[mapper.toType.type alloc] init];
+            OXObjectPool *pool = ctx.objectPool;
+            return pool ? [pool instanceOfClass:mapper.toType.type] : [[mapper.toType.type alloc] init];
         };
     }
 //    if ([_toPath isEqualToString:@"address"])
@@ -123,10 +129,16 @@
     switch (self.toType.typeEnum) {
         case OX_CONTAINER: {
             //OXContainerType *containterType = (OXContainerType *)self.toType;
+            if ( ! self.appender && ! self.containerBuilder)        //custom appenders are used as-is
+                self.containerBuilder = [context.transform builderForContainer:self.toType.type];
             if ( ! self.appender)
                 self.appender = [context.transform appenderForContainer:self.toType.type];
             if ( ! self.enumerator)
                 self.enumerator = [context.transform enumerationForContainer:self.toType.type];
+            if ( ! _getter && directGetter)
+                _getter = directGetter;
+            if ( ! _setter && directSetter)
+                _setter = directSetter;
             if ( ! _getter) {
                 if (isComplexKVC) {
                     _getter = ^(NSString *key, id target, OXContext *ctx) {
@@ -167,10 +179,10 @@
         case OX_SCALAR: {
             BOOL requireTransform = _fromType ? ![_fromType.type isSubclassOfClass:[NSValue class]] : YES;  //don't complain about NSNumber mappings
             if ( ! self.toTransform && _fromType) {
-                self.toTransform = [context.transform transformerFrom:_fromType.type toScalar:self.toType.scalarEncoding];     //_fromType.type is usualy a NSString
+                self.toTransform = [context.transform transformerFrom:_fromType.type toScalarEnum:self.toType.scalarEnum];     //_fromType.type is usualy a NSString
             }
             if ( ! self.fromTransform && _fromType) {
-                self.fromTransform = [context.transform transformerScalar:_toType.scalarEncoding to:_fromType.type];
+                self.fromTransform = [context.transform transformerScalarEnum:_toType.scalarEnum to:_fromType.type];
             }
             if (requireTransform) {
                 if (!self.toTransform && !self.setter)
@@ -185,6 +197,27 @@
                 self.toTransform = [context.transform transformerFrom:_fromType.type to:_toType.type];
             if ( ! self.fromTransform && _fromType)
                 self.fromTransform = [context.transform transformerFrom:_toType.type to:_fromType.type];
+            if ( ! _setter && directSetter) {
+                if (self.toTransform) {
+                    _setter = ^(NSString *key, id value, id target, OXContext *ctx) {
+                        OXPathMapper *mapper = ctx.currentMapper;
+                        directSetter(key, mapper.toTransform(value, ctx), target, ctx);
+                    };
+                } else {
+                    _setter = directSetter;
+                }
+            }
+            if ( ! _getter && directGetter) {
+                if (self.fromTransform) {
+                    _getter = ^(NSString *key, id target, OXContext *ctx) {
+                        id value = directGetter(key, target, ctx);
+                        OXPathMapper *mapper = ctx.currentMapper;
+                        return value==nil ? nil : mapper.fromTransform(value, ctx);
+                    };
+                } else {
+                    _getter = directGetter;
+                }
+            }
             //setter method
             if ( ! _setter) {
                 if (isComplexKVC) {
@@ -247,6 +280,19 @@
             NSAssert3(NO, @"ERROR: unknown toType.typeEnum: %d for %@->%@ scalar mapping", self.toType.typeEnum, _fromType, _toType);
             break;
     }
+    if (_intern) {      //share repeated string values, before any toTransform is applied
+        if (_toType.typeEnum == OX_ATOMIC || _toType.typeEnum == OX_SCALAR) {
+            OXSetterBlock setter = _setter;
+            _setter = ^(NSString *key, id value, id target, OXContext *ctx) {
+                setter(key, [value isKindOfClass:[NSString class]] ? [ctx.internTable intern:value] : value, target, ctx);
+            };
+        } else if (_toType.typeEnum == OX_CONTAINER && self.appender) {
+            OXSetterBlock appender = self.appender;
+            self.appender = ^(NSString *key, id value, id target, OXContext *ctx) {
+                appender(key, [value isKindOfClass:[NSString class]] ? [ctx.internTable intern:value] : value, target, ctx);
+            };
+        }
+    }
 }
 
 - (NSArray *)addErrorMessage:(NSString *)errorMessage errors:(NSArray *)errors
@@ -329,6 +375,14 @@
             errors = [self addErrorMessage:[NSString stringWithFormat:@"no 'toPath' in %@.%@ property for %@ -> %@ mapping", NSStringFromClass(_parent.toType.type), self.toPathRoot, _fromPath, _toPath] errors:errors];
         }
     }
+    if (_lazy) {
+        if (_toType.typeEnum == OX_CONTAINER) {
+            if ( ! [OXLazyArray isSubclassOfClass:_toType.type] )   //lazy containers are immutable NSArrays
+                errors = [self addErrorMessage:[NSString stringWithFormat:@"lazy container property must be declared as NSArray, not %@ in %@ mapping", NSStringFromClass(_toType.type), self] errors:errors];
+        } else if (_toType.typeEnum != OX_COMPLEX) {
+            errors = [self addErrorMessage:[NSString stringWithFormat:@"lazy only applies to container and complex properties in %@ mapping", self] errors:errors];
+        }
+    }
     return errors;
 }
 
@@ -342,6 +396,8 @@
         NSAssert(context.transform != nil, @"context.transform != nil");
         errors = [self verifyToTypeUsingSelfReflection:context errors:errors];
         if (!errors) {
+            if (_formatterName && _formatter == nil)
+                _formatter = [context.transform formatterWithName:_formatterName];  //saves a lookup per value
             [self assignDefaultBlocks:context];
             _isConfigured = YES;
         }
@@ -0,0 +1,56 @@
+/**
+
+  OXPipeStream.h
+  SAXy OX - Object-to-XML mapping library
+
+  Bounded producer/consumer stream for parsing input while it is still being loaded:  a producer appends chunks on one
+  thread, a reader consumes them on another, blocking while the pipe is empty.  The producer blocks while capacity
+  bytes are queued, so a slow parser holds back the I/O instead of buffering the whole input.
+
+    * inputStreamWithURL: starts its own producer - file URLs are read in chunks on a background queue, http(s) URLs
+      are loaded by an NSURLConnection delivering to a background operation queue
+    * closing the stream, i.e. when the reader aborts parsing, stops the producer
+
+  Used by the completion-handler read methods of OXmlReader and OXJSONReader:
+
+    [reader readXmlURL:url queue:dispatch_get_main_queue() completion:^(id result, NSArray *errors) { ... }];
+
+  The stream is synchronous, run loop scheduling is ignored.
+
+  Created by agent on 10/19/26.
+
+ */
+#import <Foundation/Foundation.h>
+
+
+@interface OXPipeInputStream : NSInputStream
+
+@property(assign,nonatomic,readonly)NSUInteger capacity;           //queued bytes before appendData: blocks
+@property(assign,atomic,readonly)unsigned long long totalIn;       //bytes appended by the producer
+
++ (id)pipeWithCapacity:(NSUInteger)capacity;
++ (id)inputStreamWithURL:(NSURL *)url;                              //file, http or https URL, loading starts at once
+
+#pragma mark - producer
+- (BOOL)appendData:(NSData *)data;                                  //blocks while the pipe is full, NO once the consumer closed it
+- (void)finish;                                                     //end of input
+- (void)failWithError:(NSError *)error;                             //the next read fails with error
+
+@end
+
+
+//
+//  Copyright (c) 2013 Outsource Cafe, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
@@ -0,0 +1,254 @@
+//
+//  OXPipeStream.m
+//  SAXy OX - Object-to-XML mapping library
+//
+//  Created by agent on 10/19/26.
+//
+
+#import "OXPipeStream.h"
+
+#define OX_PIPE_CHUNK 65536                 //bytes per file read
+#define OX_PIPE_CAPACITY (4 * OX_PIPE_CHUNK)
+
+static NSError *OXPipeError(NSString *message)
+{
+    return [NSError errorWithDomain:@"com.outsourcecafe.ox" code:99 userInfo:@{NSLocalizedDescriptionKey:message}];
+}
+
+
+@interface OXPipeInputStream () <NSURLConnectionDataDelegate>
+@property(assign,atomic,readwrite)unsigned long long totalIn;
+@end
+
+@implementation OXPipeInputStream
+{
+    NSCondition *_condition;                //guards the producer state below, signaled on every change
+    NSMutableArray *_chunks;                //NSData appended by the producer, not yet read
+    NSUInteger _offset;                     //bytes of the first chunk already read
+    NSUInteger _queued;                     //unread bytes in _chunks
+    BOOL _finished;                         //end of input, set by the producer
+    BOOL _closed;                           //closed by the consumer, the producer stops
+    NSError *_producerError;
+    NSStreamStatus _status;                 //consumer side
+    NSError *_error;
+    NSURLConnection *_connection;
+    __weak id<NSStreamDelegate> _delegate;
+}
+
+#pragma mark - constructors
+
+- (id)initWithCapacity:(NSUInteger)capacity
+{
+    if (self = [super init]) {
+        _capacity = MAX(capacity, 1);
+        _condition = [[NSCondition alloc] init];
+        _chunks = [NSMutableArray array];
+        _status = NSStreamStatusNotOpen;
+    }
+    return self;
+}
+
++ (id)pipeWithCapacity:(NSUInteger)capacity
+{
+    return [[OXPipeInputStream alloc] initWithCapacity:capacity];
+}
+
++ (id)inputStreamWithURL:(NSURL *)url
+{
+    OXPipeInputStream *pipe = [OXPipeInputStream pipeWithCapacity:OX_PIPE_CAPACITY];
+    if ([url isFileURL]) {
+        NSString *path = [url path];
+        dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+            NSFileHandle *file = [NSFileHandle fileHandleForReadingAtPath:path];
+            if (file == nil) {
+                [pipe failWithError:OXPipeError([NSString stringWithFormat:@"can't open file: %@", path])];
+                return;
+            }
+            @try {
+                BOOL reading = YES;
+                while (reading) {
+                    @autoreleasepool {
+                        NSData *chunk = [file readDataOfLength:OX_PIPE_CHUNK];
+                        reading = [chunk length] > 0 && [pipe appendData:chunk];
+                    }
+                }
+                [pipe finish];
+            } @catch (NSException *e) {     //NSFileHandle raises on read errors
+                [pipe failWithError:OXPipeError([NSString stringWithFormat:@"can't read file: %@, %@", path, [e reason]])];
+            }
+            [file closeFile];
+        });
+    } else if (url) {
+        [pipe startConnection:[NSURLRequest requestWithURL:url]];
+    } else {
+        [pipe failWithError:OXPipeError(@"nil URL")];
+    }
+    return pipe;
+}
+
+#pragma mark - private
+
+- (void)startConnection:(NSURLRequest *)request
+{
+    NSOperationQueue *queue = [[NSOperationQueue alloc] init];
+    queue.maxConcurrentOperationCount = 1;  //data in order
+    _connection = [[NSURLConnection alloc] initWithRequest:request delegate:self startImmediately:NO];
+    [_connection setDelegateQueue:queue];
+    [_connection start];
+}
+
+#pragma mark - producer
+
+- (BOOL)appendData:(NSData *)data
+{
+    [_condition lock];
+    while (_queued >= _capacity && ! _closed)
+        [_condition wait];
+    const BOOL open = ! _closed;
+    if (open && [data length] > 0) {
+        [_chunks addObject:data];
+        _queued += [data length];
+        self.totalIn += [data length];
+        [_condition broadcast];
+    }
+    [_condition unlock];
+    return open;
+}
+
+- (void)finish
+{
+    [_condition lock];
+    _finished = YES;
+    [_condition broadcast];
+    [_condition unlock];
+}
+
+- (void)failWithError:(NSError *)error
+{
+    [_condition lock];
+    if (_producerError == nil)
+        _producerError = error ? error : OXPipeError(@"input failed");
+    [_condition broadcast];
+    [_condition unlock];
+}
+
+#pragma mark - NSURLConnectionDataDelegate
+
+- (void)connection:(NSURLConnection *)connection didReceiveResponse:(NSURLResponse *)response
+{
+    if ([response isKindOfClass:[NSHTTPURLResponse class]] && [(NSHTTPURLResponse *)response statusCode] >= 400) {
+        [connection cancel];
+        [self failWithError:OXPipeError([NSString stringWithFormat:@"HTTP status %ld for %@", (long)[(NSHTTPURLResponse *)response statusCode], [response URL]])];
+    }
+}
+
+- (void)connection:(NSURLConnection *)connection didReceiveData:(NSData *)data
+{
+    if ( ! [self appendData:data])
+        [connection cancel];    //reader is done
+}
+
+- (void)connection:(NSURLConnection *)connection didFailWithError:(NSError *)error
+{
+    [self failWithError:error];
+}
+
+- (void)connectionDidFinishLoading:(NSURLConnection *)connection
+{
+    [self finish];
+}
+
+#pragma mark - NSStream
+
+- (void)open
+{
+    if (_status == NSStreamStatusNotOpen)
+        _status = NSStreamStatusOpen;
+}
+
+- (void)close
+{
+    [_condition lock];
+    _closed = YES;
+    [_chunks removeAllObjects];
+    _queued = 0;
+    [_condition broadcast];
+    [_condition unlock];
+    [_connection cancel];
+    _status = NSStreamStatusClosed;
+}
+
+- (id<NSStreamDelegate>)delegate                            { return _delegate; }
+- (void)setDelegate:(id<NSStreamDelegate>)delegate          { _delegate = delegate; }
+- (id)propertyForKey:(NSString *)key                        { return nil; }
+- (BOOL)setProperty:(id)property forKey:(NSString *)key     { return NO; }
+- (void)scheduleInRunLoop:(NSRunLoop *)aRunLoop forMode:(NSString *)mode   { }
+- (void)removeFromRunLoop:(NSRunLoop *)aRunLoop forMode:(NSString *)mode   { }
+- (NSStreamStatus)streamStatus                              { return _status; }
+- (NSError *)streamError                                    { return _error; }
+
+#pragma mark - NSInputStream
+
+- (NSInteger)read:(uint8_t *)buffer maxLength:(NSUInteger)len
+{
+    if (_status == NSStreamStatusAtEnd || len == 0)
+        return 0;
+    if (_status != NSStreamStatusOpen)
+        return -1;
+    NSInteger count = 0;
+    [_condition lock];
+    while (_queued == 0 && ! _finished && _producerError == nil)
+        [_condition wait];
+    if (_producerError) {
+        _error = _producerError;
+        _status = NSStreamStatusError;
+        count = -1;
+    } else if (_queued == 0) {
+        _status = NSStreamStatusAtEnd;
+    } else {
+        while ((NSUInteger)count < len && [_chunks count] > 0) {
+            NSData *chunk = [_chunks objectAtIndex:0];
+            const NSUInteger length = MIN(len - count, [chunk length] - _offset);
+            memcpy(buffer + count, (const uint8_t *)[chunk bytes] + _offset, length);
+            count += length;
+            _offset += length;
+            if (_offset == [chunk length]) {
+                [_chunks removeObjectAtIndex:0];
+                _offset = 0;
+            }
+        }
+        _queued -= count;
+        [_condition broadcast];     //room for the producer
+    }
+    [_condition unlock];
+    return count;
+}
+
+- (BOOL)getBuffer:(uint8_t **)buffer length:(NSUInteger *)len
+{
+    return NO;
+}
+
+- (BOOL)hasBytesAvailable
+{
+    return _status == NSStreamStatusOpen;
+}
+
+@end
+
+
+//
+//  Copyright (c) 2013 Outsource Cafe, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
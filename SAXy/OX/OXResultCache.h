@@ -0,0 +1,65 @@
+/**
+
+  OXResultCache.h
+  SAXy OX - Object-to-XML mapping library
+
+  Size-bounded LRU cache of decoded result graphs, keyed by a 64-bit hash of the input bytes.  Polling and retries
+  deliver the same payload again and again, with a cache assigned to a reader repeated input costs a hash and a byte
+  compare instead of a parse:
+
+    OXResultCache *cache = [OXResultCache cacheWithCapacity:8 * 1024 * 1024];
+    cache.copyBlock = ^(id result) { return [result copy]; };      //optional, hands out private copies
+    reader.resultCache = cache;
+    Feed *feed = [reader readXmlData:data fromURL:url];             //a hit returns the graph decoded earlier
+
+  The cost of an entry is the length of its input, which is kept to confirm hash matches byte for byte.  The capacity is
+  therefore an input-byte budget, not a bound on the memory held by the decoded graphs: a small document that expands
+  into a large graph costs only its input bytes, so size the capacity with the expected expansion in mind.
+
+  Without a copyBlock every hit returns the same instances to every caller, on every thread.  Mutating a shared result
+  changes it for all later hits, so either treat results as immutable or set a copyBlock that makes (deep enough)
+  private copies.  Readers with an objectPool bypass the cache, because their callers recycle results.  A cache holds
+  the results of one mapper, use a cache per mapper.  Thread-safe, so readers on several threads can share a cache.
+
+  Created by agent on 10/19/26.
+
+ */
+#import <Foundation/Foundation.h>
+
+typedef id (^OXResultCopyBlock)(id result);
+
+
+@interface OXResultCache : NSObject
+
+@property(assign,nonatomic,readonly)NSUInteger capacity;           //budget of input bytes of the cached results, not graph memory
+@property(copy,nonatomic,readwrite)OXResultCopyBlock copyBlock;    //copies results going in and out of the cache, nil to share them
+@property(assign,atomic,readonly)NSUInteger hits;
+@property(assign,atomic,readonly)NSUInteger misses;
+@property(assign,atomic,readonly)NSUInteger evictions;             //least recently used entries removed to stay within capacity
+@property(assign,atomic,readonly)NSUInteger count;
+@property(assign,atomic,readonly)NSUInteger totalCost;
+
++ (id)cacheWithCapacity:(NSUInteger)capacity;
+
+- (id)resultForData:(NSData *)data;                                 //nil on a miss
+- (void)setResult:(id)result forData:(NSData *)data;                //ignored if data alone exceeds the capacity
+- (void)removeAllResults;                                           //counters are kept
+
+@end
+
+
+//
+//  Copyright (c) 2013 Outsource Cafe, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
@@ -0,0 +1,199 @@
+//
+//  OXResultCache.m
+//  SAXy OX - Object-to-XML mapping library
+//
+//  Created by agent on 10/19/26.
+//
+
+#import "OXResultCache.h"
+
+
+static inline uint64_t OXRotl(uint64_t x, int r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+//multiply-rotate hash over 8-byte words (xxHash64 single lane), a small fraction of the cost of parsing the bytes
+static uint64_t OXHashBytes(const uint8_t *bytes, NSUInteger length)
+{
+    const uint64_t k1 = 0x9E3779B185EBCA87ULL;
+    const uint64_t k2 = 0xC2B2AE3D27D4EB4FULL;
+    uint64_t h = 0x27D4EB2F165667C5ULL + (uint64_t)length;
+    NSUInteger i = 0;
+    for(; i + 8 <= length; i += 8) {
+        uint64_t word;
+        memcpy(&word, bytes + i, 8);
+        h ^= OXRotl(word * k2, 31) * k1;
+        h = OXRotl(h, 27) * k1 + 0x85EBCA77C2B2AE63ULL;
+    }
+    uint64_t tail = 0;
+    memcpy(&tail, bytes + i, length - i);
+    h ^= OXRotl(tail * k2, 31) * k1;
+    h ^= h >> 33;
+    h *= k2;
+    h ^= h >> 29;
+    h *= k1;
+    h ^= h >> 32;
+    return h;
+}
+
+
+#pragma mark - OXResultCacheEntry
+
+
+//cached result, linked in least recently used order - entries are owned by the dictionary, so long lists are
+//released without recursion
+@interface OXResultCacheEntry : NSObject
+@property(strong,nonatomic,readwrite)NSNumber *key;
+@property(strong,nonatomic,readwrite)NSData *data;
+@property(strong,nonatomic,readwrite)id result;
+@property(weak,nonatomic,readwrite)OXResultCacheEntry *next;       //less recently used
+@property(weak,nonatomic,readwrite)OXResultCacheEntry *previous;   //more recently used
+@end
+
+@implementation OXResultCacheEntry
+@end
+
+
+#pragma mark - OXResultCache
+
+
+@interface OXResultCache ()
+@property(assign,atomic,readwrite)NSUInteger hits;
+@property(assign,atomic,readwrite)NSUInteger misses;
+@property(assign,atomic,readwrite)NSUInteger evictions;
+@property(assign,atomic,readwrite)NSUInteger count;
+@property(assign,atomic,readwrite)NSUInteger totalCost;
+@end
+
+@implementation OXResultCache
+{
+    NSMutableDictionary *_entries;          //OXResultCacheEntry keyed by input hash
+    __weak OXResultCacheEntry *_head;       //most recently used
+    __weak OXResultCacheEntry *_tail;       //least recently used
+}
+
+#pragma mark - constructors
+
+- (id)initWithCapacity:(NSUInteger)capacity
+{
+    if (self = [super init]) {
+        _capacity = capacity;
+        _entries = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
++ (id)cacheWithCapacity:(NSUInteger)capacity
+{
+    return [[OXResultCache alloc] initWithCapacity:capacity];
+}
+
+#pragma mark - private
+
+- (void)unlink:(OXResultCacheEntry *)entry
+{
+    OXResultCacheEntry *next = entry.next;
+    if (entry.previous)
+        entry.previous.next = next;
+    else
+        _head = next;
+    if (next)
+        next.previous = entry.previous;
+    else
+        _tail = entry.previous;
+    entry.next = nil;
+    entry.previous = nil;
+}
+
+- (void)pushFront:(OXResultCacheEntry *)entry
+{
+    entry.next = _head;
+    _head.previous = entry;
+    _head = entry;
+    if (_tail == nil)
+        _tail = entry;
+}
+
+- (void)remove:(OXResultCacheEntry *)entry
+{
+    [self unlink:entry];
+    [_entries removeObjectForKey:entry.key];
+    self.totalCost -= [entry.data length];
+    self.count = [_entries count];
+}
+
+#pragma mark - public
+
+- (id)resultForData:(NSData *)data
+{
+    NSNumber *key = [NSNumber numberWithUnsignedLongLong:OXHashBytes([data bytes], [data length])];
+    id result = nil;
+    @synchronized(self) {
+        OXResultCacheEntry *entry = [_entries objectForKey:key];
+        if (entry && [entry.data isEqualToData:data]) {
+            if (entry != _head) {
+                [self unlink:entry];
+                [self pushFront:entry];
+            }
+            result = entry.result;
+            self.hits++;
+        } else {
+            self.misses++;
+        }
+    }
+    return result && _copyBlock ? _copyBlock(result) : result;
+}
+
+- (void)setResult:(id)result forData:(NSData *)data
+{
+    if (result == nil || [data length] > _capacity)
+        return;
+    OXResultCacheEntry *entry = [[OXResultCacheEntry alloc] init];
+    entry.key = [NSNumber numberWithUnsignedLongLong:OXHashBytes([data bytes], [data length])];
+    entry.data = [data copy];   //retained if immutable
+    entry.result = _copyBlock ? _copyBlock(result) : result;  //the caller may change its instance
+    @synchronized(self) {
+        OXResultCacheEntry *existing = [_entries objectForKey:entry.key];
+        if (existing)
+            [self remove:existing];
+        [_entries setObject:entry forKey:entry.key];
+        [self pushFront:entry];
+        self.totalCost += [data length];
+        while (self.totalCost > _capacity && _tail) {
+            [self remove:_tail];
+            self.evictions++;
+        }
+        self.count = [_entries count];
+    }
+}
+
+- (void)removeAllResults
+{
+    @synchronized(self) {
+        [_entries removeAllObjects];
+        _head = nil;
+        _tail = nil;
+        self.count = 0;
+        self.totalCost = 0;
+    }
+}
+
+@end
+
+
+//
+//  Copyright (c) 2013 Outsource Cafe, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
@@ -0,0 +1,75 @@
+/**
+
+  OXTranscoder.h
+  SAXy OX - Object-to-XML mapping library
+
+  Converts XML to JSON and JSON to XML using a pair of mappers declared for the same classes, without building the
+  mapped objects.  Both mappers are matched property-by-property:  an XML element or attribute is written under the
+  JSON key mapped to the same property, and vice versa.  Leaf values go through the registered OXTransform conversions
+  of both mappers (i.e. XML text -> property type -> JSON type), so the output is the same as reading into objects and
+  writing them out again, minus the objects.
+
+    * XML -> JSON is event-to-event:  SAX callbacks write JSON text directly, optionally to an NSOutputStream in
+      small chunks.  Memory use is bounded by the element depth, not the document size.  The flip side:  when a
+      streamed conversion fails part way (NO is returned), the JSON already flushed stays in the output stream and
+      is not valid JSON - write to a temporary file or memory if the consumer can't discard it.  jsonFromXmlData:
+      returns nil on error, never a partial result.
+    * JSON -> XML walks the NSJSONSerialization result and prints elements as it goes, no mapped objects are created.
+
+  Usage:
+    OXTranscoder *transcoder = [OXTranscoder transcoderWithXmlMapper:xmlMapper jsonMapper:jsonMapper];
+    NSData *json = [transcoder jsonFromXmlData:xmlData];
+    NSString *xml = [transcoder xmlFromJSONData:json prettyPrint:YES];
+
+  Limitations:  property mappers with predicates, wildcard tags or nested JSON key paths are not transcoded.  In XML,
+  repeated elements of a container must be contiguous to stream as a single JSON array - interleaved runs are reported
+  as errors instead of being merged.
+
+  Created by agent on 10/19/26.
+
+ */
+#import <Foundation/Foundation.h>
+@class OXmlMapper;
+@class OXJSONMapper;
+@class OXmlContext;
+@class OXContext;
+
+
+@interface OXTranscoder : NSObject
+
+@property(strong,nonatomic,readonly)OXmlMapper *xmlMapper;
+@property(strong,nonatomic,readonly)OXJSONMapper *jsonMapper;
+@property(strong,nonatomic,readonly)OXmlContext *xmlContext;         //XML transforms, filters and logging flags
+@property(strong,nonatomic,readonly)OXContext *jsonContext;          //JSON transforms
+@property(strong,nonatomic,readonly)NSArray *errors;                //NSError list of the last conversion, nil on success
+@property(assign,nonatomic,readwrite)BOOL useTokenizer;             //parse UTF-8 data with OXmlTokenizer instead of NSXMLParser, default: NO
+@property(strong,nonatomic,readwrite)NSString *xmlHeader;           //prefix of XML output, nil by default
+
+#pragma mark - constructor
++ (id)transcoderWithXmlMapper:(OXmlMapper *)xmlMapper jsonMapper:(OXJSONMapper *)jsonMapper;
+
+#pragma mark - XML to JSON
+- (NSData *)jsonFromXmlData:(NSData *)xmlData;                                      //UTF-8 JSON, nil on error
+- (BOOL)writeJSONFromXmlData:(NSData *)xmlData toStream:(NSOutputStream *)stream;   //stream must be open, NO on error (output may be partial)
+- (BOOL)writeJSONFromXmlStream:(NSInputStream *)xmlStream toStream:(NSOutputStream *)stream;
+
+#pragma mark - JSON to XML
+- (NSString *)xmlFromJSONData:(NSData *)jsonData prettyPrint:(BOOL)prettyPrint;   //nil on error
+
+@end
+
+//
+//  Copyright (c) 2013 Outsource Cafe, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
@@ -0,0 +1,820 @@
+//
+//  OXTranscoder.m
+//  SAXy OX - Object-to-XML mapping library
+//
+//  Created by agent on 10/19/26.
+//
+
+#import "OXTranscoder.h"
+#import "OXType.h"
+#import "OXContext.h"
+#import "OXmlContext.h"
+#import "OXmlMapper.h"
+#import "OXmlElementMapper.h"
+#import "OXmlXPathMapper.h"
+#import "OXmlPrinter.h"
+#import "OXmlTokenizer.h"
+#import "OXGzipStream.h"
+#import "OXPathLite.h"
+#import "OXUtil.h"
+#import "OXJSONMapper.h"
+#import "OXJSONObjectMapper.h"
+#import "OXJSONPathMapper.h"
+#import "NSMutableArray+OXStack.h"
+
+#define OX_TRANSCODER_FLUSH_SIZE 16384      //JSON bytes buffered before writing to the output stream
+
+
+#pragma mark - OXTranscodeFrame
+
+
+typedef enum {
+    OX_TRANSCODE_OBJECT,    //complex element, written as a JSON object
+    OX_TRANSCODE_VALUE,     //atomic element, written when the element ends
+    OX_TRANSCODE_SKIP,      //unmapped element, children are still matched against the enclosing object
+    OX_TRANSCODE_IGNORE     //element without a JSON mapping, the whole sub-tree is dropped
+} OXTranscodeFrameEnum;
+
+//state of an open XML element
+@interface OXTranscodeFrame : NSObject
+@property(assign,nonatomic)OXTranscodeFrameEnum frameEnum;
+@property(strong,nonatomic)NSDictionary *namespaces;            //nsURIs in scope, keyed by prefix
+@property(strong,nonatomic)OXmlElementMapper *elementMapper;    //object frames
+@property(strong,nonatomic)OXJSONObjectMapper *objectMapper;    //object frames
+@property(strong,nonatomic)OXmlXPathMapper *xpathMapper;        //value frames
+@property(strong,nonatomic)OXJSONPathMapper *jsonMapper;        //value frames
+@property(assign,nonatomic)BOOL isItem;                         //value frames: container item
+@property(assign,nonatomic)BOOL hasMembers;                     //object frames: at least one member written
+@property(strong,nonatomic)OXJSONPathMapper *arrayMapper;       //object frames: mapper of the open JSON array, nil if none
+@property(assign,nonatomic)NSUInteger itemCount;                //object frames: items written to the open array
+@property(strong,nonatomic)NSMutableSet *closedArrays;          //object frames: mappers of arrays already written
+@end
+
+@implementation OXTranscodeFrame
+@end
+
+
+#pragma mark - OXTranscoder
+
+
+@interface OXTranscoder () <NSXMLParserDelegate>
+@end
+
+@implementation OXTranscoder
+{
+    NSMutableArray *_errorList;
+    BOOL _failed;
+    //XML -> JSON:
+    NSXMLParser *_parser;
+    OXmlTokenizer *_tokenizer;
+    NSMutableArray *_frames;
+    NSMutableData *_buffer;
+    NSOutputStream *_stream;
+    BOOL _rootObject;                   //JSON result is wrapped in an object, i.e. the root mapper has a key
+    //JSON -> XML:
+    OXmlPrinter *_printer;
+    NSString *_currentNsURI;
+    BOOL _isRoot;
+}
+
+#pragma mark - constructor
+
+- (id)initWithXmlMapper:(OXmlMapper *)xmlMapper jsonMapper:(OXJSONMapper *)jsonMapper
+{
+    if (self = [super init]) {
+        NSAssert(xmlMapper != nil && jsonMapper != nil, @"ERROR: OXTranscoder requires both an XML and a JSON mapper");
+        _xmlMapper = xmlMapper;
+        _jsonMapper = jsonMapper;
+        _xmlContext = [[OXmlContext alloc] init];
+        _jsonContext = [[OXContext alloc] init];
+    }
+    return self;
+}
+
++ (id)transcoderWithXmlMapper:(OXmlMapper *)xmlMapper jsonMapper:(OXJSONMapper *)jsonMapper
+{
+    return [[OXTranscoder alloc] initWithXmlMapper:xmlMapper jsonMapper:jsonMapper];
+}
+
+
+#pragma mark - error handling
+
+- (void)addErrorMessage:(NSString *)errorMessage
+{
+    if (_errorList == nil)
+        _errorList = [NSMutableArray array];
+    [_errorList addObject:[NSError errorWithDomain:@"com.outsourcecafe.ox" code:99 userInfo:@{NSLocalizedDescriptionKey:errorMessage}]];
+    _errors = _errorList;
+}
+
+//stops the conversion: jsonFromXmlData: returns nil, but in stream mode the chunks flushed before the failure have
+//already been written to the caller's stream, only the unflushed tail is dropped
+- (void)fail:(NSString *)errorMessage
+{
+    if (_failed)
+        return;
+    _failed = YES;
+    [self addErrorMessage:errorMessage];
+    if (_xmlContext.logReaderStack) NSLog(@"ERROR: %@", errorMessage);
+    [_parser abortParsing];
+    [_tokenizer abortParsing];
+}
+
+- (BOOL)configure
+{
+    _errorList = nil;
+    _errors = nil;
+    _failed = NO;
+    [_xmlContext reset];
+    [_jsonContext reset];
+    NSArray *xmlErrors = [_xmlMapper configure:_xmlContext];
+    NSArray *jsonErrors = [_jsonMapper configure:_jsonContext];
+    if (xmlErrors || jsonErrors) {
+        _errorList = [NSMutableArray array];
+        if (xmlErrors) [_errorList addObjectsFromArray:xmlErrors];
+        if (jsonErrors) [_errorList addObjectsFromArray:jsonErrors];
+        _errors = _errorList;
+        return NO;
+    }
+    return YES;
+}
+
+
+#pragma mark - JSON output
+
+- (void)appendBytes:(const char *)bytes
+{
+    [_buffer appendBytes:bytes length:strlen(bytes)];
+}
+
+- (void)appendString:(NSString *)string
+{
+    const char *bytes = [string UTF8String];
+    const char *run = bytes;
+    [_buffer appendBytes:"\"" length:1];
+    for(const char *c = bytes; *c; c++) {
+        const unsigned char ch = (unsigned char)*c;
+        if (ch == '"' || ch == '\\' || ch < 0x20) {
+            [_buffer appendBytes:run length:c - run];
+            switch (ch) {
+                case '"':  [self appendBytes:"\\\""]; break;
+                case '\\': [self appendBytes:"\\\\"]; break;
+                case '\n': [self appendBytes:"\\n"]; break;
+                case '\r': [self appendBytes:"\\r"]; break;
+                case '\t': [self appendBytes:"\\t"]; break;
+                default: {
+                    char escaped[8];
+                    snprintf(escaped, sizeof(escaped), "\\u%04x", ch);
+                    [self appendBytes:escaped];
+                    break;
+                }
+            }
+            run = c + 1;
+        }
+    }
+    [self appendBytes:run];
+    [_buffer appendBytes:"\"" length:1];
+}
+
+- (void)appendValue:(id)value
+{
+    if (value == nil || value == [NSNull null]) {
+        [self appendBytes:"null"];
+    } else if ([value isKindOfClass:[NSString class]]) {
+        [self appendString:value];
+    } else if ([value isKindOfClass:[NSNumber class]]) {
+        if (CFGetTypeID((__bridge CFTypeRef)value) == CFBooleanGetTypeID()) {
+            [self appendBytes:([value boolValue] ? "true" : "false")];
+        } else {
+            double d = [value doubleValue];
+            char digits[OX_NUMBER_BUFFER_SIZE];
+            if (isnan(d) || isinf(d))
+                [self appendBytes:"null"];
+            else
+                [self appendBytes:[OXUtil formatNumber:value buffer:digits] ? digits : [[value stringValue] UTF8String]];
+        }
+    } else {
+        [self appendString:[value description]];
+    }
+}
+
+- (BOOL)flush
+{
+    const uint8_t *bytes = [_buffer bytes];
+    const NSUInteger length = [_buffer length];
+    NSUInteger offset = 0;
+    while (offset < length) {
+        NSInteger written = [_stream write:bytes + offset maxLength:length - offset];
+        if (written <= 0) {
+            [self fail:[NSString stringWithFormat:@"JSON output stream write failed: %@", [[_stream streamError] localizedDescription]]];
+            return NO;
+        }
+        offset += written;
+    }
+    [_buffer setLength:0];
+    return YES;
+}
+
+//JSON key of a mapped property, nil for the document root
+- (NSString *)jsonKey:(OXJSONPathMapper *)jsonMapper
+{
+    NSString *key = jsonMapper.fromPath;
+    if ([OX_ROOT_PATH isEqualToString:key])
+        return nil;
+    if ([key rangeOfString:@"."].location != NSNotFound)
+        [self fail:[NSString stringWithFormat:@"nested JSON path '%@' of %@ can't be transcoded", key, jsonMapper]];
+    return key;
+}
+
+- (BOOL)beginMember:(NSString *)key inFrame:(OXTranscodeFrame *)frame
+{
+    if (frame.hasMembers) {
+        if (key == nil) {
+            [self fail:@"multiple root values can't be transcoded to a single JSON document"];
+            return NO;
+        }
+        [self appendBytes:","];
+    }
+    frame.hasMembers = YES;
+    if (key) {
+        [self appendString:key];
+        [self appendBytes:":"];
+    }
+    return YES;
+}
+
+- (void)closeArrayInFrame:(OXTranscodeFrame *)frame
+{
+    if (frame.arrayMapper) {
+        [self appendBytes:"]"];
+        if (frame.closedArrays == nil)
+            frame.closedArrays = [NSMutableSet set];
+        [frame.closedArrays addObject:frame.arrayMapper];
+        frame.arrayMapper = nil;
+        frame.itemCount = 0;
+    }
+}
+
+//container elements must be contiguous - an array can't be reopened once other members have been written
+- (BOOL)openArray:(OXJSONPathMapper *)jsonMapper inFrame:(OXTranscodeFrame *)frame
+{
+    if (frame.arrayMapper == jsonMapper)
+        return YES;
+    [self closeArrayInFrame:frame];
+    if ([frame.closedArrays containsObject:jsonMapper]) {
+        [self fail:[NSString stringWithFormat:@"interleaved '%@' elements can't be streamed to a single JSON array: %@", jsonMapper.fromPath, [_xmlContext tagPath]]];
+        return NO;
+    }
+    NSString *key = [self jsonKey:jsonMapper];
+    if (_failed || ! [self beginMember:key inFrame:frame])
+        return NO;
+    [self appendBytes:"["];
+    frame.arrayMapper = jsonMapper;
+    frame.itemCount = 0;
+    return YES;
+}
+
+- (void)beginItemInFrame:(OXTranscodeFrame *)frame
+{
+    if (frame.itemCount++ > 0)
+        [self appendBytes:","];
+}
+
+
+#pragma mark - XML to JSON
+
+//XML text -> property type -> JSON type, using the registered transforms of both mappers
+- (id)jsonValue:(NSString *)text xpathMapper:(OXmlXPathMapper *)xpathMapper jsonMapper:(OXJSONPathMapper *)jsonMapper
+{
+    if (text == nil)
+        return nil;
+    _xmlContext.currentMapper = xpathMapper;
+    id value = xpathMapper.toTransform ? xpathMapper.toTransform(text, _xmlContext) : text;
+    _jsonContext.currentMapper = jsonMapper;
+    return (value && jsonMapper.fromTransform) ? jsonMapper.fromTransform(value, _jsonContext) : value;
+}
+
+- (void)writeMember:(NSString *)text xpathMapper:(OXmlXPathMapper *)xpathMapper jsonMapper:(OXJSONPathMapper *)jsonMapper inFrame:(OXTranscodeFrame *)frame
+{
+    id value = [self jsonValue:text xpathMapper:xpathMapper jsonMapper:jsonMapper];
+    if (value) {
+        [self closeArrayInFrame:frame];
+        NSString *key = [self jsonKey:jsonMapper];
+        if ( ! _failed && [self beginMember:key inFrame:frame])
+            [self appendValue:value];
+    }
+}
+
+- (OXTranscodeFrame *)objectFrame
+{
+    for(OXTranscodeFrame *frame in [_frames reverseObjectEnumerator]) {
+        if (frame.frameEnum == OX_TRANSCODE_OBJECT)
+            return frame;
+    }
+    return nil;
+}
+
+- (NSDictionary *)namespaces:(NSDictionary *)namespaces declaredIn:(NSDictionary *)attributes
+{
+    NSMutableDictionary *scope = nil;
+    for(NSString *name in attributes) {
+        if ([name hasPrefix:@"xmlns"]) {
+            if (scope == nil)
+                scope = namespaces ? [namespaces mutableCopy] : [NSMutableDictionary dictionary];
+            NSString *prefix = [name length] > 6 ? [name substringFromIndex:6] : OX_DEFAULT_NAMESPACE;    //strip off xmlns:
+            [scope setObject:[attributes objectForKey:name] forKey:prefix];
+        }
+    }
+    return scope ? scope : namespaces;
+}
+
+- (void)startObject:(Class)type frame:(OXTranscodeFrame *)frame attributes:(NSDictionary *)attributes nsURI:(NSString *)nsURI
+{
+    OXmlElementMapper *elementMapper = [_xmlMapper elementMapperForClass:type];
+    OXJSONObjectMapper *objectMapper = [_jsonMapper objectMapperForClass:type];
+    if (elementMapper == nil || objectMapper == nil) {
+        [self fail:[NSString stringWithFormat:@"%@ class must be mapped in both XML and JSON mappers", NSStringFromClass(type)]];
+        return;
+    }
+    frame.frameEnum = OX_TRANSCODE_OBJECT;
+    frame.elementMapper = elementMapper;
+    frame.objectMapper = objectMapper;
+    [self appendBytes:"{"];
+    for(NSString *attrName in attributes) {
+        if ( ! [attrName hasPrefix:@"xmlns"]) {
+            NSRange colon = [attrName rangeOfString:@":"];
+            NSString *key = colon.location == NSNotFound ? attrName : [attrName substringFromIndex:colon.location + 1];
+            NSString *attrNSURI = colon.location == NSNotFound ? nsURI : [frame.namespaces objectForKey:[attrName substringToIndex:colon.location]];
+            NSString *value = _xmlContext.attributeFilterBlock(key, [attributes objectForKey:attrName]);
+            OXmlXPathMapper *attributeMapper = value ? [elementMapper attributeMapperByTag:key nsURI:attrNSURI] : nil;
+            OXJSONPathMapper *jsonMapper = attributeMapper ? [objectMapper objectMapperByProperty:attributeMapper.toPath] : nil;
+            if (jsonMapper)
+                [self writeMember:value xpathMapper:attributeMapper jsonMapper:jsonMapper inFrame:frame];
+        }
+    }
+}
+
+- (void)startProperty:(OXmlXPathMapper *)xpathMapper frame:(OXTranscodeFrame *)frame parent:(OXTranscodeFrame *)parent attributes:(NSDictionary *)attributes nsURI:(NSString *)nsURI
+{
+    OXJSONPathMapper *jsonMapper = [parent.objectMapper objectMapperByProperty:xpathMapper.toPath];
+    if (jsonMapper == nil) {
+        frame.frameEnum = OX_TRANSCODE_IGNORE;      //property not mapped in JSON
+        return;
+    }
+    if (xpathMapper.xpath.predicate) {
+        [self fail:[NSString stringWithFormat:@"predicate mappings can't be transcoded: %@", xpathMapper]];
+        return;
+    }
+    OXType *type = xpathMapper.toType;
+    switch (type.typeEnum) {
+        case OX_CONTAINER: {
+            if ( ! [self openArray:jsonMapper inFrame:parent])
+                return;
+            if (type.containerChildType.typeEnum == OX_COMPLEX) {
+                [self beginItemInFrame:parent];
+                [self startObject:type.containerChildType.type frame:frame attributes:attributes nsURI:nsURI];
+            } else {
+                frame.frameEnum = OX_TRANSCODE_VALUE;
+                frame.isItem = YES;
+            }
+            break;
+        }
+        case OX_COMPLEX: {
+            [self closeArrayInFrame:parent];
+            NSString *key = [self jsonKey:jsonMapper];
+            if ( ! _failed && [self beginMember:key inFrame:parent])
+                [self startObject:type.type frame:frame attributes:attributes nsURI:nsURI];
+            break;
+        }
+        case OX_SCALAR:
+        case OX_ATOMIC: {
+            frame.frameEnum = OX_TRANSCODE_VALUE;
+            break;
+        }
+        case OX_POLYMORPHIC:
+        default: {
+            [self fail:[NSString stringWithFormat:@"OXTranscoder does not support typeEnum:%d in mapper: %@", type.typeEnum, xpathMapper]];
+            return;
+        }
+    }
+    frame.xpathMapper = xpathMapper;
+    frame.jsonMapper = jsonMapper;
+}
+
+- (void)parser:(NSXMLParser *)parser didStartElement:(NSString *)tag namespaceURI:(NSString *)nsURI qualifiedName:(NSString *)qName attributes:(NSDictionary *)attributes
+{
+    if (_failed)
+        return;
+    OXTranscodeFrame *top = [_frames peek];
+    OXTranscodeFrame *frame = [[OXTranscodeFrame alloc] init];
+    frame.namespaces = [self namespaces:top.namespaces declaredIn:attributes];
+    frame.frameEnum = OX_TRANSCODE_SKIP;
+    NSRange colon = [tag rangeOfString:@":"];
+    NSString *elementName = colon.location == NSNotFound ? tag : [tag substringFromIndex:colon.location + 1];
+    NSString *nsPrefix = colon.location == NSNotFound ? OX_DEFAULT_NAMESPACE : [tag substringToIndex:colon.location];
+    NSString *elementNSURI = [frame.namespaces objectForKey:nsPrefix];
+    if (elementNSURI == nil)
+        elementNSURI = OX_DEFAULT_NAMESPACE;
+    [_xmlContext.pathStack push:elementName];
+    [_xmlContext clearText];
+    if (top.frameEnum == OX_TRANSCODE_VALUE || top.frameEnum == OX_TRANSCODE_IGNORE) {
+        frame.frameEnum = OX_TRANSCODE_IGNORE;
+    } else {
+        OXTranscodeFrame *parent = [self objectFrame];
+        OXmlElementMapper *parentMapper = parent.elementMapper;
+        OXmlXPathMapper *xpathMapper = [parentMapper.ignoreProperties containsObject:elementName] ? nil : [parentMapper matchPathStack:_xmlContext.pathStack forNSURI:elementNSURI];
+        if (xpathMapper)
+            [self startProperty:xpathMapper frame:frame parent:parent attributes:attributes nsURI:elementNSURI];
+    }
+    if (_xmlContext.logReaderStack) NSLog(@"start: %@ - %@", [_xmlContext tagPath], @[@"object", @"value", @"skip", @"ignore"][frame.frameEnum]);
+    [_frames push:frame];
+}
+
+- (void)parser:(NSXMLParser *)parser foundCharacters:(NSString *)text
+{
+    OXTranscodeFrame *top = [_frames peek];
+    if (top.frameEnum != OX_TRANSCODE_IGNORE)
+        [_xmlContext appendText:text];
+}
+
+- (void)parser:(NSXMLParser *)parser foundCDATA:(NSData *)CDATABlock
+{
+    [self parser:parser foundCharacters:[[NSString alloc] initWithData:CDATABlock encoding:NSUTF8StringEncoding]];
+}
+
+- (void)parser:(NSXMLParser *)parser didEndElement:(NSString *)tag namespaceURI:(NSString *)nsURI qualifiedName:(NSString *)qName
+{
+    if (_failed)
+        return;
+    OXTranscodeFrame *frame = [_frames pop];
+    NSString *elementName = [_xmlContext.pathStack peek];
+    switch (frame.frameEnum) {
+        case OX_TRANSCODE_VALUE: {
+            OXTranscodeFrame *parent = [self objectFrame];
+            NSString *text = _xmlContext.elementFilterBlock(elementName, [_xmlContext text]);
+            if (frame.isItem) {
+                id value = [self jsonValue:text xpathMapper:frame.xpathMapper jsonMapper:frame.jsonMapper];
+                if (value) {
+                    [self beginItemInFrame:parent];
+                    [self appendValue:value];
+                }
+            } else {
+                [self writeMember:text xpathMapper:frame.xpathMapper jsonMapper:frame.jsonMapper inFrame:parent];
+            }
+            break;
+        }
+        case OX_TRANSCODE_OBJECT: {
+            OXmlXPathMapper *bodyMapper = frame.elementMapper.bodyMapper;
+            OXJSONPathMapper *jsonMapper = bodyMapper ? [frame.objectMapper objectMapperByProperty:bodyMapper.toPath] : nil;
+            if (jsonMapper)
+                [self writeMember:_xmlContext.elementFilterBlock(nil, [_xmlContext text]) xpathMapper:bodyMapper jsonMapper:jsonMapper inFrame:frame];
+            [self closeArrayInFrame:frame];
+            [self appendBytes:"}"];
+            break;
+        }
+        case OX_TRANSCODE_SKIP:
+        case OX_TRANSCODE_IGNORE:
+        default:
+            break;
+    }
+    if (_xmlContext.logReaderStack) NSLog(@"  end: %@", [_xmlContext tagPath]);
+    [_xmlContext.pathStack pop];
+    [_xmlContext clearText];
+    if (_stream && [_buffer length] >= OX_TRANSCODER_FLUSH_SIZE)
+        [self flush];
+}
+
+- (void)parser:(NSXMLParser *)parser parseErrorOccurred:(NSError *)parseError
+{
+    if (_failed)
+        return;     //abortParsing reports an error, ignore it
+    [self fail:[NSString stringWithFormat:@"XML Parsing Error %li, Description: %@, Line: %li, Column: %li",
+                (long)[parseError code],
+                [parseError localizedDescription],
+                (long)(parser ? [parser lineNumber] : _tokenizer.lineNumber),
+                (long)(parser ? [parser columnNumber] : _tokenizer.columnNumber)]];
+}
+
+//exactly one of parser or tokenizer is set, both drive the same NSXMLParserDelegate callbacks
+- (BOOL)transcode:(NSXMLParser *)parser tokenizer:(OXmlTokenizer *)tokenizer toStream:(NSOutputStream *)stream
+{
+    if ( ! [self configure])
+        return NO;
+    _buffer = [NSMutableData dataWithCapacity:OX_TRANSCODER_FLUSH_SIZE];
+    _stream = stream;
+    _frames = [NSMutableArray array];
+    //the root frame maps the document to the 'result' property of both root mappers
+    OXJSONPathMapper *rootMapper = [_jsonMapper.rootMapper objectMapperByProperty:@"result"];
+    _rootObject = rootMapper != nil && ! [OX_ROOT_PATH isEqualToString:rootMapper.fromPath];
+    OXTranscodeFrame *root = [[OXTranscodeFrame alloc] init];
+    root.frameEnum = OX_TRANSCODE_OBJECT;
+    root.elementMapper = _xmlMapper.rootMapper;
+    root.objectMapper = _jsonMapper.rootMapper;
+    [_frames push:root];
+    [_xmlContext.pathStack push:OX_ROOT_PATH];
+    if (_rootObject)
+        [self appendBytes:"{"];
+    _parser = parser;
+    _tokenizer = tokenizer;
+    [parser setDelegate:self];
+    [parser setShouldResolveExternalEntities:NO];
+    tokenizer.delegate = self;
+    BOOL parsed = tokenizer ? [tokenizer parse] : [parser parse];   //if not successful, delegate is informed of error
+    _parser = nil;
+    _tokenizer = nil;
+    if (parsed && ! _failed) {
+        [self closeArrayInFrame:root];
+        if (_rootObject)
+            [self appendBytes:"}"];
+        else if ( ! root.hasMembers)
+            [self appendBytes:"null"];
+    } else if (_errors == nil) {
+        [self addErrorMessage:@"XML parsing failed"];
+    }
+    _frames = nil;
+    [_xmlContext reset];
+    if (_errors == nil && _stream)
+        [self flush];
+    _stream = nil;
+    return _errors == nil;
+}
+
+- (BOOL)transcodeData:(NSData *)xmlData toStream:(NSOutputStream *)stream
+{
+    if ([OXGzipInputStream compressionOfData:xmlData] != OX_COMPRESSION_NONE)
+        return [self transcode:[[NSXMLParser alloc] initWithStream:[OXGzipInputStream inputStreamWithData:xmlData]] tokenizer:nil toStream:stream];
+    if (_useTokenizer && [OXmlTokenizer canTokenize:xmlData])
+        return [self transcode:nil tokenizer:[OXmlTokenizer tokenizerWithData:xmlData] toStream:stream];
+    return [self transcode:[[NSXMLParser alloc] initWithData:xmlData] tokenizer:nil toStream:stream];
+}
+
+- (NSData *)jsonFromXmlData:(NSData *)xmlData
+{
+    BOOL success = [self transcodeData:xmlData toStream:nil];
+    NSData *json = success ? _buffer : nil;
+    _buffer = nil;
+    return json;
+}
+
+- (BOOL)writeJSONFromXmlData:(NSData *)xmlData toStream:(NSOutputStream *)stream
+{
+    BOOL success = [self transcodeData:xmlData toStream:stream];
+    _buffer = nil;
+    return success;
+}
+
+- (BOOL)writeJSONFromXmlStream:(NSInputStream *)xmlStream toStream:(NSOutputStream *)stream
+{
+    BOOL success = [self transcode:[[NSXMLParser alloc] initWithStream:[OXGzipInputStream inputStreamWithStream:xmlStream]] tokenizer:nil toStream:stream];    //tokenizer works on data, not streams
+    _buffer = nil;
+    return success;
+}
+
+
+#pragma mark - JSON to XML
+
+//JSON type -> property type -> XML text, using the registered transforms of both mappers
+- (NSString *)xmlValue:(id)value xpathMapper:(OXmlXPathMapper *)xpathMapper jsonMapper:(OXJSONPathMapper *)jsonMapper
+{
+    if (value == nil || value == [NSNull null])
+        return nil;
+    _jsonContext.currentMapper = jsonMapper;
+    id typed = jsonMapper.toTransform ? jsonMapper.toTransform(value, _jsonContext) : value;
+    _xmlContext.currentMapper = xpathMapper;
+    id text = (typed && xpathMapper.fromTransform) ? xpathMapper.fromTransform(typed, _xmlContext) : typed;
+    if (text == nil || [text isKindOfClass:[NSString class]])
+        return text;
+    return [text respondsToSelector:@selector(stringValue)] ? [text stringValue] : [text description];
+}
+
+- (id)json:(NSDictionary *)json valueFor:(OXJSONPathMapper *)jsonMapper
+{
+    return [json isKindOfClass:[NSDictionary class]] ? [json valueForKeyPath:jsonMapper.fromPath] : nil;
+}
+
+- (void)setNamespace:(NSString *)nsURI
+{
+    if ( ! [nsURI isEqualToString:_currentNsURI]) {
+        _currentNsURI = nsURI;
+        _printer.nsPrefix = [_currentNsURI isEqualToString:OX_DEFAULT_NAMESPACE ] ? nil : [_xmlMapper.nsByURI objectForKey:_currentNsURI];
+    }
+}
+
+- (NSArray *)attributesFromJSON:(NSDictionary *)json elementMapper:(OXmlElementMapper *)elementMapper objectMapper:(OXJSONObjectMapper *)objectMapper
+{
+    NSMutableArray *attrList = nil;
+    for(NSString *key in [elementMapper orderedAttributePropertyKeys]) {
+        OXmlXPathMapper *propertyMapper = [elementMapper attributeMapperByProperty:key];
+        OXJSONPathMapper *jsonMapper = [objectMapper objectMapperByProperty:key];
+        NSString *value = jsonMapper ? [self xmlValue:[self json:json valueFor:jsonMapper] xpathMapper:propertyMapper jsonMapper:jsonMapper] : nil;
+        if (value) {
+            if (!attrList) attrList = [NSMutableArray array];
+            NSString *nsPrefix = nil;
+            NSString *nsURI = propertyMapper.nsURI;
+            if ( ! [nsURI isEqualToString:OX_DEFAULT_NAMESPACE] && ! [nsURI isEqualToString:_currentNsURI] ) {
+                nsPrefix = [_xmlMapper.nsByURI objectForKey:nsURI];
+            }
+            NSString *tag = propertyMapper.fromPathLeaf;
+            [attrList addObject:nsPrefix ? [NSString stringWithFormat:@"%@:%@", nsPrefix, tag] : tag];
+            [attrList addObject:value];
+        }
+    }
+    return attrList;
+}
+
+- (NSArray *)rootAttributes:(NSArray *)attributes
+{
+    NSMutableArray *attrList = attributes ? [attributes mutableCopy] : [NSMutableArray array];
+    NSString *defaultNsURI = [_xmlMapper.nsByPrefix objectForKey:OX_DEFAULT_NAMESPACE];
+    if (defaultNsURI && ! [OX_DEFAULT_NAMESPACE isEqualToString:defaultNsURI]) {
+        [attrList addObject:@"xmlns"];
+        [attrList addObject:defaultNsURI];
+    }
+    for (NSString *nsPrefixKey in [_xmlMapper.nsByPrefix allKeys]) {
+        NSString *namespaceURI = [_xmlMapper.nsByPrefix objectForKey:nsPrefixKey];
+        if ( ! [nsPrefixKey isEqualToString:OX_DEFAULT_NAMESPACE] && ! [OX_DEFAULT_NAMESPACE isEqualToString:namespaceURI] ) {
+            [attrList addObject:[NSString stringWithFormat:@"xmlns:%@", nsPrefixKey]];
+            [attrList addObject:namespaceURI];
+        }
+    }
+    return [attrList count] > 0 ? attrList : nil;
+}
+
+- (void)printValue:(id)value tag:(NSString *)tag xpathMapper:(OXmlXPathMapper *)xpathMapper jsonMapper:(OXJSONPathMapper *)jsonMapper
+{
+    NSString *text = [self xmlValue:value xpathMapper:xpathMapper jsonMapper:jsonMapper];
+    if (text)
+        [_printer element:tag value:text];
+}
+
+//mirrors OXmlWriter writeElement:fromObject:elementMapper:, reading property values from the JSON dictionary
+- (void)printElement:(NSString *)elementName fromJSON:(NSDictionary *)json type:(Class)type
+{
+    OXmlElementMapper *elementMapper = type ? [_xmlMapper elementMapperForClass:type] : _xmlMapper.rootMapper;
+    OXJSONObjectMapper *objectMapper = type ? [_jsonMapper objectMapperForClass:type] : _jsonMapper.rootMapper;
+    if (elementMapper == nil || objectMapper == nil) {
+        [self fail:[NSString stringWithFormat:@"%@ class must be mapped in both XML and JSON mappers", NSStringFromClass(type)]];
+        return;
+    }
+    if ( ! [json isKindOfClass:[NSDictionary class]]) {
+        [self fail:[NSString stringWithFormat:@"JSON object expected for %@ element, not: %@", elementName, json]];
+        return;
+    }
+    if ( ! [elementMapper.nsURI isEqualToString:OX_DEFAULT_NAMESPACE])
+        [self setNamespace:elementMapper.nsURI];
+    NSArray *tags = nil;
+    if (elementName == nil) {
+        elementName = elementMapper.fromPathLeaf;
+        tags = elementMapper.xpath.tagStack;
+    } else {
+        int sepIndex = [OXUtil firstIndexOfChar:'/' inString:elementName];
+        tags = sepIndex < 0 ? @[elementName] : [[OXPathLite xpath:elementName] tagStack];
+        if ([tags count] > 1)
+            elementName = [tags lastObject];
+    }
+    BOOL rootElementSkip = [OX_ROOT_PATH isEqualToString:elementName];
+    OXmlXPathMapper *bodyMapper = elementMapper.bodyMapper;
+    OXJSONPathMapper *bodyJSONMapper = bodyMapper ? [objectMapper objectMapperByProperty:bodyMapper.toPath] : nil;
+    NSString *bodyText = bodyJSONMapper ? [self xmlValue:[self json:json valueFor:bodyJSONMapper] xpathMapper:bodyMapper jsonMapper:bodyJSONMapper] : nil;
+    NSArray *elementPropertyKeys = [elementMapper orderedElementPropertyKeys];
+    NSArray *attributes = [self attributesFromJSON:json elementMapper:elementMapper objectMapper:objectMapper];
+    BOOL isEmptyTag = (attributes == nil && bodyText == nil && elementPropertyKeys == nil);
+
+    if (!isEmptyTag || bodyMapper) {
+        for (NSString *tag in tags) {
+            BOOL isLeaf = [tag isEqualToString:elementName];
+            if ([OX_ROOT_PATH isEqualToString:tag]) {
+                _isRoot = YES;
+            } else {
+                NSArray *tagAttributes = isLeaf ? attributes : nil;
+                [_printer startTag:tag attributes:(_isRoot ? [self rootAttributes:tagAttributes] : tagAttributes) close:!isLeaf];
+                if (!isLeaf) {
+                    [_printer newLine];
+                    _printer.indent += 1;
+                }
+                _isRoot = NO;
+            }
+        }
+    }
+    if (isEmptyTag && bodyMapper) {
+        [_printer closeEmptyTag];
+        [_printer newLine];
+    } else if ([elementMapper noChildElements]) {
+        [_printer elementBody:elementName bodyText:bodyText];
+    } else {
+        if (!rootElementSkip) {
+            [_printer closeTag];
+            [_printer newLine];
+            _printer.indent += 1;
+        }
+        NSString *saveNsPrefix = _printer.nsPrefix;
+        for(NSString *elementKey in elementPropertyKeys) {
+            OXmlXPathMapper *pathMapper = [elementMapper elementMapperByProperty:elementKey];
+            OXJSONPathMapper *jsonMapper = [objectMapper objectMapperByProperty:elementKey];
+            id childData = jsonMapper ? [self json:json valueFor:jsonMapper] : nil;
+            if (childData == nil || childData == [NSNull null])
+                continue;
+            if ([@"*" isEqualToString:pathMapper.fromPathLeaf]) {
+                [self fail:[NSString stringWithFormat:@"wildcard mappings can't be transcoded: %@", pathMapper]];
+                return;
+            }
+            [self setNamespace:pathMapper.nsURI];
+            NSString *childTag = pathMapper.fromPath;
+            OXType *childType = pathMapper.toType;
+            switch (childType.typeEnum) {
+                case OX_CONTAINER: {
+                    if ( ! [childData isKindOfClass:[NSArray class]]) {
+                        [self fail:[NSString stringWithFormat:@"JSON array expected for %@ element, not: %@", childTag, childData]];
+                        return;
+                    }
+                    for(id itemData in childData) {
+                        if (childType.containerChildType.typeEnum == OX_COMPLEX)
+                            [self printElement:childTag fromJSON:itemData type:childType.containerChildType.type];
+                        else
+                            [self printValue:itemData tag:childTag xpathMapper:pathMapper jsonMapper:jsonMapper];
+                        if (_failed)
+                            return;
+                    }
+                    break;
+                }
+                case OX_COMPLEX: {
+                    [self printElement:childTag fromJSON:childData type:childType.type];
+                    break;
+                }
+                case OX_SCALAR:
+                case OX_ATOMIC: {
+                    [self printValue:childData tag:childTag xpathMapper:pathMapper jsonMapper:jsonMapper];
+                    break;
+                }
+                case OX_POLYMORPHIC:
+                default: {
+                    [self fail:[NSString stringWithFormat:@"OXTranscoder does not support typeEnum:%d in mapper: %@", childType.typeEnum, pathMapper]];
+                    break;
+                }
+            }
+            if (_failed)
+                return;
+        }
+        _printer.nsPrefix = saveNsPrefix;
+        if (!rootElementSkip) {
+            _printer.indent -= 1;
+            [_printer endTag:elementName indent:YES];
+        }
+    }
+    if (!isEmptyTag || bodyMapper) {
+        for (NSString *tag in [tags reverseObjectEnumerator]) {
+            if ( ! [OX_ROOT_PATH isEqualToString:tag] && ! [elementName isEqualToString:tag]) {
+                _printer.indent -= 1;
+                [_printer endTag:tag indent:YES];
+            }
+        }
+    }
+}
+
+- (NSString *)xmlFromJSONData:(NSData *)jsonData prettyPrint:(BOOL)prettyPrint
+{
+    if ( ! [self configure])
+        return nil;
+    NSError *error = nil;
+    id json = [NSJSONSerialization JSONObjectWithData:jsonData options:0 error:&error];
+    if (json == nil) {
+        [self addErrorMessage:[NSString stringWithFormat:@"JSON Parsing Error: %@", [error localizedDescription]]];
+        return nil;
+    }
+    _printer = [[OXmlPrinter alloc] init];
+    if (!prettyPrint) {
+        _printer.crString = nil;
+        _printer.indentString = nil;
+    }
+    if (_xmlHeader) {
+        [_printer appendUnencodedText:_xmlHeader];
+        [_printer newLine];
+    }
+    _isRoot = YES;
+    _currentNsURI = _xmlMapper.rootMapper.nsURI;
+    _printer.nsPrefix = [_currentNsURI isEqualToString:OX_DEFAULT_NAMESPACE ] ? nil : [_xmlMapper.nsByURI objectForKey:_currentNsURI];
+    [self printElement:nil fromJSON:@{ OX_ROOT_PATH : json } type:nil];     //wrap json in 'root' object, as OXJSONReader does
+    NSString *xml = _failed ? nil : [_printer.output copy];
+    _printer = nil;
+    [_xmlContext reset];
+    [_jsonContext reset];
+    return xml;
+}
+
+@end
+
+//
+//  Copyright (c) 2013 Outsource Cafe, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
@@ -15,6 +15,9 @@
 
     - (OXTransformBlock)transformerFrom:(Class)fromType to:(Class)toType;
 
+  Lookup tables are keyed by Class and, for scalars, by OXScalarEnum (see OXType.scalarEnum), so resolving a
+  transformer doesn't allocate any key strings.  The encoded type variants decode the scalar encoding on each call.
+
   A typical transformer looks like this:
 
      ^(id value) { return [value boolValue] ? @"true" : @"false"; };  //boolean-to-string
@@ -42,6 +45,13 @@
 
     typedef void (^OXSetterBlock)(NSString *path, id value, id target, OXContext *ctx);
 
+  Readers don't call appenders if a container builder block is available:
+
+    typedef id (^OXContainerBuilderBlock)(id container, NSArray *items, OXContext *ctx);
+
+  Instead they buffer the children of a container property and build the container once, when the parent is complete.
+  This keeps reads linear for immutable containers, which an appender would have to copy on every child.
+
   Supported collections (and their mutable subclasses) are:
 
     NSDictionary, NSArray, NSSet, NSOrderedSet
@@ -50,7 +60,6 @@
   TODO
     * Not supported (yet): NSDecimal, NSRange, NSAttributedString, NSPoint, NSRange, NSSize and NSRect(OSX)
     * should we split this class into a OXBlockFactory and OXFormatterRegistry?
-    * scalar transformers should be stored in a seperate NSDictionary, a 'L' class would cause a namespace collision with an unsigned long scalar
     * add support for NDData-to-base64 conversion
 
 
@@ -63,6 +72,7 @@
 
  */
 #import "OXBlockDef.h"
+#import "OXType.h"
 
 //built-in named formatters:
 #define OX_DEFAULT_DATE_FORMATTER @"OX_DEFAULT_DATE_FORMATTER"          //used on all dates by default
@@ -81,13 +91,21 @@
 - (OXTransformBlock)transformerFrom:(Class)fromType to:(Class)toType;
 - (OXTransformBlock)transformerFrom:(Class)fromType toScalar:(const char *)encodedType;
 - (OXTransformBlock)transformerScalar:(const char *)encodedType to:(Class)toType;
+- (OXTransformBlock)transformerFrom:(Class)fromType toScalarEnum:(OXScalarEnum)scalarEnum;
+- (OXTransformBlock)transformerScalarEnum:(OXScalarEnum)scalarEnum to:(Class)toType;
 
 - (void)registerFrom:(Class)fromType to:(Class)toType transformer:(OXTransformBlock)transformer;
 - (void)registerFrom:(Class)fromType toScalar:(const char *)encodedType transformer:(OXTransformBlock)transformer;
 - (void)registerFromScalar:(const char *)encodedType to:(Class)toType transformer:(OXTransformBlock)transformer;
 
 #pragma mark - formatters
-- (NSFormatter *)formatterWithName:(const NSString *)name;
+// NSFormatter instances aren't thread safe.  Registered formatters are used as-is on the thread that created the transform,
+// other threads get their own copy, made on first use and owned by the transform, so copies are freed with it and
+// long-lived GCD worker threads don't accumulate them.  Repeat lookups hit a lock-free thread-local cache, the lock is only
+// taken when a copy is made.  Register formatters before starting concurrent reads.
+- (NSFormatter *)formatterWithName:(const NSString *)name;                      //formatter for the calling thread
+- (NSFormatter *)localFormatter:(NSFormatter *)formatter;                        //calling thread's copy of a registered formatter
+- (NSFormatter *)formatterForMapper:(OXPathMapper *)mapper defaultName:(NSString *)name;    //mapper.formatter, else named formatter
 - (NSFormatter *)defaultDateFormatter;
 
 - (void)registerFormatter:(NSFormatter *)formatter withName:(const NSString *)name;
@@ -96,9 +114,11 @@
 #pragma mark - collection
 - (OXEnumerationBlock)enumerationForContainer:(Class)containerClass;
 - (OXSetterBlock)appenderForContainer:(Class)containerClass;
+- (OXContainerBuilderBlock)builderForContainer:(Class)containerClass;
 
 - (void)registerContainerClass:(Class)containerClass enumeration:(OXEnumerationBlock)enumeration;
 - (void)registerContainerClass:(Class)containerClass appender:(OXSetterBlock)appender;
+- (void)registerContainerClass:(Class)containerClass builder:(OXContainerBuilderBlock)builder;
 
 #pragma mark - utility
 + (NSString *)keyForEncodedType:(const char *)encodedType;  //pulls type data from encoded property types or @encode() results
@@ -10,6 +10,7 @@
 #import "OXType.h"
 #import "OXPathMapper.h"
 #import "OXUtil.h"
+#include <pthread.h>
 
 
 @interface OXTransform ()
@@ -19,23 +20,51 @@
 - (void)registerDefaultScalarToStringTransformers:(BOOL)ignoreZeros;
 @end
 
+//one process-wide key: each thread holds a transform -> copies table, values are weak so the transform stays the owner
+static pthread_key_t OXThreadCopiesKey;
+
+static void OXReleaseThreadCopies(void *table)
+{
+    CFRelease(table);
+}
+
+
 @implementation OXTransform
 {
-    NSMutableDictionary *_transformers;
+    //two-level dispatch tables, keyed by Class and OXScalarEnum, lookups don't allocate:
+    NSMutableDictionary *_transformers;             //from Class -> to Class -> OXTransformBlock
+    NSMutableDictionary *_toScalarTransformers;     //from Class -> NSMutableArray of OXTransformBlock indexed by OXScalarEnum
+    NSMutableArray *_fromScalarTransformers;        //OXScalarEnum index -> to Class -> OXTransformBlock
     NSMutableDictionary *_namedFormatters;
     NSMutableDictionary *_containerAppenders;
     NSMutableDictionary *_containerEnumerators;
+    NSMutableDictionary *_containerBuilders;
     BOOL _treatScalarZerosAsNil;
+    NSThread *_ownerThread;                         //registered formatters are used as-is on this thread, copied on others
+    NSMapTable *_threadCopies;                      //NSThread (weak) -> shared formatter -> thread copy, freed with the transform
+    pthread_mutex_t _threadCopiesLock;
 }
 
 - (id)init
 {
     if (self = [super init]) {
         _treatScalarZerosAsNil = YES;
-        _transformers = [NSMutableDictionary dictionaryWithCapacity:103];
+        _ownerThread = [NSThread currentThread];
+        _threadCopies = [NSMapTable weakToStrongObjectsMapTable];
+        pthread_mutex_init(&_threadCopiesLock, NULL);
+        static dispatch_once_t onceToken;
+        dispatch_once(&onceToken, ^{
+            pthread_key_create(&OXThreadCopiesKey, OXReleaseThreadCopies);
+        });
+        _transformers = [NSMutableDictionary dictionaryWithCapacity:31];
+        _toScalarTransformers = [NSMutableDictionary dictionaryWithCapacity:7];
+        _fromScalarTransformers = [NSMutableArray arrayWithCapacity:OX_SCALAR_ENUM_COUNT];
+        for(NSUInteger i=0;i<OX_SCALAR_ENUM_COUNT;i++)
+            [_fromScalarTransformers addObject:[NSMutableDictionary dictionaryWithCapacity:7]];
         _namedFormatters = [NSMutableDictionary dictionaryWithCapacity:43];
         _containerAppenders = [NSMutableDictionary dictionaryWithCapacity:13];
         _containerEnumerators = [NSMutableDictionary dictionaryWithCapacity:13];
+        _containerBuilders = [NSMutableDictionary dictionaryWithCapacity:13];
         [self registerDefaultTransformers];
         [self registerDefaultFormatters];
         [self registerDefaultContainerBlocks];
@@ -43,6 +72,11 @@
     return self;
 }
 
+- (void)dealloc
+{
+    pthread_mutex_destroy(&_threadCopiesLock);
+}
+
 #pragma mark - properties
 
 @dynamic treatScalarZerosAsNil;
@@ -81,26 +115,36 @@
 
 - (OXSetterBlock)appenderForContainer:(Class)containerClass
 {
-    NSString *key = NSStringFromClass(containerClass);
-    return [_containerAppenders objectForKey:key];
+    return containerClass ? [_containerAppenders objectForKey:containerClass] : nil;
 }
 
 - (OXEnumerationBlock)enumerationForContainer:(Class)containerClass
 {
-    NSString *key = NSStringFromClass(containerClass);
-    return [_containerEnumerators objectForKey:key];
+    return containerClass ? [_containerEnumerators objectForKey:containerClass] : nil;
+}
+
+- (OXContainerBuilderBlock)builderForContainer:(Class)containerClass
+{
+    return containerClass ? [_containerBuilders objectForKey:containerClass] : nil;
+}
+
+- (void)registerContainerClass:(Class)containerClass builder:(OXContainerBuilderBlock)builder
+{
+    if (builder) {
+        [_containerBuilders setObject:builder forKey:(id<NSCopying>)containerClass];
+    } else {
+        [_containerBuilders removeObjectForKey:containerClass];
+    }
 }
 
 - (void)registerContainerClass:(Class)containerClass enumeration:(OXEnumerationBlock)enumeration
 {
-    NSString *key = NSStringFromClass(containerClass);
-    [_containerEnumerators setObject:enumeration forKey:key];
+    [_containerEnumerators setObject:enumeration forKey:(id<NSCopying>)containerClass];
 }
 
 - (void)registerContainerClass:(Class)containerClass appender:(OXSetterBlock)appender
 {
-    NSString *key = NSStringFromClass(containerClass);
-    [_containerAppenders setObject:appender forKey:key];
+    [_containerAppenders setObject:appender forKey:(id<NSCopying>)containerClass];
 }
 
 /**
@@ -255,35 +299,79 @@
             }
         }
     }];
+    
+    //Container builders - called once per container property with all the children.  Existing mutable containers are
+    //filled in place, immutable containers are built with a single copy.
+    [self registerContainerClass:[NSMutableArray class] builder:^id(id container, NSArray *items, OXContext *ctx) {
+        if (container == nil)
+            return [NSMutableArray arrayWithArray:items];
+        [(NSMutableArray *)container addObjectsFromArray:items];
+        return container;
+    }];
+    [self registerContainerClass:[NSArray class] builder:^id(id container, NSArray *items, OXContext *ctx) {
+        return container ? [container arrayByAddingObjectsFromArray:items] : [NSArray arrayWithArray:items];
+    }];
+    [self registerContainerClass:[NSMutableSet class] builder:^id(id container, NSArray *items, OXContext *ctx) {
+        if (container == nil)
+            return [NSMutableSet setWithArray:items];
+        [(NSMutableSet *)container addObjectsFromArray:items];
+        return container;
+    }];
+    [self registerContainerClass:[NSSet class] builder:^id(id container, NSArray *items, OXContext *ctx) {
+        return container ? [container setByAddingObjectsFromArray:items] : [NSSet setWithArray:items];
+    }];
+    [self registerContainerClass:[NSMutableOrderedSet class] builder:^id(id container, NSArray *items, OXContext *ctx) {
+        if (container == nil)
+            return [NSMutableOrderedSet orderedSetWithArray:items];
+        [(NSMutableOrderedSet *)container addObjectsFromArray:items];
+        return container;
+    }];
+    [self registerContainerClass:[NSOrderedSet class] builder:^id(id container, NSArray *items, OXContext *ctx) {
+        NSMutableOrderedSet *newSet = container ? [NSMutableOrderedSet orderedSetWithOrderedSet:container] : [NSMutableOrderedSet orderedSetWithCapacity:[items count]];
+        [newSet addObjectsFromArray:items];
+        return [newSet copy];
+    }];
+    OXContainerBuilderBlock dictionaryBuilder = ^id(id container, NSArray *items, OXContext *ctx) {
+        NSString *keyName = ctx.currentMapper.dictionaryKeyName;
+        NSMutableDictionary *dict = [container isKindOfClass:[NSMutableDictionary class]] ? container : nil;
+        for(id item in items) {
+            id dictKey = [item valueForKey:keyName];
+            if (dictKey) {
+                if (dict == nil)    //as with the appenders, no keyed items leaves a nil container nil
+                    dict = container ? [NSMutableDictionary dictionaryWithDictionary:container] : [NSMutableDictionary dictionaryWithCapacity:[items count]];
+                [dict setObject:item forKey:dictKey];
+            }
+        }
+        return dict ? dict : container;
+    };
+    [self registerContainerClass:[NSMutableDictionary class] builder:dictionaryBuilder];
+    [self registerContainerClass:[NSDictionary class] builder:^id(id container, NSArray *items, OXContext *ctx) {
+        return [dictionaryBuilder(container, items, ctx) copy];
+    }];
 }
 
 #pragma mark - type-to-type
 
 - (OXTransformBlock)transformerFrom:(Class)fromType to:(Class)toType
 {
-    NSString *fromKey = NSStringFromClass(fromType);
-    NSMutableDictionary *fromMap = [_transformers objectForKey:fromKey];
-    if (fromMap == nil)
+    if (fromType == nil || toType == nil)
         return nil;
-    NSString *toKey = NSStringFromClass(toType);
-    return [fromMap objectForKey:toKey];
+    return [[_transformers objectForKey:fromType] objectForKey:toType];
 }
 
 - (void)registerFrom:(Class)fromType to:(Class)toType transformer:(OXTransformBlock)transformer
 {
-    NSString *fromKey = NSStringFromClass(fromType);
-    NSMutableDictionary *fromMap = [_transformers objectForKey:fromKey];
+    NSMutableDictionary *fromMap = [_transformers objectForKey:fromType];
     if (fromMap == nil) {
         if (transformer == nil)
             return;
         fromMap = [NSMutableDictionary dictionaryWithCapacity:13];
-        [_transformers setObject:fromMap forKey:fromKey];
+        [_transformers setObject:fromMap forKey:(id<NSCopying>)fromType];
     }
-    NSString *toKey = NSStringFromClass(toType);
     if (transformer == nil) {  
-        [fromMap removeObjectForKey:toKey];             //remove if nil passed in
+        [fromMap removeObjectForKey:toType];                                //remove if nil passed in
     } else {
-        [fromMap setObject:transformer forKey:toKey];   //set or overwrite if transformer != nil
+        [fromMap setObject:transformer forKey:(id<NSCopying>)toType];       //set or overwrite if transformer != nil
     }
 }
 
@@ -312,7 +400,7 @@
         return result;
     }];
     [self registerFrom:[NSNumber class] to:[NSString class] transformer:^(id value, OXContext *ctx) {
-        return value ? [value stringValue] : nil;
+        return value ? [OXUtil stringFromNumber:value] : nil;
     }];
 
     //NSDecimalNumber <-> NSString
@@ -360,16 +448,17 @@
     //NSDate <-> NSString
     [self registerFrom:[NSString class] to:[NSDate class] transformer:^(id string, OXContext *ctx) {
         NSDate *date = nil;
-        if (string) {
-            NSString *formatterName = ctx.currentMapper.formatterName;
-            NSFormatter *formatter = (NSFormatter *)[ctx.transform formatterWithName:formatterName ? formatterName : OX_DEFAULT_DATE_FORMATTER];
+        if ([string length] > 0) {      //empty elements stay nil, anything else must parse
+            NSFormatter *formatter = [ctx.transform formatterForMapper:ctx.currentMapper defaultName:OX_DEFAULT_DATE_FORMATTER];
             if ([formatter isKindOfClass:[NSDateFormatter class]]) {
               //see http://stackoverflow.com/questions/4330137/parsing-rfc3339-dates-with-nsdateformatter-in-ios-4-x-and-macos-x-10-6-impossib
                 NSError *error;
-                [(NSDateFormatter *)formatter getObjectValue:&date forString:string range:nil error:&error]; //date = [formatter dateFromString:string];
+                if ( ! [(NSDateFormatter *)formatter getObjectValue:&date forString:string range:nil error:&error]) //date = [formatter dateFromString:string];
+                    date = [ctx transformFailed:[NSString stringWithFormat:@"malformed date '%@'", string]];
             } else {
                 NSString *error;
-                [formatter getObjectValue:&date forString:string errorDescription:&error];  //TODO add error to context
+                if ( ! [formatter getObjectValue:&date forString:string errorDescription:&error])
+                    date = [ctx transformFailed:[NSString stringWithFormat:@"malformed date '%@': %@", string, error]];
             }
         }
         return date;
@@ -377,8 +466,7 @@
     [self registerFrom:[NSDate class] to:[NSString class] transformer:^(id value, OXContext *ctx) {
         NSString *date = nil;
         if (value) {
-            NSString *formatterName = ctx.currentMapper.formatterName;
-            NSFormatter *formatter = (NSFormatter *)[ctx.transform formatterWithName:formatterName ? formatterName : OX_DEFAULT_DATE_FORMATTER];
+            NSFormatter *formatter = [ctx.transform formatterForMapper:ctx.currentMapper defaultName:OX_DEFAULT_DATE_FORMATTER];
             date = [formatter stringForObjectValue:value];
         }
         return date;
@@ -406,50 +494,57 @@
 
 - (OXTransformBlock)transformerFrom:(Class)fromType toScalar:(const char *)encodedType
 {
+    return [self transformerFrom:fromType toScalarEnum:[OXType scalarEnumForEncodedType:encodedType]];
+}
+
+- (OXTransformBlock)transformerFrom:(Class)fromType toScalarEnum:(OXScalarEnum)scalarEnum
+{
+    if (fromType == nil || scalarEnum == OX_SCALAR_UNKNOWN || scalarEnum >= OX_SCALAR_ENUM_COUNT)
+        return nil;
     if ([fromType isSubclassOfClass:[NSValue class]])
         return nil; //already a wrapped scalar - TODO can we change the NSValue encoding?
-    NSString *fromKey = NSStringFromClass(fromType);
-    NSMutableDictionary *fromMap = [_transformers objectForKey:fromKey];
-    if (fromMap == nil)
-        return nil;
-    NSString *toKey = [[self class] keyForEncodedType:encodedType];
-    return [fromMap objectForKey:toKey];
+    id transformer = [[_toScalarTransformers objectForKey:fromType] objectAtIndex:scalarEnum];
+    return transformer == [NSNull null] ? nil : transformer;
 }
 
 - (void)registerFrom:(Class)fromType toScalar:(const char *)encodedType transformer:(OXTransformBlock)transformer
 {
-    NSString *fromKey = NSStringFromClass(fromType);
-    NSMutableDictionary *fromMap = [_transformers objectForKey:fromKey];
-    if (fromMap == nil) {
-        fromMap = [NSMutableDictionary dictionaryWithCapacity:13];
-        [_transformers setObject:fromMap forKey:fromKey];
+    OXScalarEnum scalarEnum = [OXType scalarEnumForEncodedType:encodedType];
+    NSAssert1(scalarEnum != OX_SCALAR_UNKNOWN, @"ERROR: unsupported scalar encoding: %s", encodedType);
+    NSMutableArray *scalarMap = [_toScalarTransformers objectForKey:fromType];
+    if (scalarMap == nil) {
+        scalarMap = [NSMutableArray arrayWithCapacity:OX_SCALAR_ENUM_COUNT];
+        for(NSUInteger i=0;i<OX_SCALAR_ENUM_COUNT;i++)
+            [scalarMap addObject:[NSNull null]];
+        [_toScalarTransformers setObject:scalarMap forKey:(id<NSCopying>)fromType];
     }
-    NSString *toKey = [[self class] keyForEncodedType:encodedType];
-    [fromMap setObject:transformer forKey:toKey];
+    [scalarMap replaceObjectAtIndex:scalarEnum withObject:transformer ? (id)transformer : [NSNull null]];
 }
 
 #pragma mark - scalar-to-object transformers
 
 - (OXTransformBlock)transformerScalar:(const char *)encodedType to:(Class)toType
 {
-    NSString *fromKey = [[self class] keyForEncodedType:encodedType];
-    NSMutableDictionary *fromMap = [_transformers objectForKey:fromKey];
-    if (fromMap == nil)
+    return [self transformerScalarEnum:[OXType scalarEnumForEncodedType:encodedType] to:toType];
+}
+
+- (OXTransformBlock)transformerScalarEnum:(OXScalarEnum)scalarEnum to:(Class)toType
+{
+    if (toType == nil || scalarEnum == OX_SCALAR_UNKNOWN || scalarEnum >= OX_SCALAR_ENUM_COUNT)
         return nil;
-    NSString *toKey = NSStringFromClass(toType);
-    return [fromMap objectForKey:toKey];
+    return [[_fromScalarTransformers objectAtIndex:scalarEnum] objectForKey:toType];
 }
 
 - (void)registerFromScalar:(const char *)encodedType to:(Class)toType transformer:(OXTransformBlock)transformer
 {
-    NSString *fromKey = [[self class] keyForEncodedType:encodedType];
-    NSMutableDictionary *fromMap = [_transformers objectForKey:fromKey];
-    if (fromMap == nil) {
-        fromMap = [NSMutableDictionary dictionaryWithCapacity:13];
-        [_transformers setObject:fromMap forKey:fromKey];
+    OXScalarEnum scalarEnum = [OXType scalarEnumForEncodedType:encodedType];
+    NSAssert1(scalarEnum != OX_SCALAR_UNKNOWN, @"ERROR: unsupported scalar encoding: %s", encodedType);
+    NSMutableDictionary *toMap = [_fromScalarTransformers objectAtIndex:scalarEnum];
+    if (transformer == nil) {
+        [toMap removeObjectForKey:toType];
+    } else {
+        [toMap setObject:transformer forKey:(id<NSCopying>)toType];
     }
-    NSString *toKey = NSStringFromClass(toType);
-    [fromMap setObject:transformer forKey:toKey];
 }
 
 
@@ -462,44 +557,43 @@
     }];
     if (zerosAsNils) {
         [self registerFromScalar:@encode(char) to:[NSString class] transformer:^(id value, OXContext *ctx) {
-            return value && [value charValue] != 0 ? [value stringValue] : nil;
+            return value && [value charValue] != 0 ? [OXUtil stringFromNumber:value] : nil;
         }];
         [self registerFromScalar:@encode(unsigned char) to:[NSString class] transformer:^(id value, OXContext *ctx) {
-            return value && [value unsignedCharValue] != 0 ? [value stringValue] : nil;
+            return value && [value unsignedCharValue] != 0 ? [OXUtil stringFromNumber:value] : nil;
         }];
         [self registerFromScalar:@encode(short) to:[NSString class] transformer:^(id value, OXContext *ctx) {
-            return value && [value shortValue] != 0 ? [value stringValue] : nil;
+            return value && [value shortValue] != 0 ? [OXUtil stringFromNumber:value] : nil;
         }];
         [self registerFromScalar:@encode(unsigned short) to:[NSString class] transformer:^(id value, OXContext *ctx) {
-            return value && [value unsignedShortValue] != 0 ? [value stringValue] : nil; 
+            return value && [value unsignedShortValue] != 0 ? [OXUtil stringFromNumber:value] : nil; 
         }];
         [self registerFromScalar:@encode(int) to:[NSString class] transformer:^(id value, OXContext *ctx) {
-            return value && [value intValue] != 0 ? [value stringValue] : nil;
+            return value && [value intValue] != 0 ? [OXUtil stringFromNumber:value] : nil;
         }];
         [self registerFromScalar:@encode(unsigned int) to:[NSString class] transformer:^(id value, OXContext *ctx) {
-            return value && [value unsignedIntValue] != 0 ? [value stringValue] : nil;
+            return value && [value unsignedIntValue] != 0 ? [OXUtil stringFromNumber:value] : nil;
         }];
         [self registerFromScalar:@encode(long) to:[NSString class] transformer:^(id value, OXContext *ctx) {
-            return value && [value longValue] != 0 ? [value stringValue] : nil;
+            return value && [value longValue] != 0 ? [OXUtil stringFromNumber:value] : nil;
         }];
         [self registerFromScalar:@encode(unsigned long) to:[NSString class] transformer:^(id value, OXContext *ctx) {
-            return value && [value unsignedLongValue] != 0 ? [value stringValue] : nil;
+            return value && [value unsignedLongValue] != 0 ? [OXUtil stringFromNumber:value] : nil;
         }];
         [self registerFromScalar:@encode(long long) to:[NSString class] transformer:^(id value, OXContext *ctx) {
-            return value && [value longLongValue] != 0l ? [value stringValue] : nil; 
+            return value && [value longLongValue] != 0l ? [OXUtil stringFromNumber:value] : nil; 
         }];
         [self registerFromScalar:@encode(unsigned long long) to:[NSString class] transformer:^(id value, OXContext *ctx) {
-            return value && [value unsignedLongLongValue] != 0l ? [value stringValue] : nil;
+            return value && [value unsignedLongLongValue] != 0l ? [OXUtil stringFromNumber:value] : nil;
         }];
         [self registerFromScalar:@encode(float) to:[NSString class] transformer:^(id value, OXContext *ctx) {
             NSString *result = nil;
             if (value && [value floatValue] != 0.0f) {
-                NSString *formatterName = ctx.currentMapper.formatterName;
-                if (formatterName) {
-                    NSNumberFormatter *formatter = (NSNumberFormatter *)[ctx.transform formatterWithName:formatterName];
+                NSNumberFormatter *formatter = (NSNumberFormatter *)[ctx.transform formatterForMapper:ctx.currentMapper defaultName:nil];
+                if (formatter) {
                     result = [formatter stringFromNumber:value];
                 } else {
-                    result = [value stringValue];
+                    result = [OXUtil stringFromNumber:value];
                 }
             }
             return result;
@@ -507,56 +601,54 @@
         [self registerFromScalar:@encode(double) to:[NSString class] transformer:^(id value, OXContext *ctx) {
             NSString *result = nil;
             if (value && [value doubleValue] != 0.0) {
-                NSString *formatterName = ctx.currentMapper.formatterName;
-                if (formatterName) {
-                    NSNumberFormatter *formatter = (NSNumberFormatter *)[ctx.transform formatterWithName:formatterName];
+                NSNumberFormatter *formatter = (NSNumberFormatter *)[ctx.transform formatterForMapper:ctx.currentMapper defaultName:nil];
+                if (formatter) {
                     result = [formatter stringFromNumber:value];
                 } else {
-                    result = [value stringValue];
+                    result = [OXUtil stringFromNumber:value];
                 }
             }
             return result;
         }];
     } else {
         [self registerFromScalar:@encode(char) to:[NSString class] transformer:^(id value, OXContext *ctx) {
-            return [value stringValue];
+            return [OXUtil stringFromNumber:value];
         }];
         [self registerFromScalar:@encode(unsigned char) to:[NSString class] transformer:^(id value, OXContext *ctx) {
-            return [value stringValue];
+            return [OXUtil stringFromNumber:value];
         }];
         [self registerFromScalar:@encode(short) to:[NSString class] transformer:^(id value, OXContext *ctx) {
-            return [value stringValue];
+            return [OXUtil stringFromNumber:value];
         }];
         [self registerFromScalar:@encode(unsigned short) to:[NSString class] transformer:^(id value, OXContext *ctx) {
-            return [value stringValue];
+            return [OXUtil stringFromNumber:value];
         }];
         [self registerFromScalar:@encode(int) to:[NSString class] transformer:^(id value, OXContext *ctx) {
-            return [value stringValue];
+            return [OXUtil stringFromNumber:value];
         }];
         [self registerFromScalar:@encode(unsigned int) to:[NSString class] transformer:^(id value, OXContext *ctx) {
-            return [value stringValue];
+            return [OXUtil stringFromNumber:value];
         }];
         [self registerFromScalar:@encode(long) to:[NSString class] transformer:^(id value, OXContext *ctx) {
-            return [value stringValue];
+            return [OXUtil stringFromNumber:value];
         }];
         [self registerFromScalar:@encode(unsigned long) to:[NSString class] transformer:^(id value, OXContext *ctx) {
-            return [value stringValue];
+            return [OXUtil stringFromNumber:value];
         }];
         [self registerFromScalar:@encode(long long) to:[NSString class] transformer:^(id value, OXContext *ctx) {
-            return [value stringValue];
+            return [OXUtil stringFromNumber:value];
         }];
         [self registerFromScalar:@encode(unsigned long long) to:[NSString class] transformer:^(id value, OXContext *ctx) {
-            return [value stringValue];
+            return [OXUtil stringFromNumber:value];
         }];
         [self registerFromScalar:@encode(float) to:[NSString class] transformer:^(id value, OXContext *ctx) {
             NSString *result = nil;
             if (value) {
-                NSString *formatterName = ctx.currentMapper.formatterName;
-                if (formatterName) {
-                    NSNumberFormatter *formatter = (NSNumberFormatter *)[ctx.transform formatterWithName:formatterName];
+                NSNumberFormatter *formatter = (NSNumberFormatter *)[ctx.transform formatterForMapper:ctx.currentMapper defaultName:nil];
+                if (formatter) {
                     result = [formatter stringFromNumber:value];
                 } else {
-                    result = [value stringValue];
+                    result = [OXUtil stringFromNumber:value];
                 }
             }
             return result;
@@ -564,12 +656,11 @@
         [self registerFromScalar:@encode(double) to:[NSString class] transformer:^(id value, OXContext *ctx) {
             NSString *result = nil;
             if (value) {
-                NSString *formatterName = ctx.currentMapper.formatterName;
-                if (formatterName) {
-                    NSNumberFormatter *formatter = (NSNumberFormatter *)[ctx.transform formatterWithName:formatterName];
+                NSNumberFormatter *formatter = (NSNumberFormatter *)[ctx.transform formatterForMapper:ctx.currentMapper defaultName:nil];
+                if (formatter) {
                     result = [formatter stringFromNumber:value];
                 } else {
-                    result = [value stringValue];
+                    result = [OXUtil stringFromNumber:value];
                 }
             }
             return result;
@@ -615,20 +706,19 @@
         return [NSNumber numberWithLong:(long)[(NSString *)string longLongValue]];
     }];
     [self registerFrom:[NSString class] toScalar:@encode(unsigned long) transformer:^(id string, OXContext *ctx) {
-        return [NSNumber numberWithUnsignedLong:(unsigned long)[(NSString *)string longLongValue]];
+        return [NSNumber numberWithUnsignedLong:(unsigned long)strtoull([(NSString *)string UTF8String], NULL, 10)];
     }];
     [self registerFrom:[NSString class] toScalar:@encode(long long) transformer:^(id string, OXContext *ctx) {
         return [NSNumber numberWithLongLong:[(NSString *)string longLongValue]];
     }];
     [self registerFrom:[NSString class] toScalar:@encode(unsigned long long) transformer:^(id string, OXContext *ctx) {
-        return [NSNumber numberWithUnsignedLongLong:(unsigned long long)[(NSString *)string longLongValue]];
+        return [NSNumber numberWithUnsignedLongLong:strtoull([(NSString *)string UTF8String], NULL, 10)];    //longLongValue saturates above LLONG_MAX
     }];
     [self registerFrom:[NSString class] toScalar:@encode(float) transformer:^(id string, OXContext *ctx) {
         NSNumber *result = nil;
         if (string) {
-            NSString *formatterName = ctx.currentMapper.formatterName;
-            if (formatterName) {
-                NSNumberFormatter *formatter = (NSNumberFormatter *)[ctx.transform formatterWithName:formatterName];
+            NSNumberFormatter *formatter = (NSNumberFormatter *)[ctx.transform formatterForMapper:ctx.currentMapper defaultName:nil];
+            if (formatter) {
                 result = [formatter numberFromString:string];
             } else {
                 result = [NSNumber numberWithFloat:[(NSString *)string floatValue]];
@@ -639,9 +729,8 @@
     [self registerFrom:[NSString class] toScalar:@encode(double) transformer:^(id string, OXContext *ctx) {
         NSNumber *result = nil;
         if (string) {
-            NSString *formatterName = ctx.currentMapper.formatterName;
-            if (formatterName) {
-                NSNumberFormatter *formatter = (NSNumberFormatter *)[ctx.transform formatterWithName:formatterName];
+            NSNumberFormatter *formatter = (NSNumberFormatter *)[ctx.transform formatterForMapper:ctx.currentMapper defaultName:nil];
+            if (formatter) {
                 result = [formatter numberFromString:string];
             } else {
                 result = [NSNumber numberWithDouble:[(NSString *)string doubleValue]];
@@ -672,7 +761,51 @@
 
 - (NSFormatter *)formatterWithName:(const id )name
 {
-    return [_namedFormatters objectForKey:name];
+    return [self localFormatter:[_namedFormatters objectForKey:name]];
+}
+
+- (NSFormatter *)localFormatter:(NSFormatter *)formatter
+{
+    NSThread *thread = [NSThread currentThread];
+    if (formatter == nil || thread == _ownerThread)
+        return formatter;
+    //fast path, no lock: only this thread reads or writes its own table and its own copies
+    NSMapTable *local = (__bridge NSMapTable *)pthread_getspecific(OXThreadCopiesKey);
+    NSFormatter *copy = [[local objectForKey:self] objectForKey:formatter];
+    if (copy)
+        return copy;
+    pthread_mutex_lock(&_threadCopiesLock);
+    NSMapTable *copies = [_threadCopies objectForKey:thread];
+    if (copies == nil) {
+        //identity keys, retained so an address can't be reused by another formatter while the transform lives
+        copies = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality
+                                       valueOptions:NSPointerFunctionsStrongMemory];
+        [_threadCopies setObject:copies forKey:thread];
+    }
+    copy = [copies objectForKey:formatter];    //pointer lookup, nothing allocated once the copy exists
+    if (copy == nil) {
+        copy = [formatter copy];
+        [copies setObject:copy forKey:formatter];
+        [copies setObject:copy forKey:copy];    //copies are already thread-local
+    }
+    pthread_mutex_unlock(&_threadCopiesLock);
+    if (local == nil) {
+        //raw pointer keys, a reused transform address only finds a zeroed weak value and falls back to this path
+        local = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsOpaqueMemory | NSPointerFunctionsOpaquePersonality
+                                      valueOptions:NSPointerFunctionsWeakMemory];
+        pthread_setspecific(OXThreadCopiesKey, CFBridgingRetain(local));
+    }
+    [local setObject:copies forKey:self];
+    return copy;
+}
+
+- (NSFormatter *)formatterForMapper:(OXPathMapper *)mapper defaultName:(NSString *)defaultName
+{
+    NSFormatter *formatter = mapper.formatter;      //resolved at configure time
+    if (formatter)
+        return [self localFormatter:formatter];
+    NSString *name = mapper.formatterName ? mapper.formatterName : defaultName;
+    return name ? [self formatterWithName:name] : nil;
 }
 
 - (NSFormatter *)defaultDateFormatter
@@ -39,6 +39,24 @@ typedef enum {
 
 #define OX_ENCODED_BOOL "?B"                                       //BOOL property encoding. Can't use @encode(BOOL) because it equals @encode(char)
 
+typedef enum {
+    OX_SCALAR_UNKNOWN,      //structs, pointers, etc. - no transformers available
+    OX_SCALAR_BOOL,         //OX_ENCODED_BOOL or C++ bool/C99 _Bool ('B')
+    OX_SCALAR_CHAR,
+    OX_SCALAR_UCHAR,
+    OX_SCALAR_SHORT,
+    OX_SCALAR_USHORT,
+    OX_SCALAR_INT,
+    OX_SCALAR_UINT,
+    OX_SCALAR_LONG,
+    OX_SCALAR_ULONG,
+    OX_SCALAR_LONGLONG,
+    OX_SCALAR_ULONGLONG,
+    OX_SCALAR_FLOAT,
+    OX_SCALAR_DOUBLE,
+    OX_SCALAR_ENUM_COUNT    //table size, not a type
+} OXScalarEnum;
+
 @interface OXType : NSObject
 
 #pragma mark - required properties
@@ -47,6 +65,7 @@ typedef enum {
 
 #pragma mark - OX_SCALAR
 @property(assign,nonatomic,readonly)const char *scalarEncoding;    //scalars only: can be @encode(<scalar>) or property encoding value
+@property(assign,nonatomic,readonly)OXScalarEnum scalarEnum;       //scalars only: decoded scalarEncoding, used for transformer lookups
 
 #pragma mark - OX_CONTAINER:
 @property(strong,nonatomic,readonly)OXType *containerChildType;    //containers only: child type held by container, can be polymorphic (i.e. NSObject)
@@ -59,11 +78,15 @@ typedef enum {
 + (id)typeContainer:(Class)type containing:(Class)childType;
 + (id)type:(Class)type typeEnum:(OXTypeEnum)typeEnum;
 
-#pragma mark - caches
-+ (OXType *)cachedType:(Class)type;
-+ (OXType *)cachedScalarType:(const char *)encodedType;
+#pragma mark - caches (process-wide and thread-safe, see OXMetadataRegistry warmUp:)
++ (OXType *)cachedType:(Class)type;                                     //one shared instance per Class
++ (OXType *)cachedScalarType:(const char *)encodedType;                 //one shared instance per OXScalarEnum
 + (id)scalarType:(Class)typeWrapper scalarEncoding:(const char *)scalarEncoding;
 
+#pragma mark - utility
++ (OXScalarEnum)scalarEnumForEncodedType:(const char *)encodedType;     //handles both @encode() and property encoded types
++ (const char *)encodedTypeForScalarEnum:(OXScalarEnum)scalarEnum;      //canonical @encode() value, OX_ENCODED_BOOL for BOOL
+
 @end
 
 //
@@ -10,11 +10,13 @@
 #import "OXContext.h"
 #import "OXTransform.h"
 #import "OXUtil.h"
+#include <stdatomic.h>
 
 
 @implementation OXType
 {
     NSDictionary *_properties;
+    _Atomic(BOOL) _propertiesLoaded;    //stored with release after _properties is set, loaded with acquire before it is read
 }
 
 #pragma mark - constructors
@@ -39,6 +41,7 @@
         _type = type ? type : [NSNumber class]; //if not specified, use NSNumber
         _typeEnum = OX_SCALAR;
         _scalarEncoding = scalarEncoding;
+        _scalarEnum = [OXType scalarEnumForEncodedType:scalarEncoding];
     }
     return self;
 }
@@ -80,37 +83,42 @@
 
 #pragma mark - caches
 
+//process-wide caches, shared by all mappers and threads:
+static OXType *_scalarTypeCache[OX_SCALAR_ENUM_COUNT];      //indexed by OXScalarEnum, immutable after initialization
+static NSMutableDictionary *_typeCache;                     //OXType keyed by Class, guarded by @synchronized(_typeCache)
+
++ (void)initialize
+{
+    if (self == [OXType class]) {
+        for(NSUInteger i=0;i<OX_SCALAR_ENUM_COUNT;i++)
+            _scalarTypeCache[i] = [OXType scalarType:[NSNumber class] scalarEncoding:[OXType encodedTypeForScalarEnum:(OXScalarEnum)i]];
+        _typeCache = [NSMutableDictionary dictionaryWithCapacity:64];
+    }
+}
+
 + (OXType *)cachedScalarType:(const char *)encodedType
 {
     if (encodedType == Nil)
         return nil;
-    static NSMutableDictionary *_scalarTypeCache;
-    if (_scalarTypeCache == nil)
-        _scalarTypeCache = [NSMutableDictionary dictionaryWithCapacity:21];
-    NSString *key = [[NSString alloc] initWithUTF8String:encodedType];
-    OXType *result = [_scalarTypeCache objectForKey:key];
-    if (result == nil) {
-        result = [OXType scalarType:[NSNumber class] scalarEncoding:encodedType];
-        [_scalarTypeCache setObject:result forKey:key];
-    }
-    return result;
+    OXScalarEnum scalarEnum = [OXType scalarEnumForEncodedType:encodedType];
+    if (scalarEnum == OX_SCALAR_UNKNOWN)
+        return [OXType scalarType:[NSNumber class] scalarEncoding:encodedType];    //unusual type, don't cache
+    return _scalarTypeCache[scalarEnum];
 }
 
 + (OXType *)cachedType:(Class)type
 {
     if (type == nil) // || [type isSubclassOfClass:[NSValue class]])          //don't cache scalar wrapper - needs a special key - use cachedScalarType
         return nil;
-    static NSMutableDictionary *_typeCache;
-    if (_typeCache == nil)
-        _typeCache = [NSMutableDictionary dictionaryWithCapacity:21];
-    NSString *key = NSStringFromClass(type);
-    OXType *result = [_typeCache objectForKey:key];
-    if (result == nil) {
-        OXTypeEnum typeEnum = [OXType guessTypeEnumFromClass:type];
-        result = [[OXType alloc] initWithType:type typeEnum:typeEnum];
-        [_typeCache setObject:result forKey:key];
+    @synchronized(_typeCache) {
+        OXType *result = [_typeCache objectForKey:type];
+        if (result == nil) {
+            OXTypeEnum typeEnum = [OXType guessTypeEnumFromClass:type];
+            result = [[OXType alloc] initWithType:type typeEnum:typeEnum];
+            [_typeCache setObject:result forKey:(id<NSCopying>)type];
+        }
+        return result;
     }
-    return result;
 }
 
 #pragma mark - public
@@ -129,6 +137,40 @@
     }
 }
 
++ (OXScalarEnum)scalarEnumForEncodedType:(const char *)encodedType
+{
+    if (encodedType == NULL)
+        return OX_SCALAR_UNKNOWN;
+    if (encodedType[0] == 'T')                                      //property encoding, example: "Tc,N,V_isHtmlBody"
+        encodedType++;
+    if (encodedType[0] == OX_ENCODED_BOOL[0] && encodedType[1] == OX_ENCODED_BOOL[1])
+        return OX_SCALAR_BOOL;
+    if (encodedType[0] == '\0' || (encodedType[1] != '\0' && encodedType[1] != ','))
+        return OX_SCALAR_UNKNOWN;                                   //multi-char encodings: structs, pointers, etc.
+    switch (encodedType[0]) {
+        case 'B': return OX_SCALAR_BOOL;
+        case 'c': return OX_SCALAR_CHAR;
+        case 'C': return OX_SCALAR_UCHAR;
+        case 's': return OX_SCALAR_SHORT;
+        case 'S': return OX_SCALAR_USHORT;
+        case 'i': return OX_SCALAR_INT;
+        case 'I': return OX_SCALAR_UINT;
+        case 'l': return OX_SCALAR_LONG;
+        case 'L': return OX_SCALAR_ULONG;
+        case 'q': return OX_SCALAR_LONGLONG;
+        case 'Q': return OX_SCALAR_ULONGLONG;
+        case 'f': return OX_SCALAR_FLOAT;
+        case 'd': return OX_SCALAR_DOUBLE;
+        default:  return OX_SCALAR_UNKNOWN;
+    }
+}
+
++ (const char *)encodedTypeForScalarEnum:(OXScalarEnum)scalarEnum
+{
+    static const char *encodings[OX_SCALAR_ENUM_COUNT] = { "?", OX_ENCODED_BOOL, "c", "C", "s", "S", "i", "I", "l", "L", "q", "Q", "f", "d" };
+    return scalarEnum < OX_SCALAR_ENUM_COUNT ? encodings[scalarEnum] : encodings[OX_SCALAR_UNKNOWN];
+}
+
 - (NSString *)description
 {
     switch (_typeEnum) {
@@ -146,10 +188,20 @@
 
 #pragma mark - properties
 
+@dynamic propertiesLoaded;
+- (BOOL)propertiesLoaded
+{
+    return atomic_load_explicit(&_propertiesLoaded, memory_order_acquire);
+}
+
 @dynamic properties;
 - (NSDictionary *)properties
 {
-    if (!_propertiesLoaded) {
+    if (atomic_load_explicit(&_propertiesLoaded, memory_order_acquire))
+        return _properties;
+    @synchronized(self) {       //cached types are shared across threads, reflect only once
+        if (atomic_load_explicit(&_propertiesLoaded, memory_order_relaxed))
+            return _properties;
         NSMutableDictionary *__properties = [NSMutableDictionary dictionary];
         [OXUtil propertyInspectionForClass:self.type withBlock:^(NSString *propertyName, Class propertyClass, const char *attributes) {
             const char *encodedType = attributes ? strchr(attributes, 'T') : "T@";
@@ -175,15 +227,17 @@
             //NSLog(@"%@ %@ (%s)->%d", propertyClass, propertyName, attributes, type.typeEnum);
         }];
         _properties = [__properties copy];
-        _propertiesLoaded = YES;
+        atomic_store_explicit(&_propertiesLoaded, YES, memory_order_release);   //publish _properties before the flag
+        return _properties;
     }
-    return _properties;
 }
 
 - (void)setProperties:(NSDictionary *)properties
 {
-    _properties = properties;
-    _propertiesLoaded = YES;
+    @synchronized(self) {
+        _properties = properties;
+        atomic_store_explicit(&_propertiesLoaded, YES, memory_order_release);
+    }
 }
 
 
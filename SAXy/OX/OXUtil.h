@@ -11,6 +11,14 @@
 #import <Foundation/Foundation.h>
 #import "OXBlockDef.h"
 
+typedef enum {
+    OX_BASE64_STANDARD = 0,                 //RFC 4648 alphabet, padded
+    OX_BASE64_URL_SAFE = 1 << 0,            //'-' and '_' in place of '+' and '/'
+    OX_BASE64_NO_PADDING = 1 << 1           //encode without trailing '=', decoding accepts missing padding
+} OXBase64Options;
+
+#define OX_NUMBER_BUFFER_SIZE 32            //room for any formatted number, including the terminating '\0'
+
 
 @interface OXUtil : NSObject
 
@@ -21,11 +29,12 @@
 + (NSString *)firstSegmentFromPath:(NSString *)path separator:(unichar)separator;               // example using '/': a/b/c -> a
 + (NSString *)lastSegmentFromPath:(NSString *)path separator:(unichar)separator;                // example using '/': a/b/c -> c
 + (NSString *)xmlSafeString:(NSString *)text;                                                   //escape chars: &<>'"
-+ (BOOL)isXPathString:(NSString *)string;                                                       //detects multi-element and/or wildcard paths
++ (BOOL)isXPathString:(NSString *)string;                                                       //detects multi-element, wildcard and/or predicate paths
 + (BOOL)allDigits:(NSString *)text;                                                             //true if text only contains chars: .-+0123456789
 
 #pragma mark - file
 + (NSData *)readResourceFile:(NSString *)fileName;                                              //read file's data from resource bundle
++ (NSURL *)resourceURL:(NSString *)fileName;                                                    //file URL of a resource bundle file
 
 #pragma mark - naming
 + (NSString *)guessSingularNoun:(NSString *)pluralNoun;                                         //guesses singular noun, given an english plural
@@ -36,9 +45,20 @@
 + (BOOL)knownSimpleType:(Class)type;                                                            //true if class is a common NS simple type (i.e. string representation)  
 + (NSString *)scalarString:(const char *)encodedType;                                           //return string representation of encoded (usually scalar) type
 
+#pragma mark - number formatting
++ (size_t)formatInt64:(int64_t)value buffer:(char *)buffer;                                      //buffer needs OX_NUMBER_BUFFER_SIZE bytes, returns length
++ (size_t)formatUInt64:(uint64_t)value buffer:(char *)buffer;
++ (size_t)formatDouble:(double)value buffer:(char *)buffer;                                     //shortest text that parses back to the same double
++ (size_t)formatFloat:(float)value buffer:(char *)buffer;                                       //shortest text that parses back to the same float
++ (size_t)formatNumber:(NSNumber *)number buffer:(char *)buffer;                                //by objCType, 0 for NSDecimalNumber and unknown types
++ (NSString *)stringFromNumber:(NSNumber *)number;                                              //formatNumber:buffer: text, stringValue fallback
+
 #pragma mark - base64
 +(NSString *)base64StringByEncodingData:(NSData *)data;                                         //encode data as base64 string
 +(NSData *)decodeBase64String:(NSString *)string;                                               //decode base64 string into data
++(NSString *)base64StringByEncodingData:(NSData *)data options:(OXBase64Options)options;
++(NSData *)decodeBase64String:(NSString *)string options:(OXBase64Options)options;             //whitespace is skipped, nil if invalid
++(NSData *)decodeBase64Bytes:(const char *)bytes length:(NSUInteger)length options:(OXBase64Options)options;   //decode raw ASCII text, no NSString needed
 
 @end
 
@@ -8,6 +8,13 @@
 #import "OXUtil.h"
 #import <objc/runtime.h>
 #import <objc/message.h>
+#include <xlocale.h>
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
 
 @implementation OXUtil
 
@@ -81,7 +88,7 @@
 {
     const static NSCharacterSet *XPATH_CHAR_SET = nil;
     if (XPATH_CHAR_SET == nil)
-        XPATH_CHAR_SET = [NSCharacterSet characterSetWithCharactersInString:@"/*"];
+        XPATH_CHAR_SET = [NSCharacterSet characterSetWithCharactersInString:@"/*["];
     const NSUInteger len = [string length];
     for(NSUInteger i=0;i<len;i++) {
         unichar ch = [string characterAtIndex:i];
@@ -134,6 +141,12 @@
     return data;
 }
 
++ (NSURL *)resourceURL:(NSString *)fileName
+{
+    NSString *resourcePath = [[NSBundle bundleForClass:[self class]] resourcePath];
+    return [NSURL fileURLWithPath:[resourcePath stringByAppendingPathComponent:fileName]];
+}
+
 
 #pragma mark - naming
 
@@ -347,456 +360,406 @@
 
 
 
-#pragma mark - base64
+#pragma mark - number formatting
 
-//the following base64 code is taken from the google-toolbox-for-mac: https://code.google.com/p/google-toolbox-for-mac/
-//Copyright 2006-2008 Google Inc.
-
-static const char *kBase64EncodeChars        = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-//static const char *kWebSafeBase64EncodeChars = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
-static const char kBase64PaddingChar = '=';
-static const char kBase64InvalidChar = 99;
-
-static const char kBase64DecodeChars[] = {
-    // This array was generated by the following code:
-    // #include <sys/time.h>
-    // #include <stdlib.h>
-    // #include <string.h>
-    // main()
-    // {
-    //   static const char Base64[] =
-    //     "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-    //   char *pos;
-    //   int idx, i, j;
-    //   printf("    ");
-    //   for (i = 0; i < 255; i += 8) {
-    //     for (j = i; j < i + 8; j++) {
-    //       pos = strchr(Base64, j);
-    //       if ((pos == NULL) || (j == 0))
-    //         idx = 99;
-    //       else
-    //         idx = pos - Base64;
-    //       if (idx == 99)
-    //         printf(" %2d,     ", idx);
-    //       else
-    //         printf(" %2d/*%c*/,", idx, j);
-    //     }
-    //     printf("\n    ");
-    //   }
-    // }
-    99,      99,      99,      99,      99,      99,      99,      99,
-    99,      99,      99,      99,      99,      99,      99,      99,
-    99,      99,      99,      99,      99,      99,      99,      99,
-    99,      99,      99,      99,      99,      99,      99,      99,
-    99,      99,      99,      99,      99,      99,      99,      99,
-    99,      99,      99,      62/*+*/, 99,      99,      99,      63/*/ */,
-    52/*0*/, 53/*1*/, 54/*2*/, 55/*3*/, 56/*4*/, 57/*5*/, 58/*6*/, 59/*7*/,
-    60/*8*/, 61/*9*/, 99,      99,      99,      99,      99,      99,
-    99,       0/*A*/,  1/*B*/,  2/*C*/,  3/*D*/,  4/*E*/,  5/*F*/,  6/*G*/,
-    7/*H*/,  8/*I*/,  9/*J*/, 10/*K*/, 11/*L*/, 12/*M*/, 13/*N*/, 14/*O*/,
-    15/*P*/, 16/*Q*/, 17/*R*/, 18/*S*/, 19/*T*/, 20/*U*/, 21/*V*/, 22/*W*/,
-    23/*X*/, 24/*Y*/, 25/*Z*/, 99,      99,      99,      99,      99,
-    99,      26/*a*/, 27/*b*/, 28/*c*/, 29/*d*/, 30/*e*/, 31/*f*/, 32/*g*/,
-    33/*h*/, 34/*i*/, 35/*j*/, 36/*k*/, 37/*l*/, 38/*m*/, 39/*n*/, 40/*o*/,
-    41/*p*/, 42/*q*/, 43/*r*/, 44/*s*/, 45/*t*/, 46/*u*/, 47/*v*/, 48/*w*/,
-    49/*x*/, 50/*y*/, 51/*z*/, 99,      99,      99,      99,      99,
-    99,      99,      99,      99,      99,      99,      99,      99,
-    99,      99,      99,      99,      99,      99,      99,      99,
-    99,      99,      99,      99,      99,      99,      99,      99,
-    99,      99,      99,      99,      99,      99,      99,      99,
-    99,      99,      99,      99,      99,      99,      99,      99,
-    99,      99,      99,      99,      99,      99,      99,      99,
-    99,      99,      99,      99,      99,      99,      99,      99,
-    99,      99,      99,      99,      99,      99,      99,      99,
-    99,      99,      99,      99,      99,      99,      99,      99,
-    99,      99,      99,      99,      99,      99,      99,      99,
-    99,      99,      99,      99,      99,      99,      99,      99,
-    99,      99,      99,      99,      99,      99,      99,      99,
-    99,      99,      99,      99,      99,      99,      99,      99,
-    99,      99,      99,      99,      99,      99,      99,      99,
-    99,      99,      99,      99,      99,      99,      99,      99,
-    99,      99,      99,      99,      99,      99,      99,      99
-};
-
-// Tests a character to see if it's a whitespace character.
-//
-// Returns:
-//   YES if the character is a whitespace character.
-//   NO if the character is not a whitespace character.
-//
-static BOOL IsSpace(unsigned char c) {
-    // we use our own mapping here because we don't want anything w/ locale
-    // support.
-    static BOOL kSpaces[256] = {
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 1,  // 0-9
-        1, 1, 1, 1, 0, 0, 0, 0, 0, 0,  // 10-19
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // 20-29
-        0, 0, 1, 0, 0, 0, 0, 0, 0, 0,  // 30-39
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // 40-49
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // 50-59
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // 60-69
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // 70-79
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // 80-89
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // 90-99
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // 100-109
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // 110-119
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // 120-129
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // 130-139
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // 140-149
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // 150-159
-        1, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // 160-169
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // 170-179
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // 180-189
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // 190-199
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // 200-209
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // 210-219
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // 220-229
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // 230-239
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // 240-249
-        0, 0, 0, 0, 0, 1,              // 250-255
-    };
-    return kSpaces[c];
-}
-
-// Calculate how long the data will be once it's base64 encoded.
-//
-// Returns:
-//   The guessed encoded length for a source length
-//
-static NSUInteger CalcEncodedLength(NSUInteger srcLen, BOOL padded) {
-    NSUInteger intermediate_result = 8 * srcLen + 5;
-    NSUInteger len = intermediate_result / 6;
-    if (padded) {
-        len = ((len + 3) / 4) * 4;
+static const char kOXDigitPairs[] = "0001020304050607080910111213141516171819202122232425262728293031323334353637383940414243444546474849"
+                                    "5051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
+
+static size_t OXFormatUInt64(uint64_t value, char *buffer)
+{
+    char digits[20];
+    char *p = digits + sizeof(digits);
+    while (value >= 100) {                  //two digits per division
+        const unsigned pair = (unsigned)(value % 100) * 2;
+        value /= 100;
+        *--p = kOXDigitPairs[pair + 1];
+        *--p = kOXDigitPairs[pair];
+    }
+    if (value >= 10) {
+        *--p = kOXDigitPairs[value * 2 + 1];
+        *--p = kOXDigitPairs[value * 2];
+    } else {
+        *--p = (char)('0' + value);
     }
-    return len;
+    const size_t length = digits + sizeof(digits) - p;
+    memcpy(buffer, p, length);
+    buffer[length] = '\0';
+    return length;
 }
 
-// Tries to calculate how long the data will be once it's base64 decoded.
-// Unlike the above, this is always an upperbound, since the source data
-// could have spaces and might end with the padding characters on them.
-//
-// Returns:
-//   The guessed decoded length for a source length
-//
-static NSUInteger GuessDecodedLength(NSUInteger srcLen) {
-    return (srcLen + 3) / 4 * 3;
+static size_t OXFormatInt64(int64_t value, char *buffer)
+{
+    if (value < 0) {
+        buffer[0] = '-';
+        return 1 + OXFormatUInt64((uint64_t)0 - (uint64_t)value, buffer + 1);
+    }
+    return OXFormatUInt64((uint64_t)value, buffer);
 }
 
+//XML and JSON numbers always use '.', whatever the process locale
+static locale_t OXNumericLocale(void)
+{
+    static locale_t cLocale;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        cLocale = newlocale(LC_NUMERIC_MASK, "C", NULL);
+    });
+    return cLocale;
+}
 
-
-+(NSString *)base64StringByEncodingData:(NSData *)data {
-    NSString *result = nil;
-    NSData *converted = [self baseEncode:[data bytes]
-                                  length:[data length]
-                                 charset:kBase64EncodeChars
-                                  padded:YES];
-    if (converted) {
-        result = [[NSString alloc] initWithData:converted encoding:NSASCIIStringEncoding];
+//Shortest round-trip text: any decimal of up to 15 (float: 6) significant digits survives a trip through the binary type,
+//so the first precision that parses back to the same value has the fewest digits possible.  17 (float: 9) always does.
+//Subnormals carry fewer significant digits and start the search at 1.  This is a printf search, not a dedicated digit
+//generator: whole numbers below 1e15 (float: 1e6), which %g prints without an exponent too, use the integer formatter.
+static size_t OXFormatReal(double value, BOOL isFloat, char *buffer)
+{
+    if (isnan(value))
+        return strlen(strcpy(buffer, "nan"));
+    if (isinf(value))
+        return strlen(strcpy(buffer, value < 0 ? "-inf" : "inf"));
+    if (fabs(value) < (isFloat ? 1e6 : 1e15) && value == trunc(value) && ! (value == 0 && signbit(value)))
+        return OXFormatInt64((int64_t)value, buffer);
+    const locale_t locale = OXNumericLocale();
+    const BOOL subnormal = isFloat ? fpclassify((float)value) == FP_SUBNORMAL : fpclassify(value) == FP_SUBNORMAL;
+    const int maxPrecision = isFloat ? 9 : 17;
+    for(int precision = subnormal ? 1 : (isFloat ? 6 : 15); ; precision++) {
+        const int length = snprintf_l(buffer, OX_NUMBER_BUFFER_SIZE, locale, "%.*g", precision, value);
+        if (precision == maxPrecision || (isFloat ? strtof_l(buffer, NULL, locale) == (float)value : strtod_l(buffer, NULL, locale) == value))
+            return (size_t)length;
     }
-    return result;
 }
 
-+(NSData *)decodeBase64String:(NSString *)string {
-    NSData *result = nil;
-    NSData *data = [string dataUsingEncoding:NSASCIIStringEncoding];
-    if (data) {
-        result = [self baseDecode:[data bytes]
-                           length:[data length]
-                          charset:kBase64DecodeChars
-                   requirePadding:YES];
-    }
-    return result;
++ (size_t)formatInt64:(int64_t)value buffer:(char *)buffer
+{
+    return OXFormatInt64(value, buffer);
 }
 
-//
-// baseEncode:length:charset:padded:
-//
-// Does the common lifting of creating the dest NSData.  it creates & sizes the
-// data for the results.  |charset| is the characters to use for the encoding
-// of the data.  |padding| controls if the encoded data should be padded to a
-// multiple of 4.
-//
-// Returns:
-//   an autorelease NSData with the encoded data, nil if any error.
-//
-+(NSData *)baseEncode:(const void *)bytes
-               length:(NSUInteger)length
-              charset:(const char *)charset
-               padded:(BOOL)padded {
-    // how big could it be?
-    NSUInteger maxLength = CalcEncodedLength(length, padded);
-    // make space
-    NSMutableData *result = [NSMutableData data];
-    [result setLength:maxLength];
-    // do it
-    NSUInteger finalLength = [self baseEncode:bytes
-                                       srcLen:length
-                                    destBytes:[result mutableBytes]
-                                      destLen:[result length]
-                                      charset:charset
-                                       padded:padded];
-    if (finalLength) {
-        NSAssert(finalLength == maxLength, @"how did we calc the length wrong?");
-    } else {
-        // shouldn't happen, this means we ran out of space
-        result = nil;
++ (size_t)formatUInt64:(uint64_t)value buffer:(char *)buffer
+{
+    return OXFormatUInt64(value, buffer);
+}
+
++ (size_t)formatDouble:(double)value buffer:(char *)buffer
+{
+    return OXFormatReal(value, NO, buffer);
+}
+
++ (size_t)formatFloat:(float)value buffer:(char *)buffer
+{
+    return OXFormatReal(value, YES, buffer);
+}
+
++ (size_t)formatNumber:(NSNumber *)number buffer:(char *)buffer
+{
+    if ( ! [number isKindOfClass:[NSNumber class]] || [number isKindOfClass:[NSDecimalNumber class]])
+        return 0;                           //decimals keep their own exact digits
+    switch ([number objCType][0]) {
+        case 'c': case 's': case 'i': case 'l': case 'q':
+            return OXFormatInt64([number longLongValue], buffer);
+        case 'C': case 'S': case 'I': case 'L': case 'Q':
+            return OXFormatUInt64([number unsignedLongLongValue], buffer);
+        case 'f':
+            return OXFormatReal([number floatValue], YES, buffer);
+        case 'd':
+            return OXFormatReal([number doubleValue], NO, buffer);
+        default:
+            return 0;
     }
-    return result;
 }
 
-//
-// baseDecode:length:charset:requirePadding:
-//
-// Does the common lifting of creating the dest NSData.  it creates & sizes the
-// data for the results.  |charset| is the characters to use for the decoding
-// of the data.
-//
-// Returns:
-//   an autorelease NSData with the decoded data, nil if any error.
-//
-//
-+(NSData *)baseDecode:(const void *)bytes
-               length:(NSUInteger)length
-              charset:(const char *)charset
-       requirePadding:(BOOL)requirePadding {
-    // could try to calculate what it will end up as
-    NSUInteger maxLength = GuessDecodedLength(length);
-    // make space
-    NSMutableData *result = [NSMutableData data];
-    [result setLength:maxLength];
-    // do it
-    NSUInteger finalLength = [self baseDecode:bytes
-                                       srcLen:length
-                                    destBytes:[result mutableBytes]
-                                      destLen:[result length]
-                                      charset:charset
-                               requirePadding:requirePadding];
-    if (finalLength) {
-        if (finalLength != maxLength) {
-            // resize down to how big it was
-            [result setLength:finalLength];
++ (NSString *)stringFromNumber:(NSNumber *)number
+{
+    char buffer[OX_NUMBER_BUFFER_SIZE];
+    const size_t length = [self formatNumber:number buffer:buffer];
+    return length ? [[NSString alloc] initWithBytes:buffer length:length encoding:NSASCIIStringEncoding] : [number stringValue];
+}
+
+
+
+#pragma mark - base64
+
+//Vectorized codec: blocks of 12 bytes (NEON: 48) are split into 6 bit indices and translated with register table lookups,
+//decoding validates a whole block at once.  Whitespace, padding, errors and the tail are left to the scalar loops.
+
+#if defined(__SSSE3__)
+#define OX_BASE64_BLOCK 16                  //characters per SIMD block
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define OX_BASE64_BLOCK 64
+#else
+#define OX_BASE64_BLOCK 16                  //scalar stride between block attempts
+#endif
+#define OX_BASE64_INVALID 0xFF
+
+static const char *kOXBase64Alphabet        = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+static const char *kOXBase64UrlSafeAlphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+//character to 6 bit value, OX_BASE64_INVALID for everything else
+static const uint8_t *OXBase64DecodeTable(BOOL urlSafe)
+{
+    static uint8_t tables[2][256];
+    static dispatch_once_t once;
+    dispatch_once(&once, ^{
+        memset(tables, OX_BASE64_INVALID, sizeof(tables));
+        for(uint8_t i = 0; i < 64; i++) {
+            tables[0][(uint8_t)kOXBase64Alphabet[i]] = i;
+            tables[1][(uint8_t)kOXBase64UrlSafeAlphabet[i]] = i;
         }
-    } else {
-        // either an error in the args, or we ran out of space
-        result = nil;
-    }
-    return result;
+    });
+    return tables[urlSafe ? 1 : 0];
 }
 
-//
-// baseEncode:srcLen:destBytes:destLen:charset:padded:
-//
-// Encodes the buffer into the larger.  returns the length of the encoded
-// data, or zero for an error.
-// |charset| is the characters to use for the encoding
-// |padded| tells if the result should be padded to a multiple of 4.
-//
-// Returns:
-//   the length of the encoded data.  zero if any error.
-//
-+(NSUInteger)baseEncode:(const char *)srcBytes
-                 srcLen:(NSUInteger)srcLen
-              destBytes:(char *)destBytes
-                destLen:(NSUInteger)destLen
-                charset:(const char *)charset
-                 padded:(BOOL)padded {
-    if (!srcLen || !destLen || !srcBytes || !destBytes) {
-        return 0;
+static inline BOOL OXBase64IsSpace(uint8_t c)
+{
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+static inline NSUInteger OXBase64EncodedLength(NSUInteger length, BOOL padded)
+{
+    return padded ? (length + 2) / 3 * 4 : (length * 4 + 2) / 3;
+}
+
+//encodes whole blocks while a full vector can be loaded, returns bytes consumed (a multiple of 3)
+static NSUInteger OXBase64EncodeBlocks(const uint8_t *src, NSUInteger length, char *dest, BOOL urlSafe)
+{
+    NSUInteger done = 0;
+#if defined(__SSSE3__)
+    const __m128i shuffle = _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+    const __m128i shift = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                        '0' - 52, '0' - 52, '0' - 52, urlSafe ? '-' - 62 : '+' - 62,
+                                        urlSafe ? '_' - 63 : '/' - 63, 'A', 0, 0);
+    while (length - done >= 16) {           //loads 16 bytes, encodes 12
+        __m128i in = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(src + done)), shuffle);
+        __m128i hi = _mm_mulhi_epu16(_mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+        __m128i lo = _mm_mullo_epi16(_mm_and_si128(in, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+        __m128i indices = _mm_or_si128(hi, lo);
+        __m128i range = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+        range = _mm_or_si128(range, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), indices), _mm_set1_epi8(13)));
+        _mm_storeu_si128((__m128i *)dest, _mm_add_epi8(indices, _mm_shuffle_epi8(shift, range)));
+        done += 12;
+        dest += 16;
     }
-    
-    char *curDest = destBytes;
-    const unsigned char *curSrc = (const unsigned char *)(srcBytes);
-    
-    // Three bytes of data encodes to four characters of cyphertext.
-    // So we can pump through three-byte chunks atomically.
-    while (srcLen > 2) {
-        // space?
-        NSAssert(destLen >= 4, @"our calc for encoded length was wrong");
-        curDest[0] = charset[curSrc[0] >> 2];
-        curDest[1] = charset[((curSrc[0] & 0x03) << 4) + (curSrc[1] >> 4)];
-        curDest[2] = charset[((curSrc[1] & 0x0f) << 2) + (curSrc[2] >> 6)];
-        curDest[3] = charset[curSrc[2] & 0x3f];
-        
-        curDest += 4;
-        curSrc += 3;
-        srcLen -= 3;
-        destLen -= 4;
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    const uint8_t *alphabet = (const uint8_t *)(urlSafe ? kOXBase64UrlSafeAlphabet : kOXBase64Alphabet);
+    const uint8x16x4_t lut = {{vld1q_u8(alphabet), vld1q_u8(alphabet + 16), vld1q_u8(alphabet + 32), vld1q_u8(alphabet + 48)}};
+    const uint8x16_t mask = vdupq_n_u8(0x3f);
+    while (length - done >= 48) {
+        uint8x16x3_t in = vld3q_u8(src + done);
+        uint8x16x4_t out;
+        out.val[0] = vqtbl4q_u8(lut, vshrq_n_u8(in.val[0], 2));
+        out.val[1] = vqtbl4q_u8(lut, vandq_u8(vorrq_u8(vshlq_n_u8(in.val[0], 4), vshrq_n_u8(in.val[1], 4)), mask));
+        out.val[2] = vqtbl4q_u8(lut, vandq_u8(vorrq_u8(vshlq_n_u8(in.val[1], 2), vshrq_n_u8(in.val[2], 6)), mask));
+        out.val[3] = vqtbl4q_u8(lut, vandq_u8(in.val[2], mask));
+        vst4q_u8((uint8_t *)dest, out);
+        done += 48;
+        dest += 64;
     }
-    
-    // now deal with the tail (<=2 bytes)
-    switch (srcLen) {
-        case 0:
-            // Nothing left; nothing more to do.
-            break;
-        case 1:
-            // One byte left: this encodes to two characters, and (optionally)
-            // two pad characters to round out the four-character cypherblock.
-            NSAssert(destLen >= 2, @"our calc for encoded length was wrong");
-            curDest[0] = charset[curSrc[0] >> 2];
-            curDest[1] = charset[(curSrc[0] & 0x03) << 4];
-            curDest += 2;
-            if (padded) {
-                NSAssert(destLen >= 4, @"our calc for encoded length was wrong");
-                curDest[0] = kBase64PaddingChar;
-                curDest[1] = kBase64PaddingChar;
-                curDest += 2;
-            }
+#endif
+    return done;
+}
+
+//decodes whole blocks until the input runs short or a block holds anything but alphabet characters,
+//returns characters consumed (a multiple of 4)
+static NSUInteger OXBase64DecodeBlocks(const uint8_t *src, NSUInteger length, uint8_t *dest, BOOL urlSafe, const uint8_t *table)
+{
+    NSUInteger done = 0;
+#if defined(__SSSE3__)
+    const __m128i lutLo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a);
+    const __m128i lutHi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m128i lutRoll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i mask2F = _mm_set1_epi8(0x2f);
+    const __m128i plus = _mm_set1_epi8('+');
+    while (length - done >= 16) {
+        __m128i str = _mm_loadu_si128((const __m128i *)(src + done));
+        if (urlSafe) {
+            //'+' and '/' are not part of this alphabet, map '-' and '_' onto them
+            if (_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(str, plus), _mm_cmpeq_epi8(str, mask2F))))
+                break;
+            __m128i dash = _mm_cmpeq_epi8(str, _mm_set1_epi8('-'));
+            __m128i underscore = _mm_cmpeq_epi8(str, _mm_set1_epi8('_'));
+            str = _mm_or_si128(_mm_andnot_si128(_mm_or_si128(dash, underscore), str),
+                               _mm_or_si128(_mm_and_si128(dash, plus), _mm_and_si128(underscore, mask2F)));
+        }
+        __m128i hiNibbles = _mm_and_si128(_mm_srli_epi32(str, 4), mask2F);
+        __m128i loNibbles = _mm_and_si128(str, mask2F);
+        __m128i hi = _mm_shuffle_epi8(lutHi, hiNibbles);
+        __m128i lo = _mm_shuffle_epi8(lutLo, loNibbles);
+        if (_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128())))
             break;
-        case 2:
-            // Two bytes left: this encodes to three characters, and (optionally)
-            // one pad character to round out the four-character cypherblock.
-            NSAssert(destLen >= 3, @"our calc for encoded length was wrong");
-            curDest[0] = charset[curSrc[0] >> 2];
-            curDest[1] = charset[((curSrc[0] & 0x03) << 4) + (curSrc[1] >> 4)];
-            curDest[2] = charset[(curSrc[1] & 0x0f) << 2];
-            curDest += 3;
-            if (padded) {
-                NSAssert(destLen >= 4, @"our calc for encoded length was wrong");
-                curDest[0] = kBase64PaddingChar;
-                curDest += 1;
-            }
+        __m128i roll = _mm_shuffle_epi8(lutRoll, _mm_add_epi8(_mm_cmpeq_epi8(str, mask2F), hiNibbles));
+        str = _mm_add_epi8(str, roll);
+        __m128i merged = _mm_madd_epi16(_mm_maddubs_epi16(str, _mm_set1_epi32(0x01400140)), _mm_set1_epi32(0x00011000));
+        __m128i out = _mm_shuffle_epi8(merged, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+        _mm_storel_epi64((__m128i *)dest, out);     //exactly 12 bytes, the destination has no slack
+        uint32_t tail = (uint32_t)_mm_cvtsi128_si32(_mm_srli_si128(out, 8));
+        memcpy(dest + 8, &tail, sizeof(tail));
+        done += 16;
+        dest += 12;
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    const uint8x16x4_t lut0 = {{vld1q_u8(table), vld1q_u8(table + 16), vld1q_u8(table + 32), vld1q_u8(table + 48)}};
+    const uint8x16x4_t lut1 = {{vld1q_u8(table + 64), vld1q_u8(table + 80), vld1q_u8(table + 96), vld1q_u8(table + 112)}};
+    const uint8x16_t offset = vdupq_n_u8(64);
+    const uint8x16_t highBit = vdupq_n_u8(0x80);
+    while (length - done >= 64) {
+        uint8x16x4_t str = vld4q_u8(src + done);
+        uint8x16_t invalid = vdupq_n_u8(0);
+        for(int i = 0; i < 4; i++) {
+            //out of range lookups yield 0, so non-ASCII bytes are flagged separately
+            uint8x16_t value = vorrq_u8(vqtbl4q_u8(lut0, str.val[i]), vqtbl4q_u8(lut1, vsubq_u8(str.val[i], offset)));
+            invalid = vorrq_u8(invalid, vorrq_u8(value, vandq_u8(str.val[i], highBit)));
+            str.val[i] = value;
+        }
+        if (vmaxvq_u8(invalid) > 63)
             break;
+        uint8x16x3_t out;
+        out.val[0] = vorrq_u8(vshlq_n_u8(str.val[0], 2), vshrq_n_u8(str.val[1], 4));
+        out.val[1] = vorrq_u8(vshlq_n_u8(str.val[1], 4), vshrq_n_u8(str.val[2], 2));
+        out.val[2] = vorrq_u8(vshlq_n_u8(str.val[2], 6), str.val[3]);
+        vst3q_u8(dest, out);
+        done += 64;
+        dest += 48;
     }
-    // return the length
-    return (curDest - destBytes);
+#endif
+    return done;
 }
 
-//
-// baseDecode:srcLen:destBytes:destLen:charset:requirePadding:
-//
-// Decodes the buffer into the larger.  returns the length of the decoded
-// data, or zero for an error.
-// |charset| is the character decoding buffer to use
-//
-// Returns:
-//   the length of the encoded data.  zero if any error.
-//
-+(NSUInteger)baseDecode:(const char *)srcBytes
-                 srcLen:(NSUInteger)srcLen
-              destBytes:(char *)destBytes
-                destLen:(NSUInteger)destLen
-                charset:(const char *)charset
-         requirePadding:(BOOL)requirePadding {
-    if (!srcLen || !destLen || !srcBytes || !destBytes) {
-        return 0;
+//dest must hold OXBase64EncodedLength bytes, returns characters written
+static NSUInteger OXBase64Encode(const uint8_t *src, NSUInteger length, char *dest, OXBase64Options options)
+{
+    const BOOL urlSafe = (options & OX_BASE64_URL_SAFE) != 0;
+    const char *alphabet = urlSafe ? kOXBase64UrlSafeAlphabet : kOXBase64Alphabet;
+    const NSUInteger done = OXBase64EncodeBlocks(src, length, dest, urlSafe);
+    const uint8_t *p = src + done;
+    const uint8_t *end = src + length;
+    char *out = dest + done / 3 * 4;
+    for(; end - p >= 3; p += 3, out += 4) {
+        out[0] = alphabet[p[0] >> 2];
+        out[1] = alphabet[((p[0] & 0x03) << 4) | (p[1] >> 4)];
+        out[2] = alphabet[((p[1] & 0x0f) << 2) | (p[2] >> 6)];
+        out[3] = alphabet[p[2] & 0x3f];
     }
-    
-    int decode;
-    NSUInteger destIndex = 0;
-    int state = 0;
-    char ch = 0;
-    while (srcLen-- && (ch = *srcBytes++) != 0)  {
-        if (IsSpace(ch))  // Skip whitespace
-            continue;
-        
-        if (ch == kBase64PaddingChar)
-            break;
-        
-        decode = charset[(unsigned int)ch];
-        if (decode == kBase64InvalidChar)
-            return 0;
-        
-        // Four cyphertext characters decode to three bytes.
-        // Therefore we can be in one of four states.
-        switch (state) {
-            case 0:
-                // We're at the beginning of a four-character cyphertext block.
-                // This sets the high six bits of the first byte of the
-                // plaintext block.
-                NSAssert(destIndex < destLen, @"our calc for decoded length was wrong");
-                destBytes[destIndex] = decode << 2;
-                state = 1;
-                break;
-            case 1:
-                // We're one character into a four-character cyphertext block.
-                // This sets the low two bits of the first plaintext byte,
-                // and the high four bits of the second plaintext byte.
-                NSAssert((destIndex+1) < destLen, @"our calc for decoded length was wrong");
-                destBytes[destIndex] |= decode >> 4;
-                destBytes[destIndex+1] = (decode & 0x0f) << 4;
-                destIndex++;
-                state = 2;
-                break;
-            case 2:
-                // We're two characters into a four-character cyphertext block.
-                // This sets the low four bits of the second plaintext
-                // byte, and the high two bits of the third plaintext byte.
-                // However, if this is the end of data, and those two
-                // bits are zero, it could be that those two bits are
-                // leftovers from the encoding of data that had a length
-                // of two mod three.
-                NSAssert((destIndex+1) < destLen, @"our calc for decoded length was wrong");
-                destBytes[destIndex] |= decode >> 2;
-                destBytes[destIndex+1] = (decode & 0x03) << 6;
-                destIndex++;
-                state = 3;
-                break;
-            case 3:
-                // We're at the last character of a four-character cyphertext block.
-                // This sets the low six bits of the third plaintext byte.
-                NSAssert(destIndex < destLen, @"our calc for decoded length was wrong");
-                destBytes[destIndex] |= decode;
-                destIndex++;
-                state = 0;
-                break;
+    if (end - p == 1) {
+        *out++ = alphabet[p[0] >> 2];
+        *out++ = alphabet[(p[0] & 0x03) << 4];
+        if ( ! (options & OX_BASE64_NO_PADDING)) {
+            *out++ = '=';
+            *out++ = '=';
         }
+    } else if (end - p == 2) {
+        *out++ = alphabet[p[0] >> 2];
+        *out++ = alphabet[((p[0] & 0x03) << 4) | (p[1] >> 4)];
+        *out++ = alphabet[(p[1] & 0x0f) << 2];
+        if ( ! (options & OX_BASE64_NO_PADDING))
+            *out++ = '=';
     }
-    
-    // We are done decoding Base-64 chars.  Let's see if we ended
-    //      on a byte boundary, and/or with erroneous trailing characters.
-    if (ch == kBase64PaddingChar) {               // We got a pad char
-        if ((state == 0) || (state == 1)) {
-            return 0;  // Invalid '=' in first or second position
+    return out - dest;
+}
+
+//dest must hold (length + 3) / 4 * 3 bytes, returns bytes written or NSNotFound for invalid input
+static NSUInteger OXBase64Decode(const uint8_t *src, NSUInteger length, uint8_t *dest, OXBase64Options options)
+{
+    const BOOL urlSafe = (options & OX_BASE64_URL_SAFE) != 0;
+    const uint8_t *table = OXBase64DecodeTable(urlSafe);
+    const uint8_t *p = src;
+    const uint8_t *end = src + length;
+    uint8_t *out = dest;
+    uint32_t bits = 0;
+    NSUInteger state = 0;                   //characters of the current 4 character quantum
+    while (p < end && *p != '=') {
+        if (state == 0) {
+            const NSUInteger consumed = OXBase64DecodeBlocks(p, end - p, out, urlSafe, table);
+            p += consumed;
+            out += consumed / 4 * 3;
         }
-        if (srcLen == 0) {
-            if (state == 2) { // We run out of input but we still need another '='
-                return 0;
-            }
-            // Otherwise, we are in state 3 and only need this '='
-        } else {
-            if (state == 2) {  // need another '='
-                while ((ch = *srcBytes++) && (srcLen-- > 0)) {
-                    if (!IsSpace(ch))
-                        break;
-                }
-                if (ch != kBase64PaddingChar) {
-                    return 0;
-                }
-            }
-            // state = 1 or 2, check if all remain padding is space
-            while ((ch = *srcBytes++) && (srcLen-- > 0)) {
-                if (!IsSpace(ch)) {
-                    return 0;
+        //one block's worth of scalar decoding gets past whatever stopped the block decoder
+        const uint8_t *stop = (NSUInteger)(end - p) > OX_BASE64_BLOCK ? p + OX_BASE64_BLOCK : end;
+        while (p < stop) {
+            const uint8_t value = table[*p];
+            if (value != OX_BASE64_INVALID) {
+                bits = (bits << 6) | value;
+                p++;
+                if (++state == 4) {
+                    out[0] = (uint8_t)(bits >> 16);
+                    out[1] = (uint8_t)(bits >> 8);
+                    out[2] = (uint8_t)bits;
+                    out += 3;
+                    bits = 0;
+                    state = 0;
                 }
+            } else if (OXBase64IsSpace(*p)) {
+                while (++p < end && OXBase64IsSpace(*p))
+                    ;                       //skip the whole run, i.e. CRLF line breaks and indentation
+            } else if (*p == '=') {
+                break;
+            } else {
+                return NSNotFound;
             }
         }
+    }
+    NSUInteger padding = 0;
+    for(; p < end; p++) {
+        if (*p == '=')
+            padding++;
+        else if ( ! OXBase64IsSpace(*p))
+            return NSNotFound;              //only padding and whitespace may follow padding
+    }
+    if (state == 0)
+        return padding ? NSNotFound : out - dest;
+    if (state == 1)
+        return NSNotFound;
+    if (padding != 4 - state && (padding != 0 || ! (options & OX_BASE64_NO_PADDING)))
+        return NSNotFound;
+    if (state == 2) {
+        if (bits & 0x0f)
+            return NSNotFound;              //non-zero trailing bits, not produced by any encoder
+        *out++ = (uint8_t)(bits >> 4);
     } else {
-        // We ended by seeing the end of the string.
-        
-        if (requirePadding) {
-            // If we require padding, then anything but state 0 is an error.
-            if (state != 0) {
-                return 0;
-            }
-        } else {
-            // Make sure we have no partial bytes lying around.  Note that we do not
-            // require trailing '=', so states 2 and 3 are okay too.
-            if (state == 1) {
-                return 0;
-            }
-        }
+        if (bits & 0x03)
+            return NSNotFound;
+        *out++ = (uint8_t)(bits >> 10);
+        *out++ = (uint8_t)(bits >> 2);
     }
-    
-    // If then next piece of output was valid and got written to it means we got a
-    // very carefully crafted input that appeared valid but contains some trailing
-    // bits past the real length, so just toss the thing.
-    if ((destIndex < destLen) &&
-        (destBytes[destIndex] != 0)) {
-        return 0;
+    return out - dest;
+}
+
++(NSString *)base64StringByEncodingData:(NSData *)data {
+    return [self base64StringByEncodingData:data options:OX_BASE64_STANDARD];
+}
+
++(NSString *)base64StringByEncodingData:(NSData *)data options:(OXBase64Options)options {
+    const NSUInteger length = [data length];
+    if (length == 0)
+        return nil;
+    const NSUInteger encodedLength = OXBase64EncodedLength(length, ! (options & OX_BASE64_NO_PADDING));
+    char *buffer = malloc(encodedLength);
+    NSUInteger written = OXBase64Encode([data bytes], length, buffer, options);
+    NSAssert2(written == encodedLength, @"ERROR: base64 encoded %lu characters, expected %lu", (unsigned long)written, (unsigned long)encodedLength);
+    return [[NSString alloc] initWithBytesNoCopy:buffer length:written encoding:NSASCIIStringEncoding freeWhenDone:YES];
+}
+
++(NSData *)decodeBase64String:(NSString *)string {
+    return [self decodeBase64String:string options:OX_BASE64_STANDARD];
+}
+
++(NSData *)decodeBase64String:(NSString *)string options:(OXBase64Options)options {
+    //decode straight out of the string's own buffer when it has an ASCII one, no intermediate NSData
+    const char *bytes = CFStringGetCStringPtr((__bridge CFStringRef)string, kCFStringEncodingASCII);
+    if (bytes)
+        return [self decodeBase64Bytes:bytes length:CFStringGetLength((__bridge CFStringRef)string) options:options];
+    bytes = [string UTF8String];
+    return bytes ? [self decodeBase64Bytes:bytes length:strlen(bytes) options:options] : nil;
+}
+
++(NSData *)decodeBase64Bytes:(const char *)bytes length:(NSUInteger)length options:(OXBase64Options)options {
+    if (bytes == NULL || length == 0)
+        return nil;
+    uint8_t *buffer = malloc((length + 3) / 4 * 3);
+    NSUInteger decoded = OXBase64Decode((const uint8_t *)bytes, length, buffer, options);
+    if (decoded == NSNotFound || decoded == 0) {
+        free(buffer);
+        return nil;
     }
-    
-    return destIndex;
+    return [[NSData alloc] initWithBytesNoCopy:buffer length:decoded freeWhenDone:YES];
 }
 
 @end
@@ -73,7 +73,8 @@
     if (!self.factory) {
         self.factory = ^(NSString *path, OXContext *ctx) {
             OXPathMapper *mapper = ctx.currentMapper;
-            return [[mapper.toType.type alloc] init];
+            OXObjectPool *pool = ctx.objectPool;
+            return pool ? [pool instanceOfClass:mapper.toType.type] : [[mapper.toType.type alloc] init];
         };
     }
     switch (self.toType.typeEnum) {
@@ -10,6 +10,13 @@
 //    // or ** - zero or more elements
 //    @ - attribute tag prefix
 //    text() - text node
+//    [...] - optional predicate on the leaf element, evaluated while streaming:
+//              item[3], item[position()<=50]       - position among matching siblings
+//              item[@type='news']                  - attribute value
+//              item[category='news']               - text of a direct child element (known only at the end tag)
+//            supported operators: = != < <= > >=, unquoted values are compared numerically
+//            a passed position range of a document-level (rootXPath) mapping stops the parser, elsewhere later
+//            siblings are skipped but still scanned, since other properties of the parent may follow
 //
 //  Created by Richard Easterling on 1/25/13.
 //
@@ -31,12 +38,44 @@ typedef enum {
 //    OXCurrentPathType
 } OXPathType;
 
+typedef enum {
+    OXPositionPredicate,        //[3] or [position()<=50]
+    OXAttributePredicate,       //[@type='news']
+    OXChildPredicate            //[category='news']
+} OXPredicateType;
+
+typedef enum {
+    OXEqualComparison,
+    OXNotEqualComparison,
+    OXLessComparison,
+    OXLessEqualComparison,
+    OXGreaterComparison,
+    OXGreaterEqualComparison
+} OXComparisonType;
+
+@interface OXPathPredicate : NSObject
+
+@property(assign,nonatomic,readonly)OXPredicateType predicateType;
+@property(assign,nonatomic,readonly)OXComparisonType comparison;
+@property(strong,nonatomic,readonly)NSString *name;                 //attribute or child element name, nil for position predicates
+@property(strong,nonatomic,readonly)NSString *value;                //literal value, quotes removed
+@property(assign,nonatomic,readonly)BOOL isNumeric;                 //unquoted literal, compare numerically
+
+- (BOOL)matchesPosition:(NSUInteger)position;                       //position is 1-based
+- (BOOL)exhaustedAfterPosition:(NSUInteger)position;                //YES if no later position can match
+- (BOOL)matchesText:(NSString *)text;                               //nil text (missing node) never matches
++ (id)predicate:(NSString *)expression;                             //expression without brackets, nil if not supported
+
+@end
+
+
 @interface OXPathLite : NSObject
 
 @property(strong,nonatomic,readonly)NSArray *tagStack;
 @property(strong,nonatomic,readonly)NSArray *tagTypeStack;
 @property(strong,nonatomic,readonly)NSString *pathRoot;
 @property(strong,nonatomic,readonly)NSString *pathLeaf;
+@property(strong,nonatomic,readonly)OXPathPredicate *predicate;     //optional leaf element predicate
 
 - (BOOL)hasRootTag;
 - (BOOL)matches:(NSArray *)tagStack;
@@ -11,6 +11,130 @@
 #import "OXPathMapper.h"    //just need OX_ROOT_PATH
 
 
+#pragma mark - OXPathPredicate
+
+
+@implementation OXPathPredicate
+
+- (id)initPredicate:(OXPredicateType)predicateType name:(NSString *)name comparison:(OXComparisonType)comparison value:(NSString *)value isNumeric:(BOOL)isNumeric
+{
+    if (self = [super init]) {
+        _predicateType = predicateType;
+        _name = name;
+        _comparison = comparison;
+        _value = value;
+        _isNumeric = isNumeric;
+    }
+    return self;
+}
+
++ (id)predicate:(NSString *)expression
+{
+    expression = [OXUtil trim:expression];
+    if ([expression length] == 0)
+        return nil;
+    if ([OXUtil allDigits:expression])      //shorthand: [3] == [position()=3]
+        return [[OXPathPredicate alloc] initPredicate:OXPositionPredicate name:nil comparison:OXEqualComparison value:expression isNumeric:YES];
+    //find comparison operator outside of quotes:
+    static NSString *operators[] = { @"!=", @"<=", @">=", @"=", @"<", @">" };
+    static const OXComparisonType comparisons[] = { OXNotEqualComparison, OXLessEqualComparison, OXGreaterEqualComparison, OXEqualComparison, OXLessComparison, OXGreaterComparison };
+    const NSUInteger len = [expression length];
+    unichar quote = 0;
+    for(NSUInteger i=0;i<len;i++) {
+        const unichar ch = [expression characterAtIndex:i];
+        if (quote) {
+            if (ch == quote)
+                quote = 0;
+        } else if (ch == '\'' || ch == '"') {
+            quote = ch;
+        } else {
+            for(int op=0;op<6;op++) {
+                NSString *opString = operators[op];
+                if (i + [opString length] <= len && [expression compare:opString options:NSLiteralSearch range:NSMakeRange(i, [opString length])] == NSOrderedSame) {
+                    NSString *lhs = [OXUtil trim:[expression substringToIndex:i]];
+                    NSString *rhs = [OXUtil trim:[expression substringFromIndex:i + [opString length]]];
+                    BOOL isQuoted = [rhs length] >= 2 && ([rhs hasPrefix:@"'"] || [rhs hasPrefix:@"\""]);
+                    NSString *value = isQuoted ? [rhs substringWithRange:NSMakeRange(1, [rhs length] - 2)] : rhs;
+                    if ([lhs length] == 0 || [value length] == 0)
+                        return nil;
+                    if ([lhs isEqualToString:@"position()"]) {
+                        return isQuoted ? nil : [[OXPathPredicate alloc] initPredicate:OXPositionPredicate name:nil comparison:comparisons[op] value:value isNumeric:YES];
+                    } else if ([lhs hasPrefix:OX_ATTRIBUTE_PREFIX]) {
+                        return [[OXPathPredicate alloc] initPredicate:OXAttributePredicate name:[lhs substringFromIndex:1] comparison:comparisons[op] value:value isNumeric:!isQuoted];
+                    } else if ([OXUtil isXPathString:lhs] || [lhs rangeOfString:@"("].location != NSNotFound) {
+                        return nil;     //only direct child elements are supported
+                    } else {
+                        return [[OXPathPredicate alloc] initPredicate:OXChildPredicate name:lhs comparison:comparisons[op] value:value isNumeric:!isQuoted];
+                    }
+                }
+            }
+        }
+    }
+    return nil;
+}
+
+- (BOOL)compare:(NSComparisonResult)result
+{
+    switch (_comparison) {
+        case OXEqualComparison:         return result == NSOrderedSame;
+        case OXNotEqualComparison:      return result != NSOrderedSame;
+        case OXLessComparison:          return result == NSOrderedAscending;
+        case OXLessEqualComparison:     return result != NSOrderedDescending;
+        case OXGreaterComparison:       return result == NSOrderedDescending;
+        case OXGreaterEqualComparison:  return result != NSOrderedAscending;
+    }
+    return NO;
+}
+
+- (BOOL)matchesPosition:(NSUInteger)position
+{
+    const NSInteger limit = [_value integerValue];
+    const NSInteger actual = (NSInteger)position;
+    return [self compare:(actual == limit) ? NSOrderedSame : (actual < limit ? NSOrderedAscending : NSOrderedDescending)];
+}
+
+- (BOOL)exhaustedAfterPosition:(NSUInteger)position
+{
+    const NSInteger limit = [_value integerValue];
+    const NSInteger actual = (NSInteger)position;
+    switch (_comparison) {
+        case OXEqualComparison:         return actual >= limit;
+        case OXLessComparison:          return actual >= limit - 1;
+        case OXLessEqualComparison:     return actual >= limit;
+        default:                        return NO;      //!=, > and >= match every position past some point
+    }
+}
+
+- (BOOL)matchesText:(NSString *)text
+{
+    if (text == nil)
+        return NO;
+    if (_isNumeric) {
+        const double actual = [text doubleValue];
+        const double expected = [_value doubleValue];
+        return [self compare:(actual == expected) ? NSOrderedSame : (actual < expected ? NSOrderedAscending : NSOrderedDescending)];
+    } else {
+        return [self compare:[text compare:_value]];
+    }
+}
+
+- (NSString *)description
+{
+    static NSString *operators[] = { @"=", @"!=", @"<", @"<=", @">", @">=" };
+    switch (_predicateType) {
+        case OXPositionPredicate:   return [NSString stringWithFormat:@"[position()%@%@]", operators[_comparison], _value];
+        case OXAttributePredicate:  return [NSString stringWithFormat:@"[@%@%@'%@']", _name, operators[_comparison], _value];
+        case OXChildPredicate:      return [NSString stringWithFormat:@"[%@%@'%@']", _name, operators[_comparison], _value];
+    }
+    return nil;
+}
+
+@end
+
+
+#pragma mark - OXPathLite
+
+
 @interface OXPathLite ()
 - (NSArray *)parsePath:(NSString *)xpath separator:(NSString *)separator;
 - (void)parseTokens:(NSArray *)tokens separator:(NSString *)separator;
@@ -63,6 +187,13 @@ static NSArray *_OXPathTypeArray;
     if (self = [super init]) {
         _tagStack = [[NSMutableArray alloc] init];
         _tagTypeStack = [[NSMutableArray alloc] init];
+        if ([xpath hasSuffix:@"]"]) {   //leaf predicate
+            NSRange open = [xpath rangeOfString:@"["];    //only leaf predicates are supported, values may contain brackets
+            NSAssert1(open.location != NSNotFound, @"ERROR: unbalanced xpath predicate: %@", xpath);
+            _predicate = [OXPathPredicate predicate:[xpath substringWithRange:NSMakeRange(open.location + 1, [xpath length] - open.location - 2)]];
+            NSAssert1(_predicate != nil, @"ERROR: unsupported xpath predicate: %@", xpath);
+            xpath = [xpath substringToIndex:open.location];
+        }
         NSArray *tokens = [self parsePath:xpath separator:separator];
         [self parseTokens:tokens separator:separator];
     }
@@ -0,0 +1,69 @@
+/**
+
+  OXmlColumnReader.h
+  SAXy OX - Object-to-XML mapping library
+
+  Columnar alternative to OXmlReader for analytics over large feeds.  Instead of creating one object per repeated
+  record element, the listed scalar or atomic properties of every record are appended to contiguous OXColumn buffers
+  (int64, double, date-as-epoch or UTF-8 string arena).  Record elements are located with the same mapper used by
+  OXmlReader and element text is converted with the mapper's OXTransform conversions, so column values equal the
+  property values OXmlReader would have set - but no record objects are allocated.
+
+    OXmlColumnReader *reader = [OXmlColumnReader readerWithMapper:mapper recordClass:[Item class] properties:@[@"price", @"published", @"category"]];
+    [reader readXmlData:data];
+    const double *prices = [[reader columnNamed:@"price"] doubleValues];
+    for(NSUInteger i = 0; i < reader.recordCount; i++) total += prices[i];
+
+  Properties must be mapped to attributes, body text or child elements of the record element.  Records nested inside
+  records are not supported, the inner elements are ignored.  Namespace prefixes are resolved as OXmlReader resolves
+  them, and records without a value for a property are flagged in the column's presenceMask.
+
+  Created by agent on 10/19/26.
+
+ */
+#import <Foundation/Foundation.h>
+#import "OXmlMapper.h"
+#import "OXmlContext.h"
+#import "OXColumn.h"
+
+
+@interface OXmlColumnReader : NSObject <NSXMLParserDelegate>
+
+#pragma mark - properties
+@property(strong,nonatomic,readonly) OXmlMapper *mapper;
+@property(assign,nonatomic,readonly) Class recordClass;
+@property(strong,nonatomic,readonly) NSArray *properties;          //property names, in column order
+@property(strong,nonatomic,readonly) NSArray *columns;             //OXColumn list of the last read, in property order
+@property(assign,nonatomic,readonly) NSUInteger recordCount;
+@property(strong,nonatomic,readonly) NSArray *errors;
+@property(strong,nonatomic,readonly) OXmlContext *context;
+@property(assign,nonatomic,readwrite) BOOL useTokenizer;            //read UTF-8 data with OXmlTokenizer instead of NSXMLParser, default: NO
+
+#pragma mark - constructor
++ (id)readerWithMapper:(OXmlMapper *)xmlMapper recordClass:(Class)recordClass properties:(NSArray *)properties;
+
+#pragma mark - parser
+- (NSArray *)readXmlText:(NSString *)xml;                           //returns columns, nil on error
+- (NSArray *)readXmlData:(NSData *)xmlData;                         //returns columns, nil on error
+- (NSArray *)readXml:(NSXMLParser *)parser;
+
+#pragma mark - columns
+- (OXColumn *)columnNamed:(NSString *)property;
+
+@end
+
+//
+//  Copyright (c) 2013 Outsource Cafe, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
@@ -0,0 +1,401 @@
+//
+//  OXmlColumnReader.m
+//  SAXy OX - Object-to-XML mapping library
+//
+//  Created by agent on 10/19/26.
+//
+
+#import "OXmlColumnReader.h"
+#import "OXType.h"
+#import "OXmlElementMapper.h"
+#import "OXmlXPathMapper.h"
+#import "OXmlTokenizer.h"
+#import "NSMutableArray+OXStack.h"
+
+
+#pragma mark - OXColumnFrame
+
+
+typedef enum {
+    OX_COLUMN_PATH_FRAME,       //complex element enclosing records, no object is created
+    OX_COLUMN_RECORD_FRAME,     //record element, values are collected until the element ends
+    OX_COLUMN_VALUE_FRAME,      //mapped column value
+    OX_COLUMN_SKIP_FRAME,       //unmapped element, children are still matched against the enclosing mapper
+    OX_COLUMN_IGNORE_FRAME      //the whole sub-tree is ignored
+} OXColumnFrameEnum;
+
+//state of an open XML element
+@interface OXColumnFrame : NSObject
+@property(assign,nonatomic)OXColumnFrameEnum frameEnum;
+@property(strong,nonatomic)OXmlElementMapper *elementMapper;    //path and record frames
+@property(strong,nonatomic)OXmlXPathMapper *xpathMapper;        //value frames
+@property(assign,nonatomic)NSUInteger columnIndex;              //value frames
+@property(strong,nonatomic)NSDictionary *outerNsBindings;       //bindings to restore when an element declaring namespaces ends
+@end
+
+@implementation OXColumnFrame
+@end
+
+
+#pragma mark - OXmlColumnReader
+
+
+//built-in transformers capture nothing, so every OXTransform shares the same global blocks and a re-registered
+//transformer compares unequal
+static OXTransform *OXBuiltInTransform(void)
+{
+    static OXTransform *transform = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        transform = [[OXTransform alloc] init];
+    });
+    return transform;
+}
+
+
+@implementation OXmlColumnReader
+{
+    NSMutableArray *_errorList;
+    NSMutableArray *_frames;
+    NSDictionary *_columnIndexes;       //NSNumber column index keyed by property name
+    NSIndexSet *_textColumns;           //columns parsing text in place, their mappers use the default scalar transformer
+    BOOL _inRecord;                     //YES between the start and end of a record element
+    NSMutableDictionary *_nsBindings;   //in-scope namespace URIs keyed by prefix, OX_DEFAULT_NAMESPACE for xmlns="..."
+    OXmlTokenizer *_tokenizer;
+}
+
+#pragma mark - constructor
+
+- (id)initWithMapper:(OXmlMapper *)xmlMapper recordClass:(Class)recordClass properties:(NSArray *)properties
+{
+    if (self = [super init]) {
+        NSAssert(xmlMapper != nil && recordClass != nil && [properties count] > 0, @"ERROR: OXmlColumnReader requires a mapper, a record class and at least one property");
+        _mapper = xmlMapper;
+        _recordClass = recordClass;
+        _properties = [properties copy];
+        _context = [[OXmlContext alloc] init];
+        NSMutableDictionary *columnIndexes = [NSMutableDictionary dictionaryWithCapacity:[properties count]];
+        for(NSUInteger i = 0; i < [properties count]; i++) {
+            [columnIndexes setObject:[NSNumber numberWithUnsignedInteger:i] forKey:[properties objectAtIndex:i]];
+        }
+        _columnIndexes = columnIndexes;
+    }
+    return self;
+}
+
++ (id)readerWithMapper:(OXmlMapper *)xmlMapper recordClass:(Class)recordClass properties:(NSArray *)properties
+{
+    return [[OXmlColumnReader alloc] initWithMapper:xmlMapper recordClass:recordClass properties:properties];
+}
+
+
+#pragma mark - error handling
+
+- (void)addErrorMessage:(NSString *)errorMessage
+{
+    if (_errorList == nil)
+        _errorList = [NSMutableArray array];
+    [_errorList addObject:[NSError errorWithDomain:@"com.outsourcecafe.ox" code:99 userInfo:@{NSLocalizedDescriptionKey:errorMessage}]];
+    _errors = _errorList;
+}
+
+
+#pragma mark - columns
+
+- (OXColumn *)columnNamed:(NSString *)property
+{
+    NSNumber *index = [_columnIndexes objectForKey:property];
+    return index ? [_columns objectAtIndex:[index unsignedIntegerValue]] : nil;
+}
+
+- (OXmlXPathMapper *)propertyMapper:(NSString *)property inMapper:(OXmlElementMapper *)recordMapper
+{
+    OXmlXPathMapper *xpathMapper = [recordMapper elementMapperByProperty:property];
+    if (xpathMapper == nil)
+        xpathMapper = [recordMapper attributeMapperByProperty:property];
+    if (xpathMapper == nil && [recordMapper.bodyMapper.toPath isEqualToString:property])
+        xpathMapper = recordMapper.bodyMapper;
+    return xpathMapper;
+}
+
+//custom transformers and formatters still get the boxed path, so a column holds the same value the property setter would
+- (BOOL)parsesText:(OXmlXPathMapper *)xpathMapper
+{
+    OXType *type = xpathMapper.toType;
+    if (type.typeEnum != OX_SCALAR || xpathMapper.formatter || xpathMapper.formatterName)
+        return NO;
+    if (type.scalarEnum == OX_SCALAR_CHAR || type.scalarEnum == OX_SCALAR_UCHAR)
+        return NO;
+    return xpathMapper.toTransform == [OXBuiltInTransform() transformerFrom:[NSString class] toScalarEnum:type.scalarEnum];
+}
+
+//columns are typed after configure, when property types are known
+- (BOOL)createColumns
+{
+    OXmlElementMapper *recordMapper = [_mapper elementMapperForClass:_recordClass];
+    if (recordMapper == nil) {
+        [self addErrorMessage:[NSString stringWithFormat:@"no element mapper registered for %@ record class", NSStringFromClass(_recordClass)]];
+        return NO;
+    }
+    NSMutableArray *columns = [NSMutableArray arrayWithCapacity:[_properties count]];
+    NSMutableIndexSet *textColumns = [NSMutableIndexSet indexSet];
+    for(NSString *property in _properties) {
+        OXmlXPathMapper *xpathMapper = [self propertyMapper:property inMapper:recordMapper];
+        OXColumn *column = xpathMapper ? [OXColumn column:property type:xpathMapper.toType] : nil;
+        if (column == nil) {
+            [self addErrorMessage:[NSString stringWithFormat:@"%@.%@ must be a mapped scalar or atomic property to be read into a column", NSStringFromClass(_recordClass), property]];
+            return NO;
+        }
+        [columns addObject:column];
+        if ([self parsesText:xpathMapper])
+            [textColumns addIndex:[columns count] - 1];
+    }
+    _columns = columns;
+    _textColumns = textColumns;
+    return YES;
+}
+
+- (void)beginRecord
+{
+    for(OXColumn *column in _columns) {
+        [column clearPending];
+    }
+}
+
+- (void)endRecord
+{
+    for(OXColumn *column in _columns) {
+        [column appendPending];
+    }
+    _recordCount++;
+}
+
+- (void)setValue:(NSString *)text mapper:(OXmlXPathMapper *)xpathMapper column:(NSUInteger)columnIndex
+{
+    if (text) {
+        OXColumn *column = [_columns objectAtIndex:columnIndex];
+        if ([_textColumns containsIndex:columnIndex] && [column setPendingText:text])
+            return;
+        _context.currentMapper = xpathMapper;
+        [column setPendingValue:xpathMapper.toTransform ? xpathMapper.toTransform(text, _context) : text];   //same conversion as the property setter
+    }
+}
+
+
+#pragma mark - namespaces
+
+//same resolution as OXmlReader: declared prefixes override the mapper's, URIs the mapper doesn't know fall back to the default namespace
+- (void)registerNamespaces:(NSDictionary *)attributes frame:(OXColumnFrame *)frame
+{
+    for (NSString *name in attributes) {
+        if ([name hasPrefix:@"xmlns"]) {
+            if (frame.outerNsBindings == nil)
+                frame.outerNsBindings = [_nsBindings copy];
+            NSString *prefix = [name length] > 6 ? [name substringFromIndex:6] : OX_DEFAULT_NAMESPACE;    //strip off xmlns:
+            NSString *nsURI = [attributes objectForKey:name];
+            if ([_mapper namespaceIdForURI:nsURI] == NSNotFound)
+                [_nsBindings removeObjectForKey:prefix];
+            else
+                [_nsBindings setObject:nsURI forKey:prefix];
+        }
+    }
+}
+
+- (NSString *)namespaceURIForName:(NSString *)qName colon:(NSRange)colon
+{
+    NSString *nsURI = [_nsBindings objectForKey:colon.location == NSNotFound ? OX_DEFAULT_NAMESPACE : [qName substringToIndex:colon.location]];
+    return nsURI ? nsURI : OX_DEFAULT_NAMESPACE;
+}
+
+
+#pragma mark - NSXMLParserDelegate
+
+- (OXmlElementMapper *)enclosingMapper
+{
+    for(OXColumnFrame *frame in [_frames reverseObjectEnumerator]) {
+        if (frame.frameEnum == OX_COLUMN_PATH_FRAME || frame.frameEnum == OX_COLUMN_RECORD_FRAME)
+            return frame.elementMapper;
+    }
+    return nil;
+}
+
+- (void)startRecord:(OXColumnFrame *)frame attributes:(NSDictionary *)attributes nsURI:(NSString *)nsURI
+{
+    frame.frameEnum = OX_COLUMN_RECORD_FRAME;
+    frame.elementMapper = [_mapper elementMapperForClass:_recordClass];
+    _inRecord = YES;
+    [self beginRecord];
+    for(NSString *attrName in attributes) {
+        if ( ! [attrName hasPrefix:@"xmlns"]) {
+            NSRange colon = [attrName rangeOfString:@":"];
+            NSString *key = colon.location == NSNotFound ? attrName : [attrName substringFromIndex:colon.location + 1];
+            NSString *attrNSURI = colon.location == NSNotFound ? nsURI : [self namespaceURIForName:attrName colon:colon];
+            OXmlXPathMapper *attributeMapper = [frame.elementMapper attributeMapperByTag:key nsURI:attrNSURI];
+            NSNumber *columnIndex = attributeMapper ? [_columnIndexes objectForKey:attributeMapper.toPath] : nil;
+            if (columnIndex)
+                [self setValue:_context.attributeFilterBlock(key, [attributes objectForKey:attrName]) mapper:attributeMapper column:[columnIndex unsignedIntegerValue]];
+        }
+    }
+}
+
+- (void)parser:(NSXMLParser *)parser didStartElement:(NSString *)tag namespaceURI:(NSString *)nsURI qualifiedName:(NSString *)qName attributes:(NSDictionary *)attributes
+{
+    OXColumnFrame *top = [_frames peek];
+    OXColumnFrame *frame = [[OXColumnFrame alloc] init];
+    frame.frameEnum = OX_COLUMN_SKIP_FRAME;
+    if ([attributes count] > 0)
+        [self registerNamespaces:attributes frame:frame];
+    NSRange colon = [tag rangeOfString:@":"];
+    NSString *elementName = colon.location == NSNotFound ? tag : [tag substringFromIndex:colon.location + 1];
+    NSString *nsURI = [self namespaceURIForName:tag colon:colon];
+    [_context.pathStack push:elementName];
+    [_context clearText];
+    if (top.frameEnum == OX_COLUMN_VALUE_FRAME || top.frameEnum == OX_COLUMN_IGNORE_FRAME) {
+        frame.frameEnum = OX_COLUMN_IGNORE_FRAME;
+    } else {
+        OXmlElementMapper *parentMapper = [self enclosingMapper];
+        OXmlXPathMapper *xpathMapper = [parentMapper.ignoreProperties containsObject:elementName] ? nil : [parentMapper matchPathStack:_context.pathStack forNSURI:nsURI];
+        if (xpathMapper) {
+            OXType *type = xpathMapper.toType;
+            Class complexClass = type.typeEnum == OX_COMPLEX ? type.type
+                               : (type.typeEnum == OX_CONTAINER && type.containerChildType.typeEnum == OX_COMPLEX ? type.containerChildType.type : nil);
+            if (_inRecord) {
+                NSNumber *columnIndex = complexClass ? nil : [_columnIndexes objectForKey:xpathMapper.toPath];
+                if (columnIndex && parentMapper == [_mapper elementMapperForClass:_recordClass]) {
+                    frame.frameEnum = OX_COLUMN_VALUE_FRAME;
+                    frame.xpathMapper = xpathMapper;
+                    frame.columnIndex = [columnIndex unsignedIntegerValue];
+                } else {
+                    frame.frameEnum = OX_COLUMN_IGNORE_FRAME;   //unlisted property or nested object
+                }
+            } else if ([complexClass isSubclassOfClass:_recordClass]) {
+                [self startRecord:frame attributes:attributes nsURI:nsURI];
+            } else if (complexClass) {
+                OXmlElementMapper *elementMapper = [_mapper elementMapperForClass:complexClass];
+                frame.frameEnum = elementMapper ? OX_COLUMN_PATH_FRAME : OX_COLUMN_IGNORE_FRAME;
+                frame.elementMapper = elementMapper;
+            } else {
+                frame.frameEnum = OX_COLUMN_IGNORE_FRAME;       //value outside of records
+            }
+        }
+    }
+    [_frames push:frame];
+}
+
+- (void)parser:(NSXMLParser *)parser foundCharacters:(NSString *)text
+{
+    OXColumnFrame *top = [_frames peek];
+    if (top.frameEnum == OX_COLUMN_VALUE_FRAME || top.frameEnum == OX_COLUMN_RECORD_FRAME)
+        [_context appendText:text];
+}
+
+- (void)parser:(NSXMLParser *)parser foundCDATA:(NSData *)CDATABlock
+{
+    [self parser:parser foundCharacters:[[NSString alloc] initWithData:CDATABlock encoding:NSUTF8StringEncoding]];
+}
+
+- (void)parser:(NSXMLParser *)parser didEndElement:(NSString *)tag namespaceURI:(NSString *)nsURI qualifiedName:(NSString *)qName
+{
+    OXColumnFrame *frame = [_frames pop];
+    NSString *elementName = [_context.pathStack peek];
+    switch (frame.frameEnum) {
+        case OX_COLUMN_VALUE_FRAME: {
+            [self setValue:_context.elementFilterBlock(elementName, [_context text]) mapper:frame.xpathMapper column:frame.columnIndex];
+            break;
+        }
+        case OX_COLUMN_RECORD_FRAME: {
+            OXmlXPathMapper *bodyMapper = frame.elementMapper.bodyMapper;
+            NSNumber *columnIndex = bodyMapper ? [_columnIndexes objectForKey:bodyMapper.toPath] : nil;
+            if (columnIndex)
+                [self setValue:_context.elementFilterBlock(nil, [_context text]) mapper:bodyMapper column:[columnIndex unsignedIntegerValue]];
+            [self endRecord];
+            _inRecord = NO;
+            break;
+        }
+        default:
+            break;
+    }
+    if (frame.outerNsBindings)
+        [_nsBindings setDictionary:frame.outerNsBindings];
+    [_context.pathStack pop];
+    [_context clearText];
+}
+
+- (void)parser:(NSXMLParser *)parser parseErrorOccurred:(NSError *)parseError
+{
+    NSString *errMsg = [NSString stringWithFormat:@"XML Parsing Error %li, Description: %@, Line: %li, Column: %li",
+                        (long)[parseError code],
+                        [parseError localizedDescription],
+                        (long)(parser ? [parser lineNumber] : _tokenizer.lineNumber),
+                        (long)(parser ? [parser columnNumber] : _tokenizer.columnNumber)];
+    [self addErrorMessage:errMsg];
+}
+
+
+#pragma mark - parser
+
+//exactly one of parser or tokenizer is set, both drive the same NSXMLParserDelegate callbacks
+- (NSArray *)readXml:(NSXMLParser *)parser tokenizer:(OXmlTokenizer *)tokenizer
+{
+    [_context reset];
+    _errorList = nil;
+    _errors = [_mapper configure:_context];
+    if (_errors || ! [self createColumns])
+        return nil;
+    _recordCount = 0;
+    _inRecord = NO;
+    _nsBindings = [NSMutableDictionary dictionaryWithDictionary:_mapper.nsByPrefix];
+    _frames = [NSMutableArray array];
+    OXColumnFrame *root = [[OXColumnFrame alloc] init];
+    root.frameEnum = OX_COLUMN_PATH_FRAME;
+    root.elementMapper = _mapper.rootMapper;
+    [_frames push:root];
+    [_context.pathStack push:OX_ROOT_PATH];
+    _tokenizer = tokenizer;
+    _tokenizer.delegate = self;
+    [parser setDelegate:self];
+    [parser setShouldResolveExternalEntities:NO];
+    BOOL parsed = tokenizer ? [tokenizer parse] : [parser parse];   //if not successful, delegate is informed of error
+    _tokenizer = nil;
+    _frames = nil;
+    _nsBindings = nil;
+    [_context reset];
+    if ( ! parsed && _errors == nil)
+        [self addErrorMessage:@"XML parsing failed"];
+    return _errors ? nil : _columns;
+}
+
+- (NSArray *)readXml:(NSXMLParser *)parser
+{
+    return [self readXml:parser tokenizer:nil];
+}
+
+- (NSArray *)readXmlData:(NSData *)xmlData
+{
+    if (_useTokenizer && [OXmlTokenizer canTokenize:xmlData])
+        return [self readXml:nil tokenizer:[OXmlTokenizer tokenizerWithData:xmlData]];
+    return [self readXml:[[NSXMLParser alloc] initWithData:xmlData]];
+}
+
+- (NSArray *)readXmlText:(NSString *)xml
+{
+    return [self readXmlData:[xml dataUsingEncoding:NSUTF8StringEncoding]];
+}
+
+@end
+
+//
+//  Copyright (c) 2013 Outsource Cafe, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
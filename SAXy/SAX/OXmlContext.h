@@ -46,12 +46,16 @@ typedef NSString* (^OXmlElementFilterBlock)(NSString *elementName, NSString *ele
 - (OXSAXActionEnum)popMappingType;
 - (OXSAXActionEnum)peekMappingType;
 - (OXSAXActionEnum)peekMappingTypeAtIndex:(NSInteger)index;
+- (NSUInteger)mappingTypeCount;
 
 #pragma mark - element body text 
 - (NSString *)text;
 - (void)clearText;
 - (void)appendText:(NSString *)text;
 
+#pragma mark - nested contexts
+- (OXmlContext *)childContext;      //new context sharing transform, filters, objectPool, internTable, limits and logging flags - used for lazy decoding
+
 #pragma mark - debug
 - (NSString *)tagPath;
 + (id)contextWithPathStack:(NSArray *)tagStack;
@@ -34,9 +34,9 @@ static NSArray *_mappingTypeWrappers;
 }
 
 
-- (id)init
+- (id)initWithTransform:(OXTransform *)transform
 {
-    if ((self = [super init])) {
+    if ((self = [super initWithTransform:transform])) {
         _mappingTypeStack = [[NSMutableArray alloc] init];
         _currentStringValue = [[NSMutableString alloc] initWithCapacity:250];
         //_namespaces = [[NSMutableDictionary alloc] init];
@@ -75,6 +75,10 @@ static NSArray *_mappingTypeWrappers;
 {
     return (OXSAXActionEnum)[[_mappingTypeStack lastObject] intValue];
 }
+- (NSUInteger)mappingTypeCount
+{
+    return [_mappingTypeStack count];
+}
 - (OXSAXActionEnum)peekMappingTypeAtIndex:(NSInteger)index
 {
     NSInteger reverseIndex = [_mappingTypeStack count] - (index + 1);
@@ -114,6 +118,22 @@ static NSArray *_mappingTypeWrappers;
     }
 }
 
+#pragma mark - nested contexts
+
+- (OXmlContext *)childContext
+{
+    OXmlContext *ctx = [[OXmlContext alloc] initWithTransform:self.transform];
+    ctx.attributeFilterBlock = _attributeFilterBlock;
+    ctx.elementFilterBlock = _elementFilterBlock;
+    ctx.objectPool = self.objectPool;
+    OXInternTable *internTable = [OXInternTable internTableWithMaxCount:self.internTable.maxCount];  //tables aren't thread safe, children may decode on other threads
+    internTable.maxLength = self.internTable.maxLength;
+    ctx.internTable = internTable;
+    ctx.logReaderStack = self.logReaderStack;
+    [ctx copyLimitsFrom:self];
+    return ctx;
+}
+
 #pragma mark - debug
 - (NSString *)tagPath
 {
@@ -87,8 +87,10 @@
 - (OXmlElementMapper *)xpath:(NSString *)xpath property:(NSString*)property;
 - (OXmlElementMapper *)xpath:(NSString *)xpath property:(NSString*)property type:(Class)propertyClass;
 - (OXmlElementMapper *)xpath:(NSString *)xpath property:(NSString*)property scalarType:(char const *)encodedType;
+- (OXmlElementMapper *)xpath:(NSString *)xpath property:(NSString*)property blobSink:(OXBlobSinkBlock)sinkFactory;  //stream large (base64) element text, see OXBlobSink
 - (OXmlElementMapper *)body:(NSString *)bodyProperty;
 - (OXmlElementMapper *)body:(NSString *)bodyProperty scalarType:(char const *)encodedType;
+- (OXmlElementMapper *)body:(NSString *)bodyProperty blobSink:(OXBlobSinkBlock)sinkFactory;      //stream large (base64) body text, see OXBlobSink
 - (OXmlElementMapper *)attribute:(NSString *)tag;
 - (OXmlElementMapper *)attributes:(NSArray *)tags;
 - (OXmlElementMapper *)attribute:(NSString *)tag scalarType:(char const *)encodedType;
@@ -107,6 +109,7 @@
 
 #pragma mark - lookup 
 - (OXmlXPathMapper *)matchPathStack:(NSArray *)tagStack forNSPrefix:(NSString *)nsPrefix;
+- (OXmlXPathMapper *)matchPathStack:(NSArray *)tagStack forNSURI:(NSString *)nsURI;
 - (OXmlXPathMapper *)elementMapperByTag:(NSString *)tag nsURI:(NSString *)nsURI;
 - (OXmlXPathMapper *)attributeMapperByTag:(NSString *)tag nsURI:(NSString *)nsURI;
 - (OXmlXPathMapper *)elementMapperByProperty:(NSString *)property;
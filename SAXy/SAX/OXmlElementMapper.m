@@ -11,6 +11,7 @@
 #import "OXProperty.h"
 #import "OXmlMapper.h"
 #import "OXUtil.h"
+#import "OXGeneratedMapping.h"
 
 
 ////////////////////////////////////////////////////////////////////////////////////////
@@ -116,9 +117,10 @@
 
 + (id)rootXPath:(NSString *)xpath type:(Class)toType nsURI:(NSString *)nsURI
 {
-    OXPathLite *path = [OXPathLite xpath:xpath];  //split root path into root and leaf segments:
-    NSString *leafPath = path.pathLeaf;
-    NSString *rootPath = [xpath substringToIndex:[xpath length] - [leafPath length]];
+    OXPathLite *path = [OXPathLite xpath:xpath];  //split root path into root and leaf segments, the leaf keeps its predicate:
+    const NSUInteger predicateStart = path.predicate ? [xpath rangeOfString:@"["].location : [xpath length];
+    NSString *rootPath = [xpath substringToIndex:predicateStart - [path.pathLeaf length]];
+    NSString *leafPath = [xpath substringFromIndex:[rootPath length]];
     return [[OXmlElementMapper rootXPath:rootPath nsURI:nsURI]
             xpath:leafPath property:@"result" type:toType];
 }
@@ -130,9 +132,10 @@
 
 + (id)rootXPath:(NSString *)xpath toMany:(Class)toType nsURI:(NSString *)nsURI
 {
-    OXPathLite *path = [OXPathLite xpath:xpath];  //split root path into root and leaf segments:
-    NSString *leafPath = path.pathLeaf;
-    NSString *rootPath = [xpath substringToIndex:[xpath length] - [leafPath length]];
+    OXPathLite *path = [OXPathLite xpath:xpath];  //split root path into root and leaf segments, the leaf keeps its predicate:
+    const NSUInteger predicateStart = path.predicate ? [xpath rangeOfString:@"["].location : [xpath length];
+    NSString *rootPath = [xpath substringToIndex:predicateStart - [path.pathLeaf length]];
+    NSString *leafPath = [xpath substringFromIndex:[rootPath length]];
     return [[OXmlElementMapper rootXPath:rootPath nsURI:nsURI]
             xpath:leafPath toMany:toType property:@"result"];
 }
@@ -346,7 +349,7 @@
 
 - (void)configureRootElement:(OXContext *)context       //TODO move to OXComplexMapper?
 {
-    self.factory = ^(NSString *path, OXContext *ctx){ return context; }; //just return existing context instance
+    self.factory = ^(NSString *path, OXContext *ctx){ return ctx; };     //the reading context, readers on other threads pass their own
     self.lock = YES;                                                        //don't map other context properties
     NSArray *propertyKeys = self.orderedElementPropertyKeys;
     NSUInteger keyCount = propertyKeys ? [propertyKeys count] : 0;
@@ -398,7 +401,9 @@
                 switch (property.type.typeEnum) {
                     case OX_CONTAINER: {
                         //unknown source type, polymprphic child type (aka NSObject) and guess that tag is singular form of property name:
-                        NSString *singularTag = [OXUtil guessSingularNoun:name];
+                        NSString *singularTag = [OXGeneratedMapping tagForClass:self.toType.type property:name];   //generated ahead-of-time?
+                        if (singularTag == nil)
+                            singularTag = [OXUtil guessSingularNoun:name];
                         simpleMapper = [[OXmlXPathMapper alloc] initMapperToType:property.type toPath:name fromType:nil fromPath:singularTag];
                         break;
                     }
@@ -430,6 +435,17 @@
     }
 }
 
+//categorize eagerly, so lookups made while reading (possibly from several threads) never mutate the mapper
+- (NSArray *)configure:(OXContext *)context
+{
+    BOOL wasConfigured = self.isConfigured;
+    NSArray *errors = [super configure:context];
+    if ( ! wasConfigured && _elementMapByProperty == nil) {
+        [self categorizePropertiesByTag];
+    }
+    return errors;
+}
+
 #pragma mark - builder pattern
 
 // OXmlXPathMapper constructors:
@@ -510,6 +526,11 @@
     return [self addSimpleMapping: [OXmlXPathMapper xpath:xpath type:propertyClass property:property]];
 }
 
+- (OXmlElementMapper *)xpath:(NSString *)xpath property:(NSString*)property blobSink:(OXBlobSinkBlock)sinkFactory
+{
+    return [self addSimpleMapping: [[OXmlXPathMapper xpath:xpath type:nil property:property] blobSink:sinkFactory]];
+}
+
 - (OXmlElementMapper *)xpath:(NSString *)xpath property:(NSString*)property scalarType:(char const *)encodedType
 {
     return [self addSimpleMapping: [OXmlXPathMapper xpath:xpath scalar:encodedType property:property]];
@@ -525,6 +546,11 @@
     return [self addSimpleMapping: [OXmlXPathMapper xpath:@"text()" scalar:encodedType property:bodyProperty]];
 }
 
+- (OXmlElementMapper *)body:(NSString *)bodyProperty blobSink:(OXBlobSinkBlock)sinkFactory
+{
+    return [self addSimpleMapping: [[OXmlXPathMapper xpath:@"text()" type:nil property:bodyProperty] blobSink:sinkFactory]];
+}
+
 - (OXmlElementMapper *)attribute:(NSString *)tag
 {
     NSString *attr = [OXmlXPathMapper xpathToAttribute:tag];
@@ -634,7 +660,11 @@
 //- (OXPathMapper *)matchPath:(OXContext *)context forNSPrefix:(NSString *)nsPrefix
 - (OXmlXPathMapper *)matchPathStack:(NSArray *)tagStack forNSPrefix:(NSString *)nsPrefix
 {
-    NSString *nsURI = nsPrefix ? [_parentMapper.nsByPrefix objectForKey:nsPrefix] : nil;
+    return [self matchPathStack:tagStack forNSURI:nsPrefix ? [_parentMapper.nsByPrefix objectForKey:nsPrefix] : nil];
+}
+
+- (OXmlXPathMapper *)matchPathStack:(NSArray *)tagStack forNSURI:(NSString *)nsURI
+{
     NSString *leaf = [tagStack peek];
     OXmlXPathMapper *mapper = [self elementMapperByTag:leaf nsURI:nsURI];
     while (mapper) {
@@ -19,6 +19,7 @@
 @property(strong,nonatomic,readonly)OXmlElementMapper *rootMapper;  //holds root mapper instance
 @property(strong,nonatomic,readonly)NSDictionary *nsByURI;          //lookup table of current nsPrefixes key by nsURIs
 @property(strong,nonatomic,readonly)NSDictionary *nsByPrefix;       //lookup table of current nsURIs key by nsPrefixes
+@property(strong,nonatomic,readonly)NSArray *nsURIById;           //namespace URIs indexed by namespace id, append-only
 @property(strong,nonatomic,readonly)NSString *nsPrefix;             //root or default namespace prefix
 @property(strong,nonatomic,readonly)NSString *nsURI;                //root or default namespace URI
 @property(assign,nonatomic,readonly)BOOL namespaceAware;            //set internally when namespace processing is active
@@ -37,6 +38,8 @@
 - (OXmlElementMapper *)elementMapperForPath:(NSString *)xpath;
 - (OXmlElementMapper *)elementMapperForClass:(Class)type;
 - (OXmlElementMapper *)matchElement:(OXContext *)context nsPrefix:(NSString *)nsPrefix;
+- (NSArray *)mappedClasses;                                     //snapshot of the classes with element mappers, does not configure
+- (NSUInteger)namespaceIdForURI:(NSString *)nsURI;              //index into nsURIById, NSNotFound if the URI is not mapped
 
 #pragma mark - configure
 - (NSArray *)configure:(OXContext *)context;
@@ -8,6 +8,7 @@
 #import "OXmlMapper.h"
 #import "NSMutableArray+OXStack.h"
 #import "OXContext.h"
+#include <stdatomic.h>
 
 
 @implementation OXmlMapper
@@ -16,7 +17,10 @@
     NSMutableDictionary *_elementMappersByNSURI;
     NSMutableDictionary *_nsByURI;
     NSMutableDictionary *_nsByPrefix;
+    NSDictionary *_nsIdByURI;
     OXmlContext *_context;
+    _Atomic(CFDictionaryRef) _configuredByClass;    //immutable table of configured mappers keyed by Class, read without a lock
+    NSMutableArray *_retiredTables;                 //replaced tables, kept until dealloc for readers that may still hold them
 }
 
 
@@ -25,6 +29,9 @@
 - (id)initWithRootNamespace:(NSString *)nsURI recommendedPrefix:(NSString *)nsPrefix
 {
     if (self = [super init]) {
+        _nsURIById = @[];
+        _nsIdByURI = @{};
+        [self registerNamespaceURI:OX_DEFAULT_NAMESPACE];  //id 0
         _nsURI = nsURI;
         _nsPrefix = nsPrefix;
         [self defaultPrefix:nsPrefix forNamespaceURI:nsURI];
@@ -47,8 +54,26 @@
     return [[OXmlMapper alloc] initWithRootNamespace:nsURI recommendedPrefix:nsPrefix];
 }
 
+- (void)dealloc
+{
+    CFDictionaryRef table = atomic_load_explicit(&_configuredByClass, memory_order_relaxed);
+    if (table)
+        CFRelease(table);
+}
+
 #pragma mark - utility
 
+//ids are never reassigned, so readers holding an older nsURIById array stay valid
+- (void)registerNamespaceURI:(NSString *)nsURI
+{
+    if (nsURI && [_nsIdByURI objectForKey:nsURI] == nil) {
+        NSMutableDictionary *nsIdByURI = [_nsIdByURI mutableCopy];
+        [nsIdByURI setObject:[NSNumber numberWithUnsignedInteger:[_nsURIById count]] forKey:nsURI];
+        _nsIdByURI = nsIdByURI;
+        _nsURIById = [_nsURIById arrayByAddingObject:nsURI];
+    }
+}
+
 - (void)setNSPrefix:(NSString *)nsPrefix forNamespaceURI:(NSString *)nsURI override:(BOOL)overridePrefix
 {
     if (_nsByPrefix == nil) {
@@ -68,6 +93,7 @@
     }
     [_nsByPrefix setObject:nsURI forKey:prefix];
     [_nsByURI setObject:prefix forKey:nsURI];
+    [self registerNamespaceURI:nsURI];
 }
 
 
@@ -90,6 +116,7 @@
     if (nsMap == nil) {
         nsMap = [NSMutableDictionary dictionaryWithCapacity:11];
         [_elementMappersByNSURI setObject:nsMap forKey:mapper.nsURI];
+        [self registerNamespaceURI:mapper.nsURI];
     }
     //sanity checks:
     NSString *keyTag = mapper.fromPathLeaf;
@@ -156,27 +183,73 @@
 {
     return [self mapperFromPathStack:context.pathStack nsPrefix:nsPrefix];
 }
+- (NSUInteger)namespaceIdForURI:(NSString *)nsURI
+{
+    NSNumber *nsId = nsURI ? [_nsIdByURI objectForKey:nsURI] : nil;
+    return nsId ? [nsId unsignedIntegerValue] : NSNotFound;
+}
+
 - (OXmlElementMapper *)elementMapperForPath:(NSString *)xpath
 {
     OXPathLite *xPathLite = [OXPathLite xpath:xpath];
     return [self mapperFromPathStack:xPathLite.tagStack nsPrefix:nil];
 }
 
+//called with the lock held: republishes the configured mappers if any were added since the last table was built
+- (void)publishConfiguredMappers
+{
+    CFDictionaryRef table = atomic_load_explicit(&_configuredByClass, memory_order_relaxed);
+    NSMutableDictionary *configured = [NSMutableDictionary dictionaryWithCapacity:[_mappersIndexedByClass count]];
+    for(OXmlElementMapper *mapper in [_mappersIndexedByClass objectEnumerator]) {
+        if (mapper.isConfigured && mapper.toType.type)
+            [configured setObject:mapper forKey:(id<NSCopying>)mapper.toType.type];
+    }
+    if (table && CFDictionaryGetCount(table) == (CFIndex)[configured count])
+        return;
+    if (table) {
+        if (_retiredTables == nil)
+            _retiredTables = [NSMutableArray array];
+        [_retiredTables addObject:(__bridge_transfer NSDictionary *)table];
+    }
+    atomic_store_explicit(&_configuredByClass, (CFDictionaryRef)CFBridgingRetain([configured copy]), memory_order_release);
+}
+
 - (OXmlElementMapper *)elementMapperForClass:(Class)type
 {
-    NSString *className = NSStringFromClass(type);
-    OXmlElementMapper *mapper = [_mappersIndexedByClass objectForKey:className];
-    if (mapper == nil) { // && ! [className hasPrefix:@"NS"]
-        //build a mapper on-the-fly
-        mapper = [OXmlElementMapper elementClass:type];
-        if (mapper != nil) {
-            [self addElementMapper:mapper];
+    //called for every complex element, so configured mappers are found without taking the lock:
+    CFDictionaryRef table = atomic_load_explicit(&_configuredByClass, memory_order_acquire);
+    OXmlElementMapper *configured = table ? (__bridge OXmlElementMapper *)CFDictionaryGetValue(table, (__bridge const void *)type) : nil;
+    if (configured)
+        return configured;
+    @synchronized(self) {   //on-the-fly mappers may be added by readers sharing this mapper
+        NSString *className = NSStringFromClass(type);
+        OXmlElementMapper *mapper = [_mappersIndexedByClass objectForKey:className];
+        if (mapper == nil) { // && ! [className hasPrefix:@"NS"]
+            //build a mapper on-the-fly
+            mapper = [OXmlElementMapper elementClass:type];
+            if (mapper != nil) {
+                [self addElementMapper:mapper];
+            }
+        }
+        if ( ! mapper.isConfigured && _context) {
+            [mapper configure:_context];
         }
+        if (mapper.isConfigured)
+            [self publishConfiguredMappers];
+        return mapper;
     }
-    if ( ! mapper.isConfigured && _context) {
-        [mapper configure:_context];
+}
+
+- (NSArray *)mappedClasses
+{
+    @synchronized(self) {
+        NSMutableArray *classes = [NSMutableArray arrayWithCapacity:[_mappersIndexedByClass count]];
+        for(OXmlElementMapper *mapper in [_mappersIndexedByClass objectEnumerator]) {
+            if (mapper.toType.type)
+                [classes addObject:mapper.toType.type];
+        }
+        return classes;
     }
-    return mapper;
 }
 
 
@@ -184,15 +257,18 @@
 
 - (NSArray *)configure:(OXContext *)context
 {
-    _context = (OXmlContext *)context;
-    NSArray *errors = nil;
-    for(NSDictionary *mapperNS in [_elementMappersByNSURI allValues]) {
-        for(OXPathMapper *mapper in [mapperNS allValues]) {
-            NSArray *subErrors = [mapper configure:context];
-            errors = subErrors == nil ? errors : (errors ? [subErrors arrayByAddingObjectsFromArray:errors] : subErrors);
+    @synchronized(self) {   //readers on other threads (or OXMetadataRegistry warmUp:) may configure concurrently
+        _context = (OXmlContext *)context;
+        NSArray *errors = nil;
+        for(NSDictionary *mapperNS in [_elementMappersByNSURI allValues]) {
+            for(OXPathMapper *mapper in [mapperNS allValues]) {
+                NSArray *subErrors = [mapper configure:context];
+                errors = subErrors == nil ? errors : (errors ? [subErrors arrayByAddingObjectsFromArray:errors] : subErrors);
+            }
         }
+        [self publishConfiguredMappers];
+        return errors;
     }
-    return errors;
 }
 
 - (void)overridePrefix:(NSString *)nsPrefix forNamespaceURI:(NSString *)nsURI
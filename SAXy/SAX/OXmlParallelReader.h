@@ -0,0 +1,67 @@
+/**
+
+  OXmlParallelReader.h
+  SAXy OX - Object-to-XML mapping library
+
+  Multi-core reader for large documents whose bulk is one repeated toMany: record element, i.e. /rss/channel/item.
+  A byte-level pre-scan locates the record elements, then the records are split into chunks of about chunkSize bytes
+  and each chunk is parsed by its own OXmlReader on a concurrent dispatch queue:
+
+    * every chunk is wrapped in the document prolog and the raw start tags of the record's ancestors, so namespace
+      declarations and ancestor attributes are in scope, then closed with matching end tags
+    * the first chunk keeps the rest of the document (non-record content before and after the records) and its
+      result is the returned graph
+    * records of the other chunks are appended to the first chunk's container in document order, using the
+      container property's containerBuilder or appender - the result equals an OXmlReader read
+
+    OXmlParallelReader *reader = [OXmlParallelReader readerWithMapper:mapper recordPath:@"/rss/channel/item"];
+    RSS *rss = [reader readXmlData:data];
+
+  The mapper is shared, workers get their own OXmlContext sharing the template context's transform and filters.  The
+  record path is matched by local name.  All records must have the same parent element, separated by whitespace or
+  comments only.  Otherwise, and for non-UTF-8, compressed or small documents, or a template context with an
+  identityMap, the document is read sequentially with a single OXmlReader.
+
+  Created by agent on 10/19/26.
+
+ */
+#import <Foundation/Foundation.h>
+#import "OXmlMapper.h"
+#import "OXmlContext.h"
+
+
+@interface OXmlParallelReader : NSObject
+
+#pragma mark - properties
+@property(strong,nonatomic,readonly) OXmlMapper *mapper;
+@property(strong,nonatomic,readonly) NSArray *recordPath;          //local names, root element first
+@property(strong,nonatomic,readonly) NSArray *errors;              //errors of all chunks, nil on success
+@property(strong,nonatomic,readonly) OXmlContext *context;         //template: transform, filters, limits and logging flags are copied to worker contexts
+@property(assign,nonatomic,readwrite) NSUInteger chunkSize;         //record bytes per worker chunk, default: 256KB
+@property(assign,nonatomic,readwrite) BOOL useTokenizer;            //workers read with OXmlTokenizer instead of NSXMLParser, default: YES
+@property(assign,nonatomic,readonly) NSUInteger chunkCount;        //chunks of the last read, 1 if read sequentially
+
+#pragma mark - constructor
++ (id)readerWithMapper:(OXmlMapper *)xmlMapper recordPath:(NSString *)recordPath;
+
+#pragma mark - parser
+- (id)readXmlText:(NSString *)xml;                                  //returns result graph, nil on error
+- (id)readXmlData:(NSData *)xmlData;                                //returns result graph, nil on error
+
+@end
+
+//
+//  Copyright (c) 2013 Outsource Cafe, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
@@ -0,0 +1,427 @@
+//
+//  OXmlParallelReader.m
+//  SAXy OX - Object-to-XML mapping library
+//
+//  Created by agent on 10/19/26.
+//
+
+#import "OXmlParallelReader.h"
+#import "OXType.h"
+#import "OXmlXPathMapper.h"
+#import "OXmlReader.h"
+#import "OXmlTokenizer.h"
+#import "OXGzipStream.h"
+#import "NSMutableArray+OXStack.h"
+
+#define OX_PARALLEL_CHUNK_SIZE (256 * 1024)
+#define OX_PARALLEL_MAX_DEPTH 32
+
+
+#pragma mark - record scanner
+
+
+//raw start tag of an element enclosing the records
+typedef struct {
+    NSUInteger start;           //offset of '<'
+    NSUInteger length;          //through '>'
+    NSUInteger nameLength;      //qualified name, starts at start + 1
+} OXTagRange;
+
+//returns the position following terminator, NULL if not found
+static const char *OXSkipPast(const char *p, const char *end, const char *terminator, size_t n)
+{
+    while ((p = memchr(p, terminator[0], end - p)) != NULL) {
+        if ((size_t)(end - p) < n)
+            return NULL;
+        if (memcmp(p, terminator, n) == 0)
+            return p + n;
+        p++;
+    }
+    return NULL;
+}
+
+//returns the position following the closing '>', skipping quoted values and DOCTYPE internal subsets
+static const char *OXTagEnd(const char *p, const char *end)
+{
+    char quote = 0;
+    int brackets = 0;
+    for(; p < end; p++) {
+        const char c = *p;
+        if (quote) {
+            if (c == quote)
+                quote = 0;
+        } else if (c == '"' || c == '\'') {
+            quote = c;
+        } else if (c == '[') {
+            brackets++;
+        } else if (c == ']') {
+            brackets--;
+        } else if (c == '>' && brackets <= 0) {
+            return p + 1;
+        }
+    }
+    return NULL;
+}
+
+static BOOL OXIsSpace(char c)
+{
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+//YES if there are only whitespace and comments between p and end
+static BOOL OXBlankGap(const char *p, const char *end)
+{
+    while (p < end) {
+        if (OXIsSpace(*p)) {
+            p++;
+        } else if (end - p >= 4 && memcmp(p, "<!--", 4) == 0) {
+            p = OXSkipPast(p + 4, end, "-->", 3);
+            if (p == NULL || p > end)
+                return NO;
+        } else {
+            return NO;
+        }
+    }
+    return YES;
+}
+
+//Appends the NSRange of every element at the record path to records and copies the start tags enclosing them to
+//ancestors (count - 1 entries).  Returns NO if the document doesn't fit the parallel model: malformed markup, or
+//records with different parents.  Names are compared by local name.
+static BOOL OXScanRecords(const char *bytes, NSUInteger length, const char **names, const size_t *nameLengths, NSUInteger count,
+                          OXTagRange *ancestors, NSUInteger *prologEnd, NSMutableData *records)
+{
+    const char *p = bytes;
+    const char *end = bytes + length;
+    NSUInteger depth = 0;                       //open elements
+    NSUInteger matched = 0;                     //leading open elements matching the record path
+    OXTagRange open[OX_PARALLEL_MAX_DEPTH];
+    const char *recordStart = NULL;             //set while inside a record
+    NSUInteger parentStart = NSNotFound;
+    *prologEnd = NSNotFound;
+    while ((p = memchr(p, '<', end - p)) != NULL) {
+        const char *tag = p;
+        const NSUInteger left = end - p;
+        if (left >= 4 && memcmp(p, "<!--", 4) == 0) {
+            p = OXSkipPast(p + 4, end, "-->", 3);
+        } else if (left >= 9 && memcmp(p, "<![CDATA[", 9) == 0) {
+            p = OXSkipPast(p + 9, end, "]]>", 3);
+        } else if (left >= 2 && p[1] == '?') {
+            p = OXSkipPast(p + 2, end, "?>", 2);
+        } else if (left >= 2 && p[1] == '!') {
+            p = OXTagEnd(p + 2, end);
+        } else if (left >= 2 && p[1] == '/') {
+            p = OXTagEnd(p + 2, end);
+            if (p == NULL || depth == 0)
+                return NO;
+            depth--;
+            if (matched > depth)
+                matched = depth;
+            if (recordStart && depth == count - 1) {
+                NSRange record = NSMakeRange(recordStart - bytes, p - recordStart);
+                [records appendBytes:&record length:sizeof(NSRange)];
+                recordStart = NULL;
+            }
+        } else {
+            const char *name = p + 1;
+            const char *nameEnd = name;
+            const char *local = name;
+            while (nameEnd < end && ! OXIsSpace(*nameEnd) && *nameEnd != '/' && *nameEnd != '>') {
+                if (*nameEnd == ':')
+                    local = nameEnd + 1;
+                nameEnd++;
+            }
+            p = OXTagEnd(nameEnd, end);
+            if (p == NULL)
+                return NO;
+            const BOOL empty = p[-2] == '/';
+            if (*prologEnd == NSNotFound)
+                *prologEnd = tag - bytes;
+            if (recordStart == NULL && depth < count && matched == depth
+                    && (size_t)(nameEnd - local) == nameLengths[depth] && memcmp(local, names[depth], nameLengths[depth]) == 0) {
+                if (depth == count - 1) {
+                    if (parentStart == NSNotFound) {
+                        parentStart = open[depth - 1].start;
+                        memcpy(ancestors, open, depth * sizeof(OXTagRange));
+                    } else if (parentStart != open[depth - 1].start) {
+                        return NO;      //records of a second parent element
+                    }
+                    if (empty) {
+                        NSRange record = NSMakeRange(tag - bytes, p - tag);
+                        [records appendBytes:&record length:sizeof(NSRange)];
+                    } else {
+                        recordStart = tag;
+                    }
+                } else {
+                    open[depth].start = tag - bytes;
+                    open[depth].length = p - tag;
+                    open[depth].nameLength = nameEnd - name;
+                    matched = depth + 1;
+                }
+            }
+            if ( ! empty)
+                depth++;
+        }
+        if (p == NULL)
+            return NO;
+    }
+    return recordStart == NULL && depth == 0;
+}
+
+
+#pragma mark - OXmlParallelReader
+
+
+@implementation OXmlParallelReader
+{
+    NSMutableArray *_errorList;
+}
+
+#pragma mark - constructor
+
+- (id)initWithMapper:(OXmlMapper *)xmlMapper recordPath:(NSString *)recordPath
+{
+    if (self = [super init]) {
+        NSMutableArray *names = [NSMutableArray array];
+        for(NSString *name in [recordPath componentsSeparatedByString:@"/"]) {
+            if ([name length] > 0)
+                [names addObject:name];
+        }
+        NSAssert2(xmlMapper != nil && [names count] >= 2 && [names count] <= OX_PARALLEL_MAX_DEPTH, @"ERROR: OXmlParallelReader requires a mapper and a record path with 2 to %d elements, not '%@'", OX_PARALLEL_MAX_DEPTH, recordPath);
+        _mapper = xmlMapper;
+        _recordPath = names;
+        _context = [[OXmlContext alloc] init];
+        _chunkSize = OX_PARALLEL_CHUNK_SIZE;
+        _useTokenizer = YES;
+    }
+    return self;
+}
+
++ (id)readerWithMapper:(OXmlMapper *)xmlMapper recordPath:(NSString *)recordPath
+{
+    return [[OXmlParallelReader alloc] initWithMapper:xmlMapper recordPath:recordPath];
+}
+
+
+#pragma mark - error handling
+
+- (void)addErrors:(NSArray *)errors
+{
+    if (_errorList == nil)
+        _errorList = [NSMutableArray array];
+    [_errorList addObjectsFromArray:errors];
+    _errors = _errorList;
+}
+
+- (void)addErrorMessage:(NSString *)errorMessage
+{
+    [self addErrors:@[[NSError errorWithDomain:@"com.outsourcecafe.ox" code:99 userInfo:@{NSLocalizedDescriptionKey:errorMessage}]]];
+}
+
+
+#pragma mark - private
+
+//worker context: transform, filters and logging flags of the template, its own stacks, no pool or intern table (not thread safe)
+- (OXmlContext *)workerContext
+{
+    OXmlContext *ctx = [[OXmlContext alloc] initWithTransform:_context.transform];
+    ctx.attributeFilterBlock = _context.attributeFilterBlock;
+    ctx.elementFilterBlock = _context.elementFilterBlock;
+    ctx.logReaderStack = _context.logReaderStack;
+    [ctx copyLimitsFrom:_context];
+    return ctx;
+}
+
+- (id)readSequentially:(NSData *)xmlData
+{
+    _chunkCount = 1;
+    OXmlReader *reader = [OXmlReader readerWithMapper:_mapper context:_context];
+    reader.useTokenizer = _useTokenizer;
+    id result = [reader readXmlData:xmlData fromURL:nil];
+    if (reader.errors)
+        [self addErrors:reader.errors];
+    return result;
+}
+
+//record ranges grouped into chunks of about chunkSize bytes, as NSRange of record indexes
+- (NSArray *)chunksOfRecords:(const NSRange *)records count:(NSUInteger)count
+{
+    NSMutableArray *chunks = [NSMutableArray array];
+    const NSUInteger chunkSize = MAX(_chunkSize, 1);
+    NSUInteger first = 0;
+    for(NSUInteger i = 0; i < count; i++) {
+        if (NSMaxRange(records[i]) - records[first].location >= chunkSize || i == count - 1) {
+            [chunks addObject:[NSValue valueWithRange:NSMakeRange(first, i + 1 - first)]];
+            first = i + 1;
+        }
+    }
+    return chunks;
+}
+
+#pragma mark - parser
+
+- (id)readXmlData:(NSData *)xmlData
+{
+    _errorList = nil;
+    _errors = nil;
+    _chunkCount = 0;
+    if (xmlData == nil || [xmlData length] == 0)
+        return nil;
+    if ([OXGzipInputStream compressionOfData:xmlData] != OX_COMPRESSION_NONE || ! [OXmlTokenizer canTokenize:xmlData] || _context.identityMap
+            || (_context.maxBytes && [xmlData length] > _context.maxBytes))
+        return [self readSequentially:xmlData];     //the sequential reader reports an exceeded limit
+
+    //pre-scan: record boundaries and enclosing start tags
+    const NSUInteger depth = [_recordPath count];
+    const char *names[OX_PARALLEL_MAX_DEPTH];
+    size_t nameLengths[OX_PARALLEL_MAX_DEPTH];
+    for(NSUInteger i = 0; i < depth; i++) {
+        names[i] = [[_recordPath objectAtIndex:i] UTF8String];
+        nameLengths[i] = strlen(names[i]);
+    }
+    const char *bytes = [xmlData bytes];
+    const NSUInteger length = [xmlData length];
+    OXTagRange ancestors[OX_PARALLEL_MAX_DEPTH];
+    NSUInteger prologEnd = 0;
+    NSMutableData *recordData = [NSMutableData data];
+    if ( ! OXScanRecords(bytes, length, names, nameLengths, depth, ancestors, &prologEnd, recordData))
+        return [self readSequentially:xmlData];
+    const NSRange *records = [recordData bytes];
+    const NSUInteger recordCount = [recordData length] / sizeof(NSRange);
+    if (_context.maxContainerCount && recordCount > _context.maxContainerCount)
+        return [self readSequentially:xmlData];     //workers only see their own chunk
+    for(NSUInteger i = 1; i < recordCount; i++) {
+        if ( ! OXBlankGap(bytes + NSMaxRange(records[i-1]), bytes + records[i].location))
+            return [self readSequentially:xmlData];     //other content between records
+    }
+    NSArray *chunks = [self chunksOfRecords:records count:recordCount];
+    if ([chunks count] < 2)
+        return [self readSequentially:xmlData];
+    _chunkCount = [chunks count];
+
+    //chunk documents: head chunk keeps everything but the records of later chunks, others are wrapped in the ancestor tags
+    const NSUInteger lastEnd = NSMaxRange(records[recordCount - 1]);
+    NSMutableData *closing = [NSMutableData data];
+    for(NSInteger i = depth - 2; i >= 0; i--) {
+        [closing appendBytes:"</" length:2];
+        [closing appendBytes:bytes + ancestors[i].start + 1 length:ancestors[i].nameLength];
+        [closing appendBytes:">" length:1];
+    }
+    NSMutableArray *documents = [NSMutableArray arrayWithCapacity:_chunkCount];
+    for(NSValue *chunk in chunks) {
+        const NSRange range = [chunk rangeValue];
+        const NSUInteger start = records[range.location].location;
+        const NSUInteger stop = NSMaxRange(records[NSMaxRange(range) - 1]);
+        NSMutableData *document = [NSMutableData dataWithCapacity:stop - start + prologEnd + 256];
+        if (range.location == 0) {
+            [document appendBytes:bytes length:stop];
+            [document appendBytes:bytes + lastEnd length:length - lastEnd];
+        } else {
+            [document appendBytes:bytes length:prologEnd];
+            for(NSUInteger i = 0; i < depth - 1; i++) {
+                [document appendBytes:bytes + ancestors[i].start length:ancestors[i].length];
+            }
+            [document appendBytes:bytes + start length:stop - start];
+            [document appendData:closing];
+        }
+        [documents addObject:document];
+    }
+
+    //configure the shared mapper once, before the workers use it
+    NSArray *configErrors = [_mapper configure:_context];
+    if (configErrors) {
+        [self addErrors:configErrors];
+        return nil;
+    }
+
+    //parse chunks concurrently, each worker collects the records it completed in document order
+    NSMutableArray *chunkRecords = [NSMutableArray arrayWithCapacity:_chunkCount];
+    NSMutableArray *chunkErrors = [NSMutableArray arrayWithCapacity:_chunkCount];
+    for(NSUInteger i = 0; i < _chunkCount; i++) {
+        [chunkRecords addObject:[NSMutableArray array]];
+        [chunkErrors addObject:[NSMutableArray array]];
+    }
+    __block id result = nil;
+    __block NSObject *parent = nil;
+    __block OXmlXPathMapper *containerMapper = nil;
+    NSString *recordName = [_recordPath lastObject];
+    const NSUInteger recordPathCount = depth + 1;       //pathStack includes the document root '/'
+    OXmlMapper *mapper = _mapper;
+    const BOOL useTokenizer = _useTokenizer;
+    dispatch_apply(_chunkCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t i) {
+        NSMutableArray *collected = [chunkRecords objectAtIndex:i];
+        OXmlReader *reader = [OXmlReader readerWithMapper:mapper context:[self workerContext]];
+        reader.useTokenizer = useTokenizer;
+        reader.stopCondition = ^(id object, OXmlXPathMapper *xpathMapper, OXmlContext *ctx) {
+            if ([ctx.pathStack count] == recordPathCount && xpathMapper.toType.typeEnum == OX_CONTAINER
+                    && [[ctx.pathStack peek] isEqualToString:recordName]) {
+                [collected addObject:object];
+                if (i == 0 && parent == nil) {
+                    parent = [ctx.instanceStack peekAtIndex:1];
+                    containerMapper = xpathMapper;
+                }
+            }
+            return NO;
+        };
+        id chunkResult = [reader readXmlData:[documents objectAtIndex:i] fromURL:nil];
+        if (chunkResult == nil) {
+            NSMutableArray *errors = [chunkErrors objectAtIndex:i];
+            if (reader.errors)
+                [errors addObjectsFromArray:reader.errors];
+            else
+                [errors addObject:[NSError errorWithDomain:@"com.outsourcecafe.ox" code:99 userInfo:@{NSLocalizedDescriptionKey:[NSString stringWithFormat:@"chunk %lu of %lu returned no result", (unsigned long)i + 1, (unsigned long)[documents count]]}]];
+        } else if (i == 0) {
+            result = chunkResult;
+        }
+    });
+    for(NSArray *errors in chunkErrors) {
+        if ([errors count] > 0)
+            [self addErrors:errors];
+    }
+    if (_errors)
+        return nil;
+    if (parent == nil) {
+        [self addErrorMessage:[NSString stringWithFormat:@"/%@ elements are not mapped to a toMany: property", [_recordPath componentsJoinedByString:@"/"]]];
+        return nil;
+    }
+
+    //merge: append the records of the other chunks to the head chunk's container, in document order
+    NSMutableArray *rest = [NSMutableArray array];
+    for(NSUInteger i = 1; i < _chunkCount; i++) {
+        [rest addObjectsFromArray:[chunkRecords objectAtIndex:i]];
+    }
+    _context.currentMapper = containerMapper;
+    if (containerMapper.containerBuilder) {
+        id container = containerMapper.containerBuilder(containerMapper.getter(containerMapper.toPath, parent, _context), rest, _context);
+        containerMapper.setter(containerMapper.toPath, container, parent, _context);
+    } else {
+        for(id record in rest) {
+            containerMapper.appender(containerMapper.toPath, record, parent, _context);
+        }
+    }
+    _context.currentMapper = nil;
+    return result;
+}
+
+- (id)readXmlText:(NSString *)xml
+{
+    return [self readXmlData:[xml dataUsingEncoding:NSUTF8StringEncoding]];
+}
+
+@end
+
+//
+//  Copyright (c) 2013 Outsource Cafe, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
@@ -11,6 +11,7 @@
 
 #define OC_DEFAULT_NEWLINE_STRING @"\n"
 #define OC_DEFAULT_INDENT_STRING @"    "
+#define OX_PRINTER_FLUSH_LENGTH 16384                                   //characters buffered before flushing to stream
 
 typedef BOOL(^OXEmbedInCDataBlock)(NSString *text);
 
@@ -23,7 +24,8 @@ typedef BOOL(^OXEmbedInCDataBlock)(NSString *text);
 @property(strong,readwrite,nonatomic) NSString *quoteChar;              //quote character, default is: "
 @property(strong,readwrite,nonatomic) NSString *indentString;           //can be set to space character sequence, tab or nil
 @property(copy,readwrite,nonatomic) OXEmbedInCDataBlock embedInCData;   //default triggers if '<' chars found or len > 500
-@property(strong,readonly,nonatomic) NSMutableString *output;           //holds output xml. TODO refactor to use streams
+@property(strong,readonly,nonatomic) NSMutableString *output;           //holds output xml, only the unflushed tail when streaming
+@property(strong,readwrite,nonatomic) NSOutputStream *stream;           //optional open stream, output is flushed to it in UTF-8 chunks
 
 
 - (void)reset;                                                          // zeros output string
@@ -37,6 +39,7 @@ typedef BOOL(^OXEmbedInCDataBlock)(NSString *text);
 - (void)closeEmptyTag;
 - (void)endTag:(NSString *)tag indent:(BOOL)indent;
 - (void)element:(NSString *)tag value:(NSString *)value;
+- (void)element:(NSString *)tag numberValue:(NSNumber *)value;          //shortest round-trip text, see OXUtil formatNumber:buffer:
 - (void)elementBody:(NSString *)tag bodyText:(NSString *)bodyText;
 - (void)closeTag;
 - (void)newLine;
@@ -44,6 +47,7 @@ typedef BOOL(^OXEmbedInCDataBlock)(NSString *text);
 - (void)appendUnencodedText:(NSString *)text;
 - (void)appendTextInCData:(NSString *)text;
 - (NSError *)writeToFile:(NSString *)path;
+- (BOOL)flush;                                                          //writes pending output to stream, NO if any write failed
 
 
 @end
@@ -10,7 +10,9 @@
 
 
 @implementation OXmlPrinter
-
+{
+    BOOL _flushFailed;
+}
 
 @synthesize output = _output;
 
@@ -44,6 +46,26 @@
 - (void)reset
 {
     [_output setString:@""];
+    _flushFailed = NO;
+}
+
+- (BOOL)flush
+{
+    if (_stream && ! _flushFailed && [_output length] > 0) {
+        const char *bytes = [_output UTF8String];
+        const NSUInteger length = strlen(bytes);
+        NSUInteger offset = 0;
+        while (offset < length) {
+            NSInteger written = [_stream write:(const uint8_t *)bytes + offset maxLength:length - offset];
+            if (written <= 0) {
+                _flushFailed = YES;
+                break;
+            }
+            offset += written;
+        }
+        [_output setString:@""];
+    }
+    return ! _flushFailed;
 }
 
 - (NSError *)writeToFile:(NSString *)path
@@ -67,10 +89,23 @@
     }
 }
 
+//formats numbers straight into the output, no intermediate string
+- (void)appendNumber:(NSNumber *)value
+{
+    char buffer[OX_NUMBER_BUFFER_SIZE];
+    if ([OXUtil formatNumber:value buffer:buffer])
+        CFStringAppendCString((__bridge CFMutableStringRef)_output, buffer, kCFStringEncodingASCII);
+    else
+        [_output appendString:[value stringValue]];
+}
+
 - (void)attribute:(NSString *)name numberValue:(NSNumber *)value
 {
-    if (name && value)
-        [_output appendFormat:@" %@=%@%@%@", name, _quoteChar, value, _quoteChar];
+    if (name && value) {
+        [_output appendFormat:@" %@=%@", name, _quoteChar];
+        [self appendNumber:value];
+        [_output appendString:_quoteChar];
+    }
 }
 
 - (void)attribute:(NSString *)name value:(NSString *)value
@@ -145,6 +180,8 @@
     [_output appendString:tag];
     [_output appendString:@">"];
     [self newLine];
+    if (_stream && [_output length] >= OX_PRINTER_FLUSH_LENGTH)
+        [self flush];
 }
 
 - (void)closeTag
@@ -159,6 +196,15 @@
     }
 }
 
+- (void)element:(NSString *)tag numberValue:(NSNumber *)value
+{
+    if (value) {
+        [self startTag:tag close:YES];
+        [self appendNumber:value];
+        [self endTag:tag indent:NO];
+    }
+}
+
 - (void)elementBody:(NSString *)tag bodyText:(NSString *)bodyText
 {
     if (bodyText) {
@@ -12,6 +12,13 @@
 #import <Foundation/Foundation.h>
 #import "OXmlMapper.h"
 #import "OXmlContext.h"
+#import "OXResultCache.h"
+
+//called after each mapped complex element is assigned to its parent, return YES to stop reading
+typedef BOOL (^OXmlStopConditionBlock)(id object, OXmlXPathMapper *mapper, OXmlContext *ctx);
+
+//called on the completion queue with the result graph, or nil and the read errors
+typedef void (^OXmlReadCompletionBlock)(id result, NSArray *errors);
 
 
 @interface OXmlReader : NSObject <NSXMLParserDelegate>
@@ -22,6 +29,12 @@
 @property(strong,nonatomic,readonly) NSArray *errors;
 //@property(strong,nonatomic,readonly) NSError *parserError;
 @property(strong,nonatomic,readonly) OXmlContext *context;
+@property(copy,nonatomic,readwrite) OXmlStopConditionBlock stopCondition;  //optional, aborts parsing and returns partial result
+@property(assign,nonatomic,readwrite) BOOL useTokenizer;    //read UTF-8 data with OXmlTokenizer instead of NSXMLParser, default: NO
+@property(assign,nonatomic,readwrite) BOOL lenient;         //drop a toMany record that fails to map and continue, default: NO
+@property(assign,nonatomic,readwrite) NSUInteger maxErrorCount;        //dropped records logged in errors, later ones are only counted, default: 100
+@property(assign,nonatomic,readonly) NSUInteger droppedRecordCount;    //records dropped by the last lenient read
+@property(strong,nonatomic,readwrite) OXResultCache *resultCache;      //optional, readXmlData: returns the cached graph of repeated input
 
 #pragma mark - constructor
 + (id)readerWithMapper:(OXmlMapper *)xmlMapper;
@@ -38,6 +51,9 @@
 // If not, returns nil and XML parse error (if any) is available in the error property.
 - (id)readXmlData:(NSData *)xmlData fromURL:(NSURL *)url;
 
+// read XML from a stream, gzip or zlib compressed input is inflated while parsing (as it is by readXmlData:fromURL:)
+- (id)readXmlStream:(NSInputStream *)stream;
+
 // read XML from URL
 // if succesful returns array of result graph.  If not, returns nil and XML parse error (if any) is available in the error property.
 - (id)readXmlURL:(NSURL *)url;
@@ -47,6 +63,46 @@
 
 - (id)readXml:(NSXMLParser *)parser;
 
+#pragma mark - asynchronous parser
+// Non-blocking variants: input is loaded in chunks on a background queue (file reads, or an NSURLConnection for http(s)
+// URLs) and fed to NSXMLParser on another background queue as the bytes arrive, so I/O and parsing overlap.  The
+// completion block is called on queue, the main queue if nil.  The reader must not be used for other reads until then.
+// Input is always streamed to NSXMLParser - useTokenizer needs the whole document in memory and is ignored.
+//    [reader readXmlURL:url queue:dispatch_get_main_queue() completion:^(id result, NSArray *errors) {
+//        if (result) [self showFeed:result];
+//    }];
+- (void)readXmlURL:(NSURL *)url queue:(dispatch_queue_t)queue completion:(OXmlReadCompletionBlock)completion;
+- (void)readXmlFile:(NSString *)fileName queue:(dispatch_queue_t)queue completion:(OXmlReadCompletionBlock)completion;     //resource file
+- (void)readXmlStream:(NSInputStream *)stream queue:(dispatch_queue_t)queue completion:(OXmlReadCompletionBlock)completion;
+
+// Early termination, i.e. taking the first 10 items of a large feed:
+//    __block NSUInteger count = 0;
+//    reader.stopCondition = ^(id object, OXmlXPathMapper *mapper, OXmlContext *ctx) {
+//        return (BOOL)([object isKindOfClass:[Item class]] && ++count >= 10);
+//    };
+// Elements still open when parsing stops are closed normally, so the partially read graph is returned.
+
+// Untrusted input, bounded by the limits of the context:
+//    reader.context.maxDepth = 32;
+//    reader.context.maxBytes = 4 * 1024 * 1024;
+//    reader.context.deadline = [NSDate dateWithTimeIntervalSinceNow:2.0];
+// A violated limit or a cancelled context.cancellationToken aborts parsing, the read returns nil and errors names the limit.
+
+// Bulk imports:  a lenient read isolates failures (exceptions thrown by factories, setters, transforms or assertions)
+// to the innermost open element mapped to a toMany: property.  The record is discarded, the rest of its sub-tree is
+// skipped and an error with the OXError*Key details is logged, then parsing carries on.  The result is returned along
+// with the errors.  Failures outside a record still stop the read.  The library sources on the unwind path are built
+// with -fobjc-arc-exceptions; add the flag to your own files defining factory, setter or transform blocks, otherwise ARC
+// leaks the objects held by their frames when an exception passes through them.
+//    reader.lenient = YES;
+//    Catalog *catalog = [reader readXmlData:data fromURL:nil];
+//    if (reader.droppedRecordCount > 0) [self report:reader.errors];
+
+#pragma mark - recycling
+// return a result graph to context.objectPool so the next read can reuse its OXReusable instances.
+// Returns the number of recycled instances, zero if no pool is assigned.
+- (NSUInteger)recycle:(id)result;
+
 @end
 
 //
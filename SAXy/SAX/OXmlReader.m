@@ -9,9 +9,77 @@
 #import "OXmlElementMapper.h"
 #import "NSMutableArray+OXStack.h"
 #import "OXUtil.h"
+#import "OXLazyArray.h"
+#import "OXmlTokenizer.h"
+#import "OXGzipStream.h"
+#import "OXPipeStream.h"
+#import "OXResultCache.h"
 #import <objc/runtime.h>
 #import <objc/message.h>
 
+
+#pragma mark - OXmlPredicateFrame
+
+
+//tracks a child element predicate of an object under construction, evaluated as the child elements end
+@interface OXmlPredicateFrame : NSObject
+@property(weak,nonatomic,readwrite)NSObject *object;
+@property(strong,nonatomic,readwrite)OXPathPredicate *predicate;
+@property(assign,nonatomic,readwrite)NSUInteger depth;          //pathStack count of the object's element
+@property(assign,nonatomic,readwrite)BOOL matched;
+@end
+
+@implementation OXmlPredicateFrame
+@end
+
+
+#pragma mark - OXmlContainerBuffer
+
+
+//children of a container property, assigned in one step when the parent element ends
+@interface OXmlContainerBuffer : NSObject
+@property(strong,nonatomic,readwrite)NSObject *target;
+@property(strong,nonatomic,readwrite)OXmlXPathMapper *mapper;
+@property(strong,nonatomic,readwrite)NSMutableArray *items;
+@end
+
+@implementation OXmlContainerBuffer
+@end
+
+
+#pragma mark - OXmlRecordFrame
+
+
+//open toMany: record of a lenient read, the reader state to restore if mapping it fails
+@interface OXmlRecordFrame : NSObject
+@property(assign,nonatomic,readwrite)NSUInteger depth;          //element depth of the record
+@property(assign,nonatomic,readwrite)NSUInteger pathCount;      //pathStack count, record element included
+@property(assign,nonatomic,readwrite)NSUInteger instanceCount;  //instanceStack count of the record's parent
+@property(assign,nonatomic,readwrite)NSUInteger mappingTypeCount;
+@end
+
+@implementation OXmlRecordFrame
+@end
+
+
+#pragma mark - OXmlNamespaceScope
+
+
+//namespace binding made by an element's xmlns attribute, undone when the element ends
+@interface OXmlNamespaceScope : NSObject
+@property(assign,nonatomic,readwrite)NSUInteger depth;          //element depth of the declaring element
+@property(strong,nonatomic,readwrite)NSString *prefix;
+@property(strong,nonatomic,readwrite)NSNumber *previousId;      //binding hidden by this scope, nil if none
+@end
+
+@implementation OXmlNamespaceScope
+@end
+
+
+#pragma mark - OXmlReader
+
+
+
 @implementation OXmlReader
 {
     NSArray *_mappers;
@@ -22,6 +90,42 @@
     //optimizations:
     NSString *_cachedNsPrefix;
     NSMutableDictionary *_cachedNsTags;
+    //namespace scopes:
+    NSMutableDictionary *_nsBindings;           //in-scope namespace ids keyed by prefix, per parse - the mapper is not modified
+    NSMutableArray *_nsScopes;                  //OXmlNamespaceScope stack
+    NSArray *_nsURIs;                           //mapper.nsURIById snapshot
+    NSUInteger _depth;                          //element depth, including skipped and captured elements
+    NSString *_resolvedNsPrefix;                //last prefix resolved by namespaceURIForPrefix:
+    NSString *_resolvedNsURI;
+    //lazy sub-tree capture:
+    NSMutableArray *_capturedEvents;            //SAX events of the lazy sub-tree being captured, nil when not capturing
+    NSUInteger _captureDepth;
+    NSArray *_capturePath;
+    OXmlXPathMapper *_captureMapper;
+    OXmlElementMapper *_captureParentMapper;
+    //lazy sub-tree replay:
+    BOOL _replaying;
+    id _replayResult;
+    //predicates and early termination:
+    NSUInteger _skipDepth;                      //>0 while skipping a sub-tree rejected by a predicate
+    NSMutableDictionary *_positionCounts;       //element positions keyed by parent instance, then by mapper
+    NSMutableArray *_predicateFrames;           //OXmlPredicateFrame stack
+    //container building:
+    NSMutableDictionary *_containerBuffers;     //OXmlContainerBuffer arrays keyed by target instance
+    BOOL _stopped;
+    //blob streaming:
+    OXBlobSink *_blobSink;                      //destination of the open element's text, nil when not streaming
+    OXmlXPathMapper *_blobMapper;
+    NSUInteger _blobDepth;
+    OXmlTokenizer *_tokenizer;                  //set while reading with the built-in tokenizer
+
+    BOOL _limitExceeded;                        //a context limit was exceeded or the read was cancelled, result is discarded
+    NSUInteger _elementCount;                   //elements started, the deadline and cancellation token are checked every 64
+    NSUInteger _textLength;                     //characters of the open element's text
+    NSMutableDictionary *_containerCounts;      //container items keyed by parent instance, then by mapper
+
+    NSMutableArray *_recordFrames;              //OXmlRecordFrame stack of a lenient read
+    NSMutableArray *_errorLog;                  //errors, appended in place
 }
 
 #pragma mark - constructor
@@ -35,6 +139,14 @@
         _mapper = mapper;
         _cachedNsPrefix = @"?";
         _cachedNsTags = [NSMutableDictionary dictionaryWithCapacity:51];
+        _nsBindings = [NSMutableDictionary dictionaryWithCapacity:7];
+        _nsScopes = [NSMutableArray array];
+        _positionCounts = [NSMutableDictionary dictionary];
+        _predicateFrames = [NSMutableArray array];
+        _containerBuffers = [NSMutableDictionary dictionary];
+        _containerCounts = [NSMutableDictionary dictionary];
+        _recordFrames = [NSMutableArray array];
+        _maxErrorCount = 100;
     }
     return self;
 }
@@ -54,7 +166,11 @@
 
 - (NSArray *)addError:(NSError *)error
 {
-    _errors = (_errors == nil) ? [NSArray arrayWithObject:error] : [_errors arrayByAddingObject:error];
+    if (_errorLog == nil || _errors != _errorLog) {     //first error of a read, or after the mapper's configuration errors
+        _errorLog = _errors ? [_errors mutableCopy] : [NSMutableArray arrayWithCapacity:7];
+        _errors = _errorLog;
+    }
+    [_errorLog addObject:error];
     return _errors;
 }
 
@@ -65,6 +181,71 @@
 }
 
 
+//strict reads keep the unconvertible value nil and report it here, lenient reads raised and dropped the record instead
+- (void)collectTransformErrors
+{
+    for(NSError *error in _context.transformErrors)
+        [self addError:error];
+}
+
+
+//stops the parser, the read returns nil with errorMessage
+- (void)failWithLimit:(NSString *)errorMessage parser:(NSXMLParser *)parser
+{
+    if (_logStack) NSLog(@"ERROR: %@ - aborting parser", errorMessage);
+    _limitExceeded = YES;
+    [self addErrorMessage:errorMessage];
+    [parser abortParsing];
+    [_tokenizer abortParsing];
+}
+
+
+//lenient read: logs the failure, restores the reader state of the innermost open record's parent and skips the rest
+//of the record.  openDepth is the depth of the innermost element still open.  Returns NO if no record is open.
+- (BOOL)dropRecord:(NSException *)exception parser:(NSXMLParser *)parser openDepth:(NSUInteger)openDepth
+{
+    OXmlRecordFrame *record = [_recordFrames peek];
+    if (record == nil)
+        return NO;
+    _droppedRecordCount++;
+    NSString *path = [_context tagPath];
+    if (_logStack) NSLog(@"ERROR: %@ - dropping record: %@", path, [exception reason]);
+    if (_droppedRecordCount <= _maxErrorCount) {
+        NSMutableDictionary *userInfo = [NSMutableDictionary dictionaryWithCapacity:5];
+        [userInfo setObject:[NSString stringWithFormat:@"record dropped at %@: %@", path, [exception reason]] forKey:NSLocalizedDescriptionKey];
+        [userInfo setObject:path forKey:OXErrorPathKey];
+        [userInfo setObject:[NSNumber numberWithInteger:parser ? [parser lineNumber] : _tokenizer.lineNumber] forKey:OXErrorLineKey];
+        [userInfo setObject:[NSNumber numberWithInteger:parser ? [parser columnNumber] : _tokenizer.columnNumber] forKey:OXErrorColumnKey];
+        if (_context.currentMapper)
+            [userInfo setObject:_context.currentMapper forKey:OXErrorMapperKey];
+        [self addError:[NSError errorWithDomain:@"com.outsourcecafe.ox" code:99 userInfo:userInfo]];
+    }
+    while ([_context.pathStack count] >= record.pathCount)
+        [_context.pathStack pop];
+    while ([_context mappingTypeCount] > record.mappingTypeCount)
+        [_context popMappingType];
+    while ([_context.instanceStack count] > record.instanceCount) {
+        NSValue *key = [NSValue valueWithNonretainedObject:[_context.instanceStack peek]];
+        [_containerBuffers removeObjectForKey:key];
+        [_positionCounts removeObjectForKey:key];
+        [_containerCounts removeObjectForKey:key];
+        [_context.instanceStack pop];
+        [_context.mapperStack pop];
+    }
+    while ([_predicateFrames count] > 0 && ((OXmlPredicateFrame *)[_predicateFrames peek]).depth >= record.pathCount)
+        [_predicateFrames pop];
+    if (_blobSink && _blobDepth >= record.depth) {
+        [_blobSink abort];
+        _blobSink = nil;
+    }
+    [_recordFrames pop];
+    [_context clearText];
+    _textLength = 0;
+    _skipDepth = openDepth >= record.depth ? openDepth - record.depth + 1 : 0;  //end tags still to come
+    return YES;
+}
+
+
 #pragma mark - XML methods
 
 
@@ -105,12 +286,65 @@
 {
     for (NSString *name in attributes) {
         if ([name hasPrefix:@"xmlns"]) {
-            [self.mapper overridePrefix:name forNamespaceURI:[attributes objectForKey:name]];
+            NSString *prefix = [name length] > 6 ? [name substringFromIndex:6] : OX_DEFAULT_NAMESPACE;    //strip off xmlns:
+            OXmlNamespaceScope *scope = [[OXmlNamespaceScope alloc] init];
+            scope.depth = _depth;
+            scope.prefix = prefix;
+            scope.previousId = [_nsBindings objectForKey:prefix];
+            [_nsScopes push:scope];
+            [_nsBindings setObject:[NSNumber numberWithUnsignedInteger:[_mapper namespaceIdForURI:[attributes objectForKey:name]]] forKey:prefix];
+            _resolvedNsPrefix = nil;
             _namespaceAware = YES;
         }
     }
 }
 
+- (void)popNamespaceScopes:(NSUInteger)depth
+{
+    OXmlNamespaceScope *scope;
+    while ((scope = [_nsScopes peek]) && scope.depth == depth) {
+        if (scope.previousId)
+            [_nsBindings setObject:scope.previousId forKey:scope.prefix];
+        else
+            [_nsBindings removeObjectForKey:scope.prefix];
+        [_nsScopes pop];
+        _resolvedNsPrefix = nil;
+    }
+}
+
+//resets bindings to the mapper's prefixes, or to the bindings in scope where a lazy sub-tree was captured
+- (void)resetNamespaceScopes:(NSDictionary *)bindings
+{
+    [_nsScopes removeAllObjects];
+    [_nsBindings removeAllObjects];
+    _nsURIs = _mapper.nsURIById;
+    _depth = 0;
+    _resolvedNsPrefix = nil;
+    if (bindings) {
+        [_nsBindings addEntriesFromDictionary:bindings];
+    } else {
+        NSDictionary *nsByPrefix = _mapper.nsByPrefix;
+        for(NSString *prefix in nsByPrefix) {
+            [_nsBindings setObject:[NSNumber numberWithUnsignedInteger:[_mapper namespaceIdForURI:[nsByPrefix objectForKey:prefix]]] forKey:prefix];
+        }
+    }
+}
+
+- (NSString *)namespaceURIForPrefix:(NSString *)nsPrefix
+{
+    if (nsPrefix == nil)
+        return nil;
+    if (_resolvedNsPrefix == nil || ! [nsPrefix isEqualToString:_resolvedNsPrefix]) {
+        NSNumber *nsId = [_nsBindings objectForKey:nsPrefix];
+        NSUInteger index = nsId ? [nsId unsignedIntegerValue] : NSNotFound;
+        if (index != NSNotFound && index >= [_nsURIs count])
+            _nsURIs = _mapper.nsURIById;    //namespace registered by an on-the-fly element mapper
+        _resolvedNsURI = index == NSNotFound ? nil : [_nsURIs objectAtIndex:index];
+        _resolvedNsPrefix = nsPrefix;
+    }
+    return _resolvedNsURI;
+}
+
 - (NSString *)startTagAsString:(NSString *)tag attributes:(NSDictionary *)attributes
 {
     NSMutableString *xml = [NSMutableString stringWithFormat:@"<%@ ",tag];
@@ -122,11 +356,11 @@
     return xml;
 }
 
-- (OXPathMapper *)bestMatchMapper:(NSString *)elementName nsPrefix:(NSString *)nsPrefix
+- (OXPathMapper *)bestMatchMapper:(NSString *)elementName nsPrefix:(NSString *)nsPrefix nsURI:(NSString *)nsURI
 {
     //give priority to mapped properties of elementMappers on the stack:
     OXmlElementMapper *elementMapper = [_context.mapperStack isEmpty] ? nil : [_context.mapperStack peek];
-    OXmlXPathMapper *xpathMapper = elementMapper ? [elementMapper matchPathStack:_context.pathStack forNSPrefix:nsPrefix] : nil;
+    OXmlXPathMapper *xpathMapper = elementMapper ? [elementMapper matchPathStack:_context.pathStack forNSURI:nsURI] : nil;
     if (xpathMapper) {
         if (xpathMapper.toType.typeEnum == OX_COMPLEX) {
             Class targetClass = xpathMapper.proxyType ? xpathMapper.proxyType.type : xpathMapper.toType.type;    //proxy support ? swap in proxy mapping
@@ -149,6 +383,97 @@
     return elementMapper;
 }
 
+static NSUInteger OXNextCount(NSMutableDictionary *table, OXmlXPathMapper *mapper, NSObject *parent)
+{
+    NSValue *parentKey = [NSValue valueWithNonretainedObject:parent];
+    NSMutableDictionary *counts = [table objectForKey:parentKey];
+    if (counts == nil) {
+        counts = [NSMutableDictionary dictionary];
+        [table setObject:counts forKey:parentKey];
+    }
+    NSValue *mapperKey = [NSValue valueWithNonretainedObject:mapper];
+    NSUInteger count = [[counts objectForKey:mapperKey] unsignedIntegerValue] + 1;
+    [counts setObject:[NSNumber numberWithUnsignedInteger:count] forKey:mapperKey];
+    return count;
+}
+
+- (NSUInteger)nextPositionOf:(OXmlXPathMapper *)mapper inParent:(NSObject *)parent
+{
+    return OXNextCount(_positionCounts, mapper, parent);
+}
+
+//position and attribute predicates can be evaluated on the start tag, child predicates are checked as the children end.
+//exhausted is set when a position predicate can't match any later sibling.
+- (BOOL)acceptElement:(OXPathPredicate *)predicate mapper:(OXmlXPathMapper *)mapper attributes:(NSDictionary *)attributes exhausted:(BOOL *)exhausted
+{
+    switch (predicate.predicateType) {
+        case OXPositionPredicate: {
+            const NSUInteger position = [self nextPositionOf:mapper inParent:[_context.instanceStack peek]];
+            *exhausted = [predicate exhaustedAfterPosition:position];
+            return [predicate matchesPosition:position];
+        }
+        case OXAttributePredicate:  return [predicate matchesText:[attributes objectForKey:predicate.name]];
+        case OXChildPredicate:      return YES;
+    }
+    return YES;
+}
+
+- (void)evaluateChildPredicate:(NSString *)elementName
+{
+    OXmlPredicateFrame *frame = [_predicateFrames peek];
+    if ( ! frame.matched && frame.depth + 1 == [_context.pathStack count] && [frame.predicate.name isEqualToString:elementName]) {
+        frame.matched = [frame.predicate matchesText:[OXUtil trim:[_context text]]];
+    }
+}
+
+- (void)bufferChild:(NSObject *)child forMapper:(OXmlXPathMapper *)mapper target:(NSObject *)target
+{
+    NSValue *key = [NSValue valueWithNonretainedObject:target];
+    NSMutableArray *buffers = [_containerBuffers objectForKey:key];
+    if (buffers == nil) {
+        buffers = [NSMutableArray arrayWithCapacity:3];
+        [_containerBuffers setObject:buffers forKey:key];
+    }
+    OXmlContainerBuffer *buffer = nil;
+    for(OXmlContainerBuffer *b in buffers) {    //usually one or two container properties per object
+        if (b.mapper == mapper) {
+            buffer = b;
+            break;
+        }
+    }
+    if (buffer == nil) {
+        buffer = [[OXmlContainerBuffer alloc] init];
+        buffer.target = target;
+        buffer.mapper = mapper;
+        buffer.items = [NSMutableArray array];
+        [buffers addObject:buffer];
+    }
+    [buffer.items addObject:child];
+}
+
+- (void)commitContainersOf:(NSObject *)target
+{
+    NSValue *key = [NSValue valueWithNonretainedObject:target];
+    NSArray *buffers = [_containerBuffers objectForKey:key];
+    if (buffers) {
+        [_containerBuffers removeObjectForKey:key];
+        for(OXmlContainerBuffer *buffer in buffers) {
+            OXmlXPathMapper *mapper = buffer.mapper;
+            _context.currentMapper = mapper;
+            id container = mapper.containerBuilder(mapper.getter(mapper.toPath, target, _context), buffer.items, _context);
+            mapper.setter(mapper.toPath, container, target, _context);
+            if (_logStack) NSLog(@"  end: %@ - %@.%@ = %lu items", [_context tagPath], target, mapper.toPath, (unsigned long)[buffer.items count]);
+        }
+    }
+}
+
+- (void)commitAllContainers
+{
+    for(NSArray *buffers in [[_containerBuffers allValues] copy]) {
+        [self commitContainersOf:[(OXmlContainerBuffer *)[buffers objectAtIndex:0] target]];
+    }
+}
+
 #pragma mark - NSXMLParserDelegate
 
 - (void)parserDidStartDocument:(NSXMLParser *)parser
@@ -176,6 +501,30 @@
 
 - (void)parser:(NSXMLParser *)parser didStartElement:(NSString *)tag namespaceURI:(NSString *)nsURI qualifiedName:(NSString *)qName attributes:(NSDictionary *)attributes
 {
+    if (_limitExceeded)
+        return;
+    _depth++;
+    _textLength = 0;
+    if (_context.maxDepth && _depth > _context.maxDepth) {
+        [self failWithLimit:[NSString stringWithFormat:@"element <%@> exceeds the maximum depth of %lu", tag, (unsigned long)_context.maxDepth] parser:parser];
+        return;
+    }
+    if ((++_elementCount & 63) == 0) {
+        NSString *violation = [_context budgetViolation];
+        if (violation) {
+            [self failWithLimit:violation parser:parser];
+            return;
+        }
+    }
+    if (_capturedEvents) {  //inside a lazy sub-tree, just record the event
+        [_capturedEvents addObject:@[tag, attributes ? attributes : @{}]];
+        _captureDepth++;
+        return;
+    }
+    if (_skipDepth) {       //inside a sub-tree rejected by a predicate
+        _skipDepth++;
+        return;
+    }
     @autoreleasepool {
         @try {
             //reset body text
@@ -186,7 +535,7 @@
             NSRange colon = [tag rangeOfString:@":"];
             NSString *elementName = colon.location == NSNotFound ? tag : [self removeTagPrefix:tag];
             NSString *nsPrefix = colon.location == NSNotFound ? OX_DEFAULT_NAMESPACE : [self namespacePrefix:tag];
-            NSString *nsURI = nsPrefix ? [_mapper.nsByPrefix objectForKey:nsPrefix] : nil;
+            NSString *nsURI = [self namespaceURIForPrefix:nsPrefix];
             if (nsURI == nil)
                 nsURI = OX_DEFAULT_NAMESPACE;
 //            if ([@"c:homePage" isEqualToString:tag])
@@ -197,7 +546,7 @@
             BOOL skipElement = parentMapper ? [parentMapper.ignoreProperties containsObject:elementName] : NO;
             OXPathMapper *mapper = nil;
             if (!skipElement) {
-                mapper = [self bestMatchMapper:elementName nsPrefix:nsPrefix];
+                mapper = [self bestMatchMapper:elementName nsPrefix:nsPrefix nsURI:nsURI];
                 skipElement = (mapper == nil);
             }
             if (skipElement) {
@@ -207,27 +556,72 @@
                 _context.currentMapper = mapper;    //needed by blocks
                 //get parrent object
                 NSObject *targetObj = [_context.instanceStack peek];
-                if (mapper.mapperEnum == OX_COMPLEX_MAPPER) {
+                OXmlXPathMapper *propertyMapper = mapper.mapperEnum != OX_COMPLEX_MAPPER ? (OXmlXPathMapper *)mapper
+                                                : (parentMapper ? (OXmlXPathMapper *)[parentMapper matchPathStack:_context.pathStack forNSURI:nsURI] : nil);
+                BOOL isReplayRoot = _replaying && [_context.instanceStack count] == 1;
+                OXPathPredicate *predicate = isReplayRoot ? nil : propertyMapper.xpath.predicate;
+                BOOL exhausted = NO;
+                if (predicate && ! [self acceptElement:predicate mapper:propertyMapper attributes:attributes exhausted:&exhausted]) {
+                    //predicate failed, ignore the whole sub-tree
+                    if (_logStack) NSLog(@"start: %@ - skipping, predicate failed: %@", [_context tagPath], predicate);
+                    [_context.pathStack pop];
+                    _skipDepth = 1;
+                    if (exhausted && targetObj == _context) {
+                        //document-level mapping, the root element maps nothing else: the rest of the input can't add to the result
+                        if (_logStack) NSLog(@"start: %@ - predicate range passed, aborting parser", [_context tagPath]);
+                        _stopped = YES;
+                        [parser abortParsing];
+                        [_tokenizer abortParsing];
+                    }
+                } else if (_context.maxContainerCount && propertyMapper.toType.typeEnum == OX_CONTAINER && targetObj
+                           && OXNextCount(_containerCounts, propertyMapper, targetObj) > _context.maxContainerCount) {
+                    [_context.pathStack pop];
+                    [self failWithLimit:[NSString stringWithFormat:@"%@.%@ exceeds the maximum of %lu container items", NSStringFromClass([targetObj class]), propertyMapper.toPath, (unsigned long)_context.maxContainerCount] parser:parser];
+                } else if (mapper.mapperEnum == OX_COMPLEX_MAPPER && propertyMapper.lazy && !isReplayRoot) {
+                    //defer mapping, record sub-tree and decode it on first access
+                    [_context.pathStack pop];
+                    _capturePath = [_context.pathStack copy];
+                    _captureMapper = propertyMapper;
+                    _captureParentMapper = parentMapper;
+                    _capturedEvents = [NSMutableArray arrayWithObject:@[tag, attributes ? attributes : @{}]];
+                    _captureDepth = 1;
+                    if (_logStack) NSLog(@"start: %@/%@ - lazy capture: %@", [_context tagPath], elementName, propertyMapper.toPath);
+                } else if (mapper.mapperEnum == OX_COMPLEX_MAPPER) {
                     //create new instance and push on the stack
                     if ( ! mapper.factory)
                         NSAssert1(NO, @"factory block should never be nil, assignDefaultBlocks:context not being called for tag: %@", elementName);
+                    if (_lenient && propertyMapper.toType.typeEnum == OX_CONTAINER) {
+                        OXmlRecordFrame *record = [[OXmlRecordFrame alloc] init];
+                        record.depth = _depth;
+                        record.pathCount = [_context.pathStack count];
+                        record.instanceCount = [_context.instanceStack count];
+                        record.mappingTypeCount = [_context mappingTypeCount];
+                        [_recordFrames push:record];
+                    }
                     targetObj = mapper.factory(elementName, _context);// [[objectClass alloc] init];
                     [_context.instanceStack push:targetObj];
                     [_context.mapperStack push:mapper];
                     [_context pushMappingType:OX_SAX_OBJECT_ACTION];
                     if (_logStack) NSLog(@"start: %@ - construct/push: %@", [_context tagPath], targetObj);
+                    if (((OXmlElementMapper *)mapper).bodyMapper.blobSink)
+                        [self beginBlob:((OXmlElementMapper *)mapper).bodyMapper];
+                    if (predicate.predicateType == OXChildPredicate) {
+                        OXmlPredicateFrame *frame = [[OXmlPredicateFrame alloc] init];
+                        frame.object = targetObj;
+                        frame.predicate = predicate;
+                        frame.depth = [_context.pathStack count];
+                        [_predicateFrames push:frame];
+                    }
                     //process attributes
                     for(NSString *attrName in attributes) {
                         if (![attrName hasPrefix:@"xmlns"] ) {
                             colon = [attrName rangeOfString:@":"];
                             NSString *key = colon.location == NSNotFound ? attrName : [self removeTagPrefix:attrName];
                             NSString *rawValue = [attributes objectForKey:attrName];
-                            if ([rawValue rangeOfString:@"&amp;"].location != NSNotFound)
-                                NSLog(@"%@=\"%@\"", key, rawValue);
                             NSString *value = _context.attributeFilterBlock(key, rawValue);
                             if (value) {
                                 if (mapper) {
-                                    NSString *attrNSURI = colon.location == NSNotFound ? nsURI : [_mapper.nsByPrefix objectForKey:[self namespacePrefix:attrName]];
+                                    NSString *attrNSURI = colon.location == NSNotFound ? nsURI : [self namespaceURIForPrefix:[self namespacePrefix:attrName]];
                                     OXmlXPathMapper *attributeMapping = [(OXmlElementMapper *)mapper attributeMapperByTag:key nsURI:attrNSURI];
                                     if (attributeMapping) {
                                         if (_logStack) NSLog(@"start: %@/@%@ - %@.%@ = '%@'", [_context tagPath], key, targetObj, attributeMapping.toPath, value);
@@ -249,9 +643,13 @@
                     //assume this is a property value mapping
                     [_context pushMappingType:OX_SAX_VALUE_ACTION];
                     if (_logStack) NSLog(@"start: %@ - property of %@", [_context tagPath], targetObj);                    
+                    if (((OXmlXPathMapper *)mapper).blobSink)
+                        [self beginBlob:(OXmlXPathMapper *)mapper];
                 }
             }
         } @catch (NSException *e) {
+            if (_lenient && [self dropRecord:e parser:parser openDepth:_depth])
+                return;
             NSLog(@"ERROR: %@ XML parser error on tag: %@",NSStringFromClass([self class]), [self startTagAsString:tag attributes:attributes]);
             @throw e;
         }
@@ -260,102 +658,286 @@
 
 - (void)parser:(NSXMLParser *)parser foundCharacters:(NSString *)text;
 {
-    [_context appendText:text];
+    if (_limitExceeded)
+        return;
+    if (_context.maxTextLength && !(_blobSink && _depth == _blobDepth) && (_textLength += [text length]) > _context.maxTextLength)
+        [self failWithLimit:[NSString stringWithFormat:@"text of <%@> exceeds the maximum length of %lu", [_context.pathStack peek], (unsigned long)_context.maxTextLength] parser:parser];
+    else if (_capturedEvents)
+        [_capturedEvents addObject:text];
+    else if (_blobSink && _depth == _blobDepth)
+        [_blobSink appendText:text];
+    else if (_skipDepth == 0)
+        [_context appendText:text];
 }
 
 - (void)parser:(NSXMLParser *)parser didEndElement:(NSString *)tag namespaceURI:(NSString *)nsURI qualifiedName:(NSString *)qName;
 {
+    if (_limitExceeded)
+        return;
+    const NSUInteger depth = _depth--;
+    _textLength = 0;
+    if (_capturedEvents) {
+        [_capturedEvents addObject:@[tag]];
+        if (--_captureDepth == 0) {
+            [self popNamespaceScopes:depth];
+            [self endLazyCapture];
+        }
+        return;
+    }
+    if (_skipDepth) {
+        _skipDepth--;
+        [self popNamespaceScopes:depth];
+        return;
+    }
     @autoreleasepool {
-        OXSAXActionEnum mappingType = [_context peekMappingType];
-        OXSAXActionEnum parentMappingType = [_context peekMappingTypeAtIndex:1];
-//        if ([tag isEqualToString:@"p:wpt"])
-//            NSLog(@"%@", tag);
-        if (mappingType == OX_SAX_SKIP_ACTION) {
-            if (_logStack) NSLog(@"  end: %@ - skipping", [_context tagPath]);
-        } else if (parentMappingType == OX_SAX_SKIP_ACTION && [_context.instanceStack count] < 2) {
-            if (_logStack) NSLog(@"  end: %@ - skipping", [_context tagPath]);
-        } else {
-            NSRange colon = [tag rangeOfString:@":"];
-            NSString *elementName = colon.location == NSNotFound ? tag : [self removeTagPrefix:tag];
-            NSString *nsPrefix = colon.location == NSNotFound ? OX_DEFAULT_NAMESPACE : [self namespacePrefix:tag];
-            //get object off the top of stack and process according to mapping type
-            NSObject *targetObj = [_context.instanceStack peek];
-            OXmlElementMapper *elementMapper = [_context.mapperStack peek];
-//            NSString *parentElement = [_context.pathStack peekAtIndex:1];
-            if (elementMapper == nil)
-                NSAssert1(elementMapper != nil, @"no OXmlElementMapper found for %@", [_context.pathStack peekAtIndex:1]);
-            if (mappingType == OX_SAX_OBJECT_ACTION) {
-                OXmlElementMapper *parentMapper = [_context.mapperStack peekAtIndex:1];
-                NSObject *child = targetObj;
-                NSObject *parent = [_context.instanceStack peekAtIndex:1];
-                //possible text node value
-                NSString *bodyText = _context.elementFilterBlock(nil, [_context text]);
-                if (bodyText) {
-                    OXmlXPathMapper *bodyMapper = [elementMapper bodyMapper];
-                    if (bodyMapper) {
-                        _context.currentMapper = bodyMapper;
-                        bodyMapper.setter(bodyMapper.toPath, bodyText, child, _context);
-                        if (_logStack) NSLog(@"  end: %@/text() - %@.%@='%@'", [_context tagPath], child, bodyMapper.toPath, bodyText);
-                    } else {
-                        if (_logStack) NSLog(@"WARNING: complex element '%@' has text value ('%@') but no body property is defined", elementName, bodyText);
+        @try {
+            if (_blobSink && depth == _blobDepth)
+                [self endBlob:[_context.instanceStack peek]];
+            OXSAXActionEnum mappingType = [_context peekMappingType];
+            OXSAXActionEnum parentMappingType = [_context peekMappingTypeAtIndex:1];
+    //        if ([tag isEqualToString:@"p:wpt"])
+    //            NSLog(@"%@", tag);
+            if ([_predicateFrames count] > 0) {     //child elements may be unmapped, so check before skipping
+                [self evaluateChildPredicate:[self removeTagPrefix:tag]];
+            }
+            if (mappingType == OX_SAX_SKIP_ACTION) {
+                if (_logStack) NSLog(@"  end: %@ - skipping", [_context tagPath]);
+            } else if (parentMappingType == OX_SAX_SKIP_ACTION && [_context.instanceStack count] < 2) {
+                if (_logStack) NSLog(@"  end: %@ - skipping", [_context tagPath]);
+            } else {
+                NSRange colon = [tag rangeOfString:@":"];
+                NSString *elementName = colon.location == NSNotFound ? tag : [self removeTagPrefix:tag];
+                NSString *nsPrefix = colon.location == NSNotFound ? OX_DEFAULT_NAMESPACE : [self namespacePrefix:tag];
+                NSString *nsURI = [self namespaceURIForPrefix:nsPrefix];
+                //get object off the top of stack and process according to mapping type
+                NSObject *targetObj = [_context.instanceStack peek];
+                OXmlElementMapper *elementMapper = [_context.mapperStack peek];
+    //            NSString *parentElement = [_context.pathStack peekAtIndex:1];
+                if (elementMapper == nil)
+                    NSAssert1(elementMapper != nil, @"no OXmlElementMapper found for %@", [_context.pathStack peekAtIndex:1]);
+                if (mappingType == OX_SAX_OBJECT_ACTION) {
+                    OXmlElementMapper *parentMapper = [_context.mapperStack peekAtIndex:1];
+                    NSObject *child = targetObj;
+                    NSObject *parent = [_context.instanceStack peekAtIndex:1];
+                    //possible text node value
+                    NSString *bodyText = _context.elementFilterBlock(nil, [_context text]);
+                    if (bodyText) {
+                        OXmlXPathMapper *bodyMapper = [elementMapper bodyMapper];
+                        if (bodyMapper) {
+                            _context.currentMapper = bodyMapper;
+                            bodyMapper.setter(bodyMapper.toPath, bodyText, child, _context);
+                            if (_logStack) NSLog(@"  end: %@/text() - %@.%@='%@'", [_context tagPath], child, bodyMapper.toPath, bodyText);
+                        } else {
+                            if (_logStack) NSLog(@"WARNING: complex element '%@' has text value ('%@') but no body property is defined", elementName, bodyText);
+                        }
                     }
-                }
-                OXmlXPathMapper *xpathMapper = parentMapper ? (OXmlXPathMapper *)[parentMapper matchPathStack:_context.pathStack forNSPrefix:nsPrefix] : nil;
-                if (xpathMapper) {
-                    _context.currentMapper = xpathMapper;
-                    if (xpathMapper.toType.typeEnum == OX_CONTAINER) {
-                        if (_logStack) NSLog(@"  end: %@ - %@.%@ += '%@'", [_context tagPath], parent, xpathMapper.toPath, child);
-                        //NSAssert1(xpathMapper.appender != nil, @"appender not set for property: %@", xpathMapper);//TODO remove me!!
-                        xpathMapper.appender(xpathMapper.toPath, child, parent, _context);
-                    } else {
-                        if (_logStack) NSLog(@"  end: %@ - %@.%@='%@'", [_context tagPath], parent, xpathMapper.toPath, child);
-                        //NSAssert1(xpathMapper.setter != nil, @"setter not set for property: %@", xpathMapper);//TODO remove me!!
-                        xpathMapper.setter(xpathMapper.toPath, child, parent, _context);
+                    OXmlXPathMapper *xpathMapper = parentMapper ? (OXmlXPathMapper *)[parentMapper matchPathStack:_context.pathStack forNSURI:nsURI] : nil;
+                    OXmlPredicateFrame *frame = [_predicateFrames peek];
+                    BOOL rejected = NO;
+                    if (frame && frame.depth == [_context.pathStack count] && frame.object == child) {
+                        [_predicateFrames pop];
+                        rejected = ! frame.matched;
                     }
-                } else {
-                    NSAssert4(NO, @"ERROR: no registered OXmlXPathMapper: %@ - %@.%@ =' %@'", [_context tagPath], parent, @"?", child);
-                }
-                [_context.instanceStack pop];
-                [_context.mapperStack pop];
-            } else if (mappingType == OX_SAX_VALUE_ACTION) {
-                //text node value
-                NSString *elementText = _context.elementFilterBlock(elementName, [_context text]);
-                OXmlXPathMapper *xpathMapper = elementMapper ? (OXmlXPathMapper *)[elementMapper matchPathStack:_context.pathStack forNSPrefix:nsPrefix] : nil;
-                if (elementText) {
-                    if (xpathMapper) {
-                        if (_logStack) NSLog(@"  end: %@ - %@.%@ = '%@'", [_context tagPath], targetObj, xpathMapper.toPath, elementText);
+                    if ([_containerBuffers count] > 0) {
+                        if (rejected)
+                            [_containerBuffers removeObjectForKey:[NSValue valueWithNonretainedObject:child]];
+                        else
+                            [self commitContainersOf:child];
+                        _context.currentMapper = xpathMapper;
+                    }
+                    NSObject *value = child;    //may be replaced by the existing instance when merge-reading
+                    if (_context.identityMap && ! rejected && ! _replaying) {
+                        value = [_context.identityMap merge:child mapper:elementMapper context:_context];
                         _context.currentMapper = xpathMapper;
-                        xpathMapper.setter(xpathMapper.toPath, elementText, targetObj, _context);
+                    }
+                    if (rejected) {
+                        if (_logStack) NSLog(@"  end: %@ - dropping '%@', predicate failed: %@", [_context tagPath], child, frame.predicate);
+                        [_context.objectPool recycle:child];
+                    } else if (_replaying && [_context.instanceStack count] == 2) {
+                        _replayResult = child;  //decoded lazy item - parent is a placeholder
+                        if (_logStack) NSLog(@"  end: %@ - lazy decoded: '%@'", [_context tagPath], child);
+                    } else if (xpathMapper) {
+                        _context.currentMapper = xpathMapper;
+                        if (xpathMapper.toType.typeEnum == OX_CONTAINER) {
+                            if (_logStack) NSLog(@"  end: %@ - %@.%@ += '%@'", [_context tagPath], parent, xpathMapper.toPath, value);
+                            //NSAssert1(xpathMapper.appender != nil, @"appender not set for property: %@", xpathMapper);//TODO remove me!!
+                            if (xpathMapper.containerBuilder)
+                                [self bufferChild:value forMapper:xpathMapper target:parent];    //assigned when parent ends
+                            else
+                                xpathMapper.appender(xpathMapper.toPath, value, parent, _context);
+                        } else {
+                            if (_logStack) NSLog(@"  end: %@ - %@.%@='%@'", [_context tagPath], parent, xpathMapper.toPath, value);
+                            //NSAssert1(xpathMapper.setter != nil, @"setter not set for property: %@", xpathMapper);//TODO remove me!!
+                            xpathMapper.setter(xpathMapper.toPath, value, parent, _context);
+                        }
+                        if (_stopCondition && !_stopped && _stopCondition(value, xpathMapper, _context)) {
+                            if (_logStack) NSLog(@"  end: %@ - stop condition met, aborting parser", [_context tagPath]);
+                            _stopped = YES;
+                            [parser abortParsing];
+                            [_tokenizer abortParsing];
+                        }
                     } else {
-                        NSAssert4(NO, @"ERROR: no registered OXmlXPathMapper: %@ - %@.%@ =' %@'", [_context tagPath], targetObj, elementName, elementText);
+                        NSAssert4(NO, @"ERROR: no registered OXmlXPathMapper: %@ - %@.%@ =' %@'", [_context tagPath], parent, @"?", child);
+                    }
+                    if ([_positionCounts count] > 0)
+                        [_positionCounts removeObjectForKey:[NSValue valueWithNonretainedObject:child]];
+                    if ([_containerCounts count] > 0)
+                        [_containerCounts removeObjectForKey:[NSValue valueWithNonretainedObject:child]];
+                    [_context.instanceStack pop];
+                    [_context.mapperStack pop];
+                } else if (mappingType == OX_SAX_VALUE_ACTION) {
+                    //text node value
+                    NSString *elementText = _context.elementFilterBlock(elementName, [_context text]);
+                    OXmlXPathMapper *xpathMapper = elementMapper ? (OXmlXPathMapper *)[elementMapper matchPathStack:_context.pathStack forNSURI:nsURI] : nil;
+                    if (elementText) {
+                        if (xpathMapper) {
+                            if (_logStack) NSLog(@"  end: %@ - %@.%@ = '%@'", [_context tagPath], targetObj, xpathMapper.toPath, elementText);
+                            _context.currentMapper = xpathMapper;
+                            xpathMapper.setter(xpathMapper.toPath, elementText, targetObj, _context);
+                        } else {
+                            NSAssert4(NO, @"ERROR: no registered OXmlXPathMapper: %@ - %@.%@ =' %@'", [_context tagPath], targetObj, elementName, elementText);
+                        }
                     }
                 }
             }
+            [_context clearText]; //reset body string
+            [_context popMappingType];
+            [_context.pathStack pop];
+            if ([_recordFrames count] > 0 && ((OXmlRecordFrame *)[_recordFrames peek]).depth == depth)
+                [_recordFrames pop];    //record mapped
+        } @catch (NSException *e) {
+            if ( ! _lenient || ! [self dropRecord:e parser:parser openDepth:_depth])
+                @throw e;
         }
-        [_context clearText]; //reset body string
-        [_context popMappingType];
-        [_context.pathStack pop];
     }
 }
 
 - (void)parser:(NSXMLParser *)parser parseErrorOccurred:(NSError *)parseError
 {
+    if (_stopped || _limitExceeded)
+        return;     //abortParsing reports an error, ignore it
     NSString *errMsg = [NSString stringWithFormat:@"XML Parsing Error on %@, Error %li, Description: %@, Line: %li, Column: %li",
                         [self.url absoluteString],
                         (long)[parseError code],
-                        [[parser parserError] localizedDescription],
-                        (long)[parser lineNumber],
-                        (long)[parser columnNumber]];
+                        [parseError localizedDescription],
+                        (long)(parser ? [parser lineNumber] : _tokenizer.lineNumber),
+                        (long)(parser ? [parser columnNumber] : _tokenizer.columnNumber)];
     [self addErrorMessage:errMsg];
 }
 
 
+#pragma mark - blob streaming
+
+- (void)beginBlob:(OXmlXPathMapper *)mapper
+{
+    _context.currentMapper = mapper;
+    _blobSink = mapper.blobSink(mapper.toPath, _context);
+    _blobMapper = mapper;
+    _blobDepth = _depth;
+    if (_logStack) NSLog(@"start: %@ - streaming text to %@", [_context tagPath], _blobSink);
+}
+
+//assigns the sink's handle through the mapper's setter, blob mappers are configured with a pass-through toTransform
+- (void)endBlob:(NSObject *)target
+{
+    OXBlobSink *sink = _blobSink;
+    OXmlXPathMapper *mapper = _blobMapper;
+    _blobSink = nil;
+    _blobMapper = nil;
+    id handle = [sink finish];
+    if (handle) {
+        if (_logStack) NSLog(@"  end: %@ - %@.%@ = %llu byte blob", [_context tagPath], target, mapper.toPath, sink.length);
+        _context.currentMapper = mapper;    //needed by blocks
+        mapper.setter(mapper.toPath, handle, target, _context);
+    } else {
+        [self addErrorMessage:[NSString stringWithFormat:@"%@ - %@", [_context tagPath], [sink.error localizedDescription]]];
+    }
+}
+
+
+#pragma mark - lazy
+
+- (void)endLazyCapture
+{
+    NSArray *events = _capturedEvents;
+    OXmlXPathMapper *xpathMapper = _captureMapper;
+    OXLazyDecoderBlock decoder = [self lazyDecoderWithPath:_capturePath parentMapper:_captureParentMapper];
+    _capturedEvents = nil;
+    _capturePath = nil;
+    _captureMapper = nil;
+    _captureParentMapper = nil;
+    NSObject *parent = [_context.instanceStack peek];
+    _context.currentMapper = xpathMapper;
+    if (xpathMapper.toType.typeEnum == OX_CONTAINER) {
+        id container = xpathMapper.getter(xpathMapper.toPath, parent, _context);
+        if ([container isKindOfClass:[OXLazyArray class]]) {
+            [(OXLazyArray *)container addSource:events];
+        } else {
+            xpathMapper.setter(xpathMapper.toPath, [OXLazyArray lazyArrayWithSources:@[events] decoder:decoder], parent, _context);
+        }
+    } else {
+        xpathMapper.setter(xpathMapper.toPath, [OXLazyProxy proxyWithSource:events decoder:decoder], parent, _context);
+    }
+    if (_logStack) NSLog(@"  end: %@ - %@.%@ lazy, %lu events", [_context tagPath], parent, xpathMapper.toPath, (unsigned long)[events count]);
+    [_context clearText];
+}
+
+//everything the decoder needs is captured now, items may be decoded after this reader is gone or on another thread
+- (OXLazyDecoderBlock)lazyDecoderWithPath:(NSArray *)path parentMapper:(OXmlElementMapper *)parentMapper
+{
+    OXmlMapper *mapper = _mapper;   //reader only holds a weak reference, keep mapper alive until decoded
+    OXmlContext *settings = [_context childContext];   //context settings in effect when the sub-tree was captured
+    BOOL namespaceAware = _namespaceAware;
+    NSDictionary *nsBindings = [_nsBindings copy];
+    return ^(id events) {
+        OXmlReader *replayReader = [OXmlReader readerWithMapper:mapper context:[settings childContext]];    //one per decode
+        return [replayReader replayEvents:events path:path parentMapper:parentMapper namespaceAware:namespaceAware nsBindings:nsBindings];
+    };
+}
+
+- (id)replayEvents:(NSArray *)events path:(NSArray *)path parentMapper:(OXmlElementMapper *)parentMapper namespaceAware:(BOOL)namespaceAware nsBindings:(NSDictionary *)nsBindings
+{
+    [_context reset];
+    _logStack = _context.logReaderStack;
+    _namespaceAware = namespaceAware;
+    [self resetNamespaceScopes:nsBindings];
+    _replaying = YES;
+    _replayResult = nil;
+    //restore the stack state found at the start of the captured sub-tree, using a placeholder parent instance:
+    for(NSString *tag in path) {
+        [_context.pathStack push:tag];
+    }
+    [_context.instanceStack push:[NSNull null]];
+    [_context.mapperStack push:parentMapper];
+    [_context pushMappingType:OX_SAX_OBJECT_ACTION];
+    for(id event in events) {
+        if ([event isKindOfClass:[NSString class]]) {
+            [self parser:nil foundCharacters:event];
+        } else if ([event count] == 2) {
+            [self parser:nil didStartElement:[event objectAtIndex:0] namespaceURI:nil qualifiedName:nil attributes:[event objectAtIndex:1]];
+        } else {
+            [self parser:nil didEndElement:[event objectAtIndex:0] namespaceURI:nil qualifiedName:nil];
+        }
+    }
+    id result = _replayResult;
+    _replayResult = nil;
+    _replaying = NO;
+    [_context reset];
+    return result;
+}
+
 #pragma mark - parser
 
 - (id)readXml:(NSXMLParser *)parser
 {
     [parser setDelegate:self];
     [parser setShouldResolveExternalEntities:NO];
+    return [self readXml:parser tokenizer:nil];
+}
+
+//exactly one of parser or tokenizer is set, both drive the same NSXMLParserDelegate callbacks
+- (id)readXml:(NSXMLParser *)parser tokenizer:(OXmlTokenizer *)tokenizer
+{
     [_context reset];
     _errors = [self.mapper configure:_context]; //use reflections to create type-specific function blocks
     if (_errors) {
@@ -367,21 +949,126 @@
         return nil;
     } else {
         _namespaceAware = self.mapper.namespaceAware;
-        id result = [parser parse] ? _context.result : nil;  //if not successful, delegate is informed of error
+        [self resetNamespaceScopes:nil];
+        _capturedEvents = nil;
+        _skipDepth = 0;
+        _stopped = NO;
+        _limitExceeded = NO;
+        _elementCount = 0;
+        _textLength = 0;
+        _droppedRecordCount = 0;
+        _context.raiseTransformErrors = _lenient;
+        _blobSink = nil;
+        [_positionCounts removeAllObjects];
+        [_containerCounts removeAllObjects];
+        [_predicateFrames removeAllObjects];
+        [_containerBuffers removeAllObjects];
+        [_recordFrames removeAllObjects];
+        [_context.identityMap beginMerge];
+        NSString *violation = [_context budgetViolation];
+        if (violation) {
+            [self failWithLimit:violation parser:nil];
+            [_context reset];
+            return nil;
+        }
+        _tokenizer = tokenizer;
+        _tokenizer.delegate = self;
+        BOOL parsed = tokenizer ? [tokenizer parse] : [parser parse];   //if not successful, delegate is informed of error
+        _tokenizer = nil;
+        if (_limitExceeded)
+            parsed = NO;    //partial graph of untrusted input
+        if (_stopped) {
+            [self finishOpenElements];
+            parsed = YES;
+        }
+        [_blobSink abort];      //element left open by a failed or aborted parse
+        _blobSink = nil;
+        [self commitAllContainers];     //containers of document-level instances
+        id result = parsed ? _context.result : nil;
+        [_context.identityMap endMerge:result];
+        [self collectTransformErrors];
         [_context reset];   //clear reader memory
+        [_positionCounts removeAllObjects];
+        [_containerCounts removeAllObjects];
+        [_predicateFrames removeAllObjects];
+        [_containerBuffers removeAllObjects];
+        [_recordFrames removeAllObjects];
         return result;
     }
 }
 
+//after an early stop, close the elements still open so partially built objects are assigned to their parents
+- (void)finishOpenElements
+{
+    if (_capturedEvents) {      //incomplete lazy sub-tree, pathStack was already popped
+        _capturedEvents = nil;
+        _captureMapper = nil;
+        _captureParentMapper = nil;
+    }
+    _skipDepth = 0;             //rejected sub-tree, pathStack was already popped
+    while ([_context.pathStack count] > 1) {
+        [self parser:nil didEndElement:[_context.pathStack peek] namespaceURI:nil qualifiedName:nil];
+    }
+}
+
 - (id)readXmlData:(NSData *)xmlData fromURL:(NSURL *)aUrl
 {
     _url = aUrl;
     if (!xmlData || [xmlData length] == 0)
         return nil;
+    //partial or merged results depend on more than the input, pooled results are recycled by the caller:
+    if (_resultCache == nil || _stopCondition || _context.identityMap || _context.objectPool)
+        return [self parseXmlData:xmlData];
+    id result = [_resultCache resultForData:xmlData];
+    if (result) {
+        _errors = nil;
+        return result;
+    }
+    result = [self parseXmlData:xmlData];
+    if (result && _errors == nil)
+        [_resultCache setResult:result forData:xmlData];
+    return result;
+}
+
+- (id)parseXmlData:(NSData *)xmlData
+{
+    const unsigned long long maxBytes = _context.maxBytes;
+    if ([OXGzipInputStream compressionOfData:xmlData] != OX_COMPRESSION_NONE) {
+        if ( ! _useTokenizer)   //inflate while parsing
+            return [self readXmlInput:[OXGzipInputStream inputStreamWithData:xmlData]];
+        xmlData = [OXGzipInputStream inflateData:xmlData maxLength:maxBytes];  //tokenizer works on data, not streams
+        if (xmlData == nil) {
+            _errors = nil;
+            [self addErrorMessage:maxBytes ? [NSString stringWithFormat:@"compressed input is invalid or exceeds the maximum of %llu bytes", maxBytes] : @"compressed input is invalid"];
+            return nil;
+        }
+    } else if (maxBytes && [xmlData length] > maxBytes) {
+        _errors = nil;
+        [self addErrorMessage:[NSString stringWithFormat:@"input of %lu bytes exceeds the maximum of %llu bytes", (unsigned long)[xmlData length], maxBytes]];
+        return nil;
+    }
     if (_context.logReaderInput) NSLog(@"xml: %@", [[NSString alloc] initWithData:xmlData encoding:NSUTF8StringEncoding]);
+    if (_useTokenizer && [OXmlTokenizer canTokenize:xmlData])
+        return [self readXml:nil tokenizer:[OXmlTokenizer tokenizerWithData:xmlData]];
     return [self readXml:[[NSXMLParser alloc] initWithData:xmlData]];
 }
 
+- (id)readXmlStream:(NSInputStream *)stream
+{
+    _url = nil;
+    return [self readXmlInput:[OXGzipInputStream inputStreamWithStream:stream]];
+}
+
+- (id)readXmlInput:(OXGzipInputStream *)input
+{
+    input.maxLength = _context.maxBytes;  //counts inflated bytes, the parser stops when the stream fails
+    id result = [self readXml:[[NSXMLParser alloc] initWithStream:input]];
+    [input close];  //a parser that failed early may leave it open, closing stops pipe producers
+    if (result == nil && input.streamError && !_limitExceeded)
+        [self addError:input.streamError];
+    return result;
+}
+
 - (id)readXmlText:(NSString *)xml
 {
     return [self readXmlData:[xml dataUsingEncoding:NSUTF8StringEncoding] fromURL:nil];
@@ -391,6 +1078,8 @@
 {
     _url = [aUrl isKindOfClass:[NSString class]] ? [NSURL URLWithString: (NSString*)aUrl] : aUrl;
     if (_logStack) NSLog(@"parse URL: %@", [_url absoluteString]);
+    if (_useTokenizer)      //tokenizer works on data, not streams
+        return [self readXmlData:[NSData dataWithContentsOfURL:self.url] fromURL:self.url];
     return [self readXml:[[NSXMLParser alloc] initWithContentsOfURL:self.url]];
 }
 
@@ -402,6 +1091,45 @@
     return [self readXmlData:data fromURL:[NSURL fileURLWithPath:filePath]];
 }
 
+#pragma mark - asynchronous parser
+
+- (void)readXmlInput:(OXGzipInputStream *)input url:(NSURL *)aUrl queue:(dispatch_queue_t)queue completion:(OXmlReadCompletionBlock)completion
+{
+    dispatch_queue_t completionQueue = queue ? queue : dispatch_get_main_queue();
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        _url = aUrl;
+        if (_logStack) NSLog(@"parse URL: %@", [aUrl absoluteString]);
+        id result = [self readXmlInput:input];
+        NSArray *errors = _errors;
+        dispatch_async(completionQueue, ^{
+            completion(result, errors);
+        });
+    });
+}
+
+- (void)readXmlURL:(NSURL *)aUrl queue:(dispatch_queue_t)queue completion:(OXmlReadCompletionBlock)completion
+{
+    OXPipeInputStream *pipe = [OXPipeInputStream inputStreamWithURL:aUrl];      //loading starts now, in parallel with parsing
+    [self readXmlInput:[OXGzipInputStream inputStreamWithStream:pipe] url:aUrl queue:queue completion:completion];
+}
+
+- (void)readXmlFile:(NSString *)fileName queue:(dispatch_queue_t)queue completion:(OXmlReadCompletionBlock)completion
+{
+    [self readXmlURL:[OXUtil resourceURL:fileName] queue:queue completion:completion];
+}
+
+- (void)readXmlStream:(NSInputStream *)stream queue:(dispatch_queue_t)queue completion:(OXmlReadCompletionBlock)completion
+{
+    [self readXmlInput:[OXGzipInputStream inputStreamWithStream:stream] url:nil queue:queue completion:completion];
+}
+
+#pragma mark - recycling
+
+- (NSUInteger)recycle:(id)result
+{
+    return _context.objectPool ? [_context.objectPool recycleGraph:result] : 0;
+}
+
 
 
 @end
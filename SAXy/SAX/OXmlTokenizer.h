@@ -0,0 +1,58 @@
+/**
+
+  OXmlTokenizer.h
+  SAXy OX - Object-to-XML mapping library
+
+  Minimal, non-validating UTF-8 XML tokenizer.  It is an optional replacement for NSXMLParser: OXmlReader uses it when
+  useTokenizer is set.  It drives the same NSXMLParserDelegate callbacks, passing nil as the parser argument, so the
+  mapping code is shared by both paths.
+
+  Differences from NSXMLParser:
+    * '<', '&' and quote delimiters are located with SSE2/AVX2 (x86-64) or NEON (arm64) vector compares, 16 or 32
+      bytes at a time, with a scalar fallback on other CPUs
+    * tag and attribute names are interned, repeated names don't allocate new strings
+    * element text is delivered in one piece, not in fragments
+    * predefined entities (&lt; &gt; &amp; &quot; &apos;) and numeric character references are decoded, DTD
+      entities are not supported, attribute values are not whitespace normalized
+    * comments, processing instructions and DOCTYPE declarations are skipped, CDATA sections are passed to
+      parser:foundCDATA: like NSXMLParser does
+    * only UTF-8 and ASCII documents are supported, use canTokenize: to check
+
+  Created by agent on 10/19/26.
+
+ */
+#import <Foundation/Foundation.h>
+
+
+@interface OXmlTokenizer : NSObject
+
+@property(weak,nonatomic,readwrite)id<NSXMLParserDelegate> delegate;
+@property(strong,nonatomic,readonly)NSError *parserError;
+@property(assign,nonatomic,readonly)NSInteger lineNumber;          //current (during callbacks) or error location, 1-based
+@property(assign,nonatomic,readonly)NSInteger columnNumber;        //current (during callbacks) or error location, 1-based
+
+#pragma mark - constructors
++ (id)tokenizerWithData:(NSData *)data;
+
+#pragma mark - public
++ (BOOL)canTokenize:(NSData *)data;                                 //NO if the XML declaration names an encoding other than UTF-8
+- (BOOL)parse;                                                      //returns NO if a parse error occurred or parsing was aborted
+- (void)abortParsing;                                               //stops parsing after the current callback returns
+
+@end
+
+//
+//  Copyright (c) 2013 Outsource Cafe, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
@@ -0,0 +1,624 @@
+//
+//  OXmlTokenizer.m
+//  SAXy OX - Object-to-XML mapping library
+//
+//  Created by agent on 10/19/26.
+//
+
+#import "OXmlTokenizer.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+
+#define OX_TOKENIZER_NAME_SLOTS 512         //must be a power of 2
+#define OX_TOKENIZER_MAX_INTERNED 64        //longer names and whitespace runs are not interned
+
+
+#pragma mark - scanning
+
+
+//returns a pointer to the first 'a' or 'b' byte, or 'end' if there is none
+static inline const char *OXScan2(const char *p, const char *end, char a, char b)
+{
+#if defined(__AVX2__)
+    const __m256i va = _mm256_set1_epi8(a);
+    const __m256i vb = _mm256_set1_epi8(b);
+    while (end - p >= 32) {
+        __m256i chunk = _mm256_loadu_si256((const __m256i *)p);
+        unsigned mask = (unsigned)_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, va), _mm256_cmpeq_epi8(chunk, vb)));
+        if (mask)
+            return p + __builtin_ctz(mask);
+        p += 32;
+    }
+#elif defined(__SSE2__)
+    const __m128i va = _mm_set1_epi8(a);
+    const __m128i vb = _mm_set1_epi8(b);
+    while (end - p >= 16) {
+        __m128i chunk = _mm_loadu_si128((const __m128i *)p);
+        unsigned mask = (unsigned)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, va), _mm_cmpeq_epi8(chunk, vb)));
+        if (mask)
+            return p + __builtin_ctz(mask);
+        p += 16;
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    const uint8x16_t va = vdupq_n_u8((uint8_t)a);
+    const uint8x16_t vb = vdupq_n_u8((uint8_t)b);
+    while (end - p >= 16) {
+        uint8x16_t chunk = vld1q_u8((const uint8_t *)p);
+        if (vmaxvq_u8(vorrq_u8(vceqq_u8(chunk, va), vceqq_u8(chunk, vb))))
+            break;                          //no movemask on NEON, the scalar loop locates the hit in this block
+        p += 16;
+    }
+#endif
+    while (p < end && *p != a && *p != b)
+        p++;
+    return p;
+}
+
+static inline BOOL OXIsSpace(char c)
+{
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r';
+}
+
+static inline const char *OXSkipSpace(const char *p, const char *end)
+{
+    while (p < end && OXIsSpace(*p))
+        p++;
+    return p;
+}
+
+static inline const char *OXNameEnd(const char *p, const char *end)
+{
+    while (p < end && !OXIsSpace(*p) && *p != '>' && *p != '/' && *p != '=' && *p != '<')
+        p++;
+    return p;
+}
+
+static inline BOOL OXIsBlank(const char *p, const char *end)
+{
+    while (p < end && OXIsSpace(*p))
+        p++;
+    return p == end;
+}
+
+//returns a pointer just past 'terminator', or NULL if it's not found
+static const char *OXSkipPast(const char *p, const char *end, const char *terminator)
+{
+    const size_t len = strlen(terminator);
+    for (;;) {
+        p = OXScan2(p, end, terminator[0], terminator[0]);
+        if ((size_t)(end - p) < len)
+            return NULL;
+        if (memcmp(p, terminator, len) == 0)
+            return p + len;
+        p++;
+    }
+}
+
+static NSUInteger OXAppendUTF8(uint32_t cp, char *out)
+{
+    if (cp < 0x80) {
+        out[0] = (char)cp;
+        return 1;
+    } else if (cp < 0x800) {
+        out[0] = (char)(0xC0 | (cp >> 6));
+        out[1] = (char)(0x80 | (cp & 0x3F));
+        return 2;
+    } else if (cp < 0x10000) {
+        out[0] = (char)(0xE0 | (cp >> 12));
+        out[1] = (char)(0x80 | ((cp >> 6) & 0x3F));
+        out[2] = (char)(0x80 | (cp & 0x3F));
+        return 3;
+    } else {
+        out[0] = (char)(0xF0 | (cp >> 18));
+        out[1] = (char)(0x80 | ((cp >> 12) & 0x3F));
+        out[2] = (char)(0x80 | ((cp >> 6) & 0x3F));
+        out[3] = (char)(0x80 | (cp & 0x3F));
+        return 4;
+    }
+}
+
+
+#pragma mark - OXmlTokenizer
+
+
+typedef struct {
+    uint32_t hash;
+    NSUInteger length;
+    char *bytes;
+    CFStringRef string;
+} OXInternedName;
+
+
+@implementation OXmlTokenizer
+{
+    NSData *_data;
+    const char *_start;
+    const char *_end;
+    const char *_p;
+    NSMutableArray *_openTags;
+    NSMutableData *_buffer;                 //entity decoding buffer
+    NSDictionary *_emptyAttributes;
+    OXInternedName *_names;
+    BOOL _rootSeen;
+    BOOL _aborted;
+    //position, counted on demand from where the last count stopped:
+    NSInteger _lineNumber;
+    NSInteger _columnNumber;
+    const char *_lineScan;                  //newlines before this have been counted
+    const char *_lineStart;                 //first byte of the line containing _lineScan
+    //delegate methods, resolved at the start of parse:
+    id<NSXMLParserDelegate> _target;
+    BOOL _startDocument;
+    BOOL _endDocument;
+    BOOL _startElement;
+    BOOL _endElement;
+    BOOL _foundCharacters;
+    BOOL _foundCDATA;
+    BOOL _parseError;
+}
+
+#pragma mark - constructors
+
+- (id)initWithData:(NSData *)data
+{
+    if (self = [super init]) {
+        _data = data;
+        _start = (const char *)[data bytes];
+        _end = _start + [data length];
+        _openTags = [NSMutableArray arrayWithCapacity:16];
+        _buffer = [NSMutableData dataWithCapacity:256];
+        _emptyAttributes = [NSDictionary dictionary];
+        _names = calloc(OX_TOKENIZER_NAME_SLOTS, sizeof(OXInternedName));
+    }
+    return self;
+}
+
++ (id)tokenizerWithData:(NSData *)data
+{
+    return [[OXmlTokenizer alloc] initWithData:data];
+}
+
+- (void)dealloc
+{
+    for(NSUInteger i = 0; i < OX_TOKENIZER_NAME_SLOTS; i++) {
+        if (_names[i].string) {
+            CFRelease(_names[i].string);
+            free(_names[i].bytes);
+        }
+    }
+    free(_names);
+}
+
+
+#pragma mark - utility
+
+- (NSString *)stringWithBytes:(const char *)p length:(NSUInteger)length
+{
+    return [[NSString alloc] initWithBytes:p length:length encoding:NSUTF8StringEncoding];
+}
+
+//tag names, attribute names and indentation repeat, return the same instance for the same bytes
+- (NSString *)internBytes:(const char *)p length:(NSUInteger)length
+{
+    if (length > OX_TOKENIZER_MAX_INTERNED)
+        return [self stringWithBytes:p length:length];
+    uint32_t hash = 2166136261u;    //FNV-1a
+    for(NSUInteger i = 0; i < length; i++) {
+        hash = (hash ^ (uint8_t)p[i]) * 16777619u;
+    }
+    OXInternedName *slot = &_names[hash & (OX_TOKENIZER_NAME_SLOTS - 1)];
+    if (slot->string && slot->hash == hash && slot->length == length && memcmp(slot->bytes, p, length) == 0) {
+        return (__bridge NSString *)slot->string;
+    }
+    NSString *name = [self stringWithBytes:p length:length];
+    if (name) {                     //direct-mapped, replace whatever occupies the slot
+        if (slot->string) {
+            CFRelease(slot->string);
+            free(slot->bytes);
+        }
+        slot->bytes = malloc(length > 0 ? length : 1);
+        memcpy(slot->bytes, p, length);
+        slot->hash = hash;
+        slot->length = length;
+        slot->string = CFBridgingRetain(name);
+    }
+    return name;
+}
+
+//sets lineNumber and columnNumber, only scanning the bytes since the previous call
+- (void)locate:(const char *)position
+{
+    if (position > _end)
+        position = _end;
+    if (_lineScan == NULL || position < _lineScan) {
+        _lineScan = _start;
+        _lineStart = _start;
+        _lineNumber = 1;
+    }
+    for(const char *p = _lineScan; p < position; p++) {
+        if (*p == '\n') {
+            _lineNumber++;
+            _lineStart = p + 1;
+        }
+    }
+    _lineScan = position;
+    _columnNumber = (position - _lineStart) + 1;
+}
+
+//during a callback, the position just past the token reported (as NSXMLParser does), otherwise the error location
+- (NSInteger)lineNumber
+{
+    if (_target && _parserError == nil)
+        [self locate:_p];
+    return _lineNumber;
+}
+
+- (NSInteger)columnNumber
+{
+    if (_target && _parserError == nil)
+        [self locate:_p];
+    return _columnNumber;
+}
+
+- (BOOL)failWithCode:(NSInteger)code message:(NSString *)message at:(const char *)position
+{
+    [self locate:position];
+    _parserError = [NSError errorWithDomain:NSXMLParserErrorDomain code:code userInfo:@{NSLocalizedDescriptionKey:message}];
+    if (_parseError)
+        [_target parser:nil parseErrorOccurred:_parserError];
+    return NO;
+}
+
+//decodes the entity at p ('&') into _buffer, returns a pointer past the ';' or NULL on error
+- (const char *)decodeEntity:(const char *)p
+{
+    const char *semi = p + 1;
+    while (semi < _end && semi - p <= 10 && *semi != ';')
+        semi++;
+    if (semi >= _end || *semi != ';') {
+        [self failWithCode:NSXMLParserEntityRefAtEOFError message:@"entity reference is not terminated by ';'" at:p];
+        return NULL;
+    }
+    const char *name = p + 1;
+    const NSUInteger length = semi - name;
+    char utf8[4];
+    NSUInteger utf8Length = 1;
+    if (length == 2 && name[0] == 'l' && name[1] == 't') {
+        utf8[0] = '<';
+    } else if (length == 2 && name[0] == 'g' && name[1] == 't') {
+        utf8[0] = '>';
+    } else if (length == 3 && memcmp(name, "amp", 3) == 0) {
+        utf8[0] = '&';
+    } else if (length == 4 && memcmp(name, "quot", 4) == 0) {
+        utf8[0] = '"';
+    } else if (length == 4 && memcmp(name, "apos", 4) == 0) {
+        utf8[0] = '\'';
+    } else if (length > 1 && name[0] == '#') {
+        BOOL hex = (name[1] == 'x');
+        const char *digit = name + (hex ? 2 : 1);
+        uint32_t cp = 0;
+        if (digit == semi) {
+            [self failWithCode:NSXMLParserInvalidCharacterRefError message:@"empty character reference" at:p];
+            return NULL;
+        }
+        for(; digit < semi; digit++) {
+            char c = *digit;
+            uint32_t d;
+            if (c >= '0' && c <= '9') {
+                d = c - '0';
+            } else if (hex && c >= 'a' && c <= 'f') {
+                d = c - 'a' + 10;
+            } else if (hex && c >= 'A' && c <= 'F') {
+                d = c - 'A' + 10;
+            } else {
+                [self failWithCode:NSXMLParserInvalidCharacterRefError message:@"invalid digit in character reference" at:p];
+                return NULL;
+            }
+            cp = cp * (hex ? 16 : 10) + d;
+        }
+        if (cp == 0 || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) {
+            [self failWithCode:NSXMLParserInvalidCharacterError message:@"character reference to an invalid character" at:p];
+            return NULL;
+        }
+        utf8Length = OXAppendUTF8(cp, utf8);
+    } else {
+        [self failWithCode:NSXMLParserUndeclaredEntityError
+                   message:[NSString stringWithFormat:@"undeclared entity '&%@;'", [self stringWithBytes:name length:length]] at:p];
+        return NULL;
+    }
+    [_buffer appendBytes:utf8 length:utf8Length];
+    return semi + 1;
+}
+
+//scans from 'from' up to the first 'stop' byte, decoding entities; sets *next to the 'stop' position (or _end)
+- (NSString *)decodedStringFrom:(const char *)from stop:(char)stop next:(const char **)next
+{
+    const char *p = OXScan2(from, _end, stop, '&');
+    if (p == _end || *p == stop) {      //common case, nothing to decode
+        *next = p;
+        return (p - from <= OX_TOKENIZER_MAX_INTERNED && OXIsBlank(from, p)) ? [self internBytes:from length:p - from] : [self stringWithBytes:from length:p - from];
+    }
+    [_buffer setLength:0];
+    while (p < _end && *p == '&') {
+        [_buffer appendBytes:from length:p - from];
+        if ((p = [self decodeEntity:p]) == NULL)
+            return nil;
+        from = p;
+        p = OXScan2(p, _end, stop, '&');
+    }
+    [_buffer appendBytes:from length:p - from];
+    *next = p;
+    return [self stringWithBytes:[_buffer bytes] length:[_buffer length]];
+}
+
+
+#pragma mark - tokens
+
+- (BOOL)scanText
+{
+    const char *textStart = _p;
+    if ([_openTags count] == 0) {       //outside the document element only whitespace is allowed
+        const char *p = OXScan2(_p, _end, '<', '<');
+        if ( ! OXIsBlank(textStart, p))
+            return [self failWithCode:NSXMLParserExtraContentError message:@"text outside of the document element" at:textStart];
+        _p = p;
+        return YES;
+    }
+    const char *next = NULL;
+    NSString *text = [self decodedStringFrom:textStart stop:'<' next:&next];
+    if (text == nil) {
+        return _parserError ? NO : [self failWithCode:NSXMLParserInvalidCharacterError message:@"text is not valid UTF-8" at:textStart];
+    }
+    _p = next;
+    if (_foundCharacters && [text length] > 0)
+        [_target parser:nil foundCharacters:text];
+    return YES;
+}
+
+- (BOOL)scanStartTag
+{
+    const char *tagStart = _p;
+    const char *p = _p + 1;
+    const char *nameEnd = OXNameEnd(p, _end);
+    if (nameEnd == p)
+        return [self failWithCode:NSXMLParserNAMERequiredError message:@"element name expected" at:p];
+    NSString *tag = [self internBytes:p length:nameEnd - p];
+    if (tag == nil)
+        return [self failWithCode:NSXMLParserInvalidCharacterError message:@"element name is not valid UTF-8" at:p];
+    p = nameEnd;
+    NSMutableDictionary *attributes = nil;
+    BOOL empty = NO;
+    for (;;) {
+        p = OXSkipSpace(p, _end);
+        if (p >= _end)
+            return [self failWithCode:NSXMLParserPrematureDocumentEndError message:@"document ends inside a start tag" at:tagStart];
+        if (*p == '>') {
+            p++;
+            break;
+        }
+        if (*p == '/') {
+            if (p + 1 < _end && p[1] == '>') {
+                empty = YES;
+                p += 2;
+                break;
+            }
+            return [self failWithCode:NSXMLParserGTRequiredError message:@"'>' expected after '/'" at:p];
+        }
+        const char *attrEnd = OXNameEnd(p, _end);
+        if (attrEnd == p)
+            return [self failWithCode:NSXMLParserAttributeNotStartedError message:@"attribute name expected" at:p];
+        NSString *name = [self internBytes:p length:attrEnd - p];
+        if (name == nil)
+            return [self failWithCode:NSXMLParserInvalidCharacterError message:@"attribute name is not valid UTF-8" at:p];
+        p = OXSkipSpace(attrEnd, _end);
+        if (p >= _end || *p != '=')
+            return [self failWithCode:NSXMLParserEqualExpectedError message:@"'=' expected after attribute name" at:p];
+        p = OXSkipSpace(p + 1, _end);
+        if (p >= _end || (*p != '"' && *p != '\''))
+            return [self failWithCode:NSXMLParserLiteralNotStartedError message:@"quoted attribute value expected" at:p];
+        const char quote = *p;
+        const char *next = NULL;
+        NSString *value = [self decodedStringFrom:p + 1 stop:quote next:&next];
+        if (value == nil)
+            return _parserError ? NO : [self failWithCode:NSXMLParserInvalidCharacterError message:@"attribute value is not valid UTF-8" at:p];
+        if (next >= _end)
+            return [self failWithCode:NSXMLParserAttributeNotFinishedError message:@"attribute value is not terminated" at:p];
+        p = next + 1;
+        if (attributes == nil)
+            attributes = [NSMutableDictionary dictionaryWithCapacity:4];
+        [attributes setObject:value forKey:name];
+    }
+    if (_rootSeen && [_openTags count] == 0)
+        return [self failWithCode:NSXMLParserExtraContentError message:@"more than one document element" at:tagStart];
+    _rootSeen = YES;
+    _p = p;
+    [_openTags addObject:tag];
+    if (_startElement)
+        [_target parser:nil didStartElement:tag namespaceURI:nil qualifiedName:nil attributes:attributes ? attributes : _emptyAttributes];
+    if (empty && !_aborted) {
+        [_openTags removeLastObject];
+        if (_endElement)
+            [_target parser:nil didEndElement:tag namespaceURI:nil qualifiedName:nil];
+    }
+    return YES;
+}
+
+- (BOOL)scanEndTag
+{
+    const char *p = _p + 2;
+    const char *nameEnd = OXNameEnd(p, _end);
+    NSString *tag = [self internBytes:p length:nameEnd - p];
+    NSString *openTag = [_openTags lastObject];
+    if (openTag == nil || ! [openTag isEqualToString:tag])
+        return [self failWithCode:NSXMLParserTagNameMismatchError
+                          message:[NSString stringWithFormat:@"end tag '%@' does not match start tag '%@'", tag, openTag] at:_p];
+    p = OXSkipSpace(nameEnd, _end);
+    if (p >= _end || *p != '>')
+        return [self failWithCode:NSXMLParserGTRequiredError message:@"'>' expected at the end of an end tag" at:p];
+    _p = p + 1;
+    [_openTags removeLastObject];
+    if (_endElement)
+        [_target parser:nil didEndElement:openTag namespaceURI:nil qualifiedName:nil];
+    return YES;
+}
+
+//comment, CDATA section or DOCTYPE declaration
+- (BOOL)scanMarkup
+{
+    const char *p = _p;
+    const NSUInteger remaining = _end - p;
+    if (remaining >= 4 && memcmp(p, "<!--", 4) == 0) {
+        p = OXSkipPast(p + 4, _end, "-->");
+        if (p == NULL)
+            return [self failWithCode:NSXMLParserCommentNotFinishedError message:@"comment is not terminated" at:_p];
+    } else if (remaining >= 9 && memcmp(p, "<![CDATA[", 9) == 0) {
+        const char *from = p + 9;
+        p = OXSkipPast(from, _end, "]]>");
+        if (p == NULL)
+            return [self failWithCode:NSXMLParserCDATANotFinishedError message:@"CDATA section is not terminated" at:_p];
+        if ([_openTags count] == 0)
+            return [self failWithCode:NSXMLParserExtraContentError message:@"CDATA outside of the document element" at:_p];
+        if (_foundCDATA)
+            [_target parser:nil foundCDATA:[NSData dataWithBytes:from length:(p - 3) - from]];
+    } else if (remaining >= 9 && memcmp(p, "<!DOCTYPE", 9) == 0) {
+        p = OXScan2(p + 9, _end, '[', '>');
+        if (p < _end && *p == '[') {        //internal subset
+            p = OXSkipPast(p, _end, "]");
+            p = p ? OXScan2(p, _end, '>', '>') : _end;
+        }
+        if (p >= _end)
+            return [self failWithCode:NSXMLParserDOCTYPEDeclNotFinishedError message:@"DOCTYPE declaration is not terminated" at:_p];
+        p++;
+    } else {
+        return [self failWithCode:NSXMLParserNotWellBalancedError message:@"unsupported markup declaration" at:_p];
+    }
+    _p = p;
+    return YES;
+}
+
+- (BOOL)scanProcessingInstruction
+{
+    const char *p = OXSkipPast(_p + 2, _end, "?>");
+    if (p == NULL)
+        return [self failWithCode:NSXMLParserPINotFinishedError message:@"processing instruction is not terminated" at:_p];
+    _p = p;
+    return YES;
+}
+
+
+#pragma mark - public
+
++ (BOOL)canTokenize:(NSData *)data
+{
+    const NSUInteger length = [data length];
+    const unsigned char *bytes = [data bytes];
+    if (length >= 2 && ((bytes[0] == 0xFE && bytes[1] == 0xFF) || (bytes[0] == 0xFF && bytes[1] == 0xFE) || bytes[0] == 0 || bytes[1] == 0))
+        return NO;      //UTF-16 or UTF-32
+    NSUInteger offset = (length >= 3 && bytes[0] == 0xEF && bytes[1] == 0xBB && bytes[2] == 0xBF) ? 3 : 0;
+    if (length < offset + 5 || memcmp(bytes + offset, "<?xml", 5) != 0)
+        return YES;     //no XML declaration, UTF-8 is the default
+    const char *start = (const char *)bytes + offset;
+    const char *declEnd = OXSkipPast(start, (const char *)bytes + length, "?>");
+    if (declEnd == NULL)
+        return NO;
+    NSString *decl = [[NSString alloc] initWithBytes:start length:declEnd - start encoding:NSASCIIStringEncoding];
+    NSRange range = [decl rangeOfString:@"encoding"];
+    if (range.location == NSNotFound)
+        return YES;
+    NSScanner *scanner = [NSScanner scannerWithString:[decl substringFromIndex:NSMaxRange(range)]];
+    NSString *encoding = nil;
+    [scanner scanUpToCharactersFromSet:[NSCharacterSet characterSetWithCharactersInString:@"\"'"] intoString:NULL];
+    [scanner scanCharactersFromSet:[NSCharacterSet characterSetWithCharactersInString:@"\"'"] intoString:NULL];
+    [scanner scanUpToCharactersFromSet:[NSCharacterSet characterSetWithCharactersInString:@"\"'"] intoString:&encoding];
+    encoding = [encoding lowercaseString];
+    return [encoding isEqualToString:@"utf-8"] || [encoding isEqualToString:@"utf8"] || [encoding isEqualToString:@"us-ascii"] || [encoding isEqualToString:@"ascii"];
+}
+
+- (BOOL)parse
+{
+    _target = _delegate;        //strong reference for the duration of the parse only
+    BOOL parsed = [self parseDocument];
+    _target = nil;
+    return parsed;
+}
+
+- (BOOL)parseDocument
+{
+    _startDocument = [_target respondsToSelector:@selector(parserDidStartDocument:)];
+    _endDocument = [_target respondsToSelector:@selector(parserDidEndDocument:)];
+    _startElement = [_target respondsToSelector:@selector(parser:didStartElement:namespaceURI:qualifiedName:attributes:)];
+    _endElement = [_target respondsToSelector:@selector(parser:didEndElement:namespaceURI:qualifiedName:)];
+    _foundCharacters = [_target respondsToSelector:@selector(parser:foundCharacters:)];
+    _foundCDATA = [_target respondsToSelector:@selector(parser:foundCDATA:)];
+    _parseError = [_target respondsToSelector:@selector(parser:parseErrorOccurred:)];
+    _parserError = nil;
+    _lineNumber = 0;
+    _columnNumber = 0;
+    _lineScan = NULL;
+    _rootSeen = NO;
+    _aborted = NO;
+    [_openTags removeAllObjects];
+    _p = _start;
+    if (_end - _p >= 3 && (uint8_t)_p[0] == 0xEF && (uint8_t)_p[1] == 0xBB && (uint8_t)_p[2] == 0xBF)
+        _p += 3;        //byte order mark
+    if (_startDocument)
+        [_target parserDidStartDocument:nil];
+    while (_p < _end && !_aborted) {
+        BOOL ok;
+        if (*_p != '<') {
+            ok = [self scanText];
+        } else if (_end - _p < 2) {
+            ok = [self failWithCode:NSXMLParserPrematureDocumentEndError message:@"document ends after '<'" at:_p];
+        } else if (_p[1] == '/') {
+            ok = [self scanEndTag];
+        } else if (_p[1] == '?') {
+            ok = [self scanProcessingInstruction];
+        } else if (_p[1] == '!') {
+            ok = [self scanMarkup];
+        } else {
+            ok = [self scanStartTag];
+        }
+        if (!ok)
+            return NO;
+    }
+    if (_aborted)
+        return [self failWithCode:NSXMLParserDelegateAbortedParseError message:@"parsing aborted by delegate" at:_p];
+    if ([_openTags count] > 0)
+        return [self failWithCode:NSXMLParserPrematureDocumentEndError
+                          message:[NSString stringWithFormat:@"document ends before end tag '%@'", [_openTags lastObject]] at:_end];
+    if ( ! _rootSeen)
+        return [self failWithCode:NSXMLParserEmptyDocumentError message:@"document is empty" at:_end];
+    if (_endDocument)
+        [_target parserDidEndDocument:nil];
+    return YES;
+}
+
+- (void)abortParsing
+{
+    _aborted = YES;
+}
+
+@end
+
+//
+//  Copyright (c) 2013 Outsource Cafe, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
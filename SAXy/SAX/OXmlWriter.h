@@ -4,7 +4,12 @@
 //
 //  Object-to-XML writer/marshalling class.
 //
-//  TODO reduce memory footprint by supporting streams
+//  Use writeXml:toStream:prettyPrint: to flush output in chunks instead of building the whole document in memory.
+//
+//  Set parallelThreshold to write large containers of complex elements on all cores:  the items are split into chunks,
+//  each chunk is written by its own writer, context and printer on a concurrent queue, and the chunk output is spliced
+//  into the document in order.  The output is identical to a serial write.  Getters and transformers of the child
+//  mappings must be safe to call from several threads.
 //
 //  Created by Richard Easterling on 1/20/13.
 //
@@ -26,10 +31,12 @@
 @property(strong,nonatomic,readwrite)NSString *schemaLocation;
 @property(strong,nonatomic,readwrite)NSDictionary *rootNodeAttributes;
 @property(strong,nonatomic,readonly) NSArray *errors;
+@property(assign,nonatomic,readwrite)NSUInteger parallelThreshold;  //containers with at least this many complex items are written concurrently, 0 (default) disables
 
 #pragma mark - writer
 - (NSString *)writeXml:(id)object;
 - (NSString *)writeXml:(id)object prettyPrint:(BOOL)prettyPrint;
+- (BOOL)writeXml:(id)object toStream:(NSOutputStream *)stream prettyPrint:(BOOL)prettyPrint;   //open stream, i.e. OXGzipOutputStream; NO on error
 
 #pragma mark - constructors
 + (id)writerWithMapper:(OXmlMapper *)mapper;
@@ -22,6 +22,13 @@
 //- (NSUInteger)countLevel:(NSUInteger)level;
 //@end
 
+//nil-safe string comparison
+static inline BOOL OXSameString(NSString *a, NSString *b)
+{
+    return a == b || [a isEqualToString:b];
+}
+
+
 @implementation OXmlWriter
 {
     BOOL _isRoot;
@@ -132,6 +139,95 @@
 
 #pragma mark - public
 
+//writes one element of a container property
+- (void)writeItem:(id)itemData pathMapper:(OXmlXPathMapper *)pathMapper childTag:(NSString *)childTag
+{
+    BOOL isWildcard = [@"*" isEqualToString:pathMapper.fromPathLeaf];
+    switch (pathMapper.toType.containerChildType.typeEnum) {
+        case OX_COMPLEX: {
+            if (isWildcard) {
+                _context.currentMapper = pathMapper;
+                NSString *dynamicTag = pathMapper.pathFactory(itemData, _context);
+                [self writeElement:dynamicTag fromObject:itemData elementMapper:nil];
+            } else {
+                [self writeElement:childTag fromObject:itemData elementMapper:nil];
+            }
+            break;
+        }
+        case OX_SCALAR:
+        case OX_ATOMIC: {
+            NSString *tag = childTag;
+            if (isWildcard) {
+                _context.currentMapper = pathMapper;
+                tag = pathMapper.pathFactory(itemData, _context);
+            }
+            if ([itemData isKindOfClass:[NSNumber class]]) {     //untransformed scalars are formatted in place
+                [_printer element:tag numberValue:itemData];
+            } else {
+                [_printer element:tag value:[itemData isKindOfClass:[NSString class]] ? (NSString *)itemData : [itemData stringValue]];
+            }
+            break;
+        }
+        case OX_POLYMORPHIC:
+        default: {
+            NSAssert2(NO, @"OXmlWriter does not yet support child typeEnum:%d in container mapper: %@", pathMapper.toType.containerChildType.typeEnum, pathMapper);
+            break;
+        }
+    }
+}
+
+//writer for one chunk of a container, starting in this writer's printer and namespace state
+- (OXmlWriter *)chunkWriter
+{
+    OXmlContext *ctx = [[OXmlContext alloc] initWithTransform:_context.transform];
+    ctx.logReaderStack = _context.logReaderStack;
+    OXmlWriter *writer = [OXmlWriter writerWithMapper:_mapper context:ctx];
+    OXmlPrinter *printer = writer.printer;
+    printer.indent = _printer.indent;
+    printer.nsPrefix = _printer.nsPrefix;
+    printer.crString = _printer.crString;
+    printer.indentString = _printer.indentString;
+    printer.quoteChar = _printer.quoteChar;
+    printer.embedInCData = _printer.embedInCData;
+    writer->_currentNsURI = _currentNsURI;
+    return writer;
+}
+
+//Writes chunks of items into separate printers on a concurrent queue, then splices their output in order.  A chunk
+//written with a namespace state other than the one its predecessor left behind is rewritten serially, so the output
+//is identical to a serial write.
+- (void)writeItemsConcurrently:(NSArray *)items pathMapper:(OXmlXPathMapper *)pathMapper childTag:(NSString *)childTag
+{
+    const NSUInteger count = [items count];
+    const NSUInteger chunkCount = MIN(count, [[NSProcessInfo processInfo] activeProcessorCount] * 4);
+    NSString *startNsURI = _currentNsURI;
+    NSString *startNsPrefix = _printer.nsPrefix;
+    NSMutableArray *writers = [NSMutableArray arrayWithCapacity:chunkCount];
+    for(NSUInteger i = 0; i < chunkCount; i++) {
+        [writers addObject:[self chunkWriter]];
+    }
+    dispatch_apply(chunkCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t i) {
+        OXmlWriter *writer = [writers objectAtIndex:i];
+        for(NSUInteger j = count * i / chunkCount; j < count * (i + 1) / chunkCount; j++) {
+            [writer writeItem:[items objectAtIndex:j] pathMapper:pathMapper childTag:childTag];
+        }
+    });
+    for(NSUInteger i = 0; i < chunkCount; i++) {
+        OXmlWriter *writer = [writers objectAtIndex:i];
+        if (OXSameString(_currentNsURI, startNsURI) && OXSameString(_printer.nsPrefix, startNsPrefix)) {
+            [_printer appendUnencodedText:writer.printer.output];
+            _currentNsURI = writer->_currentNsURI;
+            _printer.nsPrefix = writer.printer.nsPrefix;
+        } else {
+            for(NSUInteger j = count * i / chunkCount; j < count * (i + 1) / chunkCount; j++) {
+                [self writeItem:[items objectAtIndex:j] pathMapper:pathMapper childTag:childTag];
+            }
+        }
+        if (_printer.stream && [_printer.output length] >= OX_PRINTER_FLUSH_LENGTH)
+            [_printer flush];
+    }
+}
+
 - (void)writeElement:(NSString *)elementName fromObject:(id)object elementMapper:(OXmlElementMapper *)elementMapper
 {
     //if no mapper passed in, then get the mapper for the class of the passed in object:
@@ -227,36 +323,19 @@
                     switch (pathMapper.toType.typeEnum) {
                         case OX_CONTAINER: {  // handle list of child elements:
                             id<NSFastEnumeration> enumeration = pathMapper.enumerator(childData, _context);
-                            for(id itemData in enumeration) {
-                                switch (pathMapper.toType.containerChildType.typeEnum) {
-                                    case OX_COMPLEX: {
-                                        if (isWildcard) {
-                                            _context.currentMapper = pathMapper;
-                                            NSString *dynamicTag = pathMapper.pathFactory(itemData, _context);
-                                            [self writeElement:dynamicTag fromObject:itemData elementMapper:nil];
-                                        } else {
-                                            [self writeElement:childTag fromObject:itemData elementMapper:nil];
-                                        }
-                                        break;
-                                    }
-                                    case OX_SCALAR:
-                                    case OX_ATOMIC: {
-                                        NSString *childValue = [itemData isKindOfClass:[NSString class]] ? (NSString *)itemData : [itemData stringValue];
-                                        if (isWildcard) {
-                                            _context.currentMapper = pathMapper;
-                                            NSString *dynamicTag = pathMapper.pathFactory(itemData, _context);
-                                            [_printer element:dynamicTag value:childValue];
-                                        } else {
-                                            [_printer element:childTag value:childValue];
-                                        }
-                                        break;
-                                    }
-                                    case OX_POLYMORPHIC:
-                                    default: {
-                                        NSAssert2(NO, @"OXmlWriter does not yet support child typeEnum:%d in container mapper: %@", pathMapper.toType.containerChildType.typeEnum, pathMapper);
-                                        break;
-                                    }
+                            if (_parallelThreshold > 0 && pathMapper.toType.containerChildType.typeEnum == OX_COMPLEX) {
+                                NSMutableArray *items = [NSMutableArray array];
+                                for(id itemData in enumeration) {
+                                    [items addObject:itemData];
+                                }
+                                if ([items count] >= _parallelThreshold) {
+                                    [self writeItemsConcurrently:items pathMapper:pathMapper childTag:childTag];
+                                    break;
                                 }
+                                enumeration = items;
+                            }
+                            for(id itemData in enumeration) {
+                                [self writeItem:itemData pathMapper:pathMapper childTag:childTag];
                             }
                             break;
                         }
@@ -272,13 +351,15 @@
                         }
                         case OX_SCALAR:     // handle single-value (automic) element:
                         case OX_ATOMIC: {
-                            NSString *childValue = [childData isKindOfClass:[NSString class]] ? (NSString *)childData : [childData stringValue];
+                            NSString *tag = childTag;
                             if (isWildcard) {
                                 _context.currentMapper = pathMapper;
-                                NSString *dynamicTag = pathMapper.pathFactory(childData, _context);
-                                [_printer element:dynamicTag value:childValue];
+                                tag = pathMapper.pathFactory(childData, _context);
+                            }
+                            if ([childData isKindOfClass:[NSNumber class]]) {     //untransformed scalars are formatted in place
+                                [_printer element:tag numberValue:childData];
                             } else {
-                                [_printer element:childTag value:childValue];
+                                [_printer element:tag value:[childData isKindOfClass:[NSString class]] ? (NSString *)childData : [childData stringValue]];
                             }
                             break;
                         }
@@ -355,6 +436,15 @@
     }
 }
 
+- (BOOL)writeXml:(id)object toStream:(NSOutputStream *)stream prettyPrint:(BOOL)prettyPrint
+{
+    _printer.stream = stream;
+    NSString *tail = [self writeXml:object prettyPrint:prettyPrint];   //earlier output was already flushed to stream
+    BOOL success = tail != nil && [_printer flush];
+    _printer.stream = nil;
+    return success;
+}
+
 - (NSString *)writeXml:(id)object
 {
     return [self writeXml:object prettyPrint:YES];
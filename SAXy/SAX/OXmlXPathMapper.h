@@ -18,6 +18,7 @@
 
 #import "OXPathMapper.h"
 #import "OXPathLite.h"
+#import "OXBlobSink.h"
 
 
 typedef enum {
@@ -35,6 +36,7 @@ typedef enum {
 @property(strong,nonatomic,readonly)NSString *nsURI;        //namespace of tag. If not specified, defaults to parent nsURI
 @property(assign,nonatomic,readonly)OXmlTypeEnum xmlType;   //what type of XML node this maps to
 @property(strong,nonatomic,readonly)OXmlXPathMapper *next;  //allows chaining of mappers with the same lookup key (i.e. the same leafPath) - TODO move to OXPathMapper
+@property(copy,nonatomic,readwrite)OXBlobSinkBlock blobSink;//element and body mappers only: readers stream the text into a new sink and assign its result
 
 
 #pragma mark - constructors
@@ -53,9 +55,13 @@ typedef enum {
 - (OXmlXPathMapper *)fromTransform:(OXTransformBlock)fromTransform;
 - (OXmlXPathMapper *)enumerator:(OXEnumerationBlock)enumerator;
 - (OXmlXPathMapper *)appender:(OXSetterBlock)appender;
+- (OXmlXPathMapper *)containerBuilder:(OXContainerBuilderBlock)containerBuilder;
 - (OXmlXPathMapper *)nsURI:(NSString *)nsURI;
 - (OXmlXPathMapper *)proxyClass:(Class)proxyClass;
 - (OXmlXPathMapper *)isVirtualProperty;
+- (OXmlXPathMapper *)isLazy;                                    //complex properties or containers of complex items only
+- (OXmlXPathMapper *)isInterned;
+- (OXmlXPathMapper *)blobSink:(OXBlobSinkBlock)sinkFactory;
 - (OXmlXPathMapper *)formatter:(NSString *)formatterName;
 - (OXmlXPathMapper *)path:(OXPathFactoryBlock)pathFactory;
 
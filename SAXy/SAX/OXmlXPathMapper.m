@@ -19,13 +19,17 @@
 - (id)initXpath:(NSString *)xpath type:(Class)type property:(NSString *)property
 {
     if (self = [super initMapperToClass:type toPath:property fromClass:[NSString class] fromPath:xpath]) {
-        if ([OXUtil isXPathString:xpath]) {         //only allocate for multi-element or wildcard paths
-            if ([OXUtil  firstIndexOfChar:'@' inString:xpath] >= 0 || [xpath hasSuffix:OX_TEXT_NODE]) {
+        if ([OXUtil isXPathString:xpath]) {         //only allocate for multi-element, wildcard or predicate paths
+            _xpath = [OXPathLite xpath:xpath];
+            NSArray *tagTypes = _xpath.tagTypeStack;
+            if ([tagTypes containsObject:[NSNumber numberWithInt:OXAttributePathType]] || [tagTypes containsObject:[NSNumber numberWithInt:OXTextPathType]]) {
                 NSAssert1(NO, @"ERROR: unsupported xpath: '%@' - mixing leaf nodes (attributes or text) with element nodes currently not supported", xpath);
             }
-            _xpath = [OXPathLite xpath:xpath];
+            if (_xpath.predicate) {                 //predicate is only used for reading, keep plain path for writers
+                self.fromPath = [xpath substringToIndex:[xpath rangeOfString:@"["].location];
+            }
         }
-        _xmlType = [[self class] xmlTypeFromPath:xpath];
+        _xmlType = [[self class] xmlTypeFromPath:self.fromPath];
         if (property == nil) {
             property = _xpath ? _xpath.pathLeaf : xpath;
             self.toPath = [[self class] xpathToKVCPath:property];
@@ -134,6 +138,12 @@
     return self;
 }
 
+- (OXmlXPathMapper *)containerBuilder:(OXContainerBuilderBlock)containerBuilder
+{
+    self.containerBuilder = containerBuilder;
+    return self;
+}
+
 - (OXmlXPathMapper *)nsURI:(NSString *)nsURI
 {
     self.nsURI = nsURI;
@@ -152,6 +162,25 @@
     return self;
 }
 
+- (OXmlXPathMapper *)isLazy
+{
+    self.lazy = YES;
+    return self;
+}
+
+- (OXmlXPathMapper *)isInterned
+{
+    self.intern = YES;
+    return self;
+}
+
+- (OXmlXPathMapper *)blobSink:(OXBlobSinkBlock)sinkFactory
+{
+    NSAssert1(self.xmlType != OX_XML_ATTRIBUTE, @"ERROR: attribute values can't be streamed to a blob sink: %@", self.fromPath);
+    self.blobSink = sinkFactory;
+    return self;
+}
+
 - (OXmlXPathMapper *)formatter:(NSString *)formatterName
 {
     [self setValue:formatterName forKey:@"formatterName"];
@@ -195,6 +224,25 @@
     return _xpath ? _xpath.pathLeaf : self.fromPath;                    //lazy use of xpath
 }
 
+#pragma mark - public
+
+//OXmlReader only defers complex sub-trees, so a lazy atomic container would quietly be decoded eagerly
+- (NSArray *)configure:(OXContext *)context
+{
+    BOOL wasConfigured = self.isConfigured;
+    if (self.blobSink && ! self.toTransform) {
+        self.toTransform = ^(id handle, OXContext *ctx) { return handle; };  //sink results are already decoded, the setter assigns them as-is
+    }
+    NSArray *errors = [super configure:context];
+    if ( ! wasConfigured && self.lazy && self.toType.typeEnum == OX_CONTAINER && self.toType.containerChildType.typeEnum != OX_COMPLEX) {
+        NSString *message = [NSString stringWithFormat:@"lazy XML containers must hold complex items, not %@ in %@ mapping", NSStringFromClass(self.toType.containerChildType.type), self];
+        NSError *error = [NSError errorWithDomain:@"com.outsourcecafe.ox" code:99 userInfo:@{NSLocalizedDescriptionKey:message}];
+        errors = errors ? [errors arrayByAddingObject:error] : @[error];
+        self.isConfigured = NO;
+    }
+    return errors;
+}
+
 #pragma mark - utility
 
 
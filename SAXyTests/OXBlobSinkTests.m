@@ -0,0 +1,98 @@
+/**
+ 
+  OXBlobSinkTests.m
+  SAXy OX - Object-to-XML mapping library
+ 
+  Tests OXBlobSink chunked base64 decoding and blob-sink body mappings.
+
+  Created by agent on 10/19/26.
+
+*/
+#import <SenTestingKit/SenTestingKit.h>
+#import "OXmlMapper.h"
+#import "OXmlElementMapper.h"
+#import "OXmlReader.h"
+#import "OXBlobSink.h"
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+#pragma mark - test classes
+////////////////////////////////////////////////////////////////////////////////////////
+
+
+@interface OXAttachmentItem : NSObject
+@property(copy,readwrite,nonatomic) NSString *name;
+@property(strong,readwrite,nonatomic) NSData *content;
+@end
+
+@implementation OXAttachmentItem
+@end
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+#pragma mark - tests
+////////////////////////////////////////////////////////////////////////////////////////
+
+
+@interface OXBlobSinkTests : SenTestCase  @end
+
+@implementation OXBlobSinkTests
+
+- (void)testBlobSink
+{
+    OXmlMapper *mapper = [[OXmlMapper mapper] elements:@[
+                          [OXmlElementMapper rootXPath:@"/attachments/attachment" toMany:[OXAttachmentItem class]],
+                          [[[OXmlElementMapper element:@"attachment" toClass:[OXAttachmentItem class]]
+                            attribute:@"name"]
+                           body:@"content" blobSink:^(NSString *path, OXContext *ctx) { return [OXBlobSink dataSink]; }]
+                          ]];
+    OXmlReader *reader = [OXmlReader readerWithMapper:mapper];
+    NSArray *items = [reader readXmlText:@"<attachments><attachment name=\"hello.txt\">SGVs\nbG8g\nV29y bGQ=</attachment></attachments>"];
+    STAssertNil(reader.errors, @"no errors");
+    OXAttachmentItem *item = [items lastObject];
+    STAssertEqualObjects(@"hello.txt", item.name, @"attribute");
+    STAssertEqualObjects([@"Hello World" dataUsingEncoding:NSUTF8StringEncoding], item.content, @"body decoded into NSData handle");
+
+    OXBlobSink *sink = [OXBlobSink dataSink];
+    STAssertTrue([sink appendText:@"SGV"], @"partial quantum carried over");
+    STAssertEquals(0ULL, sink.length, @"nothing decoded yet");
+    STAssertTrue([sink appendText:@"sbG8="], @"completed quantum");
+    STAssertEqualObjects([@"Hello" dataUsingEncoding:NSUTF8StringEncoding], [sink finish], @"decoded across chunks");
+    sink = [OXBlobSink dataSink];
+    [sink appendText:@"SGVsb"];
+    STAssertNil([sink finish], @"truncated base64");
+    STAssertNotNil(sink.error, @"error reported");
+    sink = [OXBlobSink dataSink];
+    STAssertFalse([sink appendText:@"-_-_"], @"url-safe characters are not skipped like whitespace");
+    STAssertNil([sink finish], @"invalid character");
+
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSProcessInfo processInfo] globallyUniqueString]];
+    sink = [OXBlobSink fileSinkWithPath:path];
+    [sink appendText:@"SGVs*G8="];
+    STAssertNil([sink finish], @"invalid character in file sink");
+    STAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:path], @"partial file removed on failure");
+    sink = [OXBlobSink fileSinkWithPath:path];
+    [sink appendText:@"SGVs"];
+    [sink abort];
+    STAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:path], @"partial file removed on abort");
+}
+
+@end
+
+
+
+//
+//  Copyright (c) 2013 Outsource Cafe, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
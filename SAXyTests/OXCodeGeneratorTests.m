@@ -0,0 +1,185 @@
+/**
+ 
+  OXCodeGeneratorTests.m
+  SAXy OX - Object-to-XML mapping library
+ 
+  Tests OXCodeGenerator output and reads through the generated accessors registered with OXGeneratedMapping.
+
+  Created by agent on 10/19/26.
+
+*/
+#import <SenTestingKit/SenTestingKit.h>
+#import "OXmlMapper.h"
+#import "OXmlElementMapper.h"
+#import "OXmlContext.h"
+#import "OXmlReader.h"
+#import "OXCodeGenerator.h"
+#import "OXGeneratedMapping.h"
+#import "OXGeneratedFixture.h"
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+#pragma mark - test classes
+////////////////////////////////////////////////////////////////////////////////////////
+
+
+@interface OXGenEmail : NSObject
+@property(nonatomic)NSString *address;
+@property(nonatomic,readonly)NSString *type;
+@end
+
+@implementation OXGenEmail
+@end
+
+@interface OXGenAddress : NSObject
+@property(nonatomic)NSString *city;
+@end
+
+@implementation OXGenAddress
+@end
+
+@interface OXGenContact : NSObject
+@property(nonatomic)NSString *name;
+@property(nonatomic)NSDictionary *emails;
+@property(nonatomic)OXGenAddress *address;
+@end
+
+@implementation OXGenContact
+@end
+
+@interface OXGenItem : NSObject
+@property(nonatomic)NSString *name;
+@property(nonatomic)int count;
+@end
+
+@implementation OXGenItem
+@end
+
+
+//accessors generated into OXGeneratedMapping+Fixture.m:
+@implementation OXFixtureAddress
+@end
+
+@implementation OXFixtureItem
+- (void)setNilValueForKey:(NSString *)key { self.nilKey = key; }
+@end
+
+
+//same properties as the fixture classes, read with reflection and KVC:
+@interface OXReflectedAddress : NSObject
+@property(copy,readwrite,nonatomic) NSString *city;
+@end
+
+@implementation OXReflectedAddress
+@end
+
+@interface OXReflectedItem : NSObject
+@property(copy,readwrite,nonatomic) NSString *name;
+@property(assign,readwrite,nonatomic) int count;
+@property(assign,readwrite,nonatomic) double price;
+@property(strong,readwrite,nonatomic) OXReflectedAddress *address;
+@property(copy,readwrite,nonatomic) NSString *nilKey;
+@end
+
+@implementation OXReflectedItem
+- (void)setNilValueForKey:(NSString *)key { self.nilKey = key; }
+@end
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+#pragma mark - tests
+////////////////////////////////////////////////////////////////////////////////////////
+
+
+@interface OXCodeGeneratorTests : SenTestCase  @end
+
+@implementation OXCodeGeneratorTests
+
+- (void)testCodeGenerator
+{
+    OXmlMapper *contactsMapper = [[OXmlMapper mapper] elements:@[
+                                  [OXmlElementMapper rootXPath:@"/contacts/contact" toMany:[OXGenContact class]],
+                                  [[OXmlElementMapper elementClass:[OXGenContact class]]
+                                   xpath:@"emails/email" toMany:[OXGenEmail class] property:@"emails" dictionaryKey:@"type"],
+                                  [[OXmlElementMapper elementClass:[OXGenEmail class]]
+                                   tagMap:@{@"text()":@"address", @"@type":@"type"}]
+                                  ]];
+    OXCodeGenerator *generator = [OXCodeGenerator generatorWithName:@"Contacts"];
+    generator.imports = @[@"Contacts.h"];
+    NSString *source = [generator sourceForXmlMapper:contactsMapper];
+    STAssertEqualObjects(@"OXGeneratedMapping+Contacts.m", generator.fileName, @"file name");
+    STAssertTrue([source rangeOfString:@"@implementation OXGeneratedMapping (Contacts)"].location != NSNotFound, @"category");
+    STAssertTrue([source rangeOfString:@"((OXGenContact *)target).name = value;"].location != NSNotFound, @"direct setter");
+    STAssertTrue([source rangeOfString:@"[OXGeneratedMapping registerClass:[OXGenAddress class] properties:@["].location != NSNotFound, @"referenced class");
+    STAssertTrue([source rangeOfString:@"@\"emails\":@\"email\""].location != NSNotFound, @"container tag");
+    STAssertTrue([source rangeOfString:@"property:@\"type\"\n            setter:nil"].location != NSNotFound, @"readonly property uses KVC");
+
+    //generated accessors are picked up by the default mapper blocks:
+    __block int calls = 0;
+    [OXGeneratedMapping registerClass:[OXGenItem class] property:@"count"
+        setter:^(NSString *path, id value, id target, OXContext *ctx) { calls++; ((OXGenItem *)target).count = [value intValue]; }
+        getter:^id(NSString *path, id source, OXContext *ctx) { return [NSNumber numberWithInt:((OXGenItem *)source).count]; }];
+    OXmlMapper *mapper = [[OXmlMapper mapper] elements:@[ [OXmlElementMapper rootXPath:@"/item" type:[OXGenItem class]] ]];
+    OXGenItem *item = [[OXmlReader readerWithMapper:mapper] readXmlText:@"<item><name>x</name><count>42</count></item>"];
+    STAssertEquals(1, calls, @"generated setter called");
+    STAssertEquals(42, item.count, @"transformed before direct assignment");
+    STAssertEqualObjects(@"x", item.name, @"KVC for properties without generated accessors");
+}
+
+- (void)testGeneratedFixture
+{
+    STAssertTrue([OXGeneratedMapping isGeneratedClass:[OXFixtureItem class]], @"checked-in fixture registered at load");
+    STAssertFalse([OXGeneratedMapping isGeneratedClass:[OXReflectedItem class]], @"reflection only");
+    OXCodeGenerator *generator = [OXCodeGenerator generatorWithName:@"Fixture"];
+    generator.imports = @[@"OXGeneratedFixture.h"];
+    NSString *source = [generator sourceForClasses:@[[OXFixtureItem class]]];
+    STAssertTrue([source rangeOfString:@"if (value) ((OXFixtureItem *)target).count = [value intValue]; else [target setNilValueForKey:path];"].location != NSNotFound, @"nil checked scalar setter");
+
+    //the same document read through the generated accessors and through KVC:
+    NSString *xml = @"<item><name>widget</name><count>42</count><price>9.75</price><address><city>Boulder</city></address></item>";
+    OXmlMapper *fixtureMapper = [[OXmlMapper mapper] elements:@[ [OXmlElementMapper rootXPath:@"/item" type:[OXFixtureItem class]],
+                                                                 [OXmlElementMapper element:@"address" toClass:[OXFixtureAddress class]] ]];
+    OXmlMapper *reflectedMapper = [[OXmlMapper mapper] elements:@[ [OXmlElementMapper rootXPath:@"/item" type:[OXReflectedItem class]],
+                                                                   [OXmlElementMapper element:@"address" toClass:[OXReflectedAddress class]] ]];
+    OXmlReader *fixtureReader = [OXmlReader readerWithMapper:fixtureMapper];
+    OXmlReader *reflectedReader = [OXmlReader readerWithMapper:reflectedMapper];
+    OXFixtureItem *generated = [fixtureReader readXmlText:xml];
+    OXReflectedItem *reflected = [reflectedReader readXmlText:xml];
+    STAssertNil(fixtureReader.errors, @"generated read errors");
+    STAssertNil(reflectedReader.errors, @"reflected read errors");
+    STAssertEqualObjects(reflected.name, generated.name, @"atomic property");
+    STAssertEquals(reflected.count, generated.count, @"int property");
+    STAssertEquals(42, generated.count, @"int value");
+    STAssertEquals(reflected.price, generated.price, @"double property");
+    STAssertEqualObjects(reflected.address.city, generated.address.city, @"complex property");
+    STAssertEqualObjects(@"Boulder", generated.address.city, @"complex value");
+
+    //nil scalars go to setNilValueForKey:, as with KVC:
+    OXSetterBlock setter = [OXGeneratedMapping setterForClass:[OXFixtureItem class] property:@"count"];
+    STAssertNotNil(setter, @"generated count setter");
+    setter(@"count", nil, generated, fixtureReader.context);
+    [reflected setValue:nil forKey:@"count"];
+    STAssertEqualObjects(reflected.nilKey, generated.nilKey, @"same nil handling");
+    STAssertEqualObjects(@"count", generated.nilKey, @"setNilValueForKey: called");
+    STAssertEquals(42, generated.count, @"not unboxed to 0");
+}
+
+@end
+
+
+
+//
+//  Copyright (c) 2013 Outsource Cafe, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
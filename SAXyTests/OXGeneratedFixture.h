@@ -0,0 +1,48 @@
+/**
+
+  OXGeneratedFixture.h
+  SAXy OX - Object-to-XML mapping library
+
+  Classes mapped by the checked-in OXGeneratedMapping+Fixture.m, generated with:
+
+    OXCodeGenerator *generator = [OXCodeGenerator generatorWithName:@"Fixture"];
+    generator.imports = @[@"OXGeneratedFixture.h"];
+    NSString *source = [generator sourceForClasses:@[[OXFixtureItem class]]];
+
+  Regenerate the fixture when these classes or the generator change.  The classes are only used by the generated
+  mapping tests, so the registered accessors don't change how other tests read.
+
+  Created by agent on 10/19/26.
+
+ */
+#import <Foundation/Foundation.h>
+
+
+@interface OXFixtureAddress : NSObject
+@property(copy,readwrite,nonatomic) NSString *city;
+@end
+
+@interface OXFixtureItem : NSObject
+@property(copy,readwrite,nonatomic) NSString *name;
+@property(assign,readwrite,nonatomic) int count;
+@property(assign,readwrite,nonatomic) double price;
+@property(strong,readwrite,nonatomic) OXFixtureAddress *address;
+@property(copy,readwrite,nonatomic) NSString *nilKey;       //last key passed to setNilValueForKey:
+@end
+
+
+//
+//  Copyright (c) 2013 Outsource Cafe, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
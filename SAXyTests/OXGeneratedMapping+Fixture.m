@@ -0,0 +1,57 @@
+//
+//  OXGeneratedMapping+Fixture.m
+//
+//  Generated by OXCodeGenerator - do not edit, regenerate when the mapped classes change.
+//
+
+#import "OXGeneratedMapping.h"
+#import "OXType.h"
+#import "OXProperty.h"
+#import "OXContext.h"
+#import "OXGeneratedFixture.h"
+
+
+@interface OXGeneratedMapping (Fixture)
+@end
+
+@implementation OXGeneratedMapping (Fixture)
+
++ (void)load
+{
+    @autoreleasepool {
+        //OXFixtureItem
+        [OXGeneratedMapping registerClass:[OXFixtureItem class] properties:@[
+            [OXProperty property:@"address" type:[OXType type:[OXFixtureAddress class] typeEnum:OX_COMPLEX]],
+            [OXProperty property:@"count" type:[OXType scalarType:nil scalarEncoding:"i"]],
+            [OXProperty property:@"name" type:[OXType type:[NSString class] typeEnum:OX_ATOMIC]],
+            [OXProperty property:@"nilKey" type:[OXType type:[NSString class] typeEnum:OX_ATOMIC]],
+            [OXProperty property:@"price" type:[OXType scalarType:nil scalarEncoding:"d"]],
+        ]];
+        [OXGeneratedMapping registerClass:[OXFixtureItem class] property:@"address"
+            setter:^(NSString *path, id value, id target, OXContext *ctx) { ((OXFixtureItem *)target).address = value; }
+            getter:^id(NSString *path, id source, OXContext *ctx) { return ((OXFixtureItem *)source).address; }];
+        [OXGeneratedMapping registerClass:[OXFixtureItem class] property:@"count"
+            setter:^(NSString *path, id value, id target, OXContext *ctx) { if (value) ((OXFixtureItem *)target).count = [value intValue]; else [target setNilValueForKey:path]; }
+            getter:^id(NSString *path, id source, OXContext *ctx) { return [NSNumber numberWithInt:((OXFixtureItem *)source).count]; }];
+        [OXGeneratedMapping registerClass:[OXFixtureItem class] property:@"name"
+            setter:^(NSString *path, id value, id target, OXContext *ctx) { ((OXFixtureItem *)target).name = value; }
+            getter:^id(NSString *path, id source, OXContext *ctx) { return ((OXFixtureItem *)source).name; }];
+        [OXGeneratedMapping registerClass:[OXFixtureItem class] property:@"nilKey"
+            setter:^(NSString *path, id value, id target, OXContext *ctx) { ((OXFixtureItem *)target).nilKey = value; }
+            getter:^id(NSString *path, id source, OXContext *ctx) { return ((OXFixtureItem *)source).nilKey; }];
+        [OXGeneratedMapping registerClass:[OXFixtureItem class] property:@"price"
+            setter:^(NSString *path, id value, id target, OXContext *ctx) { if (value) ((OXFixtureItem *)target).price = [value doubleValue]; else [target setNilValueForKey:path]; }
+            getter:^id(NSString *path, id source, OXContext *ctx) { return [NSNumber numberWithDouble:((OXFixtureItem *)source).price]; }];
+
+        //OXFixtureAddress
+        [OXGeneratedMapping registerClass:[OXFixtureAddress class] properties:@[
+            [OXProperty property:@"city" type:[OXType type:[NSString class] typeEnum:OX_ATOMIC]],
+        ]];
+        [OXGeneratedMapping registerClass:[OXFixtureAddress class] property:@"city"
+            setter:^(NSString *path, id value, id target, OXContext *ctx) { ((OXFixtureAddress *)target).city = value; }
+            getter:^id(NSString *path, id source, OXContext *ctx) { return ((OXFixtureAddress *)source).city; }];
+
+    }
+}
+
+@end
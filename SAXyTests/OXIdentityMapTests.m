@@ -0,0 +1,140 @@
+/**
+ 
+  OXIdentityMapTests.m
+  SAXy OX - Object-to-XML mapping library
+ 
+  Tests identity-map merge reads, which update the instances of earlier reads in place.
+
+  Created by agent on 10/19/26.
+
+*/
+#import <SenTestingKit/SenTestingKit.h>
+#import "OXmlMapper.h"
+#import "OXmlElementMapper.h"
+#import "OXmlContext.h"
+#import "OXmlReader.h"
+#import "OXIdentityMap.h"
+#import "OXObjectPool.h"
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+#pragma mark - test classes
+////////////////////////////////////////////////////////////////////////////////////////
+
+
+@interface OXMergeItem : NSObject
+@property(copy,readwrite,nonatomic) NSString *itemId;
+@property(copy,readwrite,nonatomic) NSString *title;
+@end
+
+@implementation OXMergeItem
+@end
+
+
+@interface OXMergeLocation : NSObject
+@property(copy,readwrite,nonatomic) NSString *name;
+@property(copy,readwrite,nonatomic) NSString *note;         //not mapped
+@end
+
+@implementation OXMergeLocation
+@end
+
+
+@interface OXPooledMergeItem : NSObject <OXReusable>
+@property(copy,readwrite,nonatomic) NSString *itemId;
+@property(strong,readwrite,nonatomic) NSMutableArray *tags;
+@property(strong,readwrite,nonatomic) OXMergeLocation *location;
+@end
+
+@implementation OXPooledMergeItem
+- (void)prepareForReuse
+{
+    [_tags removeAllObjects];
+    _tags = nil;
+    _location.name = nil;
+    _location = nil;
+    _itemId = nil;
+}
+@end
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+#pragma mark - tests
+////////////////////////////////////////////////////////////////////////////////////////
+
+
+@interface OXIdentityMapTests : SenTestCase  @end
+
+@implementation OXIdentityMapTests
+
+- (void)testIdentityMapMerge
+{
+    OXmlMapper *mapper = [[OXmlMapper mapper] elements:@[ [OXmlElementMapper rootXPath:@"/items/item" toMany:[OXMergeItem class]] ]];
+    OXmlReader *reader = [OXmlReader readerWithMapper:mapper];
+    OXIdentityMap *identityMap = [[OXIdentityMap identityMap] key:@"itemId" forClass:[OXMergeItem class]];
+    reader.context.identityMap = identityMap;
+
+    NSArray *first = [reader readXmlText:@"<items><item><itemId>1</itemId><title>a</title></item><item><itemId>2</itemId><title>b</title></item></items>"];
+    STAssertEquals((NSUInteger)2, [first count], @"items read");
+    STAssertEquals((NSUInteger)2, [identityMap.created count], @"created");
+    STAssertEquals((NSUInteger)2, [identityMap count], @"indexed");
+
+    NSString *xml = @"<items><item><itemId>2</itemId><title>b2</title></item><item><itemId>3</itemId><title>c</title></item></items>";
+    NSArray *second = [reader readXmlText:xml];
+    STAssertEquals((NSUInteger)2, [second count], @"items read");
+    STAssertTrue([second objectAtIndex:0] == [first objectAtIndex:1], @"existing instance reused");
+    STAssertEqualObjects(@"b2", [[second objectAtIndex:0] title], @"updated in place");
+    STAssertEqualObjects(@[[first objectAtIndex:1]], identityMap.changed, @"changed");
+    STAssertEqualObjects(@[[second objectAtIndex:1]], identityMap.created, @"created");
+    STAssertEqualObjects(@[[first objectAtIndex:0]], identityMap.removed, @"removed");
+
+    NSArray *third = [reader readXmlText:xml];
+    STAssertEqualObjects(second, third, @"same instances");
+    STAssertEquals((NSUInteger)2, identityMap.unchangedCount, @"unchanged");
+    STAssertEquals((NSUInteger)0, [identityMap.changed count] + [identityMap.created count] + [identityMap.removed count], @"no changes");
+    STAssertTrue(identityMap.root == third, @"root replaced by result");
+}
+
+- (void)testIdentityMapMergeWithPool
+{
+    OXmlMapper *mapper = [[OXmlMapper mapper] elements:@[
+                          [OXmlElementMapper rootXPath:@"/items/item" toMany:[OXPooledMergeItem class]],
+                          [[OXmlElementMapper element:@"item" toClass:[OXPooledMergeItem class]] xpath:@"tags/tag" toMany:[NSString class] property:@"tags"],
+                          [[[OXmlElementMapper element:@"location" toClass:[OXMergeLocation class]] tag:@"name"] lockMapping]
+                          ]];
+    OXmlReader *reader = [OXmlReader readerWithMapper:mapper];
+    OXObjectPool *pool = [OXObjectPool pool];
+    reader.context.objectPool = pool;
+    reader.context.identityMap = [[OXIdentityMap identityMap] key:@"itemId" forClass:[OXPooledMergeItem class]];
+
+    OXPooledMergeItem *first = [[reader readXmlText:@"<items><item><itemId>1</itemId><tags><tag>x</tag></tags><location><name>a</name></location></item></items>"] lastObject];
+    OXMergeLocation *location = first.location;
+    location.note = @"kept";
+    OXPooledMergeItem *second = [[reader readXmlText:@"<items><item><itemId>1</itemId><tags><tag>x</tag><tag>y</tag></tags><location><name>b</name></location></item></items>"] lastObject];
+    STAssertTrue(first == second, @"existing instance reused");
+    STAssertEquals((NSUInteger)1, [pool countForClass:[OXPooledMergeItem class]], @"duplicate recycled");
+    STAssertEqualObjects((@[@"x", @"y"]), second.tags, @"moved container survives recycling of the duplicate");
+    STAssertTrue(second.location == location, @"nested value merged in place");
+    STAssertEqualObjects(@"b", location.name, @"mapped nested property merged");
+    STAssertEqualObjects(@"kept", location.note, @"unmapped nested property left alone");
+}
+
+@end
+
+
+
+//
+//  Copyright (c) 2013 Outsource Cafe, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
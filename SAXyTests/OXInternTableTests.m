@@ -0,0 +1,93 @@
+/**
+ 
+  OXInternTableTests.m
+  SAXy OX - Object-to-XML mapping library
+ 
+  Tests OXInternTable and reads of interned path mappers.
+
+  Created by agent on 10/19/26.
+
+*/
+#import <SenTestingKit/SenTestingKit.h>
+#import "OXmlMapper.h"
+#import "OXmlElementMapper.h"
+#import "OXmlXPathMapper.h"
+#import "OXmlContext.h"
+#import "OXmlReader.h"
+#import "OXInternTable.h"
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+#pragma mark - test classes
+////////////////////////////////////////////////////////////////////////////////////////
+
+
+@interface OXInternedItem : NSObject
+@property(copy,readwrite,nonatomic) NSString *itemId;
+@property(copy,readwrite,nonatomic) NSString *title;
+@end
+
+@implementation OXInternedItem
+@end
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+#pragma mark - tests
+////////////////////////////////////////////////////////////////////////////////////////
+
+
+@interface OXInternTableTests : SenTestCase  @end
+
+@implementation OXInternTableTests
+
+- (void)testInternedValues
+{
+    OXmlElementMapper *itemMapper = [[OXmlElementMapper element:@"item" toClass:[OXInternedItem class]]
+                                     xpathMapper:[[OXmlXPathMapper xpath:@"title"] isInterned]];
+    OXmlMapper *mapper = [[OXmlMapper mapper] elements:@[ [OXmlElementMapper rootXPath:@"/items/item" toMany:[OXInternedItem class]], itemMapper ]];
+    OXmlReader *reader = [OXmlReader readerWithMapper:mapper];
+    NSArray *items = [reader readXmlText:@"<items><item><itemId>1</itemId><title>application/atom+xml</title></item>"
+                                          "<item><itemId>2</itemId><title>application/atom+xml</title></item>"
+                                          "<item><itemId>3</itemId><title>application/rss+xml</title></item></items>"];
+    STAssertEquals((NSUInteger)3, [items count], @"items read");
+    STAssertTrue([[items objectAtIndex:0] title] == [[items objectAtIndex:1] title], @"repeated value shares one instance");
+    STAssertEqualObjects(@"application/rss+xml", [[items objectAtIndex:2] title], @"distinct value");
+    STAssertEquals((NSUInteger)2, [reader.context.internTable count], @"interned values");
+    STAssertEquals((NSUInteger)1, reader.context.internTable.hits, @"hits");
+
+    reader.context.internTable.maxLength = 16;
+    OXmlContext *child = [reader.context childContext];
+    STAssertTrue(child.internTable != reader.context.internTable, @"child contexts get their own table");
+    STAssertEquals((NSUInteger)16, child.internTable.maxLength, @"limits carried over");
+    STAssertEquals((NSUInteger)0, [child.internTable count], @"child table starts empty");
+
+    OXInternTable *table = [OXInternTable internTableWithMaxCount:1];
+    NSMutableString *text = [NSMutableString stringWithString:@"first value, not a tagged pointer"];
+    NSString *first = [table intern:text];
+    [text appendString:@" - parser buffer reused"];
+    STAssertEqualObjects(@"first value, not a tagged pointer", first, @"mutable values are copied");
+    STAssertTrue([table intern:@"first value, not a tagged pointer"] == first, @"shared instance");
+    NSString *second = @"second value, not interned because the table is full";
+    STAssertTrue([table intern:second] == second, @"bounded table passes values through");
+    STAssertEquals((NSUInteger)1, [table count], @"bounded");
+}
+
+@end
+
+
+
+//
+//  Copyright (c) 2013 Outsource Cafe, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
@@ -52,7 +52,11 @@
 #import "OXJSONPathMapper.h"
 #import "OXContext.h"
 #import "OXJSONReader.h"
+#import "OXJSONParallelReader.h"
 #import "OXJSONWriter.h"
+#import "OXObjectPool.h"
+#import "OXGzipStream.h"
+#import "OXLazyArray.h"
 
 
 
@@ -96,11 +100,19 @@
 }
 @end
 
-@interface OXCartoon : OXTuneEntity
+@interface OXCartoon : OXTuneEntity <OXReusable>
 @property (nonatomic, assign) int year;
 @end
 
-@implementation OXCartoon  @end
+@implementation OXCartoon
+- (void)prepareForReuse
+{
+    self.identifier = 0;
+    self.name = nil;
+    self.url = nil;
+    self.year = 0;
+}
+@end
 
 
 @interface OXTune : OXTuneEntity
@@ -331,6 +343,215 @@
 
 }
 
+- (void)testRecycling
+{
+    NSString *json = @"[{\"id\":100103,\"name\":\"Bugs Bunny\",\"starred_in\":[{\"name\":\"A Wild Hare\",\"year\":1940},{\"name\":\"Hare-um Scare-um\",\"year\":1939}]}]";
+    context.objectPool = [OXObjectPool pool];
+    OXJSONReader *reader = [OXJSONReader readerWithMapper:mapper context:context];
+    
+    NSArray *tunes = [reader readText:json];
+    OXCartoon *cartoon = [[[tunes objectAtIndex:0] starredIn] objectAtIndex:0];
+    STAssertEqualObjects(@"A Wild Hare", cartoon.name, @"first read");
+    STAssertEquals((NSUInteger)0, context.objectPool.hits, @"empty pool");
+    STAssertEquals((NSUInteger)2, [reader recycle:[[tunes objectAtIndex:0] starredIn]], @"both OXCartoon instances recycled");
+    STAssertNil(cartoon.name, @"prepareForReuse called on recycle");
+    STAssertEquals((NSUInteger)2, [context.objectPool countForClass:[OXCartoon class]], @"idle OXCartoon instances");
+    
+    tunes = [reader readText:json];
+    STAssertEquals((NSUInteger)2, context.objectPool.hits, @"OXCartoon instances reused by factory");
+    STAssertEquals((NSUInteger)0, [context.objectPool countForClass:[OXCartoon class]], @"pool emptied");
+    OXCartoon *reused = [[[tunes objectAtIndex:0] starredIn] lastObject];
+    STAssertEqualObjects(@"Hare-um Scare-um", reused.name, @"reused instance re-populated");
+    STAssertEquals(1939, reused.year, @"reused instance re-populated");
+}
+- (void)testLazyDecoding
+{
+    OXJSONObjectMapper *tuneMapper = [mapper objectMapperForClass:[OXTune class]];
+    [[tuneMapper objectMapperByPath:@"references"] isLazy];
+    [[tuneMapper objectMapperByPath:@"studio"] isLazy];
+    OXJSONReader *reader = [OXJSONReader readerWithMapper:mapper context:context];
+    
+    NSArray *tunes = [reader readResourceFile:@"tunes.json"];
+    OXTune *tune = [tunes objectAtIndex:0];
+    STAssertTrue([tune.references isKindOfClass:[OXLazyArray class]], @"lazy container installed");
+    OXLazyArray *references = (OXLazyArray *)tune.references;
+    STAssertEquals((NSUInteger)0, references.decodedCount, @"nothing decoded before first access");
+    STAssertEqualObjects(@"http://en.wikiquote.org/wiki/Daffy_Duck/", [[references lastObject] absoluteString], @"NSURL decoded on access");
+    STAssertEquals((NSUInteger)1, references.decodedCount, @"only accessed item decoded");
+    
+    STAssertFalse([(OXLazyProxy *)tune.studio isDecoded], @"lazy complex property not decoded before first access");
+    STAssertEqualObjects(@"Warner Bros.", tune.studio.name, @"OXStudioAddress decoded on access");
+    STAssertEquals(34.152141, tune.studio.location.latitude, @"nested flattened mapping decoded");
+    STAssertTrue([(OXLazyProxy *)tune.studio isDecoded], @"decoded");
+}
+
+- (void)testParallelRead
+{
+    OXJSONMapper *jsonMapper = [[OXJSONMapper mapper] objects:@[
+                                [OXJSONObjectMapper rootToManyClass:[OXCartoon class]]
+                                ,
+                                [[[[OXJSONObjectMapper objectClass:[OXCartoon class]]
+                                    path:@"id" type:[NSNumber class] property:@"identifier"]
+                                   path:@"name"]
+                                  path:@"year" type:[NSNumber class]]
+                                ]];
+    NSMutableString *json = [NSMutableString stringWithString:@"["];
+    for(int i = 0; i < 3000; i++) {     //escaped quotes and brackets inside strings must not split elements
+        [json appendFormat:@"%@\n {\"id\":%d, \"name\":\"Duck \\\"Amuck\\\" [%d], {\\\\}\", \"year\":%d}", i ? @"," : @"", i, i, 1900 + i % 100];
+    }
+    [json appendString:@"\n]"];
+
+    OXJSONParallelReader *reader = [OXJSONParallelReader readerWithMapper:jsonMapper arrayPath:nil];
+    reader.sliceSize = 4096;
+    NSArray *cartoons = [reader readText:json];
+    STAssertNil(reader.errors, @"no slice errors");
+    STAssertTrue(reader.sliceCount > 1, @"decoded in several slices");
+    NSArray *expected = [[OXJSONReader readerWithMapper:jsonMapper] readText:json];
+    STAssertEquals((NSUInteger)3000, [expected count], @"sequential read");
+    STAssertEquals([expected count], [cartoons count], @"all slices merged");
+    for(NSUInteger i = 0; i < [cartoons count]; i++) {
+        OXCartoon *cartoon = [cartoons objectAtIndex:i];
+        STAssertEquals((long)i, cartoon.identifier, @"document order");
+        STAssertEqualObjects([[expected objectAtIndex:i] name], cartoon.name, @"same decoding as OXJSONReader");
+    }
+
+    reader.sliceSize = 1024 * 1024;
+    STAssertEquals((NSUInteger)3000, [[reader readText:json] count], @"small array read sequentially");
+    STAssertEquals((NSUInteger)1, reader.sliceCount, @"one slice");
+}
+
+- (void)testLenientRead
+{
+    OXJSONMapper *jsonMapper = [[OXJSONMapper mapper] objects:@[
+                                [OXJSONObjectMapper rootToManyClass:[OXCartoon class]]
+                                ,
+                                [[[[OXJSONObjectMapper objectClass:[OXCartoon class]]
+                                    path:@"id" type:[NSNumber class] property:@"identifier"]
+                                   path:@"name"]
+                                  pathMapper:[[OXJSONPathMapper path:@"year" scalar:@encode(int) property:@"year" fromType:[NSNumber class]]
+                                              setter:^(NSString *path, id value, id target, OXContext *ctx) {
+                                                  if ([value intValue] < 0)
+                                                      [NSException raise:NSInvalidArgumentException format:@"malformed year: %@", value];
+                                                  [target setValue:value forKey:path];
+                                              }]]
+                                ]];
+    NSString *json = @"[{\"id\":1,\"name\":\"A Wild Hare\",\"year\":1940},{\"id\":2,\"year\":-1},{\"id\":3,\"name\":\"Duck Amuck\",\"year\":1953},null,{\"id\":5,\"year\":-1}]";
+    OXJSONReader *reader = [OXJSONReader readerWithMapper:jsonMapper];
+    STAssertThrows([reader readText:json], @"strict read fails on the first bad item");
+
+    reader.lenient = YES;
+    NSArray *cartoons = [reader readText:json];
+    STAssertEquals((NSUInteger)2, [cartoons count], @"failed items dropped");
+    STAssertEqualObjects(@"Duck Amuck", [[cartoons lastObject] name], @"items after a failure are read");
+    STAssertEquals((NSUInteger)2, reader.droppedRecordCount, @"dropped items counted");
+    STAssertEquals((NSUInteger)2, [reader.errors count], @"one error per dropped item");
+    STAssertTrue([[[[reader.errors objectAtIndex:0] userInfo] objectForKey:OXErrorPathKey] hasSuffix:@"[1]"], @"index of first failure");
+    STAssertTrue([[[[reader.errors objectAtIndex:1] userInfo] objectForKey:OXErrorPathKey] hasSuffix:@"[4]"], @"index of second failure, null items counted");
+    STAssertNotNil([[[reader.errors objectAtIndex:0] userInfo] objectForKey:OXErrorMapperKey], @"failing mapper");
+
+    reader.maxErrorCount = 1;
+    cartoons = [reader readText:json];
+    STAssertEquals((NSUInteger)1, [reader.errors count], @"error log capped");
+    STAssertEquals((NSUInteger)2, reader.droppedRecordCount, @"still counted");
+
+    //a malformed date is a transform failure: reported by a strict read, fails its item in a lenient one
+    OXJSONMapper *tuneMapper = [[OXJSONMapper mapper] objects:@[
+                                [OXJSONObjectMapper rootToManyClass:[OXTune class]]
+                                ,
+                                [[[OXJSONObjectMapper objectClass:[OXTune class]]
+                                    path:@"name"]
+                                   path:@"lastUpdated"]
+                                ]];
+    json = @"[{\"name\":\"Bugs\",\"lastUpdated\":\"2013-03-07T12:30:00-0000\"},{\"name\":\"Daffy\",\"lastUpdated\":\"last Tuesday\"}]";
+    reader = [OXJSONReader readerWithMapper:tuneMapper];
+    NSArray *tunes = [reader readText:json];
+    STAssertEquals((NSUInteger)2, [tunes count], @"strict read keeps the item");
+    STAssertNil([[tunes lastObject] lastUpdated], @"malformed date left nil");
+    STAssertEquals((NSUInteger)1, [reader.errors count], @"transform failure reported");
+    reader.lenient = YES;
+    tunes = [reader readText:json];
+    STAssertEquals((NSUInteger)1, [tunes count], @"lenient read drops the item");
+    STAssertEqualObjects(@"Bugs", [[tunes lastObject] name], @"well-formed item read");
+    STAssertTrue([[[[reader.errors objectAtIndex:0] userInfo] objectForKey:OXErrorPathKey] hasSuffix:@"[1]"], @"index of the malformed item");
+}
+
+- (void)testParallelWrite
+{
+    OXJSONMapper *jsonMapper = [[OXJSONMapper mapper] objects:@[
+                                [OXJSONObjectMapper rootToManyClass:[OXCartoon class]]
+                                ,
+                                [[[[OXJSONObjectMapper objectClass:[OXCartoon class]]
+                                    path:@"id" type:[NSNumber class] property:@"identifier"]
+                                   path:@"name"]
+                                  path:@"year" type:[NSNumber class]]
+                                ]];
+    NSMutableArray *cartoons = [NSMutableArray array];
+    for(int i = 0; i < 1000; i++) {
+        OXCartoon *cartoon = [OXCartoon new];
+        cartoon.identifier = i;
+        cartoon.name = [NSString stringWithFormat:@"Cartoon %d", i];
+        cartoon.year = 1930 + i % 40;
+        [cartoons addObject:cartoon];
+    }
+    NSString *serial = [[OXJSONWriter writerWithMapper:jsonMapper] writeAsText:cartoons];
+    OXJSONWriter *writer = [OXJSONWriter writerWithMapper:jsonMapper];
+    writer.parallelThreshold = 100;
+    STAssertEqualObjects(serial, [writer writeAsText:cartoons], @"items mapped concurrently, joined in order");
+    STAssertNil(writer.errors, @"no errors");
+}
+
+- (void)testReadLimits
+{
+    OXJSONMapper *jsonMapper = [[OXJSONMapper mapper] objects:@[
+                                [OXJSONObjectMapper rootToManyClass:[OXTune class]]
+                                ,
+                                [[[[OXJSONObjectMapper objectClass:[OXTune class]]
+                                   path:@"name"]
+                                  path:@"studio"]
+                                 lockMapping]
+                                ,
+                                [[[OXJSONObjectMapper objectClass:[OXStudioAddress class]]
+                                  path:@"city"]
+                                 lockMapping]
+                                ]];
+    NSMutableArray *items = [NSMutableArray array];
+    for(int i = 0; i < 200; i++)
+        [items addObject:[NSString stringWithFormat:@"{\"name\":\"Daffy%d\",\"studio\":{\"city\":\"Burbank\"}}", i]];
+    NSString *json = [NSString stringWithFormat:@"[%@]", [items componentsJoinedByString:@","]];
+    OXJSONReader *reader = [OXJSONReader readerWithMapper:jsonMapper];
+    reader.context.maxDepth = 2;
+    reader.context.maxContainerCount = 200;
+    reader.context.maxTextLength = 8;
+    NSArray *tunes = [reader readText:json];
+    STAssertEquals((NSUInteger)200, [tunes count], @"within limits");
+    STAssertEqualObjects(@"Burbank", [[[tunes lastObject] studio] city], @"nested object read");
+
+    reader.context.maxContainerCount = 199;
+    STAssertNil([reader readText:json], @"too many container items");
+    STAssertEquals((NSUInteger)1, [reader.errors count], @"one limit error");
+    reader.context.maxContainerCount = 0;
+    reader.context.maxDepth = 1;
+    STAssertNil([reader readText:json], @"too deep");
+    reader.context.maxDepth = 0;
+    reader.context.maxTextLength = 7;
+    STAssertNil([reader readText:json], @"text too long");
+    reader.context.maxTextLength = 0;
+    NSData *data = [json dataUsingEncoding:NSUTF8StringEncoding];
+    reader.context.maxBytes = [data length] / 2;
+    STAssertNil([reader readData:data], @"input too large");
+    STAssertNil([reader readData:[OXGzipOutputStream gzipData:data]], @"inflated input too large");
+    reader.context.maxBytes = 0;
+    STAssertEquals((NSUInteger)200, [[reader readData:[OXGzipOutputStream gzipData:data]] count], @"compressed input within limits");
+
+    reader.context.cancellationToken = [OXCancellationToken token];
+    STAssertNotNil([reader readText:json], @"not cancelled");
+    [reader.context.cancellationToken cancel];
+    STAssertNil([reader readText:json], @"cancelled");
+    reader.context.cancellationToken = nil;
+    reader.context.deadline = [NSDate dateWithTimeIntervalSinceNow:-1.0];
+    STAssertNil([reader readText:json], @"deadline passed");
+    STAssertEqualObjects(@"read deadline", [[[reader.errors lastObject] localizedDescription] substringToIndex:13], @"deadline error");
+}
 
 @end
 
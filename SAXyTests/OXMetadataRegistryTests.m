@@ -0,0 +1,101 @@
+/**
+ 
+  OXMetadataRegistryTests.m
+  SAXy OX - Object-to-XML mapping library
+ 
+  Tests OXMetadataRegistry warm-up and the shared, thread-safe type cache.
+
+  Created by agent on 10/19/26.
+
+*/
+#import <SenTestingKit/SenTestingKit.h>
+#import "OXType.h"
+#import "OXmlMapper.h"
+#import "OXmlElementMapper.h"
+#import "OXmlReader.h"
+#import "OXMetadataRegistry.h"
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+#pragma mark - test classes
+////////////////////////////////////////////////////////////////////////////////////////
+
+
+@interface OXWarmEmail : NSObject
+@property(nonatomic)NSString *address;
+@property(nonatomic)NSString *note;
+@property(nonatomic)NSString *type;
+@end
+
+@implementation OXWarmEmail
+@end
+
+@interface OXWarmAddress : NSObject
+@property(nonatomic)NSString *city;
+@property(nonatomic)int zip;
+@end
+
+@implementation OXWarmAddress
+@end
+
+@interface OXWarmOrganization : NSObject
+@property(nonatomic)NSString *name;
+@property(nonatomic)OXWarmAddress *address;
+@end
+
+@implementation OXWarmOrganization
+@end
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+#pragma mark - tests
+////////////////////////////////////////////////////////////////////////////////////////
+
+
+@interface OXMetadataRegistryTests : SenTestCase  @end
+
+@implementation OXMetadataRegistryTests
+
+- (void)testWarmUp
+{
+    OXmlMapper *mapper = [[OXmlMapper mapperWithRootNamespace:@"http://OutsourceCafe.com/schema/contacts/1/1" recommendedPrefix:@"c"] elements:@[
+                          [OXmlElementMapper rootXPath:@"/contacts/contact/orginization" toMany:[OXWarmOrganization class]]
+                          ]];
+    NSArray *errors = [OXMetadataRegistry warmUpNow:@[ mapper, [OXWarmOrganization class] ]];
+    STAssertNil(errors, @"warm-up errors");
+    STAssertTrue([OXMetadataRegistry typeForClass:[OXWarmOrganization class]].propertiesLoaded, @"mapped class reflected by warm-up");
+    STAssertNotNil([OXMetadataRegistry property:@"zip" ofClass:[OXWarmAddress class]], @"referenced classes reflected");
+
+    //one shared OXType per class, regardless of the calling thread:
+    OXType *expected = [OXMetadataRegistry typeForClass:[OXWarmEmail class]];
+    __block NSUInteger mismatches = 0;
+    dispatch_apply(16, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t i) {
+        if ([OXType cachedType:[OXWarmEmail class]] != expected || [expected.properties count] != 3) {
+            @synchronized(self) { mismatches++; }
+        }
+    });
+    STAssertEquals((NSUInteger)0, mismatches, @"thread-safe type cache");
+
+    OXWarmOrganization *result = [[[OXmlReader readerWithMapper:mapper] readXmlText:@"<contacts xmlns=\"http://OutsourceCafe.com/schema/contacts/1/1\"><contact><orginization><name>Acme</name></orginization></contact></contacts>"] lastObject];
+    STAssertEqualObjects(@"Acme", result.name, @"read after warm-up");
+}
+
+@end
+
+
+
+//
+//  Copyright (c) 2013 Outsource Cafe, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
@@ -120,6 +120,43 @@
     
 }
 
+- (void)testPredicates
+{
+    NSArray *rootab = @[@"/", @"a", @"b"];
+    
+    OXPathLite *child = [OXPathLite xpath:@"a/b[category='news']"];
+    STAssertEqualObjects(@"b", child.pathLeaf, @"predicate stripped from leaf");
+    NSAssert([child matches:rootab], @"a/b[...]");
+    STAssertEquals(OXChildPredicate, child.predicate.predicateType, @"OXChildPredicate");
+    STAssertEqualObjects(@"category", child.predicate.name, @"child name");
+    STAssertTrue([child.predicate matchesText:@"news"], @"news");
+    STAssertFalse([child.predicate matchesText:@"sports"], @"sports");
+    STAssertFalse([child.predicate matchesText:nil], @"missing child");
+    
+    OXPathLite *position = [OXPathLite xpath:@"entry[position()<=50]"];
+    STAssertEquals(OXPositionPredicate, position.predicate.predicateType, @"OXPositionPredicate");
+    STAssertTrue([position.predicate matchesPosition:1], @"1 <= 50");
+    STAssertTrue([position.predicate matchesPosition:50], @"50 <= 50");
+    STAssertFalse([position.predicate matchesPosition:51], @"51 <= 50");
+    
+    OXPathLite *shorthand = [OXPathLite xpath:@"entry[3]"];
+    STAssertTrue([shorthand.predicate matchesPosition:3], @"[3]");
+    STAssertFalse([shorthand.predicate matchesPosition:2], @"[3]");
+    
+    OXPathLite *attribute = [OXPathLite xpath:@"a/b[@href!='http://x.com/a[1]']"];
+    STAssertEquals(OXAttributePredicate, attribute.predicate.predicateType, @"OXAttributePredicate");
+    STAssertEqualObjects(@"href", attribute.predicate.name, @"attribute name");
+    STAssertTrue([attribute.predicate matchesText:@"http://y.com"], @"!=");
+    STAssertFalse([attribute.predicate matchesText:@"http://x.com/a[1]"], @"!=");
+    
+    OXPathLite *numeric = [OXPathLite xpath:@"item[price>9.5]"];
+    STAssertTrue([numeric.predicate matchesText:@"10"], @"numeric compare");
+    STAssertFalse([numeric.predicate matchesText:@"9"], @"numeric compare");
+    
+    STAssertNil([OXPathPredicate predicate:@"a/b='x'"], @"nested child paths not supported");
+    STAssertNil([OXPathPredicate predicate:@"last()"], @"functions not supported");
+}
+
 @end
 
 //
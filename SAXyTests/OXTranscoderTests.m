@@ -0,0 +1,231 @@
+/**
+ 
+  OXTranscoderTests.m
+  SAXy OX - Object-to-XML mapping library
+ 
+  Tests OXTranscoder, streaming XML to JSON and back through existing mappers.
+
+  Created by agent on 10/19/26.
+
+*/
+#import <SenTestingKit/SenTestingKit.h>
+#import "OXmlMapper.h"
+#import "OXmlElementMapper.h"
+#import "OXmlReader.h"
+#import "OXJSONMapper.h"
+#import "OXJSONObjectMapper.h"
+#import "OXTranscoder.h"
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+#pragma mark - test classes
+////////////////////////////////////////////////////////////////////////////////////////
+
+
+@interface OXTransCartoon : NSObject
+@property(nonatomic)long identifier;
+@property(nonatomic)NSString *name;
+@property(nonatomic)int year;
+@end
+
+@implementation OXTransCartoon
+@end
+
+@interface OXTransStudio : NSObject
+@property(nonatomic)NSString *name;
+@property(nonatomic)NSString *city;
+@end
+
+@implementation OXTransStudio
+@end
+
+@interface OXTransTune : NSObject
+@property(nonatomic)long identifier;
+@property(nonatomic)NSString *name;
+@property(nonatomic)NSSet *cartoonSeries;
+@property(nonatomic)NSMutableArray *starredIn;
+@property(nonatomic)OXTransStudio *studio;
+@end
+
+@implementation OXTransTune
+@end
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+#pragma mark - tests
+////////////////////////////////////////////////////////////////////////////////////////
+
+
+@interface OXTranscoderTests : SenTestCase  @end
+
+@implementation OXTranscoderTests
+
+- (void)testTranscoder
+{
+    OXmlMapper *xmlMapper = [[OXmlMapper mapper] elements:@[
+                             [OXmlElementMapper rootXPath:@"/cartoons/cartoon" toMany:[OXTransCartoon class]]
+                             ,
+                             [[[[[OXmlElementMapper elementClass:[OXTransCartoon class]]
+                                 attribute:@"id" scalarType:@encode(long) property:@"identifier"]
+                                tag:@"name"]
+                               tag:@"year" scalarType:@encode(int)]
+                              lockMapping]
+                             ]];
+    OXJSONMapper *jsonMapper = [[OXJSONMapper mapper] objects:@[
+                                [OXJSONObjectMapper rootToManyClass:[OXTransCartoon class]]
+                                ,
+                                [[[[[OXJSONObjectMapper objectClass:[OXTransCartoon class]]
+                                    path:@"id" type:[NSNumber class] property:@"identifier"]
+                                   path:@"name"]
+                                  path:@"year" type:[NSNumber class]]
+                                 lockMapping]
+                                ]];
+    NSString *xml = @"<cartoons><cartoon id=\"1\"><name>Duck \"Amuck\"</name><year>1953</year></cartoon><cartoon id=\"2\"><name>What's Opera, Doc?</name><year>1957</year></cartoon></cartoons>";
+    OXTranscoder *transcoder = [OXTranscoder transcoderWithXmlMapper:xmlMapper jsonMapper:jsonMapper];
+    
+    NSData *json = [transcoder jsonFromXmlData:[xml dataUsingEncoding:NSUTF8StringEncoding]];
+    STAssertNil(transcoder.errors, @"no errors");
+    NSArray *cartoons = [NSJSONSerialization JSONObjectWithData:json options:0 error:nil];
+    STAssertEquals((NSUInteger)2, [cartoons count], @"root container streamed as JSON array");
+    STAssertEqualObjects(@1, [[cartoons objectAtIndex:0] objectForKey:@"id"], @"attribute transformed to JSON number");
+    STAssertEqualObjects(@"Duck \"Amuck\"", [[cartoons objectAtIndex:0] objectForKey:@"name"], @"escaped string");
+    STAssertEqualObjects(@1957, [[cartoons objectAtIndex:1] objectForKey:@"year"], @"element transformed to JSON number");
+    
+    NSString *roundTrip = [transcoder xmlFromJSONData:json prettyPrint:NO];
+    STAssertNil(transcoder.errors, @"no errors");
+    NSArray *result = [[OXmlReader readerWithMapper:xmlMapper] readXmlText:roundTrip];
+    STAssertEquals((NSUInteger)2, [result count], @"JSON transcoded back to XML");
+    OXTransCartoon *cartoon = [result lastObject];
+    STAssertEquals(2L, cartoon.identifier, @"attribute");
+    STAssertEqualObjects(@"What's Opera, Doc?", cartoon.name, @"element");
+    STAssertEquals(1953, ((OXTransCartoon *)[result objectAtIndex:0]).year, @"scalar element");
+    
+    STAssertNil([transcoder jsonFromXmlData:[@"<cartoons><cartoon>" dataUsingEncoding:NSUTF8StringEncoding]], @"no partial JSON");
+    STAssertNotNil(transcoder.errors, @"parse error reported");
+}
+
+- (void)testTranscoderNestedGraph
+{
+    OXmlMapper *xmlMapper = [[OXmlMapper mapper] elements:@[
+                             [OXmlElementMapper rootXPath:@"/tunes/tune" toMany:[OXTransTune class]]
+                             ,
+                             [[[[[[[OXmlElementMapper elementClass:[OXTransTune class]]
+                                   attribute:@"id" scalarType:@encode(long) property:@"identifier"]
+                                  tag:@"name"]
+                                 xpath:@"series" toMany:[NSString class] property:@"cartoonSeries"]
+                                xpath:@"cartoon" toMany:[OXTransCartoon class] property:@"starredIn"]
+                               xpath:@"studio" property:@"studio" type:[OXTransStudio class]]
+                              lockMapping]
+                             ,
+                             [[[[OXmlElementMapper elementClass:[OXTransStudio class]]
+                                tag:@"name"]
+                               tag:@"city"]
+                              lockMapping]
+                             ,
+                             [[[[[OXmlElementMapper elementClass:[OXTransCartoon class]]
+                                 attribute:@"id" scalarType:@encode(long) property:@"identifier"]
+                                tag:@"name"]
+                               tag:@"year" scalarType:@encode(int)]
+                              lockMapping]
+                             ]];
+    OXJSONMapper *jsonMapper = [[OXJSONMapper mapper] objects:@[
+                                [OXJSONObjectMapper rootToManyClass:[OXTransTune class]]
+                                ,
+                                [[[[[[[OXJSONObjectMapper objectClass:[OXTransTune class]]
+                                      path:@"id" type:[NSNumber class] property:@"identifier"]
+                                     path:@"name"]
+                                    path:@"cartoon_series" toMany:[NSString class] property:@"cartoonSeries"]
+                                   path:@"starred_in" toMany:[OXTransCartoon class] property:@"starredIn"]
+                                  path:@"studio"]
+                                 lockMapping]
+                                ,
+                                [[[[OXJSONObjectMapper objectClass:[OXTransStudio class]]
+                                   path:@"name"]
+                                  path:@"city"]
+                                 lockMapping]
+                                ,
+                                [[[[[OXJSONObjectMapper objectClass:[OXTransCartoon class]]
+                                    path:@"id" type:[NSNumber class] property:@"identifier"]
+                                   path:@"name"]
+                                  path:@"year" type:[NSNumber class]]
+                                 lockMapping]
+                                ]];
+    NSString *xml = @"<tunes>"
+                     "<tune id=\"100101\"><name>Daffy Duck</name><series>Looney Tunes</series><series>Merrie Melodies</series>"
+                     "<cartoon id=\"1\"><name>Duck Amuck</name><year>1953</year></cartoon>"
+                     "<cartoon id=\"2\"><name>Daffy Doodles</name><year>1946</year></cartoon>"
+                     "<studio><name>Warner Bros.</name><city>Burbank</city></studio></tune>"
+                     "<tune id=\"100103\"><name>Bugs Bunny</name><series>Looney Tunes</series></tune>"
+                     "</tunes>";
+    NSData *xmlData = [xml dataUsingEncoding:NSUTF8StringEncoding];
+    OXTranscoder *transcoder = [OXTranscoder transcoderWithXmlMapper:xmlMapper jsonMapper:jsonMapper];
+
+    NSData *json = [transcoder jsonFromXmlData:xmlData];
+    STAssertNil(transcoder.errors, @"no errors");
+    NSArray *tunes = [NSJSONSerialization JSONObjectWithData:json options:0 error:nil];
+    STAssertEquals((NSUInteger)2, [tunes count], @"tunes");
+    NSDictionary *daffy = [tunes objectAtIndex:0];
+    STAssertEqualObjects((@[@"Looney Tunes", @"Merrie Melodies"]), [daffy objectForKey:@"cartoon_series"], @"atomic container streamed as an array of strings");
+    NSArray *starredIn = [daffy objectForKey:@"starred_in"];
+    STAssertEquals((NSUInteger)2, [starredIn count], @"complex container");
+    STAssertEqualObjects(@1946, [[starredIn lastObject] objectForKey:@"year"], @"nested object member transformed");
+    STAssertEqualObjects(@2, [[starredIn lastObject] objectForKey:@"id"], @"nested object attribute");
+    STAssertEqualObjects(@"Burbank", [[daffy objectForKey:@"studio"] objectForKey:@"city"], @"nested complex object after a container");
+    NSDictionary *bugs = [tunes lastObject];
+    STAssertEqualObjects((@[@"Looney Tunes"]), [bugs objectForKey:@"cartoon_series"], @"single item container");
+    STAssertNil([bugs objectForKey:@"starred_in"], @"empty container omitted");
+
+    NSString *roundTrip = [transcoder xmlFromJSONData:json prettyPrint:NO];
+    STAssertNil(transcoder.errors, @"no errors");
+    OXTransTune *tune = [[[OXmlReader readerWithMapper:xmlMapper] readXmlText:roundTrip] objectAtIndex:0];
+    STAssertEqualObjects(@"Burbank", tune.studio.city, @"nested object transcoded back to XML");
+    STAssertEquals((NSUInteger)2, [tune.starredIn count], @"complex container transcoded back to XML");
+    STAssertTrue([tune.cartoonSeries containsObject:@"Merrie Melodies"], @"atomic container transcoded back to XML");
+
+    //stream path, same output as the buffered one
+    NSOutputStream *memory = [NSOutputStream outputStreamToMemory];
+    [memory open];
+    STAssertTrue([transcoder writeJSONFromXmlData:xmlData toStream:memory], @"streamed from data");
+    STAssertEqualObjects(json, [memory propertyForKey:NSStreamDataWrittenToMemoryStreamKey], @"streamed JSON");
+    memory = [NSOutputStream outputStreamToMemory];
+    [memory open];
+    STAssertTrue([transcoder writeJSONFromXmlStream:[NSInputStream inputStreamWithData:xmlData] toStream:memory], @"streamed from stream");
+    STAssertEqualObjects(json, [memory propertyForKey:NSStreamDataWrittenToMemoryStreamKey], @"streamed JSON");
+
+    //error part way through a document larger than one flush: nil when buffered, partial output when streamed
+    NSMutableString *large = [NSMutableString stringWithString:@"<tunes>"];
+    for(int i = 0; i < 1000; i++) {
+        [large appendFormat:@"<tune id=\"%d\"><name>Daffy %d</name><series>Looney Tunes</series></tune>", i, i];
+    }
+    [large appendString:@"<tune id=\"1000\"><name>Bugs</nam></tune></tunes>"];
+    NSData *largeData = [large dataUsingEncoding:NSUTF8StringEncoding];
+    STAssertNil([transcoder jsonFromXmlData:largeData], @"no partial JSON from the buffered conversion");
+    STAssertNotNil(transcoder.errors, @"parse error reported");
+    memory = [NSOutputStream outputStreamToMemory];
+    [memory open];
+    STAssertFalse([transcoder writeJSONFromXmlData:largeData toStream:memory], @"streamed conversion fails");
+    STAssertNotNil(transcoder.errors, @"parse error reported");
+    NSData *partial = [memory propertyForKey:NSStreamDataWrittenToMemoryStreamKey];
+    STAssertTrue([partial length] > 0, @"chunks flushed before the error stay in the stream");
+    STAssertNil([NSJSONSerialization JSONObjectWithData:partial options:0 error:nil], @"partial output is not valid JSON");
+}
+
+@end
+
+
+
+//
+//  Copyright (c) 2013 Outsource Cafe, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
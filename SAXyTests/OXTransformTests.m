@@ -15,6 +15,7 @@
 #import "OXmlXPathMapper.h"
 #import "OXProperty.h"
 #import "OXTransform.h"
+#import <objc/runtime.h>
 
 
 ////////////////////////////////////////////////////////////////////////////////////////
@@ -211,6 +212,84 @@
     STAssertEqualObjects(@"d", [OXTransform keyForEncodedType:@encode(double)], @"test keyForEncodedType on @encode(double)");
 }
 
+- (void)testScalarEnumDispatch
+{
+    STAssertEquals(OX_SCALAR_BOOL, [OXType scalarEnumForEncodedType:OX_ENCODED_BOOL], @"OX_ENCODED_BOOL");
+    STAssertEquals(OX_SCALAR_CHAR, [OXType scalarEnumForEncodedType:"Tc,N,V_isHtmlBody"], @"encoded property");
+    STAssertEquals(OX_SCALAR_ULONG, [OXType scalarEnumForEncodedType:@encode(unsigned long)], @"@encode(unsigned long)");
+    STAssertEquals(OX_SCALAR_DOUBLE, [OXType scalarEnumForEncodedType:@encode(NSTimeInterval)], @"@encode(NSTimeInterval)");
+    STAssertEquals(OX_SCALAR_UNKNOWN, [OXType scalarEnumForEncodedType:"T^c,N,V_charPtr"], @"pointers not supported");
+    STAssertEquals([OXType cachedScalarType:"Ti,N,V_a"], [OXType cachedScalarType:@encode(int)], @"scalar types cached by enum");
+    
+    //a class named 'L' used to collide with the unsigned long scalar key:
+    Class lClass = objc_getClass("L");
+    if (lClass == nil) {
+        lClass = objc_allocateClassPair([NSObject class], "L", 0);
+        objc_registerClassPair(lClass);
+    }
+    OXTransformBlock scalarToString = [_transform transformerScalar:@encode(unsigned long) to:[NSString class]];
+    STAssertNotNil(scalarToString, @"unsigned long -> NSString");
+    [_transform registerFrom:lClass to:[NSString class] transformer:^(id value, OXContext *ctx) { return @"L"; }];
+    STAssertEquals(scalarToString, [_transform transformerScalar:@encode(unsigned long) to:[NSString class]], @"no collision");
+    STAssertEquals(scalarToString, [_transform transformerScalarEnum:OX_SCALAR_ULONG to:[NSString class]], @"enum lookup");
+    STAssertEqualObjects(@"L", [_transform transformerFrom:lClass to:[NSString class]](nil, _ctx), @"class lookup");
+}
+
+- (void)testThreadLocalFormatters
+{
+    NSFormatter *shared = [_transform formatterWithName:OX_CURRENCY_FORMATTER];
+    STAssertNotNil(shared, @"registered formatter");
+    STAssertEquals(shared, [_transform formatterWithName:OX_CURRENCY_FORMATTER], @"used as-is on owner thread");
+    STAssertEquals(shared, [_transform localFormatter:shared], @"used as-is on owner thread");
+    
+    __block NSFormatter *local1 = nil;
+    __block NSFormatter *local2 = nil;
+    __block NSFormatter *named = nil;
+    dispatch_semaphore_t done = dispatch_semaphore_create(0);
+    OXTransform *transform = _transform;
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        local1 = [transform localFormatter:shared];
+        local2 = [transform localFormatter:local1];
+        named = [transform formatterWithName:OX_CURRENCY_FORMATTER];
+        dispatch_semaphore_signal(done);
+    });
+    dispatch_semaphore_wait(done, DISPATCH_TIME_FOREVER);
+    STAssertNotNil(local1, @"thread copy");
+    STAssertTrue(local1 != shared, @"other threads get a copy");
+    STAssertEquals(local1, local2, @"copy is reused, not copied again");
+    STAssertEquals(local1, named, @"named lookup returns the thread copy");
+    STAssertEqualObjects([(NSNumberFormatter *)shared stringFromNumber:@12.5], [(NSNumberFormatter *)local1 stringFromNumber:@12.5], @"same format");
+}
+
+- (void)testContainerBuilders
+{
+    NSArray *items = @[@"a", @"b", @"b"];
+    OXContainerBuilderBlock arrayBuilder = [_transform builderForContainer:[NSArray class]];
+    STAssertEqualObjects(items, arrayBuilder(nil, items, _ctx), @"new NSArray");
+    STAssertEqualObjects((@[@"z", @"a", @"b", @"b"]), arrayBuilder(@[@"z"], items, _ctx), @"existing NSArray");
+    
+    NSMutableArray *existing = [NSMutableArray arrayWithObject:@"z"];
+    OXContainerBuilderBlock mutableBuilder = [_transform builderForContainer:[NSMutableArray class]];
+    STAssertEquals((id)existing, mutableBuilder(existing, items, _ctx), @"mutable container filled in place");
+    STAssertEquals((NSUInteger)4, [existing count], @"mutable container filled in place");
+    
+    OXContainerBuilderBlock setBuilder = [_transform builderForContainer:[NSSet class]];
+    STAssertEquals((NSUInteger)2, [setBuilder(nil, items, _ctx) count], @"NSSet removes duplicates");
+    
+    _ctx.currentMapper = [OXmlXPathMapper xpath:@"tag" toMany:[OXTransTestObj class] property:@"tags" dictionaryKey:@"note"];
+    OXTransTestObj *obj1 = [[OXTransTestObj alloc] init];
+    obj1.note = @"one";
+    OXTransTestObj *obj2 = [[OXTransTestObj alloc] init];
+    obj2.note = @"two";
+    NSDictionary *dict = [_transform builderForContainer:[NSDictionary class]](nil, @[obj1, obj2], _ctx);
+    STAssertFalse([dict isKindOfClass:[NSMutableDictionary class]], @"immutable dictionary");
+    STAssertEquals(obj2, [dict objectForKey:@"two"], @"keyed by dictionaryKeyName");
+    OXTransTestObj *unkeyed = [[OXTransTestObj alloc] init];
+    STAssertNil([_transform builderForContainer:[NSDictionary class]](nil, @[unkeyed], _ctx), @"no keyed items, no dictionary");
+    STAssertNil([_transform builderForContainer:[NSMutableDictionary class]](nil, @[unkeyed], _ctx), @"no keyed items, no mutable dictionary");
+    STAssertEquals(dict, [_transform builderForContainer:[NSMutableDictionary class]](dict, @[unkeyed], _ctx), @"existing dictionary kept");
+}
+
 - (void)testXmlEncoding
 {
     STAssertNil([OXUtil xmlSafeString:nil], @"nil safe");
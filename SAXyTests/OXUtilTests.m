@@ -26,4 +26,92 @@
     STAssertTrue([OXUtil knownSimpleType:[NSMutableString class]], @"knownSimpleType: NSMutableString");
 }
 
+- (void)testNumberFormatting
+{
+    char buffer[OX_NUMBER_BUFFER_SIZE];
+    [OXUtil formatDouble:0.1 + 0.2 buffer:buffer];
+    STAssertEquals(0, strcmp("0.30000000000000004", buffer), @"all digits needed to round-trip");
+    [OXUtil formatDouble:39.112233 buffer:buffer];
+    STAssertEquals(0, strcmp("39.112233", buffer), @"no more digits than needed");
+    [OXUtil formatDouble:5e-324 buffer:buffer];
+    STAssertEquals(0, strcmp("5e-324", buffer), @"shortest subnormal");
+    [OXUtil formatFloat:0.1f buffer:buffer];
+    STAssertEquals(0, strcmp("0.1", buffer), @"float digits, not its double expansion");
+    STAssertEquals((size_t)20, [OXUtil formatInt64:INT64_MIN buffer:buffer], @"int64 length");
+    STAssertEquals(0, strcmp("-9223372036854775808", buffer), @"INT64_MIN");
+    [OXUtil formatUInt64:UINT64_MAX buffer:buffer];
+    STAssertEquals(0, strcmp("18446744073709551615", buffer), @"UINT64_MAX");
+
+    STAssertEqualObjects(@"3", [OXUtil stringFromNumber:[NSNumber numberWithDouble:3.0]], @"integral double");
+    STAssertEqualObjects(@"-42", [OXUtil stringFromNumber:[NSNumber numberWithShort:-42]], @"short");
+    STAssertEqualObjects(@"1.10", [OXUtil stringFromNumber:[NSDecimalNumber decimalNumberWithString:@"1.10"]], @"decimals unchanged");
+    for(int i = 0; i < 1000; i++) {
+        double value = (double)arc4random() / (arc4random() | 1) * (i % 2 ? 1e-7 : 1e9);
+        STAssertEquals(value, strtod([[OXUtil stringFromNumber:[NSNumber numberWithDouble:value]] UTF8String], NULL), @"round trip %d", i);
+    }
+
+    //the process locale doesn't change the decimal separator:
+    const char *saved = setlocale(LC_NUMERIC, NULL);
+    NSString *savedLocale = saved ? [NSString stringWithUTF8String:saved] : @"C";
+    if (setlocale(LC_NUMERIC, "de_DE.UTF-8") || setlocale(LC_NUMERIC, "fr_FR.UTF-8")) {
+        [OXUtil formatDouble:39.112233 buffer:buffer];
+        STAssertEquals(0, strcmp("39.112233", buffer), @"C locale decimal point");
+        setlocale(LC_NUMERIC, [savedLocale UTF8String]);
+    }
+}
+
+- (void)testNumberFormattingSpeed
+{
+    const int count = 200000;
+    double *values = malloc(count * sizeof(double));
+    for(int i = 0; i < count; i++)
+        values[i] = i % 4 == 0 ? (double)(i * 7) : (double)arc4random() / (arc4random() | 1) * (i % 2 ? 1e-3 : 1e3);
+    char buffer[OX_NUMBER_BUFFER_SIZE];
+    size_t total = 0;
+    CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+    for(int i = 0; i < count; i++)
+        total += [OXUtil formatDouble:values[i] buffer:buffer];
+    const CFAbsoluteTime formatTime = CFAbsoluteTimeGetCurrent() - start;
+    start = CFAbsoluteTimeGetCurrent();
+    for(int i = 0; i < count; i++) @autoreleasepool {
+        total += [[[NSNumber numberWithDouble:values[i]] stringValue] length];
+    }
+    const CFAbsoluteTime stringValueTime = CFAbsoluteTimeGetCurrent() - start;
+    free(values);
+    NSLog(@"formatDouble: %.3fs, stringValue: %.3fs for %d values (%lu chars)", formatTime, stringValueTime, count, (unsigned long)total);
+    STAssertTrue(formatTime < stringValueTime * 2, @"no slower than NSNumber stringValue (which drops round-trip digits)");
+}
+
+- (void)testBase64
+{
+    NSData *text = [@"Man is distinguished" dataUsingEncoding:NSASCIIStringEncoding];
+    STAssertEqualObjects(@"TWFuIGlzIGRpc3Rpbmd1aXNoZWQ=", [OXUtil base64StringByEncodingData:text], @"padded encoding");
+    STAssertEqualObjects(text, [OXUtil decodeBase64String:@"TWFuIGlz\r\n  IGRpc3Rp\r\n  bmd1aXNoZWQ="], @"whitespace skipped");
+    STAssertNil([OXUtil decodeBase64String:@"TWFuIGlzIGRpc3Rpbmd1aXNoZWQ"], @"padding required by default");
+    STAssertNil([OXUtil decodeBase64String:@"TWFuIGlz*GRpc3Rpbmd1aXNoZWQ="], @"invalid character");
+
+    const uint8_t bytes[] = {0xfb, 0xff, 0xbf};
+    NSData *binary = [NSData dataWithBytes:bytes length:sizeof(bytes)];
+    STAssertEqualObjects(@"+/+/", [OXUtil base64StringByEncodingData:binary], @"standard alphabet");
+    STAssertEqualObjects(@"-_-_", [OXUtil base64StringByEncodingData:binary options:OX_BASE64_URL_SAFE], @"url-safe alphabet");
+    STAssertEqualObjects(binary, [OXUtil decodeBase64String:@"-_-_" options:OX_BASE64_URL_SAFE], @"url-safe decoding");
+    STAssertNil([OXUtil decodeBase64String:@"+/+/" options:OX_BASE64_URL_SAFE], @"standard characters are not url-safe");
+
+    NSData *one = [@"A" dataUsingEncoding:NSASCIIStringEncoding];
+    STAssertEqualObjects(@"QQ", [OXUtil base64StringByEncodingData:one options:OX_BASE64_NO_PADDING], @"unpadded encoding");
+    STAssertEqualObjects(one, [OXUtil decodeBase64String:@"QQ" options:OX_BASE64_NO_PADDING], @"unpadded decoding");
+    STAssertEqualObjects(one, [OXUtil decodeBase64String:@"QQ==" options:OX_BASE64_NO_PADDING], @"padding still accepted");
+
+    //long enough for the vector paths, all lengths modulo 3
+    NSMutableData *data = [NSMutableData data];
+    for(uint32_t i = 0; i < 1000; i++) {
+        uint8_t byte = (uint8_t)(i * 7919 >> 3);
+        [data appendBytes:&byte length:1];
+        for(OXBase64Options options = 0; options <= (OX_BASE64_URL_SAFE | OX_BASE64_NO_PADDING); options++) {
+            NSString *encoded = [OXUtil base64StringByEncodingData:data options:options];
+            STAssertEqualObjects(data, [OXUtil decodeBase64String:encoded options:options], @"round trip of %u bytes, options %d", i+1, options);
+        }
+    }
+}
+
 @end
@@ -0,0 +1,141 @@
+/**
+ 
+  OXmlColumnReaderTests.m
+  SAXy OX - Object-to-XML mapping library
+ 
+  Tests OXmlColumnReader and the typed OXColumn buffers it fills.
+
+  Created by agent on 10/19/26.
+
+*/
+#import <SenTestingKit/SenTestingKit.h>
+#import "OXmlMapper.h"
+#import "OXmlElementMapper.h"
+#import "OXmlContext.h"
+#import "OXmlReader.h"
+#import "OXmlColumnReader.h"
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+#pragma mark - test classes
+////////////////////////////////////////////////////////////////////////////////////////
+
+
+@interface OXColumnItem : NSObject
+@property(copy,readwrite,nonatomic) NSString *name;
+@property(assign,readwrite,nonatomic) int count;
+@property(assign,readwrite,nonatomic) unsigned long long serial;
+@end
+
+@implementation OXColumnItem
+@end
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+#pragma mark - tests
+////////////////////////////////////////////////////////////////////////////////////////
+
+
+@interface OXmlColumnReaderTests : SenTestCase  @end
+
+@implementation OXmlColumnReaderTests
+
+- (void)testColumnReader
+{
+    OXmlMapper *mapper = [[OXmlMapper mapper] elements:@[
+                          [OXmlElementMapper rootXPath:@"/items/item" toMany:[OXColumnItem class]],
+                          [OXmlElementMapper element:@"item" toClass:[OXColumnItem class]]
+                          ]];
+    OXmlColumnReader *reader = [OXmlColumnReader readerWithMapper:mapper recordClass:[OXColumnItem class] properties:@[@"count", @"name"]];
+    NSArray *columns = [reader readXmlText:@"<items><item><name>first</name><count>3</count></item>"
+                                            "<item><count>4</count></item>"
+                                            "<item><name>third</name><count>5</count></item></items>"];
+    STAssertNil(reader.errors, @"no errors");
+    STAssertEquals((NSUInteger)2, [columns count], @"one column per property");
+    STAssertEquals((NSUInteger)3, reader.recordCount, @"records read");
+    OXColumn *count = [reader columnNamed:@"count"];
+    STAssertEquals(OX_COLUMN_INT64, count.columnEnum, @"int scalar stored as int64");
+    const int64_t *counts = [count int64Values];
+    STAssertEquals((int64_t)12, counts[0] + counts[1] + counts[2], @"contiguous values");
+    OXColumn *name = [reader columnNamed:@"name"];
+    STAssertEquals(OX_COLUMN_STRING, name.columnEnum, @"NSString stored in arena");
+    STAssertEqualObjects(@"", [name stringAtIndex:1], @"missing value");
+    STAssertEqualObjects(@"third", [name stringAtIndex:2], @"string offsets");
+    STAssertEquals((NSUInteger)10, [name stringOffsets][3], @"one arena for all values");
+
+    STAssertTrue([count hasValueAtIndex:1], @"present");
+    STAssertFalse([name hasValueAtIndex:1], @"missing string flagged");
+    STAssertNil([name objectAtIndex:1], @"missing string boxed as nil");
+    STAssertEquals((NSUInteger)1, name.missingCount, @"missing values counted");
+
+    reader = [OXmlColumnReader readerWithMapper:mapper recordClass:[OXColumnItem class] properties:@[@"missing"]];
+    STAssertNil([reader readXmlText:@"<items/>"], @"unmapped property");
+    STAssertNotNil(reader.errors, @"error reported");
+}
+
+- (void)testColumnReaderNamespacesAndMissingValues
+{
+    OXmlMapper *mapper = [[OXmlMapper mapperWithRootNamespace:@"ns.com/feed" recommendedPrefix:@"f"] elements:@[
+                          [OXmlElementMapper rootXPath:@"/items/item" toMany:[OXColumnItem class]],
+                          [[[[OXmlElementMapper element:@"item" toClass:[OXColumnItem class]]
+                             attribute:@"serial" scalarType:@encode(unsigned long long)]
+                            tag:@"count" scalarType:@encode(int)]
+                           tag:@"name"]
+                          ]];
+    NSString *xml = @"<f:items xmlns:f='ns.com/feed'>"
+                     "<f:item serial='18446744073709551615'><f:name>max</f:name><f:count>0</f:count></f:item>"
+                     "<f:item serial='9223372036854775808'><f:name>no count</f:name></f:item>"
+                     "<item xmlns='ns.com/feed' serial='7'><name>default ns</name><count>-2</count></item>"
+                     "</f:items>";
+    OXmlColumnReader *reader = [OXmlColumnReader readerWithMapper:mapper recordClass:[OXColumnItem class] properties:@[@"serial", @"count", @"name"]];
+    STAssertNotNil([reader readXmlText:xml], @"read");
+    STAssertNil(reader.errors, @"no errors");
+    STAssertEquals((NSUInteger)3, reader.recordCount, @"prefixed and default namespace records matched");
+    STAssertEqualObjects(@"default ns", [[reader columnNamed:@"name"] stringAtIndex:2], @"default namespace element");
+
+    OXColumn *count = [reader columnNamed:@"count"];
+    STAssertTrue([count hasValueAtIndex:0], @"stored zero is a value");
+    STAssertFalse([count hasValueAtIndex:1], @"missing int flagged, not read as 0");
+    STAssertEquals((int64_t)-2, [count int64AtIndex:2], @"signed value");
+    STAssertEquals((NSUInteger)1, count.missingCount, @"one missing count");
+    STAssertEquals((uint8_t)0x05, [count presenceMask][0], @"presence bits");
+
+    OXColumn *serial = [reader columnNamed:@"serial"];
+    STAssertTrue(serial.isUnsigned, @"unsigned long long column");
+    STAssertEquals(ULLONG_MAX, [serial uint64AtIndex:0], @"no overflow above INT64_MAX");
+    STAssertEquals(9223372036854775808ULL, [serial uint64AtIndex:1], @"INT64_MAX + 1");
+    STAssertEqualObjects([NSNumber numberWithUnsignedLongLong:7], [serial objectAtIndex:2], @"boxed unsigned value");
+
+    OXColumnItem *item = [[[OXmlReader readerWithMapper:mapper] readXmlText:xml] objectAtIndex:0];
+    STAssertEquals(ULLONG_MAX, item.serial, @"object reader parses unsigned text without saturating");
+
+    reader = [OXmlColumnReader readerWithMapper:mapper recordClass:[OXColumnItem class] properties:@[@"serial", @"count"]];
+    [reader.context.transform registerFrom:[NSString class] toScalar:@encode(int) transformer:^(id string, OXContext *ctx) {
+        return [NSNumber numberWithInt:10 * [(NSString *)string intValue]];
+    }];
+    STAssertNotNil([reader readXmlText:xml], @"read reusing the record buffer");
+    count = [reader columnNamed:@"count"];
+    STAssertEquals((int64_t)-20, [count int64AtIndex:2], @"registered transformer still applied");
+    STAssertFalse([count hasValueAtIndex:1], @"missing value after a parsed record");
+    STAssertEquals(9223372036854775808ULL, [[reader columnNamed:@"serial"] uint64AtIndex:1], @"default transformer parsed in place");
+}
+
+@end
+
+
+
+//
+//  Copyright (c) 2013 Outsource Cafe, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
@@ -238,6 +238,33 @@
 }
 
 
+
+- (void)testScopedNamespaces
+{
+    OXmlMapper *mapper = [[OXmlMapper mapperWithRootNamespace:@"ns.com/x" recommendedPrefix:@"c"]
+                          elements:@[
+                              [OXmlElementMapper rootXPath:@"/list/ns" toMany:[OXNS class]]
+                              ,
+                              [[OXmlElementMapper elementClass:[OXNS class]]
+                               xpath:@"a"]
+                          ]]
+    ;
+    OXmlReader *reader = [OXmlReader readerWithMapper:mapper];
+    NSString *xml = @"<x:list xmlns:x='ns.com/x'>"
+                     "<x:ns><x:a>one</x:a></x:ns>"
+                     "<y:ns xmlns:y='ns.com/x'><y:a>two</y:a></y:ns>"
+                     "</x:list>";
+    NSArray *array = [reader readXmlText:xml];
+    STAssertNil(reader.errors, @"no errors");
+    STAssertEquals((NSUInteger)2, [array count], @"both prefixes resolved");
+    STAssertEqualObjects(@"two", [[array objectAtIndex:1] a], @"element scoped prefix");
+    STAssertNil([mapper.nsByPrefix objectForKey:@"x"], @"document prefixes don't change the mapper");
+    STAssertNil([mapper.nsByPrefix objectForKey:@"y"], @"element prefixes don't change the mapper");
+    STAssertEqualObjects(@"c", [mapper.nsByURI objectForKey:@"ns.com/x"], @"configured prefix kept for writers");
+    STAssertEquals([mapper namespaceIdForURI:@"ns.com/x"], [mapper.nsURIById indexOfObject:@"ns.com/x"], @"namespace id");
+}
+
+
 @end
 
 //
@@ -0,0 +1,550 @@
+/**
+ 
+  OXmlReaderTests.m
+  SAXy OX - Object-to-XML mapping library
+ 
+  Tests OXmlReader features layered over the basic mapping: predicates, early termination, limits and read modes.
+
+  Created by agent on 10/19/26.
+
+*/
+#import <SenTestingKit/SenTestingKit.h>
+#import "OXmlMapper.h"
+#import "OXmlElementMapper.h"
+#import "OXmlXPathMapper.h"
+#import "OXmlContext.h"
+#import "OXmlReader.h"
+#import "OXmlWriter.h"
+#import "OXmlParallelReader.h"
+#import "OXGzipStream.h"
+#import "OXResultCache.h"
+#import "OXLazyArray.h"
+#import "OXObjectPool.h"
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+#pragma mark - test classes
+////////////////////////////////////////////////////////////////////////////////////////
+
+
+@interface OXReadVoice : NSObject
+@property(nonatomic)NSString *actor;
+@end
+
+@implementation OXReadVoice
+@end
+
+@interface OXReadToon : NSObject
+@property(nonatomic)NSString *kind;
+@property(nonatomic)NSString *name;
+@property(nonatomic)OXReadVoice *voice;
+@property(nonatomic)NSString *species;
+@end
+
+@implementation OXReadToon
+@end
+
+@interface OXReadCast : NSObject
+@property(nonatomic)NSArray *members;
+@property(nonatomic)NSString *title;
+@end
+
+@implementation OXReadCast
+@end
+
+@interface OXReadCopyCast : NSObject
+@property(copy,nonatomic)NSArray *members;
+@end
+
+@implementation OXReadCopyCast
+@end
+
+@interface OXReadTune : NSObject <OXReusable>
+@property(nonatomic)NSString *firstName;
+@property(nonatomic)NSString *lastName;
+@end
+
+@implementation OXReadTune
+- (void)prepareForReuse
+{
+    _firstName = nil;
+    _lastName = nil;
+}
+@end
+
+@interface OXReadEpisode : NSObject
+@property(nonatomic)NSString *title;
+@property(nonatomic)NSDate *aired;
+@end
+
+@implementation OXReadEpisode
+@end
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+#pragma mark - tests
+////////////////////////////////////////////////////////////////////////////////////////
+
+
+@interface OXmlReaderFeatureTests : SenTestCase  @end
+
+@implementation OXmlReaderFeatureTests
+{
+    NSString *castXml;
+    NSUInteger toonsCreated;
+}
+
+- (void)setUp
+{
+    [super setUp];
+    castXml = @"<cast>"
+               "<toon kind=\"duck\"><name>Daffy</name><species>duck</species></toon>"
+               "<toon kind=\"rabbit\"><name>Bugs</name><voice><actor>Mel Blanc</actor></voice><species>rabbit</species></toon>"
+               "<toon kind=\"duck\"><name>Donald</name><species>duck</species></toon>"
+               "<toon kind=\"pig\"><name>Porky</name><species>pig</species></toon>"
+               "<title>Looney Tunes</title>"
+               "</cast>";
+    toonsCreated = 0;
+}
+
+//members mapped with the given xpath, counting OXReadToon instances built by the factory
+- (OXmlMapper *)castMapper:(NSString *)membersXPath
+{
+    return [[OXmlMapper mapper] elements:@[
+             [OXmlElementMapper rootXPath:@"/cast" type:[OXReadCast class]],
+             [[[OXmlElementMapper elementClass:[OXReadCast class]]
+                                xpath:membersXPath toMany:[OXReadToon class] property:@"members"]
+                                xpath:@"title" property:@"title"],
+             [[[[[OXmlElementMapper elementClass:[OXReadToon class]]
+                                attribute:@"kind" property:@"kind"]
+                                xpath:@"name" property:@"name"]
+                                xpath:@"species" property:@"species"]
+                                elementFactory:^(NSString *path, OXContext *ctx) {
+                                    toonsCreated++;
+                                    return [[OXReadToon alloc] init];
+                                }],
+             [[OXmlElementMapper elementClass:[OXReadVoice class]]
+                                xpath:@"actor" property:@"actor"]
+    ]];
+}
+
+//tune elements mapped to OXReadTune members
+- (OXmlMapper *)tuneMapper
+{
+    return [[OXmlMapper mapper] elements:@[
+             [OXmlElementMapper rootXPath:@"/cast" type:[OXReadCast class]],
+             [[OXmlElementMapper elementClass:[OXReadCast class]]
+                                xpath:@"tune" toMany:[OXReadTune class] property:@"members"],
+             [[[OXmlElementMapper elementClass:[OXReadTune class]]
+                                xpath:@"firstName" property:@"firstName"]
+                                xpath:@"lastName" property:@"lastName"]
+    ]];
+}
+
+//cast of count tunes named Daffy0, Daffy1, ...
+- (OXReadCast *)tuneCast:(int)count
+{
+    NSMutableArray *members = [NSMutableArray arrayWithCapacity:count];
+    for(int i = 0; i < count; i++) {
+        OXReadTune *tune = [OXReadTune new];
+        tune.firstName = [NSString stringWithFormat:@"Daffy%d", i];
+        tune.lastName = @"Duck";
+        [members addObject:tune];
+    }
+    OXReadCast *cast = [OXReadCast new];
+    cast.members = members;
+    return cast;
+}
+
+- (NSArray *)namesOf:(OXReadCast *)cast
+{
+    return [cast.members valueForKey:@"name"];
+}
+
+- (void)testPredicates
+{
+    OXReadCast *cast = [[OXmlReader readerWithMapper:[self castMapper:@"toon[@kind='duck']"]] readXmlText:castXml];
+    STAssertEqualObjects((@[@"Daffy", @"Donald"]), [self namesOf:cast], @"attribute predicate");
+    STAssertEquals((NSUInteger)2, toonsCreated, @"rejected sub-trees skipped without building objects");
+    STAssertEqualObjects(@"Looney Tunes", cast.title, @"elements after skipped sub-trees are read");
+
+    toonsCreated = 0;
+    cast = [[OXmlReader readerWithMapper:[self castMapper:@"toon[@kind!='duck']"]] readXmlText:castXml];
+    STAssertEqualObjects((@[@"Bugs", @"Porky"]), [self namesOf:cast], @"negated attribute predicate");
+    STAssertEqualObjects(@"pig", [[cast.members lastObject] species], @"accepted sub-tree fully mapped");
+
+    toonsCreated = 0;
+    cast = [[OXmlReader readerWithMapper:[self castMapper:@"toon[position()<=2]"]] readXmlText:castXml];
+    STAssertEqualObjects((@[@"Daffy", @"Bugs"]), [self namesOf:cast], @"position range");
+    STAssertEquals((NSUInteger)2, toonsCreated, @"later elements skipped");
+
+    cast = [[OXmlReader readerWithMapper:[self castMapper:@"toon[3]"]] readXmlText:castXml];
+    STAssertEqualObjects((@[@"Donald"]), [self namesOf:cast], @"position shorthand");
+
+    toonsCreated = 0;
+    cast = [[OXmlReader readerWithMapper:[self castMapper:@"toon[species='duck']"]] readXmlText:castXml];
+    STAssertEqualObjects((@[@"Daffy", @"Donald"]), [self namesOf:cast], @"child predicate");
+    STAssertEquals((NSUInteger)4, toonsCreated, @"child predicates decide after the object is built, rejected ones are dropped");
+    STAssertEqualObjects(@"Looney Tunes", cast.title, @"parent still mapped");
+
+    cast = [[OXmlReader readerWithMapper:[self castMapper:@"toon[name='Elmer']"]] readXmlText:castXml];
+    STAssertNotNil(cast, @"no match is not an error");
+    STAssertEquals((NSUInteger)0, [cast.members count], @"nothing matched");
+
+    //document-level range: the parser stops at the first element past it, so the malformed tail is never read
+    OXmlMapper *mapper = [[OXmlMapper mapper] elements:@[
+                           [OXmlElementMapper rootXPath:@"/cast/toon[position()<=2]" toMany:[OXReadToon class]],
+                           [[OXmlElementMapper elementClass:[OXReadToon class]] xpath:@"name" property:@"name"]
+                           ]];
+    NSString *truncated = @"<cast><toon><name>Daffy</name></toon><toon><name>Bugs</name></toon><toon><name>Donald</name></toon><oops></cast>";
+    for(NSNumber *tokenize in @[ @NO, @YES ]) {
+        OXmlReader *reader = [OXmlReader readerWithMapper:mapper];
+        reader.useTokenizer = [tokenize boolValue];
+        NSArray *toons = [reader readXmlText:truncated];
+        STAssertEqualObjects((@[@"Daffy", @"Bugs"]), [toons valueForKey:@"name"], @"range read, tokenizer: %@", tokenize);
+        STAssertNil(reader.errors, @"stopped before the malformed input, tokenizer: %@", tokenize);
+    }
+}
+
+- (void)testStopCondition
+{
+    OXmlReader *reader = [OXmlReader readerWithMapper:[self castMapper:@"toon"]];
+    __block NSUInteger count = 0;
+    reader.stopCondition = ^(id object, OXmlXPathMapper *mapper, OXmlContext *ctx) {
+        return (BOOL)([object isKindOfClass:[OXReadToon class]] && ++count >= 2);
+    };
+    OXReadCast *cast = [reader readXmlText:castXml];
+    STAssertNotNil(cast, @"partial graph returned, not nil");
+    STAssertNil(reader.errors, @"abortParsing is not reported as an error");
+    STAssertEqualObjects((@[@"Daffy", @"Bugs"]), [self namesOf:cast], @"first N items");
+    STAssertEquals((NSUInteger)2, toonsCreated, @"parsing stopped");
+    STAssertNil(cast.title, @"elements after the stop are not read");
+
+    //stop inside a record: the open toon and cast are closed by finishOpenElements and assigned to their parents
+    reader = [OXmlReader readerWithMapper:[self castMapper:@"toon"]];
+    reader.stopCondition = ^(id object, OXmlXPathMapper *mapper, OXmlContext *ctx) {
+        return [object isKindOfClass:[OXReadVoice class]];
+    };
+    cast = [reader readXmlText:castXml];
+    STAssertEqualObjects((@[@"Daffy", @"Bugs"]), [self namesOf:cast], @"partially read record assigned to its parent");
+    OXReadToon *bugs = [cast.members lastObject];
+    STAssertEqualObjects(@"Mel Blanc", bugs.voice.actor, @"nested object read up to the stop");
+    STAssertNil(bugs.species, @"properties after the stop are not set");
+    STAssertNil(cast.title, @"open parent closed without reading further");
+
+    //predicate and stop condition together
+    toonsCreated = 0;
+    count = 0;
+    reader = [OXmlReader readerWithMapper:[self castMapper:@"toon[@kind='duck']"]];
+    reader.stopCondition = ^(id object, OXmlXPathMapper *mapper, OXmlContext *ctx) {
+        return (BOOL)([object isKindOfClass:[OXReadToon class]] && ++count >= 1);
+    };
+    cast = [reader readXmlText:castXml];
+    STAssertEqualObjects((@[@"Daffy"]), [self namesOf:cast], @"first matching item");
+}
+
+- (void)testParallelRead
+{
+    OXReadCast *cast = [self tuneCast:2000];
+    OXmlMapper *mapper = [self tuneMapper];
+    NSString *xml = [[OXmlWriter writerWithMapper:mapper] writeXml:cast prettyPrint:YES];
+
+    OXmlParallelReader *reader = [OXmlParallelReader readerWithMapper:mapper recordPath:@"/cast/tune"];
+    reader.chunkSize = 4096;
+    OXReadCast *copy = [reader readXmlText:xml];
+    STAssertNil(reader.errors, @"no chunk errors");
+    STAssertTrue(reader.chunkCount > 1, @"read in several chunks");
+    STAssertEquals((NSUInteger)2000, [copy.members count], @"all members merged");
+    for(NSUInteger i = 0; i < [copy.members count]; i++) {
+        STAssertEqualObjects([[cast.members objectAtIndex:i] firstName], [[copy.members objectAtIndex:i] firstName], @"document order at %lu", (unsigned long)i);
+    }
+
+    reader.chunkSize = 1024 * 1024;
+    copy = [reader readXmlText:xml];
+    STAssertEquals((NSUInteger)1, reader.chunkCount, @"small document read sequentially");
+    STAssertEquals((NSUInteger)2000, [copy.members count], @"sequential read");
+}
+
+- (void)testReadLimits
+{
+    OXmlMapper *mapper = [self tuneMapper];
+    NSString *xml = [[OXmlWriter writerWithMapper:mapper] writeXml:[self tuneCast:200] prettyPrint:NO];     //indentation would count as text
+    OXmlReader *reader = [OXmlReader readerWithMapper:mapper];
+    reader.context.maxDepth = 3;
+    reader.context.maxContainerCount = 200;
+    reader.context.maxTextLength = 8;
+    STAssertEquals((NSUInteger)200, [[[reader readXmlText:xml] members] count], @"within limits");
+
+    reader.context.maxContainerCount = 199;
+    STAssertNil([reader readXmlText:xml], @"too many container items");
+    STAssertEquals((NSUInteger)1, [reader.errors count], @"limit error, not a parser error");
+    reader.context.maxContainerCount = 0;
+    reader.context.maxDepth = 2;
+    STAssertNil([reader readXmlText:xml], @"too deep");
+    reader.context.maxDepth = 0;
+    reader.context.maxTextLength = 7;
+    STAssertNil([reader readXmlText:xml], @"text too long");
+    reader.context.maxTextLength = 0;
+    reader.context.maxBytes = [xml length] / 2;
+    STAssertNil([reader readXmlText:xml], @"input too large");
+    STAssertNil([reader readXmlData:[OXGzipOutputStream gzipData:[xml dataUsingEncoding:NSUTF8StringEncoding]] fromURL:nil], @"inflated input too large");
+    reader.context.maxBytes = 0;
+
+    reader.context.cancellationToken = [OXCancellationToken token];
+    STAssertNotNil([reader readXmlText:xml], @"not cancelled");
+    [reader.context.cancellationToken cancel];
+    STAssertNil([reader readXmlText:xml], @"cancelled");
+    reader.context.cancellationToken = nil;
+    reader.context.deadline = [NSDate dateWithTimeIntervalSinceNow:-1.0];
+    STAssertNil([reader readXmlText:xml], @"deadline passed");
+    STAssertEqualObjects(@"read deadline", [[[reader.errors lastObject] localizedDescription] substringToIndex:13], @"deadline error");
+}
+
+- (void)testAsyncRead
+{
+    OXmlMapper *mapper = [self tuneMapper];
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:@"OXAsyncRead.xml.gz"];
+    NSData *xml = [[[OXmlWriter writerWithMapper:mapper] writeXml:[self tuneCast:5000] prettyPrint:YES] dataUsingEncoding:NSUTF8StringEncoding];  //several pipe chunks
+    STAssertTrue([[OXGzipOutputStream gzipData:xml] writeToFile:path atomically:YES], @"test file");
+
+    dispatch_queue_t queue = dispatch_queue_create("com.outsourcecafe.ox.test", DISPATCH_QUEUE_SERIAL);
+    dispatch_semaphore_t done = dispatch_semaphore_create(0);
+    __block OXReadCast *copy = nil;
+    __block NSArray *readErrors = nil;
+    [[OXmlReader readerWithMapper:mapper] readXmlURL:[NSURL fileURLWithPath:path] queue:queue completion:^(id result, NSArray *errors) {
+        copy = result;
+        readErrors = errors;
+        dispatch_semaphore_signal(done);
+    }];
+    STAssertEquals(0L, dispatch_semaphore_wait(done, dispatch_time(DISPATCH_TIME_NOW, 10 * NSEC_PER_SEC)), @"completion called");
+    STAssertNil(readErrors, @"no errors");
+    STAssertEquals((NSUInteger)5000, [copy.members count], @"inflated and parsed while reading");
+    STAssertEqualObjects(@"Daffy4999", [[copy.members lastObject] firstName], @"last member");
+
+    [[OXmlReader readerWithMapper:mapper] readXmlURL:[NSURL fileURLWithPath:[path stringByAppendingString:@".missing"]] queue:queue completion:^(id result, NSArray *errors) {
+        copy = result;
+        readErrors = errors;
+        dispatch_semaphore_signal(done);
+    }];
+    dispatch_semaphore_wait(done, dispatch_time(DISPATCH_TIME_NOW, 10 * NSEC_PER_SEC));
+    STAssertNil(copy, @"missing file");
+    STAssertNotNil(readErrors, @"missing file error");
+    [[NSFileManager defaultManager] removeItemAtPath:path error:nil];
+}
+
+- (void)testLenientRead
+{
+    OXmlMapper *mapper = [[OXmlMapper mapper] elements:@[
+                                [OXmlElementMapper rootXPath:@"/cast" type:[OXReadCast class]],
+                                [[OXmlElementMapper elementClass:[OXReadCast class]]
+                                                   xpath:@"tune" toMany:[OXReadTune class] property:@"members"],
+                                [[[OXmlElementMapper elementClass:[OXReadTune class]]
+                                                   xpathMapper:[[OXmlXPathMapper xpath:@"firstName" type:[NSString class] property:@"firstName"]
+                                                                setter:^(NSString *path, id value, id target, OXContext *ctx) {
+                                                                    if ([value hasPrefix:@"Bad"])
+                                                                        [NSException raise:NSInvalidArgumentException format:@"malformed name: %@", value];
+                                                                    [target setValue:value forKey:path];
+                                                                }]]
+                                                   xpath:@"lastName" property:@"lastName"]
+                          ]];
+    NSString *xml = @"<cast>\n"
+                     "<tune><firstName>Daffy</firstName><lastName>Duck</lastName></tune>\n"
+                     "<tune><firstName>Bad1</firstName><lastName>Duck</lastName></tune>\n"
+                     "<tune><firstName>Bugs</firstName><lastName>Bunny</lastName></tune>\n"
+                     "<tune><firstName>Bad2</firstName><lastName>Bunny</lastName></tune>\n"
+                     "</cast>";
+    OXmlReader *reader = [OXmlReader readerWithMapper:mapper];
+    reader.lenient = YES;
+    OXReadCast *cast = [reader readXmlText:xml];
+    STAssertEquals((NSUInteger)2, [cast.members count], @"failed records dropped");
+    STAssertEqualObjects(@"Bunny", [[cast.members lastObject] lastName], @"records after a failure are read");
+    STAssertEquals((NSUInteger)2, reader.droppedRecordCount, @"dropped records counted");
+    NSDictionary *info = [[reader.errors objectAtIndex:0] userInfo];
+    STAssertEqualObjects(@"/cast/tune/firstName", [info objectForKey:OXErrorPathKey], @"failure path");
+    STAssertEquals(3, [[info objectForKey:OXErrorLineKey] intValue], @"failure line");
+    STAssertEqualObjects(@"firstName", [[info objectForKey:OXErrorMapperKey] toPath], @"failing mapper");
+
+    reader.maxErrorCount = 1;
+    cast = [reader readXmlText:xml];
+    STAssertEquals((NSUInteger)1, [reader.errors count], @"error log capped");
+    STAssertEquals((NSUInteger)2, reader.droppedRecordCount, @"still counted");
+}
+
+- (void)testMalformedValues
+{
+    OXmlMapper *mapper = [[OXmlMapper mapper] elements:@[
+                                [OXmlElementMapper rootXPath:@"/cast" type:[OXReadCast class]],
+                                [[OXmlElementMapper elementClass:[OXReadCast class]]
+                                                   xpath:@"episode" toMany:[OXReadEpisode class] property:@"members"],
+                                [[[OXmlElementMapper elementClass:[OXReadEpisode class]]
+                                                   xpath:@"title" property:@"title"]
+                                                   xpath:@"aired" property:@"aired"]
+                          ]];
+    NSString *xml = @"<cast>\n"
+                     "<episode><title>A Wild Hare</title><aired>1940-07-27T00:00:00Z</aired></episode>\n"
+                     "<episode><title>Hare-um Scare-um</title><aired>August 12th 1939</aired></episode>\n"
+                     "<episode><title>Duck Amuck</title><aired>1953-02-28T00:00:00Z</aired></episode>\n"
+                     "</cast>";
+
+    //strict: the value stays nil and the failure is reported
+    OXmlReader *reader = [OXmlReader readerWithMapper:mapper];
+    OXReadCast *cast = [reader readXmlText:xml];
+    STAssertEquals((NSUInteger)3, [cast.members count], @"records kept");
+    STAssertNil([[cast.members objectAtIndex:1] aired], @"malformed date left nil");
+    STAssertNotNil([[cast.members objectAtIndex:2] aired], @"well-formed date read");
+    STAssertEquals((NSUInteger)1, [reader.errors count], @"transform failure reported");
+    STAssertTrue([[[reader.errors lastObject] localizedDescription] rangeOfString:@"August 12th 1939"].location != NSNotFound, @"malformed value in message");
+
+    //lenient: the record is dropped, with the position of the failure on either parser
+    for(NSNumber *tokenize in @[ @NO, @YES ]) {
+        reader = [OXmlReader readerWithMapper:mapper];
+        reader.lenient = YES;
+        reader.useTokenizer = [tokenize boolValue];
+        cast = [reader readXmlText:xml];
+        STAssertEquals((NSUInteger)2, [cast.members count], @"malformed record dropped");
+        STAssertEqualObjects(@"Duck Amuck", [[cast.members lastObject] title], @"records after a failure are read");
+        STAssertEquals((NSUInteger)1, reader.droppedRecordCount, @"dropped record counted");
+        NSDictionary *info = [[reader.errors objectAtIndex:0] userInfo];
+        STAssertEqualObjects(@"/cast/episode/aired", [info objectForKey:OXErrorPathKey], @"failure path");
+        STAssertEquals(3, [[info objectForKey:OXErrorLineKey] intValue], @"failure line, tokenizer: %@", tokenize);
+    }
+}
+
+- (void)testResultCache
+{
+    NSString *daffy = @"<cast><tune><firstName>Daffy</firstName><lastName>Duck</lastName></tune></cast>";
+    NSString *bugs = @"<cast><tune><firstName>Bugs</firstName><lastName>Bunny</lastName></tune></cast>";
+    OXResultCache *cache = [OXResultCache cacheWithCapacity:[daffy length] + [bugs length]];
+    OXmlReader *reader = [OXmlReader readerWithMapper:[self tuneMapper]];
+    reader.resultCache = cache;
+    OXReadCast *first = [reader readXmlText:daffy];
+    STAssertEquals(first, [reader readXmlText:daffy], @"repeated input returns the cached graph");
+    STAssertEquals((NSUInteger)1, cache.hits, @"hit");
+    STAssertEquals((NSUInteger)1, cache.misses, @"miss");
+    STAssertEqualObjects(@"Bugs", [[[[reader readXmlText:bugs] members] lastObject] firstName], @"different input is parsed");
+    STAssertEquals((NSUInteger)2, cache.count, @"both cached");
+
+    [reader readXmlText:[daffy stringByAppendingString:@" "]];
+    STAssertEquals((NSUInteger)2, cache.evictions, @"least recently used entries evicted to fit");
+    STAssertEquals((NSUInteger)1, cache.count, @"one entry left");
+
+    [cache removeAllResults];
+    cache.copyBlock = ^id(id result) {
+        OXReadCast *copy = [OXReadCast new];
+        copy.members = [[result members] copy];
+        return copy;
+    };
+    first = [reader readXmlText:daffy];
+    OXReadCast *second = [reader readXmlText:daffy];
+    STAssertTrue(first != second, @"copies handed out");
+    STAssertEqualObjects([[first.members lastObject] firstName], [[second.members lastObject] firstName], @"same content");
+
+    //results of pooled readers are recycled by their callers, so they are never cached or shared:
+    cache.copyBlock = nil;
+    reader.context.objectPool = [OXObjectPool pool];
+    NSUInteger hits = cache.hits;
+    first = [reader readXmlText:bugs];
+    [reader recycle:first];
+    second = [reader readXmlText:bugs];
+    STAssertTrue(first != second, @"cache bypassed");
+    STAssertEquals(hits, cache.hits, @"no hits");
+    STAssertEqualObjects(@"Bugs", [[second.members lastObject] firstName], @"parsed again after recycling");
+}
+
+- (void)testRecycling
+{
+    NSString *xml = @"<cast><tune><firstName>Bugs</firstName></tune><tune><firstName>Daffy</firstName><lastName>Duck</lastName></tune></cast>";
+    OXmlReader *reader = [OXmlReader readerWithMapper:[self tuneMapper]];
+    STAssertEquals((NSUInteger)0, [reader recycle:[[reader readXmlText:xml] members]], @"nothing recycled without a pool");
+
+    OXObjectPool *pool = [OXObjectPool pool];
+    reader.context.objectPool = pool;
+    OXReadCast *cast = [reader readXmlText:xml];
+    OXReadTune *daffy = [cast.members lastObject];
+    STAssertEquals((NSUInteger)0, pool.hits, @"empty pool");
+    STAssertEquals((NSUInteger)0, [reader recycle:cast], @"OXReadCast isn't reusable, so its members aren't reached");
+    STAssertEquals((NSUInteger)2, [reader recycle:cast.members], @"both OXReadTune instances recycled");
+    STAssertNil(daffy.firstName, @"prepareForReuse called on recycle");
+    STAssertEquals((NSUInteger)2, [pool countForClass:[OXReadTune class]], @"idle OXReadTune instances");
+
+    cast = [reader readXmlText:xml];
+    STAssertEquals((NSUInteger)2, pool.hits, @"OXReadTune instances reused by factory");
+    STAssertEquals((NSUInteger)0, [pool countForClass:[OXReadTune class]], @"pool emptied");
+    STAssertEqualObjects((@[@"Bugs", @"Daffy"]), [cast.members valueForKey:@"firstName"], @"reused instances re-populated");
+    STAssertNil([[cast.members objectAtIndex:0] lastName], @"no stale values carried over");
+}
+
+- (void)testLazyRead
+{
+    OXmlMapper *mapper = [[OXmlMapper mapper] elements:@[
+             [OXmlElementMapper rootXPath:@"/cast" type:[OXReadCast class]],
+             [[OXmlElementMapper elementClass:[OXReadCast class]]
+                                xpathMapper:[[OXmlXPathMapper xpath:@"tune" toMany:[OXReadTune class] containerType:[NSArray class] property:@"members"] isLazy]],
+             [[[OXmlElementMapper elementClass:[OXReadTune class]]
+                                xpath:@"firstName" property:@"firstName"]
+                                xpath:@"lastName" property:@"lastName"]
+    ]];
+    NSString *xml = [[OXmlWriter writerWithMapper:[self tuneMapper]] writeXml:[self tuneCast:3] prettyPrint:NO];
+    OXmlReader *reader = [OXmlReader readerWithMapper:mapper];
+    OXReadCast *cast = [reader readXmlText:xml];
+    STAssertNil(reader.errors, @"no errors");
+    STAssertTrue([cast.members isKindOfClass:[OXLazyArray class]], @"complex items captured");
+    STAssertEquals((NSUInteger)3, [cast.members count], @"one source per item");
+    STAssertEqualObjects(@"Daffy2", [[cast.members lastObject] firstName], @"decoded on access");
+
+    //copy property setters keep the lazy array, so later items are appended rather than replacing earlier ones:
+    mapper = [[OXmlMapper mapper] elements:@[
+             [OXmlElementMapper rootXPath:@"/cast" type:[OXReadCopyCast class]],
+             [[OXmlElementMapper elementClass:[OXReadCopyCast class]]
+                                xpathMapper:[[OXmlXPathMapper xpath:@"tune" toMany:[OXReadTune class] containerType:[NSArray class] property:@"members"] isLazy]],
+             [[[OXmlElementMapper elementClass:[OXReadTune class]]
+                                xpath:@"firstName" property:@"firstName"]
+                                xpath:@"lastName" property:@"lastName"]
+    ]];
+    xml = [[OXmlWriter writerWithMapper:[self tuneMapper]] writeXml:[self tuneCast:64] prettyPrint:NO];
+    OXReadCopyCast *copyCast = [[OXmlReader readerWithMapper:mapper] readXmlText:xml];
+    STAssertTrue([copyCast.members isKindOfClass:[OXLazyArray class]], @"still lazy after a copy setter");
+    STAssertEquals((NSUInteger)64, [copyCast.members count], @"no items lost");
+    STAssertEquals((NSUInteger)0, [(OXLazyArray *)copyCast.members decodedCount], @"nothing decoded by the setter");
+
+    //decoded concurrently, after the reader is gone:
+    __block NSUInteger mismatches = 0;
+    dispatch_apply(64, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t i) {
+        NSString *expected = [NSString stringWithFormat:@"Daffy%lu", (unsigned long)i];
+        if ( ! [[[copyCast.members objectAtIndex:i] firstName] isEqualToString:expected] || [[copyCast.members objectAtIndex:63 - i] firstName] == nil) {
+            @synchronized(self) { mismatches++; }
+        }
+    });
+    STAssertEquals((NSUInteger)0, mismatches, @"thread-safe decoding");
+    STAssertEquals((NSUInteger)64, [(OXLazyArray *)copyCast.members decodedCount], @"each item decoded once");
+
+    //atomic items are plain text, nothing to defer:
+    mapper = [[OXmlMapper mapper] elements:@[
+             [OXmlElementMapper rootXPath:@"/cast" type:[OXReadCast class]],
+             [[OXmlElementMapper elementClass:[OXReadCast class]]
+                                xpathMapper:[[OXmlXPathMapper xpath:@"tune" toMany:[NSString class] containerType:[NSArray class] property:@"members"] isLazy]]
+    ]];
+    reader = [OXmlReader readerWithMapper:mapper];
+    STAssertNil([reader readXmlText:@"<cast><tune>Daffy</tune></cast>"], @"lazy atomic container rejected");
+    STAssertTrue([[[reader.errors lastObject] localizedDescription] hasPrefix:@"lazy XML containers"], @"configuration error");
+}
+
+@end
+
+
+
+//
+//  Copyright (c) 2013 Outsource Cafe, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
@@ -0,0 +1,124 @@
+/**
+ 
+  OXmlTokenizerTests.m
+  SAXy OX - Object-to-XML mapping library
+ 
+  Tests OXmlTokenizer, the UTF-8 tokenizer readers can use in place of NSXMLParser.
+
+  Created by agent on 10/19/26.
+
+*/
+#import <SenTestingKit/SenTestingKit.h>
+#import "OXmlMapper.h"
+#import "OXmlElementMapper.h"
+#import "OXmlContext.h"
+#import "OXmlReader.h"
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+#pragma mark - test classes
+////////////////////////////////////////////////////////////////////////////////////////
+
+
+@interface OXTokenEmail : NSObject
+@property(nonatomic)NSString *address;
+@property(nonatomic)NSString *note;
+@property(nonatomic)NSString *type;
+@property(nonatomic)NSURL *url;
+@end
+
+@implementation OXTokenEmail
+@end
+
+@interface OXTokenAddress : NSObject
+@property(nonatomic)NSString *city;
+@property(nonatomic)int zip;
+@end
+
+@implementation OXTokenAddress
+@end
+
+@interface OXTokenOrganization : NSObject
+@property(nonatomic)NSString *name;
+@property(nonatomic)NSURL *homePage;
+@property(nonatomic)NSDate *lastUpdated;
+@property(nonatomic)NSString *notes;
+@property(nonatomic)NSDictionary *emails;
+@property(nonatomic)OXTokenAddress *address;
+@end
+
+@implementation OXTokenOrganization
+@end
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+#pragma mark - tests
+////////////////////////////////////////////////////////////////////////////////////////
+
+
+@interface OXmlTokenizerTests : SenTestCase  @end
+
+@implementation OXmlTokenizerTests
+
+- (OXmlMapper *)contactsMapper
+{
+    return [[OXmlMapper mapperWithRootNamespace:@"http://OutsourceCafe.com/schema/contacts/1/1" recommendedPrefix:@"c"] elements:@[
+             [OXmlElementMapper rootXPath:@"/contacts/contact/orginization" toMany:[OXTokenOrganization class]],
+             [[OXmlElementMapper element:@"orginization" toClass:[OXTokenOrganization class]]
+                                xpath:@"emails/email" toMany:[OXTokenEmail class] property:@"emails" dictionaryKey:@"type"],
+             [[OXmlElementMapper elementClass:[OXTokenEmail class]]
+                                tagMap:@{@"text()":@"address", @"@note":@"note", @"@type":@"type", @"@url":@"url"}]
+    ]];
+}
+
+- (void)testTokenizerReader
+{
+    OXmlReader *parserReader = [OXmlReader readerWithMapper:[self contactsMapper]];
+    NSArray *expected = [parserReader readXmlFile:@"ContactsTestData.xml"];
+    OXmlReader *reader = [OXmlReader readerWithMapper:[self contactsMapper]];
+    reader.useTokenizer = YES;
+    NSArray *array = [reader readXmlFile:@"ContactsTestData.xml"];
+    STAssertNil(reader.errors, @"no tokenizer errors");
+    STAssertEquals([expected count], [array count], @"same result count as NSXMLParser");
+    OXTokenOrganization *org = [array objectAtIndex:0];
+    OXTokenOrganization *expectedOrg = [expected objectAtIndex:0];
+    STAssertEqualObjects(expectedOrg.name, org.name, @"org.name");
+    STAssertEqualObjects(expectedOrg.homePage, org.homePage, @"org.homePage");
+    STAssertEqualObjects(expectedOrg.lastUpdated, org.lastUpdated, @"org.lastUpdated");
+    STAssertEqualObjects(expectedOrg.notes, org.notes, @"org.notes");
+    STAssertEquals(expectedOrg.address.zip, org.address.zip, @"org.address.zip");
+    STAssertEquals([expectedOrg.emails count], [org.emails count], @"org.emails count");
+    OXTokenEmail *email1 = [org.emails objectForKey:@"home"];
+    STAssertEqualObjects(@"http://dude.com/x?a=1&b=2", [email1.url absoluteString], @"entity decoding");
+
+    //entities, CDATA, comments and errors:
+    OXmlMapper *mapper = [[OXmlMapper mapper] elements:@[ [OXmlElementMapper rootXPath:@"/item" type:[OXTokenEmail class]] ]];
+    reader = [OXmlReader readerWithMapper:mapper];
+    reader.useTokenizer = YES;
+    OXTokenEmail *item = [reader readXmlText:@"<?xml version=\"1.0\"?><!DOCTYPE item><!-- note --><item type='a&apos;b'><note>a&lt;b&#x26;c&#38;&quot;d&apos;&#233;</note><address/></item>"];
+    STAssertNil(reader.errors, @"no tokenizer errors");
+    STAssertEqualObjects(@"a<b&c&\"d'\u00e9", item.note, @"decoded text");
+    item = [reader readXmlText:@"<item><note>x</nota></item>"];
+    STAssertNil(item, @"mismatched end tag");
+    STAssertNotNil(reader.errors, @"mismatched end tag error");
+}
+
+@end
+
+
+
+//
+//  Copyright (c) 2013 Outsource Cafe, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
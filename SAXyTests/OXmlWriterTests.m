@@ -15,6 +15,7 @@
 #import "OXmlMapper.h"
 #import "OXmlElementMapper.h"
 #import "OXmlXPathMapper.h"
+#import "OXGzipStream.h"
 
 ///////////////////////////////////////////////////////////////////////////////////
 #pragma mark - test classes
@@ -51,6 +52,13 @@
 @implementation ToonCharacter
 @end
 
+@interface ToonCast : NSObject
+@property(nonatomic)NSArray *members;
+@end
+
+@implementation ToonCast
+@end
+
 @interface AssignOnly : NSObject
 @property(nonatomic,assign)BOOL take;
 @end
@@ -121,4 +129,77 @@
     STAssertEqualObjects(@"<duck><take>true</take></duck>", xml,  @"write without first calling read");
 }
 
+- (void)testCompressedStreams
+{
+    NSMutableArray *members = [NSMutableArray array];
+    for(int i = 0; i < 2000; i++) {     //enough output for several printer flushes
+        ToonCharacter *toon = [ToonCharacter new];
+        toon.firstName = [NSString stringWithFormat:@"Daffy%d", i];
+        toon.lastName = @"Duck";
+        [members addObject:toon];
+    }
+    ToonCast *cast = [ToonCast new];
+    cast.members = members;
+    OXmlMapper *mapper = [[OXmlMapper mapper] elements:@[
+                                [OXmlElementMapper rootXPath:@"/cast" type:[ToonCast class]],
+                                [[OXmlElementMapper elementClass:[ToonCast class]]
+                                                   xpath:@"tune" toMany:[ToonCharacter class] property:@"members"],
+                                [[[OXmlElementMapper elementClass:[ToonCharacter class]]
+                                                   xpath:@"firstName" property:@"firstName"]
+                                                   xpath:@"lastName" property:@"lastName"]
+                          ]];
+
+    //writer -> gzip -> memory
+    NSOutputStream *memory = [NSOutputStream outputStreamToMemory];
+    OXGzipOutputStream *gzip = [OXGzipOutputStream outputStreamWithStream:memory];
+    [gzip open];
+    STAssertTrue([[OXmlWriter writerWithMapper:mapper] writeXml:cast toStream:gzip prettyPrint:YES], @"streamed write");
+    [gzip close];
+    NSData *compressed = [memory propertyForKey:NSStreamDataWrittenToMemoryStreamKey];
+    STAssertEquals(OX_COMPRESSION_GZIP, [OXGzipInputStream compressionOfData:compressed], @"gzip magic number");
+    STAssertTrue([compressed length] < gzip.totalIn / 4, @"repetitive XML compresses well");
+
+    //compressed data is detected and inflated while parsing
+    ToonCast *copy = [[OXmlReader readerWithMapper:mapper] readXmlData:compressed fromURL:nil];
+    STAssertEquals((NSUInteger)2000, [copy.members count], @"all members read back");
+    STAssertEqualObjects(@"Daffy1999", [[copy.members lastObject] firstName], @"last member");
+
+    NSData *xml = [OXGzipInputStream inflateData:compressed];
+    STAssertEquals((unsigned long long)[xml length], gzip.totalIn, @"inflated length");
+    STAssertEqualObjects(xml, [OXGzipInputStream inflateData:xml], @"plain input passes through");
+    STAssertEqualObjects(xml, [OXGzipInputStream inflateData:[OXGzipOutputStream gzipData:xml]], @"whole-buffer round trip");
+    STAssertNil([OXGzipInputStream inflateData:[compressed subdataWithRange:NSMakeRange(0, [compressed length] / 2)]], @"truncated input");
+}
+
+- (void)testParallelWrite
+{
+    NSMutableArray *members = [NSMutableArray array];
+    for(int i = 0; i < 2000; i++) {
+        ToonCharacter *toon = [ToonCharacter new];
+        toon.firstName = [NSString stringWithFormat:@"Daffy%d", i];
+        toon.lastName = @"Duck & <Friends>";
+        [members addObject:toon];
+    }
+    ToonCast *cast = [ToonCast new];
+    cast.members = members;
+    OXmlMapper *mapper = [[OXmlMapper mapper] elements:@[
+                                [OXmlElementMapper rootXPath:@"/cast" type:[ToonCast class]],
+                                [[OXmlElementMapper elementClass:[ToonCast class]]
+                                                   xpath:@"tune" toMany:[ToonCharacter class] property:@"members"],
+                                [[[OXmlElementMapper elementClass:[ToonCharacter class]]
+                                                   xpath:@"firstName" property:@"firstName"]
+                                                   xpath:@"lastName" property:@"lastName"]
+                          ]];
+    NSString *serial = [[OXmlWriter writerWithMapper:mapper] writeXml:cast prettyPrint:YES];
+    OXmlWriter *writer = [OXmlWriter writerWithMapper:mapper];
+    writer.parallelThreshold = 100;
+    STAssertEqualObjects(serial, [writer writeXml:cast prettyPrint:YES], @"chunks spliced in order, same indentation");
+
+    NSOutputStream *memory = [NSOutputStream outputStreamToMemory];
+    [memory open];
+    STAssertTrue([writer writeXml:cast toStream:memory prettyPrint:NO], @"streamed parallel write");
+    NSString *streamed = [[NSString alloc] initWithData:[memory propertyForKey:NSStreamDataWrittenToMemoryStreamKey] encoding:NSUTF8StringEncoding];
+    STAssertEqualObjects([[OXmlWriter writerWithMapper:mapper] writeXml:cast prettyPrint:NO], streamed, @"compact output");
+}
+
 @end